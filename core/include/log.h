@@ -24,7 +24,8 @@
  * 2. have a name starting with "log_" *or* depend on the pseudo-module LOG,
  * 3. implement log_write()
  *
- * See "sys/log/log_printfnoformat" for an example.
+ * See "sys/log/log_printfnoformat" for an example. "sys/log/log_binary" defers
+ * the formatting to the host, for logging with minimal overhead.
  *
  * @author      Kaspar Schleiser <kaspar@schleiser.de>
  */
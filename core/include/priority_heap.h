@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  core_util
+ * @{
+ *
+ * @file
+ * @brief       Intrusive binary heap priority queue
+ *
+ * Alternative to @ref priority_queue.h for long queues: adding and removing
+ * nodes is O(log n), peeking at the head is O(1). Nodes with the same
+ * priority are dequeued in the order they were added, like in
+ * @ref priority_queue.h.
+ *
+ * The heap is a complete binary tree linked through the nodes, so no memory
+ * besides the nodes is needed.
+ */
+
+#ifndef PRIORITY_HEAP_H
+#define PRIORITY_HEAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @brief data type for priority heap nodes
+ */
+typedef struct priority_heap_node {
+    struct priority_heap_node *parent;  /**< parent node */
+    struct priority_heap_node *left;    /**< left child */
+    struct priority_heap_node *right;   /**< right child */
+    uint32_t priority;                  /**< node priority, lowest first */
+    uint32_t seq;                       /**< insertion order, set by
+                                         *   priority_heap_add() */
+} priority_heap_node_t;
+
+/**
+ * @brief data type for priority heaps
+ */
+typedef struct {
+    priority_heap_node_t *root;         /**< node with the lowest priority */
+    unsigned size;                      /**< number of nodes in the heap */
+    uint32_t seq;                       /**< next insertion sequence number */
+} priority_heap_t;
+
+/**
+ * @brief Static initializer for priority_heap_node_t.
+ */
+#define PRIORITY_HEAP_NODE_INIT { NULL, NULL, NULL, 0, 0 }
+
+/**
+ * @brief Static initializer for priority_heap_t.
+ */
+#define PRIORITY_HEAP_INIT { NULL, 0, 0 }
+
+/**
+ * @brief   Initialize a priority heap node object.
+ *
+ * @param[out] node     pre-allocated priority_heap_node_t object, must not be
+ *                      NULL
+ */
+static inline void priority_heap_node_init(priority_heap_node_t *node)
+{
+    priority_heap_node_t n = PRIORITY_HEAP_NODE_INIT;
+    *node = n;
+}
+
+/**
+ * @brief   Initialize a priority heap object.
+ *
+ * @param[out] heap     pre-allocated priority_heap_t object, must not be NULL
+ */
+static inline void priority_heap_init(priority_heap_t *heap)
+{
+    priority_heap_t h = PRIORITY_HEAP_INIT;
+    *heap = h;
+}
+
+/**
+ * @brief get the head of the heap without removing it
+ *
+ * @param[in]   heap    the heap
+ *
+ * @return              the node with the lowest priority, NULL if empty
+ */
+static inline priority_heap_node_t *priority_heap_peek(const priority_heap_t *heap)
+{
+    return heap->root;
+}
+
+/**
+ * @brief get the number of nodes in the heap
+ *
+ * @param[in]   heap    the heap
+ *
+ * @return              number of nodes in @p heap
+ */
+static inline unsigned priority_heap_size(const priority_heap_t *heap)
+{
+    return heap->size;
+}
+
+/**
+ * @brief insert @p node into @p heap based on its priority
+ *
+ * The node will be dequeued after nodes with the same priority already in
+ * the heap.
+ *
+ * @param[in,out]   heap    the heap
+ * @param[in]       node    the node to add
+ *
+ * @pre The heap does not already contain @p node.
+ */
+void priority_heap_add(priority_heap_t *heap, priority_heap_node_t *node);
+
+/**
+ * @brief remove @p node from @p heap
+ *
+ * @param[in,out]   heap    the heap
+ * @param[in]       node    the node to remove
+ *
+ * @pre The heap contains @p node.
+ */
+void priority_heap_remove(priority_heap_t *heap, priority_heap_node_t *node);
+
+/**
+ * @brief remove the head of the heap
+ *
+ * @param[in,out]   heap    the heap
+ *
+ * @return              the old head, NULL if empty
+ */
+priority_heap_node_t *priority_heap_remove_head(priority_heap_t *heap);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+#endif /* PRIORITY_HEAP_H */
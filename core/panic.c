@@ -37,6 +37,10 @@
 #include "ps.h"
 #endif
 
+#ifdef MODULE_UART_STDIO_TX_BUF
+#include "uart_stdio.h"
+#endif
+
 const char assert_crash_message[] = "FAILED ASSERTION.";
 
 /* flag preventing "recursive crash printing loop" */
@@ -73,6 +77,10 @@ NORETURN void core_panic(core_panic_t crash_code, const char *message)
     }
     /* disable watchdog and all possible sources of interrupts */
     irq_disable();
+#ifdef MODULE_UART_STDIO_TX_BUF
+    /* the thread draining the stdio buffer will not run anymore */
+    uart_stdio_flush();
+#endif
     panic_arch();
 #ifndef DEVELHELP
     /* DEVELHELP not set => reboot system */
@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     core_util
+ * @{
+ *
+ * @file
+ * @brief       Intrusive binary heap priority queue implementation
+ *
+ * The tree is kept complete, so the position of the last node (and the
+ * parent of the next free position) is found by following the bits of its
+ * 1-based index from the root.
+ *
+ * @}
+ */
+
+#include <assert.h>
+
+#include "priority_heap.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+static inline int _less(const priority_heap_node_t *a,
+                        const priority_heap_node_t *b)
+{
+    if (a->priority != b->priority) {
+        return a->priority < b->priority;
+    }
+    /* wrap-around safe as long as less than 2^31 nodes are queued */
+    return (int32_t)(a->seq - b->seq) < 0;
+}
+
+static priority_heap_node_t *_node_at(const priority_heap_t *heap, unsigned pos)
+{
+    priority_heap_node_t *node = heap->root;
+    unsigned bit = 8 * sizeof(pos) - 1;
+
+    /* skip the leading one, it denotes the root */
+    while (!(pos & (1U << bit))) {
+        bit--;
+    }
+    while (bit--) {
+        node = (pos & (1U << bit)) ? node->right : node->left;
+    }
+    return node;
+}
+
+static inline void _replace_child(priority_heap_t *heap,
+                                  priority_heap_node_t *parent,
+                                  priority_heap_node_t *old,
+                                  priority_heap_node_t *new)
+{
+    if (!parent) {
+        heap->root = new;
+    }
+    else if (parent->left == old) {
+        parent->left = new;
+    }
+    else {
+        parent->right = new;
+    }
+}
+
+/**
+ * @brief   swap @p node with its parent
+ */
+static void _swap_up(priority_heap_t *heap, priority_heap_node_t *node)
+{
+    priority_heap_node_t *parent = node->parent;
+    priority_heap_node_t *left = node->left;
+    priority_heap_node_t *right = node->right;
+
+    _replace_child(heap, parent->parent, parent, node);
+    node->parent = parent->parent;
+
+    if (parent->left == node) {
+        node->left = parent;
+        node->right = parent->right;
+        if (node->right) {
+            node->right->parent = node;
+        }
+    }
+    else {
+        node->right = parent;
+        node->left = parent->left;
+        if (node->left) {
+            node->left->parent = node;
+        }
+    }
+    parent->parent = node;
+
+    parent->left = left;
+    parent->right = right;
+    if (left) {
+        left->parent = parent;
+    }
+    if (right) {
+        right->parent = parent;
+    }
+}
+
+static void _sift_up(priority_heap_t *heap, priority_heap_node_t *node)
+{
+    while (node->parent && _less(node, node->parent)) {
+        _swap_up(heap, node);
+    }
+}
+
+static void _sift_down(priority_heap_t *heap, priority_heap_node_t *node)
+{
+    while (1) {
+        priority_heap_node_t *min = node;
+
+        if (node->left && _less(node->left, min)) {
+            min = node->left;
+        }
+        if (node->right && _less(node->right, min)) {
+            min = node->right;
+        }
+        if (min == node) {
+            return;
+        }
+        _swap_up(heap, min);
+    }
+}
+
+void priority_heap_add(priority_heap_t *heap, priority_heap_node_t *node)
+{
+    unsigned pos = ++heap->size;
+
+    DEBUG("priority_heap_add(): adding node with priority %lu at %u\n",
+          (unsigned long)node->priority, pos);
+
+    node->seq = heap->seq++;
+    node->left = node->right = NULL;
+
+    if (pos == 1) {
+        node->parent = NULL;
+        heap->root = node;
+        return;
+    }
+
+    priority_heap_node_t *parent = _node_at(heap, pos >> 1);
+    assert(parent != node);
+    node->parent = parent;
+    if (pos & 1) {
+        parent->right = node;
+    }
+    else {
+        parent->left = node;
+    }
+    _sift_up(heap, node);
+}
+
+void priority_heap_remove(priority_heap_t *heap, priority_heap_node_t *node)
+{
+    assert(heap->size > 0);
+
+    /* detach the last node, it fills the hole left by node */
+    priority_heap_node_t *last = _node_at(heap, heap->size--);
+    _replace_child(heap, last->parent, last, NULL);
+
+    if (last != node) {
+        last->parent = node->parent;
+        last->left = node->left;
+        last->right = node->right;
+        _replace_child(heap, node->parent, node, last);
+        if (last->left) {
+            last->left->parent = last;
+        }
+        if (last->right) {
+            last->right->parent = last;
+        }
+
+        if (last->parent && _less(last, last->parent)) {
+            _sift_up(heap, last);
+        }
+        else {
+            _sift_down(heap, last);
+        }
+    }
+
+    node->parent = node->left = node->right = NULL;
+}
+
+priority_heap_node_t *priority_heap_remove_head(priority_heap_t *heap)
+{
+    priority_heap_node_t *head = heap->root;
+
+    if (head) {
+        priority_heap_remove(heap, head);
+    }
+    return head;
+}
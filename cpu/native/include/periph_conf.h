@@ -48,6 +48,15 @@
 #define TIMER_NUMOF        (1U)
 #define TIMER_0_EN         1
 
+/**
+ * @brief   Number of channels of the POSIX timer based timer
+ *
+ * The itimer based default implementation only supports a single channel.
+ */
+#ifndef NATIVE_TIMER_CHANNELS
+#define NATIVE_TIMER_CHANNELS (4U)
+#endif
+
 /**
  * @brief xtimer configuration
  * @{
@@ -26,6 +26,9 @@
  * @}
  */
 
+/* the POSIX timer based implementation lives in timer_posix.c */
+#ifndef MODULE_NATIVE_POSIX_TIMER
+
 #ifdef __MACH__
 #include <mach/clock.h>
 #include <mach/mach_init.h>
@@ -202,3 +205,5 @@ unsigned int timer_read(tim_t dev)
 
     return ts2ticks(&t) - time_null;
 }
+
+#endif /* MODULE_NATIVE_POSIX_TIMER */
@@ -0,0 +1,249 @@
+/**
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     native_cpu
+ * @ingroup     drivers_periph_timer
+ * @{
+ *
+ * @file
+ * @brief       Native CPU periph/timer.h implementation based on a POSIX timer
+ *
+ * Alternative to the itimer based implementation in timer.c, enabled with the
+ * `native_posix_timer` module (Linux only).
+ *
+ * All channels are kept as absolute CLOCK_MONOTONIC deadlines. A single POSIX
+ * timer is armed (TIMER_ABSTIME) with the earliest pending deadline. Its
+ * SIGALRM is delivered like any other native interrupt, so no minimum
+ * resolution clamping is involved.
+ *
+ * @}
+ */
+
+#ifdef MODULE_NATIVE_POSIX_TIMER
+
+#ifndef __linux__
+#error "native_posix_timer is only available on Linux"
+#endif
+
+#include <signal.h>
+#include <time.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <err.h>
+
+#include "cpu.h"
+#include "cpu_conf.h"
+#include "irq.h"
+#include "native_internal.h"
+#include "periph/timer.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define NATIVE_TIMER_SPEED 1000000
+
+#define NS_PER_SEC          (1000000000LLU)
+#define NS_PER_TICK         (NS_PER_SEC / NATIVE_TIMER_SPEED)
+
+/**
+ * @brief   Timer channel state
+ */
+typedef struct {
+    uint64_t deadline;      /**< absolute CLOCK_MONOTONIC deadline in ns */
+    bool active;            /**< true if the channel is armed */
+} _channel_t;
+
+static uint64_t time_null;
+static timer_t _timer;
+static bool _created;
+
+static timer_cb_t _callback;
+static void *_cb_arg;
+
+static _channel_t _channels[NATIVE_TIMER_CHANNELS];
+
+static uint64_t _now_ns(void)
+{
+    struct timespec t;
+
+    _native_syscall_enter();
+    if (real_clock_gettime(CLOCK_MONOTONIC, &t) == -1) {
+        err(EXIT_FAILURE, "timer_read: clock_gettime");
+    }
+    _native_syscall_leave();
+
+    return ((uint64_t)t.tv_sec * NS_PER_SEC) + t.tv_nsec;
+}
+
+/**
+ * @brief   (re-)arm the POSIX timer with the earliest active channel deadline
+ *
+ * @pre     interrupts are disabled
+ */
+static void _arm(void)
+{
+    struct itimerspec its;
+    uint64_t next = 0;
+
+    for (unsigned i = 0; i < NATIVE_TIMER_CHANNELS; i++) {
+        if (_channels[i].active &&
+            ((next == 0) || (_channels[i].deadline < next))) {
+            next = _channels[i].deadline;
+        }
+    }
+
+    /* an all-zero it_value disarms the timer */
+    memset(&its, 0, sizeof(its));
+    its.it_value.tv_sec = next / NS_PER_SEC;
+    its.it_value.tv_nsec = next % NS_PER_SEC;
+
+    DEBUG("timer: arming for %u.%09u\n", (unsigned)its.it_value.tv_sec,
+          (unsigned)its.it_value.tv_nsec);
+
+    _native_syscall_enter();
+    if (timer_settime(_timer, TIMER_ABSTIME, &its, NULL) == -1) {
+        err(EXIT_FAILURE, "timer_arm: timer_settime");
+    }
+    _native_syscall_leave();
+}
+
+/**
+ * native timer "interrupt" handler
+ *
+ * Fires all due channels and re-arms the POSIX timer for the remaining ones.
+ * The signal of a deadline that was moved later in the meantime fires
+ * nothing.
+ */
+static void _timer_isr(void)
+{
+    DEBUG("%s\n", __func__);
+
+    uint64_t now = _now_ns();
+    for (unsigned i = 0; i < NATIVE_TIMER_CHANNELS; i++) {
+        if (_channels[i].active && (_channels[i].deadline <= now)) {
+            _channels[i].active = false;
+            _callback(_cb_arg, i);
+        }
+    }
+
+    _arm();
+}
+
+int timer_init(tim_t dev, unsigned long freq, timer_cb_t cb, void *arg)
+{
+    DEBUG("%s\n", __func__);
+    if (dev >= TIMER_NUMOF) {
+        return -1;
+    }
+    if (freq != NATIVE_TIMER_SPEED) {
+        return -1;
+    }
+
+    /* initialize time delta */
+    time_null = 0;
+    time_null = timer_read(0);
+
+    _callback = cb;
+    _cb_arg = arg;
+    memset(_channels, 0, sizeof(_channels));
+
+    if (!_created) {
+        struct sigevent sev;
+
+        memset(&sev, 0, sizeof(sev));
+        sev.sigev_notify = SIGEV_SIGNAL;
+        sev.sigev_signo = SIGALRM;
+
+        _native_syscall_enter();
+        if (timer_create(CLOCK_MONOTONIC, &sev, &_timer) == -1) {
+            err(EXIT_FAILURE, "timer_init: timer_create");
+        }
+        _native_syscall_leave();
+        if (register_interrupt(SIGALRM, _timer_isr) != 0) {
+            DEBUG("darn!\n\n");
+        }
+        _created = true;
+    }
+
+    return 0;
+}
+
+static int _set(tim_t dev, int channel, uint64_t deadline)
+{
+    if ((dev >= TIMER_NUMOF) || ((unsigned)channel >= NATIVE_TIMER_CHANNELS)) {
+        return -1;
+    }
+
+    unsigned state = irq_disable();
+    _channels[channel].deadline = deadline;
+    _channels[channel].active = true;
+    _arm();
+    irq_restore(state);
+
+    return 1;
+}
+
+int timer_set(tim_t dev, int channel, unsigned int offset)
+{
+    DEBUG("%s\n", __func__);
+
+    return _set(dev, channel, _now_ns() + ((uint64_t)offset * NS_PER_TICK));
+}
+
+int timer_set_absolute(tim_t dev, int channel, unsigned int value)
+{
+    DEBUG("%s\n", __func__);
+
+    /* compute the deadline on the tick boundary of value, just like a compare
+     * match on real hardware, taking the 32-bit counter wrap into account */
+    uint64_t now = _now_ns() / NS_PER_TICK;
+    uint32_t delta = value - (uint32_t)(now - time_null);
+
+    return _set(dev, channel, (now + delta) * NS_PER_TICK);
+}
+
+int timer_clear(tim_t dev, int channel)
+{
+    if ((dev >= TIMER_NUMOF) || ((unsigned)channel >= NATIVE_TIMER_CHANNELS)) {
+        return -1;
+    }
+
+    unsigned state = irq_disable();
+    _channels[channel].active = false;
+    _arm();
+    irq_restore(state);
+
+    return 1;
+}
+
+void timer_start(tim_t dev)
+{
+    (void)dev;
+    DEBUG("%s\n", __func__);
+}
+
+void timer_stop(tim_t dev)
+{
+    (void)dev;
+    DEBUG("%s\n", __func__);
+}
+
+unsigned int timer_read(tim_t dev)
+{
+    if (dev >= TIMER_NUMOF) {
+        return 0;
+    }
+
+    return (unsigned int)((_now_ns() / NS_PER_TICK) - time_null);
+}
+
+#endif /* MODULE_NATIVE_POSIX_TIMER */
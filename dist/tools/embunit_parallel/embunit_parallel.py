@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Runs the suites of a native unittests binary in parallel processes."""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+import time
+from concurrent.futures import ThreadPoolExecutor, as_completed
+
+SUITE_RE = re.compile(r"^suite (\S+)$")
+DURATION_RE = re.compile(r"#duration (\S+) (\d+)")
+OK_RE = re.compile(r"OK \((\d+) tests\)")
+FAILED_RE = re.compile(r"run (\d+) failures (\d+)")
+FAILURE_RE = re.compile(r"^(\S+\.\S+ \(.+ \d+\) .*)$")
+
+
+class Result(object):
+    def __init__(self, suite):
+        self.suite = suite
+        self.status = "CRASH"
+        self.tests = 0
+        self.failed = 0
+        self.failures = []
+        self.durations = []
+        self.seconds = 0.0
+        self.output = ""
+
+
+def _run(elf, env, timeout):
+    proc = subprocess.run([elf], env=env, stdin=subprocess.DEVNULL,
+                          stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                          timeout=timeout)
+    return proc.stdout.decode("utf-8", "replace")
+
+
+def list_suites(elf, timeout):
+    env = dict(os.environ, UNITTESTS_LIST="1")
+    suites = []
+    for line in _run(elf, env, timeout).splitlines():
+        match = SUITE_RE.match(line.strip())
+        if match:
+            suites.append(match.group(1))
+    return suites
+
+
+def run_suite(elf, suite, timeout):
+    result = Result(suite)
+    env = dict(os.environ, UNITTESTS_SUITES=suite, EMBUNIT_DURATIONS="1")
+    start = time.monotonic()
+    try:
+        result.output = _run(elf, env, timeout)
+    except subprocess.TimeoutExpired as exc:
+        result.status = "TIMEOUT"
+        result.output = (exc.output or b"").decode("utf-8", "replace")
+    result.seconds = time.monotonic() - start
+
+    for line in result.output.splitlines():
+        line = line.lstrip(".")
+        match = DURATION_RE.search(line)
+        if match:
+            result.durations.append((int(match.group(2)), match.group(1)))
+            continue
+        match = FAILURE_RE.match(line)
+        if match:
+            result.failures.append(match.group(1))
+            continue
+        if result.status == "TIMEOUT":
+            continue
+        match = OK_RE.search(line)
+        if match:
+            result.status = "OK"
+            result.tests = int(match.group(1))
+            continue
+        match = FAILED_RE.search(line)
+        if match:
+            result.status = "FAILED"
+            result.tests = int(match.group(1))
+            result.failed = int(match.group(2))
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("elf", help="unittests binary built for native")
+    parser.add_argument("suites", nargs="*",
+                        help="suites to run (default: all in the binary)")
+    parser.add_argument("-j", "--jobs", type=int, default=os.cpu_count(),
+                        help="number of parallel workers (default: %(default)s)")
+    parser.add_argument("-t", "--timeout", type=float, default=60,
+                        help="timeout per suite in s (default: %(default)s)")
+    parser.add_argument("-s", "--slow", type=float, default=100,
+                        help="report tests slower than this in ms "
+                             "(default: %(default)s)")
+    args = parser.parse_args()
+
+    suites = args.suites or list_suites(args.elf, args.timeout)
+    if not suites:
+        print("no test suites found in %s" % args.elf)
+        return 1
+
+    start = time.monotonic()
+    results = []
+    with ThreadPoolExecutor(max_workers=args.jobs) as pool:
+        futures = [pool.submit(run_suite, args.elf, suite, args.timeout)
+                   for suite in suites]
+        for future in as_completed(futures):
+            result = future.result()
+            results.append(result)
+            print("[%*d/%d] %-24s %-7s %4d tests %7.2f s" %
+                  (len(str(len(suites))), len(results), len(suites),
+                   result.suite, result.status, result.tests, result.seconds))
+            sys.stdout.flush()
+    elapsed = time.monotonic() - start
+
+    bad = [r for r in results if r.status != "OK"]
+    for result in sorted(bad, key=lambda r: r.suite):
+        print("\n%s: %s" % (result.suite, result.status))
+        for failure in result.failures:
+            print("    %s" % failure)
+        if result.status in ("CRASH", "TIMEOUT"):
+            # no summary line, show how far the suite got
+            for line in result.output.splitlines()[-10:]:
+                print("  | %s" % line)
+
+    slow = sorted((d for r in results for d in r.durations
+                   if d[0] >= args.slow * 1000), reverse=True)
+    if slow:
+        print("\ntests slower than %g ms:" % args.slow)
+        for usec, name in slow:
+            print("  %10.1f ms  %s" % (usec / 1000.0, name))
+
+    tests = sum(r.tests for r in results)
+    failed = sum(r.failed for r in results)
+    cpu = sum(r.seconds for r in results)
+    print("\n%d suites, %d tests, %d failures, %d suites crashed or timed out "
+          "in %.2f s (%.2f s in workers)" %
+          (len(results), tests, failed,
+           sum(1 for r in bad if r.status != "FAILED"), elapsed, cpu))
+    if bad:
+        print("FAILED")
+        return 1
+    print("OK (%d tests)" % tests)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Decode the output of RIOT's log_binary module.
+
+Reads terminal output from a file or stdin, replaces all "LOGB" lines by the
+formatted log messages and passes all other lines through unchanged. The
+format strings are looked up in the application's ELF file.
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+LOGB_RE = re.compile(r'LOGB((?: [0-9a-fA-F]{8})+)\s*$')
+DROPPED_RE = re.compile(r'LOGB-DROPPED (\d+)')
+CONV_RE = re.compile(r'%([-+ #0]*)(\d+|\*)?(?:\.(\d+))?'
+                     r'(hh|h|ll|l|j|z|t|L)?([diouxXcsp%])')
+
+HDR_NARGS = 0x000000ff
+HDR_LEVEL = 0x0000ff00
+HDR_TIME = 0x00010000
+
+LEVELS = ['NONE', 'ERROR', 'WARNING', 'INFO', 'DEBUG', 'ALL']
+
+SHT_NOBITS = 8
+SHF_ALLOC = 0x2
+
+
+class Elf(object):
+    """Minimal ELF reader, giving access to the allocated sections' data"""
+
+    def __init__(self, filename):
+        with open(filename, 'rb') as f:
+            self.data = f.read()
+        if self.data[:4] != b'\x7fELF':
+            raise ValueError("%s is no ELF file" % filename)
+        is64 = self.data[4] == 2
+        endian = '<' if self.data[5] == 1 else '>'
+
+        if is64:
+            shoff, = struct.unpack_from(endian + 'Q', self.data, 0x28)
+            shentsize, shnum = struct.unpack_from(endian + 'HH', self.data,
+                                                  0x3a)
+            shdr = endian + 'IIQQQQIIQQ'
+        else:
+            shoff, = struct.unpack_from(endian + 'I', self.data, 0x20)
+            shentsize, shnum = struct.unpack_from(endian + 'HH', self.data,
+                                                  0x2e)
+            shdr = endian + 'IIIIIIIIII'
+
+        self.sections = []
+        for i in range(shnum):
+            (_, sh_type, sh_flags, sh_addr, sh_offset, sh_size, _, _, _,
+             _) = struct.unpack_from(shdr, self.data, shoff + i * shentsize)
+            if (sh_flags & SHF_ALLOC) and (sh_type != SHT_NOBITS) and sh_size:
+                self.sections.append((sh_addr, sh_offset, sh_size))
+
+    def string(self, addr):
+        """Get the zero terminated string at addr, None if not contained"""
+        for sh_addr, sh_offset, sh_size in self.sections:
+            if sh_addr <= addr < sh_addr + sh_size:
+                start = sh_offset + addr - sh_addr
+                end = self.data.find(b'\0', start, sh_offset + sh_size)
+                if end < 0:
+                    return None
+                return self.data[start:end].decode('utf-8', 'replace')
+        return None
+
+
+def format_message(elf, fmt, args):
+    """Format fmt like printf() with the recorded 32-bit args"""
+    args = list(args)
+    out = []
+    pos = 0
+
+    for m in CONV_RE.finditer(fmt):
+        out.append(fmt[pos:m.start()])
+        pos = m.end()
+        flags, width, precision, _, conv = m.groups()
+        if conv == '%':
+            out.append('%')
+            continue
+        if width == '*':
+            width = str(args.pop(0) if args else 0)
+        value = args.pop(0) if args else 0
+        spec = '%' + flags + (width or '')
+        if precision is not None:
+            spec += '.' + precision
+
+        if conv in 'di':
+            if value & 0x80000000:
+                value -= 1 << 32
+            out.append((spec + 'd') % value)
+        elif conv in 'ouxX':
+            out.append((spec + conv) % value)
+        elif conv == 'c':
+            out.append((spec + 'c') % chr(value & 0xff))
+        elif conv == 'p':
+            out.append((spec + 's') % ('0x%x' % value))
+        else:
+            string = elf.string(value)
+            if string is None:
+                string = '<0x%08x>' % value
+            out.append((spec + 's') % string)
+
+    out.append(fmt[pos:])
+    return ''.join(out)
+
+
+def decode_line(elf, line):
+    m = LOGB_RE.search(line)
+    if not m:
+        m = DROPPED_RE.search(line)
+        if m:
+            return '*** %s log records dropped\n' % m.group(1)
+        return line
+
+    words = [int(w, 16) for w in m.group(1).split()]
+    hdr = words[0]
+    fmt = elf.string(words[1])
+    args = words[2:]
+    prefix = ''
+
+    level = (hdr & HDR_LEVEL) >> 8
+    if level < len(LEVELS):
+        prefix += '[%s] ' % LEVELS[level]
+    if hdr & HDR_TIME:
+        prefix = '%10u ' % args.pop(0) + prefix
+
+    if fmt is None:
+        return prefix + 'unknown format string at 0x%08x %s\n' % (
+            words[1], ' '.join('0x%x' % a for a in args))
+    return prefix + format_message(elf, fmt, args)
+
+
+def main():
+    p = argparse.ArgumentParser(description=__doc__)
+    p.add_argument('elf', help='ELF file of the application')
+    p.add_argument('input', nargs='?', type=argparse.FileType('r'),
+                   default=sys.stdin,
+                   help='captured terminal output (default: stdin)')
+    args = p.parse_args()
+
+    elf = Elf(args.elf)
+    for line in args.input:
+        sys.stdout.write(decode_line(elf, line))
+        sys.stdout.flush()
+
+
+if __name__ == '__main__':
+    main()
@@ -11,16 +11,32 @@
 #include <string.h>
 #include <unistd.h>
 #include <stdio.h>
+#include <time.h>
 #include <netdb.h>
 #include <net/if.h>
 #include <arpa/inet.h>
 
 #include "net/uhcp.h"
 
-char _prefix[16];
-unsigned _prefix_len;
+#define MAX_LEASES          (256U)
+#define DEFAULT_LIFETIME    (300U)
+
+typedef struct {
+    uint8_t client_id[UHCP_CLIENT_ID_LEN];
+    time_t expires;
+    unsigned used;
+} lease_t;
+
+static char _prefix[16];
+static unsigned _prefix_len;
+static unsigned _delegate_len;
+static uint16_t _lifetime = DEFAULT_LIFETIME;
+static lease_t _leases[MAX_LEASES];
+static unsigned _leases_numof = 1;
 
 static const char *BIND_OPTION = "--bind-to-device";
+static const char *DELEGATE_OPTION = "--delegate";
+static const char *LIFETIME_OPTION = "--lifetime";
 static void bind_to_device(int sock, const char *interface);
 
 int ipv6_addr_split(char *addr_str, char seperator, int _default)
@@ -45,8 +61,9 @@ int main(int argc, char *argv[])
     unsigned _bind_to_device = 0;
 
     if (argc < 3) {
-        fprintf(stderr, "usage: uhcpd <interface> <prefix/prefix_length> [%s]\n",
-                BIND_OPTION);
+        fprintf(stderr, "usage: uhcpd <interface> <prefix/prefix_length> [%s]\n"
+                "             [%s <prefix_length>] [%s <seconds>]\n",
+                BIND_OPTION, DELEGATE_OPTION, LIFETIME_OPTION);
         exit(1);
     }
 
@@ -62,12 +79,35 @@ int main(int argc, char *argv[])
         exit(1);
     }
 
-    if (argc == 4) {
-        if (strcmp(BIND_OPTION, argv[3])) {
+    for (int i = 3; i < argc; i++) {
+        if (!strcmp(BIND_OPTION, argv[i])) {
+            _bind_to_device = 1;
+        }
+        else if (!strcmp(DELEGATE_OPTION, argv[i]) && (i + 1 < argc)) {
+            _delegate_len = atoi(argv[++i]);
+        }
+        else if (!strcmp(LIFETIME_OPTION, argv[i]) && (i + 1 < argc)) {
+            int lifetime = atoi(argv[++i]);
+            if ((lifetime <= 0) || (lifetime > (int)UHCP_LIFETIME_INFINITE)) {
+                fprintf(stderr, "error: invalid lifetime\n");
+                exit(1);
+            }
+            _lifetime = lifetime;
+        }
+        else {
             fprintf(stderr, "error: unkwown option\n");
             exit(1);
         }
-        _bind_to_device = 1;
+    }
+
+    if (_delegate_len) {
+        if ((_delegate_len < _prefix_len) || (_delegate_len > 128)) {
+            fprintf(stderr, "error: invalid delegated prefix length\n");
+            exit(1);
+        }
+        /* number of sub-prefixes, capped by the lease table */
+        unsigned bits = _delegate_len - _prefix_len;
+        _leases_numof = (bits >= 8) ? MAX_LEASES : (1U << bits);
     }
 
     char *addr_str = UHCP_MCAST_ADDR;
@@ -137,6 +177,90 @@ int main(int argc, char *argv[])
     exit(0);
 }
 
+static void _sub_prefix(uint8_t *prefix, unsigned idx)
+{
+    memcpy(prefix, _prefix, 16);
+
+    /* write idx into the bits between pool and delegated prefix length */
+    for (unsigned bit = _delegate_len; idx && (bit > _prefix_len); bit--) {
+        unsigned pos = bit - 1;
+        if (idx & 1) {
+            prefix[pos >> 3] |= (0x80 >> (pos & 0x7));
+        }
+        else {
+            prefix[pos >> 3] &= ~(0x80 >> (pos & 0x7));
+        }
+        idx >>= 1;
+    }
+}
+
+static int _find_lease(const uint8_t *client_id, time_t now)
+{
+    int free_idx = -1;
+    time_t oldest = 0;
+
+    for (unsigned i = 0; i < _leases_numof; i++) {
+        lease_t *lease = &_leases[i];
+        if (lease->used &&
+            !memcmp(lease->client_id, client_id, UHCP_CLIENT_ID_LEN)) {
+            return i;
+        }
+        /* prefer never used entries, then the one expired the longest */
+        if (!lease->used) {
+            if ((free_idx < 0) || _leases[free_idx].used) {
+                free_idx = i;
+            }
+        }
+        else if ((lease->expires < now) &&
+                 ((free_idx < 0) || (_leases[free_idx].used &&
+                                     (lease->expires < oldest)))) {
+            free_idx = i;
+            oldest = lease->expires;
+        }
+    }
+
+    if (free_idx >= 0) {
+        memcpy(_leases[free_idx].client_id, client_id, UHCP_CLIENT_ID_LEN);
+        _leases[free_idx].used = 1;
+    }
+    return free_idx;
+}
+
+int uhcp_server_lease(const uint8_t *client_id, const uint8_t *src,
+                      uint8_t *prefix, uint8_t *prefix_len, uint16_t *lifetime)
+{
+    if (!_delegate_len) {
+        /* single prefix mode, everybody gets the whole prefix */
+        memcpy(prefix, _prefix, 16);
+        *prefix_len = _prefix_len;
+        *lifetime = UHCP_LIFETIME_INFINITE;
+        return 0;
+    }
+
+    /* requests without client id are identified by the interface identifier
+     * of their source address */
+    if (!client_id) {
+        client_id = src + 16 - UHCP_CLIENT_ID_LEN;
+    }
+
+    time_t now = time(NULL);
+    int idx = _find_lease(client_id, now);
+    if (idx < 0) {
+        return -1;
+    }
+
+    _leases[idx].expires = now + _lifetime;
+    _sub_prefix(prefix, idx);
+    *prefix_len = _delegate_len;
+    *lifetime = _lifetime;
+
+    char prefix_str[INET6_ADDRSTRLEN];
+    inet_ntop(AF_INET6, prefix, prefix_str, INET6_ADDRSTRLEN);
+    printf("uhcpd: lease %u: %s/%u for %us\n", (unsigned)idx, prefix_str,
+           _delegate_len, (unsigned)_lifetime);
+    return 0;
+}
+
 int udp_sendto(uint8_t *buf, size_t len, uint8_t *dst, uint16_t dst_port, uhcp_iface_t iface)
 {
     struct sockaddr_in6 dst_addr;
@@ -20,6 +20,7 @@
  */
 
 #include <errno.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -65,11 +66,20 @@ static void _rx_start(cc110x_t *dev)
     gpio_irq_enable(dev->params.gdo2);
 }
 
+/* The packet is streamed through the FIFO into the packet buffer, followed
+ * by the status bytes. For a packet of maximum length these end up in
+ * pkt_buf->status, so the destination is addressed from the start of the
+ * packet buffer. */
+static inline char *_pkt_buf_pos(cc110x_pkt_buf_t *pkt_buf, unsigned pos)
+{
+    return (char *)pkt_buf + offsetof(cc110x_pkt_buf_t, packet) + pos;
+}
+
 static void _rx_read_data(cc110x_t *dev, void(*callback)(void*), void*arg)
 {
-    int fifo = cc110x_get_reg_robust(dev, 0xfb);
+    int fifo = cc110x_get_reg_robust(dev, CC110X_RXBYTES);
 
-    if (fifo & 0x80) {
+    if (fifo & RXFIFO_OVERFLOW) {
         DEBUG("%s:%s:%u rx overflow\n", RIOT_FILE_RELATIVE, __func__, __LINE__);
         _rx_abort(dev);
         return;
@@ -84,31 +94,37 @@ static void _rx_read_data(cc110x_t *dev, void(*callback)(void*), void*arg)
     if (!pkt_buf->pos) {
         pkt_buf->pos = 1;
         pkt_buf->packet.length = cc110x_read_reg(dev, CC110X_RXFIFO);
+        fifo--;
 
         /* Possible packet received, RX -> IDLE (0.1 us) */
         dev->cc110x_statistic.packets_in++;
+
+        if (pkt_buf->packet.length >= sizeof(cc110x_pkt_t)) {
+            DEBUG("%s:%s:%u rx oversized packet\n", RIOT_FILE_RELATIVE,
+                  __func__, __LINE__);
+            _rx_abort(dev);
+            return;
+        }
     }
 
-    int left = pkt_buf->packet.length+1 - pkt_buf->pos;
+    /* the packet is followed by the 2 appended status bytes */
+    int left = pkt_buf->packet.length + 1 + CC110X_STATUS_LENGTH - pkt_buf->pos;
 
     /* if the fifo doesn't contain the rest of the packet,
-     * leav at least one byte as per spec sheet. */
-    int to_read = (fifo < left) ? (fifo-1) : fifo;
-    if (to_read > left) {
-        to_read = left;
-    }
+     * leave at least one byte as per spec sheet. */
+    int to_read = (fifo < left) ? (fifo - 1) : left;
 
-    if (to_read) {
+    if (to_read > 0) {
         cc110x_readburst_reg(dev, CC110X_RXFIFO,
-                ((char *)&pkt_buf->packet)+pkt_buf->pos, to_read);
+                             _pkt_buf_pos(pkt_buf, pkt_buf->pos), to_read);
         pkt_buf->pos += to_read;
     }
 
     if (to_read == left) {
-        uint8_t status[2];
         /* full packet received. */
-        /* Read the 2 appended status bytes (status[0] = RSSI, status[1] = LQI) */
-        cc110x_readburst_reg(dev, CC110X_RXFIFO, (char *)status, 2);
+        /* status[0] = RSSI, status[1] = LQI */
+        uint8_t *status = (uint8_t *)_pkt_buf_pos(pkt_buf,
+                                                  pkt_buf->packet.length + 1);
 
         /* Store RSSI value of packet */
         pkt_buf->rssi = status[I_RSSI];
@@ -177,12 +193,18 @@ static void _tx_continue(cc110x_t *dev)
         return;
     }
 
-    int fifo = 64 - cc110x_get_reg_robust(dev, 0xfa);
+    /* the TX FIFO is empty after the flush in cc110x_send() */
+    int fifo = CC110X_FIFO_SIZE;
 
-    if (fifo & 0x80) {
-        DEBUG("%s:%s:%u tx underflow!\n", RIOT_FILE_RELATIVE, __func__, __LINE__);
-        _tx_abort(dev);
-        return;
+    if (left < size) {
+        uint8_t txbytes = cc110x_get_reg_robust(dev, CC110X_TXBYTES);
+
+        if (txbytes & TXFIFO_UNDERFLOW) {
+            DEBUG("%s:%s:%u tx underflow!\n", RIOT_FILE_RELATIVE, __func__, __LINE__);
+            _tx_abort(dev);
+            return;
+        }
+        fifo -= txbytes;
     }
 
     if (!fifo) {
@@ -203,9 +225,9 @@ static void _tx_continue(cc110x_t *dev)
     }
 
     if (to_send < left) {
-        /* set GDO2 to 0x2 -> will deassert at TX FIFO below threshold */
+        /* GDO2 is still set to 0x2 by cc110x_send() -> will deassert at TX
+         * FIFO below threshold */
         gpio_irq_enable(dev->params.gdo2);
-        cc110x_write_reg(dev, CC110X_IOCFG2, 0x02);
     }
     else {
         /* set GDO2 to 0x6 -> will deassert at packet end */
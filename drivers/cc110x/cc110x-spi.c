@@ -95,18 +95,12 @@ void cc110x_writeburst_reg(cc110x_t *dev, uint8_t addr, const char *src, uint8_t
 
 void cc110x_readburst_reg(cc110x_t *dev, uint8_t addr, char *buffer, uint8_t count)
 {
-    int i = 0;
     unsigned int cpsr;
     lock(dev);
     cpsr = irq_disable();
     cc110x_cs(dev);
-    spi_transfer_byte(dev->params.spi, SPI_CS_UNDEF, false,
-                      (addr | CC110X_READ_BURST));
-    while (i < count) {
-        buffer[i] = (char)spi_transfer_byte(dev->params.spi, SPI_CS_UNDEF,
-                                            false, CC110X_NOBYTE);
-        i++;
-    }
+    spi_transfer_regs(dev->params.spi, SPI_CS_UNDEF,
+                      (addr | CC110X_READ_BURST), NULL, buffer, count);
     gpio_set(dev->params.cs);
     irq_restore(cpsr);
     spi_release(dev->params.spi);
@@ -29,7 +29,11 @@ extern "C" {
 #endif
 
 #define CC110X_RXBUF_SIZE           (2)
-#define CC110X_MAX_DATA_LENGTH      (58+64)
+#define CC110X_MAX_DATA_LENGTH      (CC110X_PACKET_LENGTH - \
+                                     CC110X_HEADER_LENGTH - 1)
+#define CC110X_FIFO_SIZE            (64)    /**< size of the RX and TX FIFO */
+#define CC110X_STATUS_LENGTH        (2)     /**< RSSI and LQI appended to a
+                                                 received packet */
 
 #define CC110X_HEADER_LENGTH        (3)     /**< Header covers SRC, DST and
                                                  FLAGS */
@@ -119,8 +123,13 @@ typedef struct __attribute__((packed))
 typedef struct {
     uint8_t rssi;                           /**< RSSI value */
     uint8_t lqi;                            /**< link quality indicator */
-    uint8_t pos;                            /**< I have no clue. */
+    uint16_t pos;                           /**< bytes of the packet (and
+                                                 status bytes) passed through
+                                                 the FIFO so far */
     cc110x_pkt_t packet;                    /**< whole packet */
+    uint8_t status[CC110X_STATUS_LENGTH];   /**< room for the status bytes
+                                                 following a received packet
+                                                 of maximum length */
 } cc110x_pkt_buf_t;
 
 /**
@@ -19,6 +19,7 @@
  */
 
 #include <errno.h>
+#include <stddef.h>
 #include <string.h>
 
 #include "luid.h"
@@ -26,7 +27,12 @@
 #include "xtimer.h"
 #include "assert.h"
 #include "net/ethernet.h"
+#include "net/ethertype.h"
+#include "net/inet_csum.h"
+#include "net/ipv6/hdr.h"
 #include "net/netdev/eth.h"
+#include "net/protnum.h"
+#include "net/udp.h"
 
 #include "enc28j60.h"
 #include "enc28j60_regs.h"
@@ -74,6 +80,16 @@
 #define BUF_RX_START                (0)
 #define BUF_RX_END                  (BUF_TX_START - 2)
 
+/**
+ * @brief   Offsets into a frame carrying an UDP datagram over IPv6
+ * @{
+ */
+#define IPV6_OFFSET                 (sizeof(ethernet_hdr_t))
+#define UDP_OFFSET                  (IPV6_OFFSET + sizeof(ipv6_hdr_t))
+#define UDP_CSUM_OFFSET             (UDP_OFFSET + offsetof(udp_hdr_t, checksum))
+#define UDP_HDRS_LEN                (UDP_OFFSET + sizeof(udp_hdr_t))
+/** @} */
+
 
 static void switch_bank(enc28j60_t *dev, int8_t bank)
 {
@@ -89,18 +105,69 @@ static void switch_bank(enc28j60_t *dev, int8_t bank)
     dev->bank = bank;
 }
 
+static inline void bus_acquire(enc28j60_t *dev)
+{
+    spi_acquire(dev->spi, dev->cs_pin, SPI_MODE_0, SPI_CLK);
+}
+
+static inline void bus_release(enc28j60_t *dev)
+{
+    spi_release(dev->spi);
+}
+
+/* the following functions expect the SPI bus to be acquired, so that
+ * sequences of commands can be issued in a single transaction */
+static uint8_t rcr(enc28j60_t *dev, uint8_t reg, int8_t bank)
+{
+    switch_bank(dev, bank);
+    return spi_transfer_reg(dev->spi, dev->cs_pin, (CMD_RCR | reg), 0);
+}
+
+static void wcr(enc28j60_t *dev, uint8_t reg, int8_t bank, uint8_t value)
+{
+    switch_bank(dev, bank);
+    spi_transfer_reg(dev->spi, dev->cs_pin, (CMD_WCR | reg), value);
+}
+
+static void bfs(enc28j60_t *dev, uint8_t reg, int8_t bank, uint8_t mask)
+{
+    switch_bank(dev, bank);
+    spi_transfer_reg(dev->spi, dev->cs_pin, (CMD_BFS | reg), mask);
+}
+
+static void bfc(enc28j60_t *dev, uint8_t reg, int8_t bank, uint8_t mask)
+{
+    switch_bank(dev, bank);
+    spi_transfer_reg(dev->spi, dev->cs_pin, (CMD_BFC | reg), mask);
+}
+
+static void w_addr(enc28j60_t *dev, uint8_t addr, uint16_t val)
+{
+    wcr(dev, addr, 0, (val & 0xff));
+    wcr(dev, addr + 1, 0, (val >> 8));
+}
+
+static void rbm(enc28j60_t *dev, uint8_t *data, size_t len)
+{
+    spi_transfer_regs(dev->spi, dev->cs_pin, CMD_RBM, NULL, data, len);
+}
+
+static void wbm(enc28j60_t *dev, const uint8_t *data, size_t len)
+{
+    spi_transfer_regs(dev->spi, dev->cs_pin, CMD_WBM, data, NULL, len);
+}
+
 static uint8_t cmd_rcr(enc28j60_t *dev, uint8_t reg, int8_t bank)
 {
     uint8_t res;
 
     /* start transaction */
-    spi_acquire(dev->spi, dev->cs_pin, SPI_MODE_0, SPI_CLK);
+    bus_acquire(dev);
 
-    switch_bank(dev, bank);
-    res = spi_transfer_reg(dev->spi, dev->cs_pin, (CMD_RCR | reg), 0);
+    res = rcr(dev, reg, bank);
 
     /* finish SPI transaction */
-    spi_release(dev->spi);
+    bus_release(dev);
 
     return res;
 }
@@ -110,13 +177,13 @@ static uint8_t cmd_rcr_miimac(enc28j60_t *dev, uint8_t reg, int8_t bank)
     char res[2];
 
     /* start transaction */
-    spi_acquire(dev->spi, dev->cs_pin, SPI_MODE_0, SPI_CLK);
+    bus_acquire(dev);
 
     switch_bank(dev, bank);
     spi_transfer_regs(dev->spi, dev->cs_pin, (CMD_RCR | reg), NULL, res, 2);
 
     /* finish SPI transaction */
-    spi_release(dev->spi);
+    bus_release(dev);
 
     return (uint8_t)res[1];
 }
@@ -124,44 +191,34 @@ static uint8_t cmd_rcr_miimac(enc28j60_t *dev, uint8_t reg, int8_t bank)
 static void cmd_wcr(enc28j60_t *dev, uint8_t reg, int8_t bank, uint8_t value)
 {
     /* start transaction */
-    spi_acquire(dev->spi, dev->cs_pin, SPI_MODE_0, SPI_CLK);
+    bus_acquire(dev);
 
-    switch_bank(dev, bank);
-    spi_transfer_reg(dev->spi, dev->cs_pin, (CMD_WCR | reg), value);
+    wcr(dev, reg, bank, value);
 
     /* finish SPI transaction */
-    spi_release(dev->spi);
+    bus_release(dev);
 }
 
 static void cmd_bfs(enc28j60_t *dev, uint8_t reg, int8_t bank, uint8_t mask)
 {
     /* start transaction */
-    spi_acquire(dev->spi, dev->cs_pin, SPI_MODE_0, SPI_CLK);
+    bus_acquire(dev);
 
-    switch_bank(dev, bank);
-    spi_transfer_reg(dev->spi, dev->cs_pin, (CMD_BFS | reg), mask);
+    bfs(dev, reg, bank, mask);
 
     /* finish SPI transaction */
-    spi_release(dev->spi);
+    bus_release(dev);
 }
 
 static void cmd_bfc(enc28j60_t *dev, uint8_t reg, int8_t bank, uint8_t mask)
 {
     /* start transaction */
-    spi_acquire(dev->spi, dev->cs_pin, SPI_MODE_0, SPI_CLK);
+    bus_acquire(dev);
 
-    switch_bank(dev, bank);
-    spi_transfer_reg(dev->spi, dev->cs_pin, (CMD_BFC | reg), mask);
+    bfc(dev, reg, bank, mask);
 
     /* finish SPI transaction */
-    spi_release(dev->spi);
-}
-
-static uint16_t cmd_r_addr(enc28j60_t *dev, uint8_t addr)
-{
-    uint8_t low = cmd_rcr(dev, addr, 0);
-    uint8_t high = cmd_rcr(dev, addr + 1, 0);
-    return (uint16_t)((high << 8) | low);
+    bus_release(dev);
 }
 
 static void cmd_w_addr(enc28j60_t *dev, uint8_t addr, uint16_t val)
@@ -194,26 +251,6 @@ static void cmd_w_phy(enc28j60_t *dev, uint8_t reg, uint16_t val)
     while (cmd_rcr_miimac(dev, REG_B3_MISTAT, 3) & MISTAT_BUSY) {}
 }
 
-static void cmd_rbm(enc28j60_t *dev, uint8_t *data, size_t len)
-{
-    /* start transaction */
-    spi_acquire(dev->spi, dev->cs_pin, SPI_MODE_0, SPI_CLK);
-    /* transfer data */
-    spi_transfer_regs(dev->spi, dev->cs_pin, CMD_RBM, NULL, data, len);
-    /* finish SPI transaction */
-    spi_release(dev->spi);
-}
-
-static void cmd_wbm(enc28j60_t *dev, uint8_t *data, size_t len)
-{
-    /* start transaction */
-    spi_acquire(dev->spi, dev->cs_pin, SPI_MODE_0, SPI_CLK);
-    /* transfer data */
-    spi_transfer_regs(dev->spi, dev->cs_pin, CMD_WBM, data, NULL, len);
-    /* finish SPI transaction */
-    spi_release(dev->spi);
-}
-
 static void mac_get(enc28j60_t *dev, uint8_t *mac)
 {
     mac[0] = cmd_rcr_miimac(dev, REG_B3_MAADR6, 3);
@@ -240,11 +277,88 @@ static void on_int(void *arg)
     netdev->event_callback(arg, NETDEV_EVENT_ISR);
 }
 
+static inline uint16_t rx_addr(uint16_t addr)
+{
+    /* addresses behind the RX buffer wrap around to its start */
+    if (addr > BUF_RX_END) {
+        addr -= (BUF_RX_END - BUF_RX_START + 1);
+    }
+    return addr;
+}
+
+/* returns the length of the UDP datagram carried by an IPv6 frame, 0 if the
+ * frame carries something else */
+static uint16_t udp_len(const uint8_t *frame, size_t len)
+{
+    const uint8_t *ipv6 = &frame[IPV6_OFFSET];
+    uint16_t res;
+
+    if ((len < UDP_HDRS_LEN) ||
+        (frame[offsetof(ethernet_hdr_t, type)] != (ETHERTYPE_IPV6 >> 8)) ||
+        (frame[offsetof(ethernet_hdr_t, type) + 1] != (ETHERTYPE_IPV6 & 0xff)) ||
+        (ipv6[offsetof(ipv6_hdr_t, nh)] != PROTNUM_UDP)) {
+        return 0;
+    }
+    res = (uint16_t)((ipv6[offsetof(ipv6_hdr_t, len)] << 8) |
+                     ipv6[offsetof(ipv6_hdr_t, len) + 1]);
+    if ((res < sizeof(udp_hdr_t)) || (res > (len - UDP_OFFSET))) {
+        return 0;
+    }
+    return res;
+}
+
+static uint16_t udp_pseudo_csum(uint16_t sum, const uint8_t *frame,
+                                uint16_t len)
+{
+    const uint8_t tail[] = { (len >> 8), (len & 0xff), 0, PROTNUM_UDP };
+
+    sum = inet_csum(sum, &frame[IPV6_OFFSET + offsetof(ipv6_hdr_t, src)],
+                    2 * sizeof(ipv6_addr_t));
+    return inet_csum(sum, tail, sizeof(tail));
+}
+
+/* computes the unnormalized Internet checksum of the buffer memory from
+ * start to end (inclusive) with the DMA, the SPI bus must be acquired */
+static uint16_t dma_csum(enc28j60_t *dev, uint16_t start, uint16_t end)
+{
+    uint16_t csum;
+
+    w_addr(dev, ADDR_DMA_START, start);
+    w_addr(dev, ADDR_DMA_END, end);
+    bfs(dev, REG_ECON1, -1, (ECON1_CSUMEN | ECON1_DMAST));
+    while (rcr(dev, REG_ECON1, -1) & ECON1_DMAST) {}
+    bfc(dev, REG_EIR, -1, EIR_DMAIF);
+    /* the device stores the normalized checksum, high byte first */
+    csum = (uint16_t)(rcr(dev, REG_B0_EDMACSH, 0) << 8);
+    csum |= rcr(dev, REG_B0_EDMACSL, 0);
+    return ~csum;
+}
+
+static void tx_csum(enc28j60_t *dev, const uint8_t *hdrs, uint16_t len)
+{
+    /* the frame follows the per packet control byte */
+    uint16_t start = BUF_TX_START + 1 + UDP_OFFSET;
+    uint16_t csum = ~udp_pseudo_csum(dma_csum(dev, start, start + len - 1),
+                                     hdrs, len);
+    uint8_t tmp[2];
+
+    /* a checksum of zero is sent as all ones */
+    if (csum == 0) {
+        csum = 0xffff;
+    }
+    tmp[0] = (uint8_t)(csum >> 8);
+    tmp[1] = (uint8_t)(csum & 0xff);
+    w_addr(dev, ADDR_WRITE_PTR, BUF_TX_START + 1 + UDP_CSUM_OFFSET);
+    wbm(dev, tmp, sizeof(tmp));
+}
+
 static int nd_send(netdev_t *netdev, const struct iovec *data, unsigned count)
 {
     enc28j60_t *dev = (enc28j60_t *)netdev;
     uint8_t ctrl = 0;
-    int c = 0;
+    uint8_t hdrs[UDP_HDRS_LEN];
+    uint16_t len;
+    size_t c = 0;
 
     mutex_lock(&dev->devlock);
 
@@ -252,60 +366,121 @@ static int nd_send(netdev_t *netdev, const struct iovec *data, unsigned count)
     netdev->stats.tx_bytes += count;
 #endif
 
+    bus_acquire(dev);
     /* set write pointer */
-    cmd_w_addr(dev, ADDR_WRITE_PTR, BUF_TX_START);
+    w_addr(dev, ADDR_WRITE_PTR, BUF_TX_START);
     /* write control byte and the actual data into the buffer */
-    cmd_wbm(dev, &ctrl, 1);
-    for (int i = 0; i < count; i++) {
+    wbm(dev, &ctrl, 1);
+    for (unsigned i = 0; i < count; i++) {
+        if (dev->csum_offload && (c < sizeof(hdrs))) {
+            size_t n = sizeof(hdrs) - c;
+
+            memcpy(&hdrs[c], data[i].iov_base,
+                   (data[i].iov_len < n) ? data[i].iov_len : n);
+        }
         c += data[i].iov_len;
-        cmd_wbm(dev, (uint8_t *)data[i].iov_base, data[i].iov_len);
+        wbm(dev, (uint8_t *)data[i].iov_base, data[i].iov_len);
     }
     /* set TX end pointer */
-    cmd_w_addr(dev, ADDR_TX_END, cmd_r_addr(dev, ADDR_WRITE_PTR) - 1);
+    w_addr(dev, ADDR_TX_END, BUF_TX_START + c);
+    /* fill in UDP checksums the network stack left to the device */
+    if (dev->csum_offload && ((len = udp_len(hdrs, c)) > 0) &&
+        (hdrs[UDP_CSUM_OFFSET] == 0) && (hdrs[UDP_CSUM_OFFSET + 1] == 0)) {
+        tx_csum(dev, hdrs, len);
+    }
     /* trigger the send process */
-    cmd_bfs(dev, REG_ECON1, -1, ECON1_TXRTS);
+    bfs(dev, REG_ECON1, -1, ECON1_TXRTS);
+    bus_release(dev);
 
     mutex_unlock(&dev->devlock);
-    return c;
+    return (int)c;
+}
+
+/* The functions below handle the oldest frame in the RX buffer, the SPI bus
+ * must be acquired. The header of a frame is read only once, after that the
+ * read pointer stays behind it until the frame is read or dropped. */
+static void rx_release(enc28j60_t *dev)
+{
+    w_addr(dev, ADDR_RX_READ, dev->rx_next);
+    bfs(dev, REG_ECON2, -1, ECON2_PKTDEC);
+    dev->rx_ptr = dev->rx_next;
+    dev->rx_size = 0;
+    dev->rx_pending--;
+}
+
+static uint16_t rx_peek(enc28j60_t *dev)
+{
+    uint8_t rsv[RSV_LEN];
+
+    /* frames received with errors are released on the way */
+    while ((dev->rx_size == 0) && (dev->rx_pending > 0)) {
+        w_addr(dev, ADDR_READ_PTR, dev->rx_ptr);
+        rbm(dev, rsv, sizeof(rsv));
+        dev->rx_next = (uint16_t)((rsv[1] << 8) | rsv[0]);
+        dev->rx_size = (uint16_t)((rsv[3] << 8) | rsv[2]);
+        if (!(rsv[4] & RSV_RXOK) || (dev->rx_size <= ETHERNET_FCS_LEN)) {
+            DEBUG("[enc28j60] recv: dropping erroneous frame\n");
+            rx_release(dev);
+        }
+        else {
+            dev->rx_size -= ETHERNET_FCS_LEN;   /* discard CRC */
+        }
+    }
+    return dev->rx_size;
+}
+
+static bool rx_csum_ok(enc28j60_t *dev, const uint8_t *frame, size_t size)
+{
+    uint16_t len = udp_len(frame, size);
+    uint16_t start;
+
+    /* datagrams without checksum are left to the network stack */
+    if ((len == 0) ||
+        ((frame[UDP_CSUM_OFFSET] | frame[UDP_CSUM_OFFSET + 1]) == 0)) {
+        return true;
+    }
+    start = rx_addr(dev->rx_ptr + RSV_LEN + UDP_OFFSET);
+    return (udp_pseudo_csum(dma_csum(dev, start, rx_addr(start + len - 1)),
+                            frame, len) == 0xffff);
 }
 
 static int nd_recv(netdev_t *netdev, void *buf, size_t max_len, void *info)
 {
     enc28j60_t *dev = (enc28j60_t *)netdev;
-    uint8_t head[6];
-    size_t size;
-    uint16_t next;
+    int size;
 
     (void)info;
     mutex_lock(&dev->devlock);
+    bus_acquire(dev);
 
-    /* set read pointer to RX read address */
-    cmd_w_addr(dev, ADDR_READ_PTR, cmd_r_addr(dev, ADDR_RX_READ));
-    /* read packet header */
-    cmd_rbm(dev, head, 6);
-    /* TODO: care for endianess */
-    next = (uint16_t)((head[1] << 8) | head[0]);
-    size = (size_t)((head[3] << 8) | head[2]) - 4;  /* discard CRC */
-
-    if (buf != NULL) {
+    size = (int)rx_peek(dev);
+    if ((size > 0) && (buf != NULL)) {
 #ifdef MODULE_NETSTATS_L2
         netdev->stats.rx_count++;
         netdev->stats.rx_bytes += size;
 #endif
         /* read packet content into the supplied buffer */
-        if (size <= max_len) {
-            cmd_rbm(dev, (uint8_t *)buf, size);
+        if ((size_t)size <= max_len) {
+            rbm(dev, (uint8_t *)buf, size);
+            if (dev->csum_offload && !rx_csum_ok(dev, buf, size)) {
+                DEBUG("[enc28j60] recv: invalid UDP checksum\n");
+                size = -EBADMSG;
+            }
         } else {
             DEBUG("[enc28j60] recv: unable to get packet - buffer too small\n");
             size = 0;
         }
         /* release memory */
-        cmd_w_addr(dev, ADDR_RX_READ, next);
-        cmd_bfs(dev, REG_ECON2, -1, ECON2_PKTDEC);
+        rx_release(dev);
+    }
+    else if ((size > 0) && (max_len > 0)) {
+        /* drop the packet */
+        rx_release(dev);
     }
 
+    bus_release(dev);
     mutex_unlock(&dev->devlock);
-    return (int)size;
+    return size;
 }
 
 static int nd_init(netdev_t *netdev)
@@ -348,6 +523,9 @@ static int nd_init(netdev_t *netdev)
     cmd_w_addr(dev, ADDR_RX_START, BUF_RX_START);
     cmd_w_addr(dev, ADDR_RX_END, BUF_RX_END);
     cmd_w_addr(dev, ADDR_RX_READ, BUF_RX_START);
+    dev->rx_ptr = BUF_RX_START;
+    dev->rx_size = 0;
+    dev->rx_pending = 0;
     /* configure the TX buffer */
     cmd_w_addr(dev, ADDR_TX_START, BUF_TX_START);
     cmd_w_addr(dev, ADDR_TX_END, BUF_TX_END);
@@ -422,10 +600,15 @@ static void nd_isr(netdev_t *netdev)
             }
         }
         if (eir & EIR_PKTIF) {
-            do {
+            /* read the packet count once for all frames received so far,
+             * each recv() call takes them from the pending ones */
+            uint8_t cnt = cmd_rcr(dev, REG_B1_EPKTCNT, 1);
+
+            dev->rx_pending = cnt;
+            while ((cnt-- > 0) && (dev->rx_pending > 0)) {
                 DEBUG("[enc28j60] isr: packet received\n");
                 netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
-            } while (cmd_rcr(dev, REG_B1_EPKTCNT, 1) > 0);
+            }
         }
         if (eir & EIR_RXERIF) {
             DEBUG("[enc28j60] isr: incoming packet dropped - RX buffer full\n");
@@ -453,6 +636,11 @@ static int nd_get(netdev_t *netdev, netopt_t opt, void *value, size_t max_len)
             assert(max_len >= ETHERNET_ADDR_LEN);
             mac_get(dev, (uint8_t *)value);
             return ETHERNET_ADDR_LEN;
+        case NETOPT_CHECKSUM_OFFLOAD:
+            assert(max_len >= sizeof(netopt_enable_t));
+            *((netopt_enable_t *)value) = (dev->csum_offload) ? NETOPT_ENABLE
+                                                              : NETOPT_DISABLE;
+            return sizeof(netopt_enable_t);
         default:
             return netdev_eth_get(netdev, opt, value, max_len);
     }
@@ -467,6 +655,10 @@ static int nd_set(netdev_t *netdev, netopt_t opt, void *value, size_t value_len)
             assert(value_len == ETHERNET_ADDR_LEN);
             mac_set(dev, (uint8_t *)value);
             return ETHERNET_ADDR_LEN;
+        case NETOPT_CHECKSUM_OFFLOAD:
+            assert(value_len == sizeof(netopt_enable_t));
+            dev->csum_offload = (*((netopt_enable_t *)value) == NETOPT_ENABLE);
+            return sizeof(netopt_enable_t);
         default:
             return netdev_eth_set(netdev, opt, value, value_len);
     }
@@ -490,4 +682,7 @@ void enc28j60_setup(enc28j60_t *dev, const enc28j60_params_t *params)
     dev->reset_pin = params->reset_pin;
     mutex_init(&dev->devlock);
     dev->bank = 99;                         /* mark as invalid */
+    dev->rx_pending = 0;
+    dev->rx_size = 0;
+    dev->csum_offload = false;
 }
@@ -48,6 +48,8 @@ extern "C" {
 #define ADDR_RX_END         0x0a    /**< RX buffer end */
 #define ADDR_RX_READ        0x0c    /**< start of oldest packet in RX buffer */
 #define ADDR_RX_WRITE       0x0e    /**< start of free space in RX buffer */
+#define ADDR_DMA_START      0x10    /**< DMA start */
+#define ADDR_DMA_END        0x12    /**< DMA end */
 /** @} */
 
 /**
@@ -428,6 +430,14 @@ extern "C" {
 #define TX_POVERRIDE        0x01
 /** @} */
 
+/**
+ * @brief   Receive status vector
+ * @{
+ */
+#define RSV_LEN             6       /**< length incl. next packet pointer */
+#define RSV_RXOK            0x80    /**< frame received ok (byte 4) */
+/** @} */
+
 #ifdef __cplusplus
 }
 #endif
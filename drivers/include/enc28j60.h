@@ -10,6 +10,10 @@
  * @defgroup    drivers_enc28j60 ENC28J60
  * @ingroup     drivers_netdev
  * @brief       Driver for the ENC28J60 Ethernet Adapter
+ *
+ * The driver can compute and check the checksums of UDP datagrams over IPv6
+ * with the DMA of the device, see @ref NETOPT_CHECKSUM_OFFLOAD. The option is
+ * disabled by default.
  * @{
  *
  * @file
@@ -21,6 +25,7 @@
 #ifndef ENC28J60_H
 #define ENC28J60_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "mutex.h"
@@ -53,6 +58,12 @@ typedef struct {
     gpio_t reset_pin;       /**< pin connected to the RESET line */
     mutex_t devlock;        /**< lock the device on access */
     int8_t bank;            /**< remember the active register bank */
+    uint8_t rx_pending;     /**< frames signaled but not received yet */
+    uint16_t rx_ptr;        /**< start of the oldest frame in the RX buffer */
+    uint16_t rx_next;       /**< start of the frame after it */
+    uint16_t rx_size;       /**< size of the oldest frame, 0 if its header was
+                             *   not read yet */
+    bool csum_offload;      /**< compute UDP checksums with the DMA */
 } enc28j60_t;
 
 /**
@@ -64,6 +64,9 @@
 #include "net/netdev.h"
 #include "periph/gpio.h"
 #include "periph/spi.h"
+#ifdef MODULE_SX127X_DUTY
+#include "net/lora.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -116,8 +119,31 @@ extern "C" {
 #define SX127X_IRQ_DIO3                  (1<<3)  /**< DIO3 IRQ */
 #define SX127X_IRQ_DIO4                  (1<<4)  /**< DIO4 IRQ */
 #define SX127X_IRQ_DIO5                  (1<<5)  /**< DIO5 IRQ */
+#define SX127X_IRQ_DUTY                  (1<<6)  /**< Duty cycle timer */
+#define SX127X_IRQ_TX_TIMEOUT            (1<<7)  /**< TX timeout timer */
 /** @} */
 
+#if defined(MODULE_SX127X_DUTY) || defined(DOXYGEN)
+/**
+ * @name    SX127X duty cycle scheduler configuration
+ *
+ * With the `sx127x_duty` module, frames sent while the sub-band of the current
+ * channel is closed by its duty cycle, or while another frame is on air, are
+ * queued and transmitted as soon as the sub-band opens again. A queued frame
+ * goes out on the channel that was set when it was sent, which the device
+ * then keeps.
+ * @{
+ */
+#ifndef SX127X_DUTY_QUEUE_LEN
+#define SX127X_DUTY_QUEUE_LEN            (2U)   /**< Number of queued frames */
+#endif
+#ifndef SX127X_DUTY_BANDS
+#define SX127X_DUTY_BANDS                (lora_duty_bands_eu868)    /**< Band table */
+#define SX127X_DUTY_BANDS_NUMOF          (LORA_DUTY_BANDS_EU868_NUMOF)  /**< Number of sub-bands */
+#endif
+/** @} */
+#endif
+
 /**
  * @brief   SX127X initialization result.
  */
@@ -238,6 +264,15 @@ typedef struct {
     xtimer_t rx_timeout_timer;         /**< RX operation timeout timer */
     uint32_t last_channel;             /**< Last channel in frequency hopping sequence */
     bool is_last_cad_success;          /**< Sign of success of last CAD operation (activity detected) */
+#if defined(MODULE_SX127X_DUTY) || defined(DOXYGEN)
+    lora_duty_t duty;                  /**< Duty cycle accounting */
+    xtimer_t duty_timer;               /**< Timer for the next queued frame */
+    uint8_t duty_queue[SX127X_DUTY_QUEUE_LEN][UINT8_MAX];   /**< Queued frames */
+    uint8_t duty_queue_size[SX127X_DUTY_QUEUE_LEN];         /**< Queued frame lengths */
+    uint32_t duty_queue_channel[SX127X_DUTY_QUEUE_LEN];     /**< Queued frame channels */
+    uint8_t duty_queue_head;           /**< Index of the oldest queued frame */
+    uint8_t duty_queue_len;            /**< Number of queued frames */
+#endif
 } sx127x_internal_t;
 
 /**
@@ -18,6 +18,13 @@
  * stack provided by RIOT (e.g. GNRC). This enables W5100 devices to communicate
  * via IPv6, enables unlimited connections, and more...
  *
+ * Alternatively, the `w5100_sock_udp` and `w5100_sock_tcp` modules implement
+ * @ref net_sock_udp and @ref net_sock_tcp on top of the four hardware sockets
+ * of the device (IPv4 only). Only the payload then crosses the SPI bus, which
+ * needs four bytes on the bus for every byte of data as the device does not
+ * support address auto increment, and no software network stack is needed.
+ * The device is set up with w5100_sock_init() instead of netdev in this case.
+ *
  * @note        This driver expects to be triggered by the external interrupt
  *              line of the W5100 device. On some Arduino shields this is not
  *              enabled by default, you have to close the corresponding solder
@@ -77,6 +84,38 @@ typedef struct {
  */
 void w5100_setup(w5100_t *dev, const w5100_params_t *params);
 
+/**
+ * @brief   Number of hardware sockets of W5100 devices
+ */
+#define W5100_SOCK_NUMOF    (4U)
+
+/**
+ * @brief   IPv4 configuration used by the hardware sockets
+ */
+typedef struct {
+    uint8_t addr[4];        /**< IPv4 address of the device */
+    uint8_t mask[4];        /**< subnet mask */
+    uint8_t gw[4];          /**< default gateway */
+} w5100_ipconf_t;
+
+/**
+ * @brief   Use the hardware sockets of the given device for sock
+ *
+ * Resets the device and splits its memory evenly among the
+ * @ref W5100_SOCK_NUMOF hardware sockets. Every UDP sock, connected TCP sock
+ * and listening TCP queue occupies one of them. The device must be set up with
+ * w5100_setup() before and must not be used through netdev afterwards.
+ *
+ * Needs the `w5100_sock_udp` or `w5100_sock_tcp` module.
+ *
+ * @param[in] dev       device descriptor, set up with w5100_setup()
+ * @param[in] conf      IPv4 configuration of the device
+ *
+ * @return  0 on success
+ * @return  W5100_ERR_BUS if the device does not answer
+ */
+int w5100_sock_init(w5100_t *dev, const w5100_ipconf_t *conf);
+
 #ifdef __cplusplus
 }
 #endif
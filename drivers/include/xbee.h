@@ -26,6 +26,7 @@
 #include <stdint.h>
 
 #include "mutex.h"
+#include "tsrb.h"
 #include "xtimer.h"
 #include "periph/uart.h"
 #include "periph/gpio.h"
@@ -61,6 +62,17 @@ extern "C" {
  */
 #define XBEE_MAX_TXHDR_LENGTH       (14U)
 
+/**
+ * @brief   Size of the UART receive ring buffer in byte
+ *
+ * The ring buffer holds the data received on the UART until it is parsed in
+ * thread context. The default holds four frames of maximum size. Must be a
+ * power of two.
+ */
+#ifndef XBEE_RX_BUF_SIZE
+#define XBEE_RX_BUF_SIZE            (512U)
+#endif
+
 /**
  * @brief   Default protocol for data that is coming in
  */
@@ -96,9 +108,10 @@ extern "C" {
 /**
  * @brief   States of the internal FSM for handling incoming UART frames
  *
- * Incoming data frames on the UART interfaces are handled using a finite state
- * machine (FSM) in the UARTs RX interrupt handler. The FSM is needed to extract
- * frame specific data as the frame size, frame type, and checksums.
+ * The UARTs RX interrupt handler only puts incoming data into a ring buffer.
+ * The data is split into frames by a finite state machine (FSM) in thread
+ * context, which also extracts frame specific data as the frame size, frame
+ * type, and checksums.
  */
 typedef enum {
     XBEE_INT_STATE_IDLE,    /**< waiting for the beginning of a new frame */
@@ -111,8 +124,21 @@ typedef enum {
                              *   responses */
     XBEE_INT_STATE_RX,      /**< handling incoming data when receiving radio
                              *   packets */
+    XBEE_INT_STATE_SKIP,    /**< skipping the rest of a frame that is not
+                             *   handled or does not fit into the buffers */
 } xbee_rx_state_t;
 
+/**
+ * @brief   Statistics of the UART receive path
+ */
+typedef struct {
+    uint32_t frames;        /**< received radio packets with valid checksum */
+    uint32_t dropped;       /**< radio packets dropped because they are too
+                             *   large or were not read */
+    uint32_t cksum;         /**< frames with invalid checksum */
+    uint32_t overrun;       /**< bytes lost because the ring buffer was full */
+} xbee_rx_stats_t;
+
 /**
  * @brief   Configuration parameters for XBee devices
  */
@@ -142,10 +168,21 @@ typedef struct {
     uint8_t addr_flags;                 /**< address flags as defined above */
     uint8_t addr_short[2];              /**< onw 802.15.4 short address */
     eui64_t addr_long;                  /**< own 802.15.4 long address */
+    /* UART RX ring buffer, filled by the RX interrupt */
+    tsrb_t rx_rb;                       /**< ring buffer for received data */
+    char rx_rb_buf[XBEE_RX_BUF_SIZE];   /**< memory of the ring buffer */
+    volatile uint16_t rx_need;          /**< bytes needed by the FSM to make
+                                         *   progress, the RX interrupt
+                                         *   signals the thread when they are
+                                         *   available */
+    volatile uint8_t rx_pending;        /**< thread was signalled and did not
+                                         *   parse the data, yet */
+    xbee_rx_stats_t rx_stats;           /**< receive statistics */
     /* general variables for the UART RX state machine */
     xbee_rx_state_t int_state;          /**< current state if the UART RX FSM */
     uint16_t int_size;                  /**< temporary space for parsing the
-                                         *   frame size */
+                                         *   frame size, bytes left to skip
+                                         *   in XBEE_INT_STATE_SKIP */
     /* values for the UART TX state machine */
     mutex_t tx_lock;                    /**< mutex to allow only one
                                          *   transmission at a time */
@@ -191,6 +228,17 @@ extern const netdev_driver_t xbee_driver;
  */
 void xbee_setup(xbee_t *dev, const xbee_params_t *params);
 
+/**
+ * @brief   UART RX callback of the driver
+ *
+ * Registered with the UART by the driver's init function. It is exposed to
+ * feed recorded UART data into a device for testing.
+ *
+ * @param[in] arg           the XBee device
+ * @param[in] c             the received byte
+ */
+void xbee_rx_cb(void *arg, uint8_t c);
+
 /**
  * @brief   Put together the internal proprietary XBee header
  *
@@ -23,6 +23,7 @@
 #define SX127X_INTERNAL_H
 
 #include <inttypes.h>
+#include "net/lora.h"
 #include "sx127x.h"
 
 #ifdef __cplusplus
@@ -127,6 +128,14 @@ void sx127x_rx_chain_calibration(sx127x_t *dev);
  */
 int16_t sx127x_read_rssi(const sx127x_t *dev);
 
+/**
+ * @brief   Gets the current LoRa modulation parameters
+ *
+ * @param[in] dev                      The sx127x device descriptor
+ * @param[out] mod                     The modulation parameters
+ */
+void sx127x_get_lora_modulation(const sx127x_t *dev, lora_modulation_t *mod);
+
 #ifdef __cplusplus
 }
 #endif
@@ -44,6 +44,9 @@ static void _init_timers(sx127x_t *dev);
 static int _init_peripherals(sx127x_t *dev);
 static void _on_tx_timeout(void *arg);
 static void _on_rx_timeout(void *arg);
+#ifdef MODULE_SX127X_DUTY
+static void _on_duty_timeout(void *arg);
+#endif
 
 /* SX127X DIO interrupt handlers initialization */
 static void sx127x_on_dio0_isr(void *arg);
@@ -377,6 +380,10 @@ static void _on_tx_timeout(void *arg)
     netdev_t *dev = (netdev_t *) arg;
 
     dev->event_callback(dev, NETDEV_EVENT_TX_TIMEOUT);
+#ifdef MODULE_SX127X_DUTY
+    /* the thread context frees the radio for the queued frames */
+    sx127x_on_dio_isr((sx127x_t *) arg, SX127X_IRQ_TX_TIMEOUT);
+#endif
 }
 
 static void _on_rx_timeout(void *arg)
@@ -386,6 +393,13 @@ static void _on_rx_timeout(void *arg)
     dev->event_callback(dev, NETDEV_EVENT_RX_TIMEOUT);
 }
 
+#ifdef MODULE_SX127X_DUTY
+static void _on_duty_timeout(void *arg)
+{
+    sx127x_on_dio_isr((sx127x_t *) arg, SX127X_IRQ_DUTY);
+}
+#endif
+
 static void _init_timers(sx127x_t *dev)
 {
     dev->_internal.tx_timeout_timer.arg = dev;
@@ -393,6 +407,11 @@ static void _init_timers(sx127x_t *dev)
 
     dev->_internal.rx_timeout_timer.arg = dev;
     dev->_internal.rx_timeout_timer.callback = _on_rx_timeout;
+
+#ifdef MODULE_SX127X_DUTY
+    dev->_internal.duty_timer.arg = dev;
+    dev->_internal.duty_timer.callback = _on_duty_timeout;
+#endif
 }
 
 static int _init_peripherals(sx127x_t *dev)
@@ -120,6 +120,25 @@ void sx127x_set_channel(sx127x_t *dev, uint32_t channel)
     sx127x_reg_write(dev, SX127X_REG_FRFLSB, (uint8_t)(channel & 0xFF));
 }
 
+void sx127x_get_lora_modulation(const sx127x_t *dev, lora_modulation_t *mod)
+{
+    /* Note: When using LoRa modem only bandwidths 125, 250 and 500 kHz are supported. */
+    mod->bandwidth = 125 << dev->settings.lora.bandwidth;
+    mod->preamble_len = dev->settings.lora.preamble_len;
+    mod->sf = dev->settings.lora.datarate;
+    mod->cr = dev->settings.lora.coderate;
+    mod->flags = 0;
+    if (dev->settings.lora.flags & SX127X_ENABLE_CRC_FLAG) {
+        mod->flags |= LORA_FLAG_CRC;
+    }
+    if (dev->settings.lora.flags & SX127X_ENABLE_FIXED_HEADER_LENGTH_FLAG) {
+        mod->flags |= LORA_FLAG_IMPLICIT_HEADER;
+    }
+    if (dev->settings.lora.flags & SX127X_LOW_DATARATE_OPTIMIZE_FLAG) {
+        mod->flags |= LORA_FLAG_LOW_DATARATE_OPT;
+    }
+}
+
 uint32_t sx127x_get_time_on_air(const sx127x_t *dev, uint8_t pkt_len)
 {
     uint32_t air_time = 0;
@@ -130,49 +149,11 @@ uint32_t sx127x_get_time_on_air(const sx127x_t *dev, uint8_t pkt_len)
             break;
         case SX127X_MODEM_LORA:
         {
-            double bw = 0.0;
-
-            /* Note: When using LoRa modem only bandwidths 125, 250 and 500 kHz are supported. */
-            switch (dev->settings.lora.bandwidth) {
-                case SX127X_BW_125_KHZ:
-                    bw = 125e3;
-                    break;
-                case SX127X_BW_250_KHZ:
-                    bw = 250e3;
-                    break;
-                case SX127X_BW_500_KHZ:
-                    bw = 500e3;
-                    break;
-                default:
-                    DEBUG("Invalid bandwith: %d\n", dev->settings.lora.bandwidth);
-                    break;
-            }
-
-            /* Symbol rate : time for one symbol [secs] */
-            double rs = bw / (1 << dev->settings.lora.datarate);
-            double ts = 1 / rs;
-
-            /* time of preamble */
-            double t_preamble = (dev->settings.lora.preamble_len + 4.25) * ts;
-
-            /* Symbol length of payload and time */
-            double tmp =
-                ceil(
-                    (8 * pkt_len - 4 * dev->settings.lora.datarate + 28
-                     + 16 * (dev->settings.lora.flags & SX127X_ENABLE_CRC_FLAG)
-                     - (!(dev->settings.lora.flags & SX127X_ENABLE_FIXED_HEADER_LENGTH_FLAG) ? 20 : 0))
-                    / (double) (4 * dev->settings.lora.datarate
-                                - (((dev->settings.lora.flags & SX127X_LOW_DATARATE_OPTIMIZE_FLAG)
-                                    > 0) ? 2 : 0)))
-                * (dev->settings.lora.coderate + 4);
-            double n_payload = 8 + ((tmp > 0) ? tmp : 0);
-            double t_payload = n_payload * ts;
-
-            /* Time on air */
-            double t_on_air = t_preamble + t_payload;
+            lora_modulation_t mod;
 
+            sx127x_get_lora_modulation(dev, &mod);
             /* return milli seconds */
-            air_time = floor(t_on_air * 1e3 + 0.999);
+            air_time = (lora_time_on_air(&mod, pkt_len) + 999) / 1000;
         }
         break;
     }
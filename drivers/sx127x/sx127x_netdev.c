@@ -35,6 +35,12 @@
 static uint8_t _get_tx_len(const struct iovec *vector, unsigned count);
 static int _set_state(sx127x_t *dev, netopt_state_t state);
 static int _get_state(sx127x_t *dev, void *val);
+static void _tx(sx127x_t *dev, const struct iovec *vector, unsigned count);
+#ifdef MODULE_SX127X_DUTY
+static int _duty_enqueue(sx127x_t *dev, const struct iovec *vector,
+                         unsigned count);
+static void _duty_continue(sx127x_t *dev);
+#endif
 
 /* Netdev driver api functions */
 static int _send(netdev_t *netdev, const struct iovec *vector, unsigned count);
@@ -57,12 +63,32 @@ static int _send(netdev_t *netdev, const struct iovec *vector, unsigned count)
 {
     sx127x_t *dev = (sx127x_t*) netdev;
 
+#ifdef MODULE_SX127X_DUTY
+    /* keep the order of frames already waiting for their sub-band */
+    if ((dev->_internal.duty_queue_len > 0) ||
+        (sx127x_get_state(dev) == SX127X_RF_TX_RUNNING) ||
+        (lora_duty_wait(&dev->_internal.duty, dev->settings.channel,
+                        xtimer_now_usec64()) > 0)) {
+        int res = _duty_enqueue(dev, vector, count);
+
+        _duty_continue(dev);
+        return res;
+    }
+#else
     if (sx127x_get_state(dev) == SX127X_RF_TX_RUNNING) {
         DEBUG("[WARNING] Cannot send packet: radio alredy in transmitting "
               "state.\n");
         return -ENOTSUP;
     }
+#endif
+
+    _tx(dev, vector, count);
 
+    return 0;
+}
+
+static void _tx(sx127x_t *dev, const struct iovec *vector, unsigned count)
+{
     uint8_t size;
     size = _get_tx_len(vector, count);
     switch (dev->settings.modem) {
@@ -88,6 +114,17 @@ static int _send(netdev_t *netdev, const struct iovec *vector, unsigned count)
             for (size_t i = 0;i < count ; i++) {
                 sx127x_write_fifo(dev, vector[i].iov_base, vector[i].iov_len);
             }
+
+#ifdef MODULE_SX127X_DUTY
+            {
+                lora_modulation_t mod;
+
+                sx127x_get_lora_modulation(dev, &mod);
+                lora_duty_account(&dev->_internal.duty, dev->settings.channel,
+                                  xtimer_now_usec64(),
+                                  lora_time_on_air(&mod, size));
+            }
+#endif
             break;
         default:
             puts("sx127x_netdev, Unsupported modem");
@@ -117,10 +154,76 @@ static int _send(netdev_t *netdev, const struct iovec *vector, unsigned count)
     /* Put chip into transfer mode */
     sx127x_set_state(dev, SX127X_RF_TX_RUNNING);
     sx127x_set_op_mode(dev, SX127X_RF_OPMODE_TRANSMITTER);
+}
+
+#ifdef MODULE_SX127X_DUTY
+static int _duty_enqueue(sx127x_t *dev, const struct iovec *vector,
+                         unsigned count)
+{
+    sx127x_internal_t *internal = &dev->_internal;
+    unsigned idx = (internal->duty_queue_head + internal->duty_queue_len) %
+                   SX127X_DUTY_QUEUE_LEN;
+    uint8_t *frame = internal->duty_queue[idx];
+    size_t size = 0;
+
+    if (internal->duty_queue_len >= SX127X_DUTY_QUEUE_LEN) {
+        DEBUG("[WARNING] Cannot send packet: duty cycle queue full\n");
+        return -EBUSY;
+    }
+
+    for (unsigned i = 0; i < count; i++) {
+        if ((size + vector[i].iov_len) > UINT8_MAX) {
+            return -EOVERFLOW;
+        }
+        memcpy(&frame[size], vector[i].iov_base, vector[i].iov_len);
+        size += vector[i].iov_len;
+    }
+    internal->duty_queue_size[idx] = size;
+    internal->duty_queue_channel[idx] = dev->settings.channel;
+    internal->duty_queue_len++;
 
     return 0;
 }
 
+static void _duty_continue(sx127x_t *dev)
+{
+    sx127x_internal_t *internal = &dev->_internal;
+    uint32_t channel;
+    uint64_t wait;
+
+    if ((internal->duty_queue_len == 0) ||
+        (sx127x_get_state(dev) == SX127X_RF_TX_RUNNING)) {
+        /* the end of the transmission calls this again */
+        return;
+    }
+
+    /* the frame is charged to the sub-band it was queued for */
+    channel = internal->duty_queue_channel[internal->duty_queue_head];
+    wait = lora_duty_wait(&internal->duty, channel, xtimer_now_usec64());
+    if (wait > 0) {
+        /* off times of more than 71 minutes take several timer runs */
+        DEBUG("sx127x: sub-band closed for %lu ms\n",
+              (unsigned long)(wait / 1000));
+        xtimer_set(&internal->duty_timer,
+                   (wait > UINT32_MAX) ? UINT32_MAX : (uint32_t)wait);
+        return;
+    }
+
+    struct iovec vector = {
+        .iov_base = internal->duty_queue[internal->duty_queue_head],
+        .iov_len = internal->duty_queue_size[internal->duty_queue_head],
+    };
+
+    internal->duty_queue_head = (internal->duty_queue_head + 1) %
+                                SX127X_DUTY_QUEUE_LEN;
+    internal->duty_queue_len--;
+    if (channel != dev->settings.channel) {
+        sx127x_set_channel(dev, channel);
+    }
+    _tx(dev, &vector, 1);
+}
+#endif
+
 static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
 {
     sx127x_t *dev = (sx127x_t*) netdev;
@@ -150,6 +253,8 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
                 return -EBADMSG;
             }
 
+            size = sx127x_reg_read(dev, SX127X_REG_LR_RXNBBYTES);
+
             netdev_sx127x_lora_packet_info_t *packet_info = info;
             if (packet_info) {
                 /* there is no LQI for LoRa */
@@ -190,10 +295,9 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
                     }
 #endif
                 }
-                packet_info->time_on_air = sx127x_get_time_on_air(dev, len);
+                packet_info->time_on_air = sx127x_get_time_on_air(dev, size);
             }
 
-            size = sx127x_reg_read(dev, SX127X_REG_LR_RXNBBYTES);
             if (buf == NULL) {
                 return size;
             }
@@ -237,6 +341,13 @@ static int _init(netdev_t *netdev)
     sx127x_init(sx127x);
 
     sx127x_init_radio_settings(sx127x);
+#ifdef MODULE_SX127X_DUTY
+    xtimer_remove(&sx127x->_internal.duty_timer);
+    lora_duty_init(&sx127x->_internal.duty, SX127X_DUTY_BANDS,
+                   SX127X_DUTY_BANDS_NUMOF);
+    sx127x->_internal.duty_queue_head = 0;
+    sx127x->_internal.duty_queue_len = 0;
+#endif
     /* Put chip into sleep */
     sx127x_set_sleep(sx127x);
 
@@ -252,6 +363,13 @@ static void _isr(netdev_t *netdev)
     uint8_t irq = dev->irq;
     dev->irq = 0;
 
+#ifdef MODULE_SX127X_DUTY
+    uint8_t tx_timeout = irq & SX127X_IRQ_TX_TIMEOUT;
+
+    /* both timers are handled below */
+    irq &= ~(SX127X_IRQ_DUTY | SX127X_IRQ_TX_TIMEOUT);
+#endif
+
     switch (irq) {
         case SX127X_IRQ_DIO0:
             sx127x_on_dio0(dev);
@@ -272,6 +390,15 @@ static void _isr(netdev_t *netdev)
         default:
             break;
     }
+
+#ifdef MODULE_SX127X_DUTY
+    if (tx_timeout && (sx127x_get_state(dev) == SX127X_RF_TX_RUNNING)) {
+        /* the frame is lost, but the radio is free again */
+        sx127x_set_standby(dev);
+    }
+    /* a finished transmission or an opened sub-band let the next frame go */
+    _duty_continue(dev);
+#endif
 }
 
 static int _get(netdev_t *netdev, netopt_t opt, void *val, size_t max_len)
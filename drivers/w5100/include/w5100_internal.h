@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_w5100
+ * @{
+ *
+ * @file
+ * @brief       Internal register access functions for W5100 devices
+ *
+ * These functions are shared by the MACRAW netdev driver and the hardware
+ * socket backend. All of them expect the SPI bus to be acquired by the caller.
+ */
+
+#ifndef W5100_INTERNAL_H
+#define W5100_INTERNAL_H
+
+#include <stdint.h>
+
+#include "w5100.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   SPI mode used for W5100 devices
+ */
+#define W5100_SPI_MODE      SPI_MODE_0
+
+/**
+ * @brief   Acquire the SPI bus of the given device
+ */
+static inline void w5100_acquire(w5100_t *dev)
+{
+    spi_acquire(dev->p.spi, dev->p.cs, W5100_SPI_MODE, dev->p.clk);
+}
+
+/**
+ * @brief   Release the SPI bus of the given device
+ */
+static inline void w5100_release(w5100_t *dev)
+{
+    spi_release(dev->p.spi);
+}
+
+/**
+ * @brief   Read a single register
+ *
+ * @param[in] dev       device to read from
+ * @param[in] reg       address of the register
+ *
+ * @return  the value of the register
+ */
+uint8_t w5100_rreg(w5100_t *dev, uint16_t reg);
+
+/**
+ * @brief   Write a single register
+ *
+ * @param[in] dev       device to write to
+ * @param[in] reg       address of the register
+ * @param[in] data      value to write
+ */
+void w5100_wreg(w5100_t *dev, uint16_t reg, uint8_t data);
+
+/**
+ * @brief   Read a 16-bit register, most significant byte first
+ *
+ * @param[in] dev       device to read from
+ * @param[in] addr_high address of the most significant byte
+ * @param[in] addr_low  address of the least significant byte
+ *
+ * @return  the value of the register
+ */
+uint16_t w5100_raddr(w5100_t *dev, uint16_t addr_high, uint16_t addr_low);
+
+/**
+ * @brief   Write a 16-bit register, most significant byte first
+ *
+ * @param[in] dev       device to write to
+ * @param[in] addr_high address of the most significant byte
+ * @param[in] addr_low  address of the least significant byte
+ * @param[in] val       value to write
+ */
+void w5100_waddr(w5100_t *dev,
+                 uint16_t addr_high, uint16_t addr_low, uint16_t val);
+
+/**
+ * @brief   Read consecutive registers or buffer memory
+ *
+ * @param[in] dev       device to read from
+ * @param[in] addr      address of the first byte
+ * @param[out] data     buffer for the data
+ * @param[in] len       number of bytes to read
+ */
+void w5100_rchunk(w5100_t *dev, uint16_t addr, uint8_t *data, size_t len);
+
+/**
+ * @brief   Write consecutive registers or buffer memory
+ *
+ * @param[in] dev       device to write to
+ * @param[in] addr      address of the first byte
+ * @param[in] data      data to write
+ * @param[in] len       number of bytes to write
+ */
+void w5100_wchunk(w5100_t *dev, uint16_t addr, const uint8_t *data, size_t len);
+
+/**
+ * @brief   Check the SPI connection and reset the device
+ *
+ * A random but locally administered MAC address is written to the device
+ * after the reset.
+ *
+ * @param[in] dev       device to reset
+ *
+ * @return  0 on success
+ * @return  W5100_ERR_BUS if the device does not answer
+ */
+int w5100_reset(w5100_t *dev);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* W5100_INTERNAL_H */
+/** @} */
@@ -75,7 +75,8 @@ extern "C" {
 /**
  * @brief   Socket 0 registers
  *
- * As we are using the device in MACRAW mode, we only need socket 0.
+ * In MACRAW mode, we only need socket 0.
+ * @{
  */
 #define S0_MR               (0x0400)    /**< mode */
 #define S0_CR               (0x0401)    /**< control */
@@ -110,6 +111,32 @@ extern "C" {
 #define S0_RX_RD1           (0x0429)    /**< RX read pointer 1 */
 /** @} */
 
+/**
+ * @brief   Generic socket registers, offsets to SN_BASE()
+ *
+ * Used by the hardware socket backend, which uses all four sockets.
+ * @{
+ */
+#define SN_BASE(sn)         (0x0400 + ((sn) << 8))  /**< base of socket sn */
+#define SN_MR               (0x00)      /**< mode */
+#define SN_CR               (0x01)      /**< control */
+#define SN_IR               (0x02)      /**< interrupt flags */
+#define SN_SR               (0x03)      /**< state */
+#define SN_PORT0            (0x04)      /**< source port 0 */
+#define SN_PORT1            (0x05)      /**< source port 1 */
+#define SN_DIPR0            (0x0c)      /**< destination IP address 0 */
+#define SN_DPORT0           (0x10)      /**< destination port 0 */
+#define SN_DPORT1           (0x11)      /**< destination port 1 */
+#define SN_TX_FSR0          (0x20)      /**< TX free size 0 */
+#define SN_TX_FSR1          (0x21)      /**< TX free size 1 */
+#define SN_TX_WR0           (0x24)      /**< TX write pointer 0 */
+#define SN_TX_WR1           (0x25)      /**< TX write pointer 1 */
+#define SN_RX_RSR0          (0x26)      /**< RX receive size 0 */
+#define SN_RX_RSR1          (0x27)      /**< RX receive size 1 */
+#define SN_RX_RD0           (0x28)      /**< RX read pointer 0 */
+#define SN_RX_RD1           (0x29)      /**< RX read pointer 1 */
+/** @} */
+
 /**
  * @brief   Some selected bitfield definitions
  */
@@ -117,19 +144,37 @@ extern "C" {
 
 #define RMSR_8KB_TO_S0      (0x03)      /**< receive memory size: 8kib */
 #define TMSR_8KB_TO_S0      (0x03)      /**< transmit memory size: 8kib */
+#define MSR_2KB_EACH        (0x55)      /**< memory size: 2kib per socket */
 
 #define IMR_S0_INT          (0x01)      /**< global socket 0 interrupt mask */
 
+#define MR_TCP              (0x01)      /**< socket mode: TCP */
 #define MR_UDP              (0x02)      /**< socket mode: UDP */
 #define MR_MACRAW           (0x04)      /**< socket mode: raw Ethernet */
 
 #define CR_OPEN             (0x01)      /**< socket command: open */
+#define CR_LISTEN           (0x02)      /**< socket command: TCP listen */
+#define CR_CONNECT          (0x04)      /**< socket command: TCP connect */
+#define CR_DISCON           (0x08)      /**< socket command: TCP disconnect */
 #define CR_CLOSE            (0x10)      /**< socket command: close */
+#define CR_SEND             (0x20)      /**< socket command: send data */
 #define CR_SEND_MAC         (0x21)      /**< socket command: send raw */
 #define CR_RECV             (0x40)      /**< socket command: receive new data */
 
 #define IR_SEND_OK          (0x10)      /**< socket interrupt: send ok */
+#define IR_TIMEOUT          (0x08)      /**< socket interrupt: ARP or TCP
+                                         *   timeout */
 #define IR_RECV             (0x04)      /**< socket interrupt: data received */
+#define IR_DISCON           (0x02)      /**< socket interrupt: FIN received */
+#define IR_CON              (0x01)      /**< socket interrupt: connected */
+
+#define SR_CLOSED           (0x00)      /**< socket state: closed */
+#define SR_INIT             (0x13)      /**< socket state: TCP opened */
+#define SR_LISTEN           (0x14)      /**< socket state: TCP listening */
+#define SR_ESTABLISHED      (0x17)      /**< socket state: TCP connected */
+#define SR_CLOSE_WAIT       (0x1c)      /**< socket state: TCP closed by the
+                                         *   remote end */
+#define SR_UDP              (0x22)      /**< socket state: UDP opened */
 /** @} */
 
 #ifdef __cplusplus
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_w5100
+ * @{
+ *
+ * @file
+ * @brief       sock types of the W5100 hardware socket backend
+ */
+#ifndef SOCK_TYPES_H
+#define SOCK_TYPES_H
+
+#include <stdint.h>
+
+#include "net/af.h"
+#include "net/sock.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   UDP sock type
+ * @internal
+ */
+struct sock_udp {
+    struct _sock_tl_ep local;           /**< local end point */
+    struct _sock_tl_ep remote;          /**< remote end point, AF_UNSPEC if
+                                         *   not connected */
+    uint16_t flags;                     /**< option flags */
+    uint8_t sn;                         /**< hardware socket, 0xff if not
+                                         *   bound yet */
+};
+
+/**
+ * @brief   TCP sock type
+ * @internal
+ */
+struct sock_tcp {
+    struct _sock_tl_ep local;           /**< local end point */
+    struct _sock_tl_ep remote;          /**< remote end point */
+    struct sock_tcp_queue *queue;       /**< queue the sock was accepted on */
+    uint8_t sn;                         /**< hardware socket, 0xff if not
+                                         *   connected */
+};
+
+/**
+ * @brief   TCP queue type
+ * @internal
+ */
+struct sock_tcp_queue {
+    struct _sock_tl_ep local;           /**< local end point */
+    struct sock_tcp *array;             /**< socks for accepted connections */
+    unsigned short len;                 /**< length of sock_tcp_queue::array */
+    uint16_t flags;                     /**< option flags */
+    uint8_t sn;                         /**< listening hardware socket, 0xff
+                                         *   if all are in use */
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SOCK_TYPES_H */
+/** @} */
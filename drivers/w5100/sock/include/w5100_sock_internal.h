@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_w5100
+ * @{
+ *
+ * @file
+ * @brief       Hardware socket functions shared by the W5100 UDP and TCP sock
+ *              implementations
+ *
+ * Unless noted otherwise, the functions acquire the SPI bus themselves.
+ */
+#ifndef W5100_SOCK_INTERNAL_H
+#define W5100_SOCK_INTERNAL_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "net/sock.h"
+#include "w5100.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Value of the hardware socket number of unbound socks
+ */
+#define W5100_SOCK_UNDEF            (0xff)
+
+/**
+ * @brief   Time in microseconds sock_tcp_disconnect() waits for the remote
+ *          end to close the connection before the socket is closed anyway
+ */
+#ifndef W5100_SOCK_DISCON_TIMEOUT
+#define W5100_SOCK_DISCON_TIMEOUT   (100U * 1000U)
+#endif
+
+/**
+ * @brief   Maximum payload of a UDP datagram
+ */
+#define W5100_SOCK_UDP_MAX          (1472U)
+
+/**
+ * @brief   Size of the header the device puts in front of received UDP
+ *          datagrams: source address, source port and payload length
+ */
+#define W5100_SOCK_UDP_HDR_LEN      (8U)
+
+/**
+ * @brief   Checks an end point given to the sock API
+ *
+ * @param[in] ep    the end point
+ *
+ * @return  0 if the device can handle @p ep
+ * @return  -EAFNOSUPPORT if @p ep is not an IPv4 end point
+ * @return  -EINVAL if @p ep names a network interface
+ */
+int w5100_sock_check_ep(const struct _sock_tl_ep *ep);
+
+/**
+ * @brief   Opens a hardware socket
+ *
+ * @param[in] mode  MR_UDP or MR_TCP
+ * @param[in] port  local port, 0 for an ephemeral port
+ * @param[in] flags sock flags, see @ref net_sock_flags
+ *
+ * @return  the number of the hardware socket
+ * @return  -EADDRINUSE if @p port is used by another socket of the same mode
+ *          and @p flags does not contain SOCK_FLAGS_REUSE_EP
+ * @return  -ENOMEM if all hardware sockets are in use
+ */
+int w5100_sock_open(uint8_t mode, uint16_t port, uint16_t flags);
+
+/**
+ * @brief   Closes a hardware socket and makes it available again
+ *
+ * @param[in] sn    the hardware socket
+ */
+void w5100_sock_close(uint8_t sn);
+
+/**
+ * @brief   Gets the local end point of a hardware socket
+ *
+ * @param[in] sn    the hardware socket
+ * @param[out] ep   the local end point
+ */
+void w5100_sock_local(uint8_t sn, struct _sock_tl_ep *ep);
+
+/**
+ * @brief   Sets the destination of a hardware socket
+ *
+ * @param[in] sn    the hardware socket
+ * @param[in] ep    the destination, must be an IPv4 end point
+ */
+void w5100_sock_set_remote(uint8_t sn, const struct _sock_tl_ep *ep);
+
+/**
+ * @brief   Gets the destination of a hardware socket
+ *
+ * @param[in] sn    the hardware socket
+ * @param[out] ep   the destination
+ */
+void w5100_sock_get_remote(uint8_t sn, struct _sock_tl_ep *ep);
+
+/**
+ * @brief   Executes a socket command and waits until the device accepted it
+ *
+ * @param[in] sn    the hardware socket
+ * @param[in] cmd   the command, one of the CR_* values
+ */
+void w5100_sock_cmd(uint8_t sn, uint8_t cmd);
+
+/**
+ * @brief   Gets the state of a hardware socket
+ *
+ * @param[in] sn    the hardware socket
+ *
+ * @return  the value of the state register, one of the SR_* values
+ */
+uint8_t w5100_sock_state(uint8_t sn);
+
+/**
+ * @brief   Gets the number of received bytes of a hardware socket
+ *
+ * @param[in] sn    the hardware socket
+ *
+ * @return  the number of bytes in the receive buffer
+ */
+uint16_t w5100_sock_rx_size(uint8_t sn);
+
+/**
+ * @brief   Copies received data, starting @p offset bytes after the read
+ *          pointer of a hardware socket
+ *
+ * @param[in] sn        the hardware socket
+ * @param[in] offset    offset to the read pointer
+ * @param[out] data     buffer for the data
+ * @param[in] len       number of bytes to copy
+ */
+void w5100_sock_read(uint8_t sn, uint16_t offset, void *data, size_t len);
+
+/**
+ * @brief   Removes data from the receive buffer of a hardware socket
+ *
+ * @param[in] sn        the hardware socket
+ * @param[in] len       number of bytes to remove
+ */
+void w5100_sock_read_done(uint8_t sn, uint16_t len);
+
+/**
+ * @brief   Gets the free space in the transmit buffer of a hardware socket
+ *
+ * @param[in] sn    the hardware socket
+ *
+ * @return  the number of bytes that can be sent at once
+ */
+uint16_t w5100_sock_tx_free(uint8_t sn);
+
+/**
+ * @brief   Sends data with a hardware socket and waits until it was sent
+ *
+ * @pre     @p len is not larger than w5100_sock_tx_free()
+ *
+ * @param[in] sn        the hardware socket
+ * @param[in] data      the data
+ * @param[in] len       length of @p data
+ *
+ * @return  0 on success
+ * @return  -ETIMEDOUT if the device gave up (ARP or TCP retransmissions)
+ * @return  -ECONNRESET if the peer reset the TCP connection
+ */
+int w5100_sock_send(uint8_t sn, const void *data, size_t len);
+
+/**
+ * @brief   Waits for an event of a hardware socket
+ *
+ * Only the requested interrupt flags are taken, so several threads may wait
+ * for different flags of one socket, e.g. a sender for IR_SEND_OK and a
+ * reader for IR_RECV. IR_DISCON and IR_TIMEOUT of a TCP socket are not taken
+ * until the socket is opened again, as they end the connection for all
+ * waiters. Callers check the state of the socket, as a flag may have been set
+ * by an event an earlier call already handled.
+ *
+ * @param[in] sn            the hardware socket
+ * @param[in] flags         the interrupt flags (IR_*) to wait for
+ * @param[in,out] timeout   timeout in microseconds or SOCK_NO_TIMEOUT,
+ *                          the remaining time on return
+ *
+ * @return  the flags of @p flags that were set
+ * @return  -EAGAIN if @p timeout is 0 and none of @p flags is set
+ * @return  -ETIMEDOUT if @p timeout expired
+ */
+int w5100_sock_wait(uint8_t sn, uint8_t flags, uint32_t *timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* W5100_SOCK_INTERNAL_H */
+/** @} */
@@ -0,0 +1,334 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_w5100
+ * @{
+ *
+ * @file
+ * @brief       TCP sock implementation on W5100 hardware sockets
+ *
+ * A listening hardware socket takes exactly one connection. A queue therefore
+ * listens with a new hardware socket after every accepted connection, as long
+ * as there are free ones.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <string.h>
+
+#include "net/sock/tcp.h"
+#include "w5100_regs.h"
+#include "w5100_sock_internal.h"
+
+#define ENABLE_DEBUG        (0)
+#include "debug.h"
+
+static int _listen(sock_tcp_queue_t *queue)
+{
+    /* all hardware sockets of a queue listen on the same port */
+    int sn = w5100_sock_open(MR_TCP, queue->local.port,
+                             queue->flags | SOCK_FLAGS_REUSE_EP);
+
+    if (sn < 0) {
+        queue->sn = W5100_SOCK_UNDEF;
+        return sn;
+    }
+    w5100_sock_cmd(sn, CR_LISTEN);
+    queue->sn = (uint8_t)sn;
+    return 0;
+}
+
+static int _check_conn(sock_tcp_t *sock)
+{
+    if (sock->sn == W5100_SOCK_UNDEF) {
+        return -ENOTCONN;
+    }
+    switch (w5100_sock_state(sock->sn)) {
+        case SR_ESTABLISHED:
+        case SR_CLOSE_WAIT:
+            return 0;
+        case SR_CLOSED:
+            return -ECONNRESET;
+        default:
+            return -ENOTCONN;
+    }
+}
+
+int sock_tcp_connect(sock_tcp_t *sock, const sock_tcp_ep_t *remote,
+                     uint16_t local_port, uint16_t flags)
+{
+    uint32_t timeout = SOCK_NO_TIMEOUT;
+    int res, sn;
+    uint8_t sr;
+
+    assert(sock != NULL);
+    assert((remote != NULL) && (remote->port != 0));
+
+    if ((res = w5100_sock_check_ep(remote)) < 0) {
+        return res;
+    }
+    if (remote->addr.ipv4_u32 == 0) {
+        return -EINVAL;
+    }
+    if ((sn = w5100_sock_open(MR_TCP, local_port, flags)) < 0) {
+        return sn;
+    }
+    w5100_sock_set_remote(sn, remote);
+    w5100_sock_cmd(sn, CR_CONNECT);
+
+    /* the device gives up on its own after its retransmissions */
+    res = 0;
+    while (((sr = w5100_sock_state(sn)) != SR_ESTABLISHED) &&
+           (sr != SR_CLOSE_WAIT)) {
+        if (sr == SR_CLOSED) {
+            res = (res & IR_TIMEOUT) ? -ETIMEDOUT : -ECONNREFUSED;
+            w5100_sock_close(sn);
+            return res;
+        }
+        res = w5100_sock_wait(sn, IR_CON | IR_DISCON | IR_TIMEOUT, &timeout);
+    }
+    sock->sn = (uint8_t)sn;
+    sock->queue = NULL;
+    w5100_sock_local(sock->sn, &sock->local);
+    memcpy(&sock->remote, remote, sizeof(sock_tcp_ep_t));
+    return 0;
+}
+
+int sock_tcp_listen(sock_tcp_queue_t *queue, const sock_tcp_ep_t *local,
+                    sock_tcp_t *queue_array, unsigned queue_len,
+                    uint16_t flags)
+{
+    int res, sn;
+
+    assert(queue != NULL);
+    assert((local != NULL) && (local->port != 0));
+    assert((queue_array != NULL) && (queue_len != 0));
+
+    if ((res = w5100_sock_check_ep(local)) < 0) {
+        return res;
+    }
+    if (queue_len > USHRT_MAX) {
+        return -EFAULT;
+    }
+    /* the first socket checks the port */
+    if ((sn = w5100_sock_open(MR_TCP, local->port, flags)) < 0) {
+        return sn;
+    }
+    w5100_sock_cmd(sn, CR_LISTEN);
+    queue->sn = (uint8_t)sn;
+    queue->flags = flags;
+    queue->array = queue_array;
+    queue->len = queue_len;
+    w5100_sock_local(sn, &queue->local);
+    for (unsigned i = 0; i < queue_len; i++) {
+        queue_array[i].sn = W5100_SOCK_UNDEF;
+        queue_array[i].queue = NULL;
+    }
+    return 0;
+}
+
+void sock_tcp_disconnect(sock_tcp_t *sock)
+{
+    uint32_t timeout = W5100_SOCK_DISCON_TIMEOUT;
+    sock_tcp_queue_t *queue;
+
+    assert(sock != NULL);
+
+    if (sock->sn == W5100_SOCK_UNDEF) {
+        return;
+    }
+    queue = sock->queue;
+    if (_check_conn(sock) == 0) {
+        w5100_sock_cmd(sock->sn, CR_DISCON);
+        while ((w5100_sock_state(sock->sn) != SR_CLOSED) &&
+               (w5100_sock_wait(sock->sn, IR_DISCON | IR_TIMEOUT,
+                                &timeout) >= 0)) {}
+    }
+    w5100_sock_close(sock->sn);
+    sock->sn = W5100_SOCK_UNDEF;
+    sock->queue = NULL;
+
+    /* the queue may have run out of hardware sockets before */
+    if ((queue != NULL) && (queue->array != NULL) &&
+        (queue->sn == W5100_SOCK_UNDEF)) {
+        _listen(queue);
+    }
+}
+
+void sock_tcp_stop_listen(sock_tcp_queue_t *queue)
+{
+    assert(queue != NULL);
+
+    if (queue->array == NULL) {
+        return;
+    }
+    if (queue->sn != W5100_SOCK_UNDEF) {
+        w5100_sock_close(queue->sn);
+    }
+    /* sever connections established through this queue */
+    for (unsigned i = 0; i < queue->len; i++) {
+        if (queue->array[i].queue == queue) {
+            queue->array[i].queue = NULL;
+            sock_tcp_disconnect(&queue->array[i]);
+        }
+    }
+    queue->sn = W5100_SOCK_UNDEF;
+    queue->array = NULL;
+    queue->len = 0;
+}
+
+int sock_tcp_get_local(sock_tcp_t *sock, sock_tcp_ep_t *ep)
+{
+    assert(sock && ep);
+
+    if (sock->sn == W5100_SOCK_UNDEF) {
+        return -EADDRNOTAVAIL;
+    }
+    memcpy(ep, &sock->local, sizeof(sock_tcp_ep_t));
+    return 0;
+}
+
+int sock_tcp_get_remote(sock_tcp_t *sock, sock_tcp_ep_t *ep)
+{
+    assert(sock && ep);
+
+    if (sock->sn == W5100_SOCK_UNDEF) {
+        return -ENOTCONN;
+    }
+    memcpy(ep, &sock->remote, sizeof(sock_tcp_ep_t));
+    return 0;
+}
+
+int sock_tcp_queue_get_local(sock_tcp_queue_t *queue, sock_tcp_ep_t *ep)
+{
+    assert(queue && ep);
+
+    if (queue->array == NULL) {
+        return -EADDRNOTAVAIL;
+    }
+    memcpy(ep, &queue->local, sizeof(sock_tcp_ep_t));
+    return 0;
+}
+
+int sock_tcp_accept(sock_tcp_queue_t *queue, sock_tcp_t **sock,
+                    uint32_t timeout)
+{
+    sock_tcp_t *res = NULL;
+    uint8_t sr;
+    int err;
+
+    assert((queue != NULL) && (sock != NULL));
+
+    if (queue->array == NULL) {
+        return -EINVAL;
+    }
+    if ((queue->sn == W5100_SOCK_UNDEF) && (_listen(queue) < 0)) {
+        return -ENOMEM;
+    }
+    while (((sr = w5100_sock_state(queue->sn)) != SR_ESTABLISHED) &&
+           (sr != SR_CLOSE_WAIT)) {
+        if (sr == SR_CLOSED) {
+            /* connection attempt was reset, listen again */
+            w5100_sock_cmd(queue->sn, CR_OPEN);
+            w5100_sock_cmd(queue->sn, CR_LISTEN);
+        }
+        if ((err = w5100_sock_wait(queue->sn, IR_CON | IR_DISCON | IR_TIMEOUT,
+                                   &timeout)) < 0) {
+            return err;
+        }
+    }
+    for (unsigned i = 0; i < queue->len; i++) {
+        if (queue->array[i].sn == W5100_SOCK_UNDEF) {
+            res = &queue->array[i];
+            break;
+        }
+    }
+    if (res == NULL) {
+        /* the connection stays with the listening socket until a sock of
+         * the queue is disconnected */
+        return -ENOMEM;
+    }
+    res->sn = queue->sn;
+    res->queue = queue;
+    memcpy(&res->local, &queue->local, sizeof(sock_tcp_ep_t));
+    w5100_sock_get_remote(res->sn, &res->remote);
+    _listen(queue);
+    DEBUG("[w5100_sock] tcp: accepted connection on socket %u\n",
+          (unsigned)res->sn);
+    *sock = res;
+    return 0;
+}
+
+ssize_t sock_tcp_read(sock_tcp_t *sock, void *data, size_t max_len,
+                      uint32_t timeout)
+{
+    uint16_t size;
+    int res;
+
+    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+
+    if (sock->sn == W5100_SOCK_UNDEF) {
+        return -ENOTCONN;
+    }
+    while ((size = w5100_sock_rx_size(sock->sn)) == 0) {
+        if ((res = _check_conn(sock)) < 0) {
+            return res;
+        }
+        if (w5100_sock_state(sock->sn) == SR_CLOSE_WAIT) {
+            /* remote end closed the connection, no more data */
+            return 0;
+        }
+        if ((res = w5100_sock_wait(sock->sn, IR_RECV | IR_DISCON | IR_TIMEOUT,
+                                   &timeout)) < 0) {
+            return res;
+        }
+    }
+    if (size > max_len) {
+        size = max_len;
+    }
+    w5100_sock_read(sock->sn, 0, data, size);
+    w5100_sock_read_done(sock->sn, size);
+    return size;
+}
+
+ssize_t sock_tcp_write(sock_tcp_t *sock, const void *data, size_t len)
+{
+    const uint8_t *pos = data;
+    size_t left = len;
+    int res;
+
+    assert(sock != NULL);
+    assert((len == 0) || (data != NULL));
+
+    while (left > 0) {
+        uint32_t timeout = SOCK_NO_TIMEOUT;
+        uint16_t chunk;
+
+        if ((res = _check_conn(sock)) < 0) {
+            return res;
+        }
+        if ((chunk = w5100_sock_tx_free(sock->sn)) == 0) {
+            w5100_sock_wait(sock->sn, IR_SEND_OK | IR_DISCON | IR_TIMEOUT,
+                            &timeout);
+            continue;
+        }
+        if (chunk > left) {
+            chunk = left;
+        }
+        if (w5100_sock_send(sock->sn, pos, chunk) < 0) {
+            /* retransmissions failed, the device closed the connection */
+            return -ECONNRESET;
+        }
+        pos += chunk;
+        left -= chunk;
+    }
+    return len;
+}
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_w5100
+ * @{
+ *
+ * @file
+ * @brief       UDP sock implementation on W5100 hardware sockets
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "net/sock/udp.h"
+#include "w5100_regs.h"
+#include "w5100_sock_internal.h"
+
+#define ENABLE_DEBUG        (0)
+#include "debug.h"
+
+static int _bind(sock_udp_t *sock, uint16_t port)
+{
+    int sn = w5100_sock_open(MR_UDP, port, sock->flags);
+
+    if (sn < 0) {
+        return sn;
+    }
+    sock->sn = (uint8_t)sn;
+    w5100_sock_local(sock->sn, &sock->local);
+    return 0;
+}
+
+int sock_udp_create(sock_udp_t *sock, const sock_udp_ep_t *local,
+                    const sock_udp_ep_t *remote, uint16_t flags)
+{
+    int res;
+
+    assert(sock != NULL);
+    assert(remote == NULL || remote->port != 0);
+
+    if (((local != NULL) && ((res = w5100_sock_check_ep(local)) < 0)) ||
+        ((remote != NULL) && ((res = w5100_sock_check_ep(remote)) < 0))) {
+        return res;
+    }
+    if ((remote != NULL) && (remote->addr.ipv4_u32 == 0)) {
+        return -EINVAL;
+    }
+    memset(sock, 0, sizeof(sock_udp_t));
+    sock->local.family = AF_UNSPEC;
+    sock->remote.family = AF_UNSPEC;
+    sock->flags = flags;
+    sock->sn = W5100_SOCK_UNDEF;
+    if (remote != NULL) {
+        memcpy(&sock->remote, remote, sizeof(sock_udp_ep_t));
+    }
+    if (local != NULL) {
+        return _bind(sock, local->port);
+    }
+    return 0;
+}
+
+void sock_udp_close(sock_udp_t *sock)
+{
+    assert(sock != NULL);
+
+    if (sock->sn != W5100_SOCK_UNDEF) {
+        w5100_sock_close(sock->sn);
+        sock->sn = W5100_SOCK_UNDEF;
+    }
+}
+
+int sock_udp_get_local(sock_udp_t *sock, sock_udp_ep_t *ep)
+{
+    assert(sock && ep);
+
+    if (sock->local.family == AF_UNSPEC) {
+        return -EADDRNOTAVAIL;
+    }
+    memcpy(ep, &sock->local, sizeof(sock_udp_ep_t));
+    return 0;
+}
+
+int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *ep)
+{
+    assert(sock && ep);
+
+    if (sock->remote.family == AF_UNSPEC) {
+        return -ENOTCONN;
+    }
+    memcpy(ep, &sock->remote, sizeof(sock_udp_ep_t));
+    return 0;
+}
+
+ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
+                      uint32_t timeout, sock_udp_ep_t *remote)
+{
+    uint8_t hdr[W5100_SOCK_UDP_HDR_LEN];
+    uint16_t len;
+    int res;
+
+    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+
+    if (sock->sn == W5100_SOCK_UNDEF) {
+        return -EADDRNOTAVAIL;
+    }
+    while (w5100_sock_rx_size(sock->sn) < W5100_SOCK_UDP_HDR_LEN) {
+        if ((res = w5100_sock_wait(sock->sn, IR_RECV, &timeout)) < 0) {
+            return res;
+        }
+    }
+
+    /* only the payload and this header cross the bus, the device already
+     * dropped datagrams with bad checksums or for other ports */
+    w5100_sock_read(sock->sn, 0, hdr, sizeof(hdr));
+    len = (hdr[6] << 8) | hdr[7];
+    if (len > max_len) {
+        w5100_sock_read_done(sock->sn, sizeof(hdr) + len);
+        return -ENOBUFS;
+    }
+    w5100_sock_read(sock->sn, sizeof(hdr), data, len);
+    w5100_sock_read_done(sock->sn, sizeof(hdr) + len);
+
+    uint16_t port = (hdr[4] << 8) | hdr[5];
+
+    if ((sock->remote.family != AF_UNSPEC) &&
+        ((memcmp(sock->remote.addr.ipv4, hdr, 4) != 0) ||
+         (sock->remote.port != port))) {
+        return -EPROTO;
+    }
+    if (remote != NULL) {
+        memset(remote, 0, sizeof(sock_udp_ep_t));
+        remote->family = AF_INET;
+        memcpy(remote->addr.ipv4, hdr, 4);
+        remote->port = port;
+    }
+    DEBUG("[w5100_sock] udp: received %u byte on socket %u\n",
+          (unsigned)len, (unsigned)sock->sn);
+    return len;
+}
+
+ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
+                      const sock_udp_ep_t *remote)
+{
+    sock_udp_t tmp;
+    int res;
+
+    assert((sock != NULL) || (remote != NULL));
+    assert((len == 0) || (data != NULL));
+
+    if (remote != NULL) {
+        if ((res = w5100_sock_check_ep(remote)) < 0) {
+            return res;
+        }
+        if ((remote->port == 0) || (remote->addr.ipv4_u32 == 0)) {
+            return -EINVAL;
+        }
+    }
+    else if (sock->remote.family == AF_UNSPEC) {
+        return -ENOTCONN;
+    }
+    else {
+        remote = &sock->remote;
+    }
+    if (len > W5100_SOCK_UDP_MAX) {
+        return -ENOMEM;
+    }
+    if (sock == NULL) {
+        /* send from an ephemeral port */
+        sock_udp_create(&tmp, NULL, NULL, 0);
+        sock = &tmp;
+    }
+    if ((sock->sn == W5100_SOCK_UNDEF) && ((res = _bind(sock, 0)) < 0)) {
+        return res;
+    }
+
+    w5100_sock_set_remote(sock->sn, remote);
+    res = w5100_sock_send(sock->sn, data, len);
+    if (sock == &tmp) {
+        sock_udp_close(&tmp);
+    }
+    /* the device gives up if the next hop does not answer ARP requests */
+    return (res < 0) ? -EHOSTUNREACH : (ssize_t)len;
+}
@@ -0,0 +1,463 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_w5100
+ * @{
+ *
+ * @file
+ * @brief       Hardware socket management for the W5100 sock backend
+ *
+ * The device signals events of all sockets on one interrupt line, which is
+ * asserted while the interrupt flags of a socket enabled in the IMR register
+ * are set. A socket is enabled in IMR only while a thread waits for it. The
+ * interrupt wakes all waiting threads, which check their sockets over SPI.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "assert.h"
+#include "mutex.h"
+#include "net/af.h"
+#include "xtimer.h"
+
+#include "w5100.h"
+#include "w5100_internal.h"
+#include "w5100_regs.h"
+#include "w5100_sock_internal.h"
+
+#define ENABLE_DEBUG        (0)
+#include "debug.h"
+
+#define SN_MEMSIZE          (0x0800)
+#define SN_MASK             (SN_MEMSIZE - 1)
+#define SN_TX_BASE(sn)      (0x4000 + ((sn) * SN_MEMSIZE))
+#define SN_RX_BASE(sn)      (0x6000 + ((sn) * SN_MEMSIZE))
+
+#define EPHEMERAL_MIN       (49152U)
+
+static w5100_t *_dev = NULL;
+static uint8_t _addr[4];
+
+/* all variables below are protected by the SPI bus lock */
+static uint8_t _used;                           /* open hardware sockets */
+static uint8_t _waiting;                        /* sockets waited for */
+static uint8_t _sleeping[W5100_SOCK_NUMOF];     /* threads waiting per socket */
+static uint8_t _pending[W5100_SOCK_NUMOF];      /* flags not yet taken */
+static uint8_t _mode[W5100_SOCK_NUMOF];
+static uint16_t _port[W5100_SOCK_NUMOF];
+static uint16_t _ephemeral = EPHEMERAL_MIN;
+static mutex_t _wait[W5100_SOCK_NUMOF];
+
+static inline uint8_t _rreg(uint8_t sn, uint8_t reg)
+{
+    return w5100_rreg(_dev, SN_BASE(sn) + reg);
+}
+
+static inline void _wreg(uint8_t sn, uint8_t reg, uint8_t data)
+{
+    w5100_wreg(_dev, SN_BASE(sn) + reg, data);
+}
+
+static uint16_t _raddr_stable(uint8_t sn, uint8_t reg)
+{
+    uint16_t val, prev;
+
+    /* the size registers are updated by the device while they are read, so
+     * they are read until two reads agree */
+    val = w5100_raddr(_dev, SN_BASE(sn) + reg, SN_BASE(sn) + reg + 1);
+    do {
+        prev = val;
+        val = w5100_raddr(_dev, SN_BASE(sn) + reg, SN_BASE(sn) + reg + 1);
+    } while (val != prev);
+    return val;
+}
+
+/* Wakes all threads waiting for a socket, as each one waits for other flags.
+ * Surplus wake ups only make a waiter check the flags once more. */
+static void _wake(unsigned sn)
+{
+    for (unsigned i = 0; i < _sleeping[sn]; i++) {
+        mutex_unlock(&_wait[sn]);
+    }
+}
+
+static void _isr(netdev_t *netdev, netdev_event_t event)
+{
+    (void)netdev;
+
+    if (event != NETDEV_EVENT_ISR) {
+        return;
+    }
+    for (unsigned sn = 0; sn < W5100_SOCK_NUMOF; sn++) {
+        if (_waiting & (1 << sn)) {
+            _wake(sn);
+        }
+    }
+}
+
+/* The interrupt line only signals a falling edge while it was not asserted
+ * for another socket before. So whenever the IMR is reduced, the flags of the
+ * remaining sockets are checked by hand. */
+static void _kick(void)
+{
+    uint8_t ir = w5100_rreg(_dev, REG_IR) & _waiting;
+
+    for (unsigned sn = 0; sn < W5100_SOCK_NUMOF; sn++) {
+        if (ir & (1 << sn)) {
+            _wake(sn);
+        }
+    }
+}
+
+static bool _port_used(uint8_t mode, uint16_t port)
+{
+    for (unsigned sn = 0; sn < W5100_SOCK_NUMOF; sn++) {
+        if ((_used & (1 << sn)) && (_mode[sn] == mode) && (_port[sn] == port)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int w5100_sock_init(w5100_t *dev, const w5100_ipconf_t *conf)
+{
+    assert((dev != NULL) && (conf != NULL));
+
+    w5100_acquire(dev);
+    if (w5100_reset(dev) != 0) {
+        w5100_release(dev);
+        return W5100_ERR_BUS;
+    }
+    _dev = dev;
+    _used = 0;
+    _waiting = 0;
+    for (unsigned sn = 0; sn < W5100_SOCK_NUMOF; sn++) {
+        mutex_init(&_wait[sn]);
+        mutex_lock(&_wait[sn]);
+        _sleeping[sn] = 0;
+        _pending[sn] = 0;
+    }
+    memcpy(_addr, conf->addr, sizeof(_addr));
+    w5100_wchunk(dev, REG_GAR0, conf->gw, sizeof(conf->gw));
+    w5100_wchunk(dev, REG_SUB0, conf->mask, sizeof(conf->mask));
+    w5100_wchunk(dev, REG_SIPR0, conf->addr, sizeof(conf->addr));
+    w5100_wreg(dev, REG_RMSR, MSR_2KB_EACH);
+    w5100_wreg(dev, REG_TMSR, MSR_2KB_EACH);
+    w5100_wreg(dev, REG_IMR, 0);
+    dev->nd.event_callback = _isr;
+    w5100_release(dev);
+
+    return 0;
+}
+
+int w5100_sock_check_ep(const struct _sock_tl_ep *ep)
+{
+    if (ep->family != AF_INET) {
+        return -EAFNOSUPPORT;
+    }
+    if (ep->netif != SOCK_ADDR_ANY_NETIF) {
+        return -EINVAL;
+    }
+    return 0;
+}
+
+int w5100_sock_open(uint8_t mode, uint16_t port, uint16_t flags)
+{
+    int sn;
+
+    assert(_dev != NULL);
+
+    w5100_acquire(_dev);
+    for (sn = 0; sn < (int)W5100_SOCK_NUMOF; sn++) {
+        if (!(_used & (1 << sn))) {
+            break;
+        }
+    }
+    if (sn == W5100_SOCK_NUMOF) {
+        w5100_release(_dev);
+        return -ENOMEM;
+    }
+    if (port == 0) {
+        do {
+            port = _ephemeral++;
+            if (_ephemeral == 0) {
+                _ephemeral = EPHEMERAL_MIN;
+            }
+        } while (_port_used(mode, port));
+    }
+    else if (!(flags & SOCK_FLAGS_REUSE_EP) && _port_used(mode, port)) {
+        w5100_release(_dev);
+        return -EADDRINUSE;
+    }
+    _used |= (1 << sn);
+    _mode[sn] = mode;
+    _port[sn] = port;
+    _wreg(sn, SN_MR, mode);
+    _wreg(sn, SN_PORT0, (uint8_t)(port >> 8));
+    _wreg(sn, SN_PORT1, (uint8_t)(port & 0xff));
+    _wreg(sn, SN_CR, CR_OPEN);
+    while (_rreg(sn, SN_CR)) {}
+    _wreg(sn, SN_IR, 0xff);
+    _pending[sn] = 0;
+    w5100_release(_dev);
+
+    DEBUG("[w5100_sock] opened socket %i, mode %u, port %u\n",
+          sn, (unsigned)mode, (unsigned)port);
+    return sn;
+}
+
+void w5100_sock_close(uint8_t sn)
+{
+    assert(sn < W5100_SOCK_NUMOF);
+
+    w5100_acquire(_dev);
+    _wreg(sn, SN_CR, CR_CLOSE);
+    while (_rreg(sn, SN_CR)) {}
+    _wreg(sn, SN_IR, 0xff);
+    _pending[sn] = 0;
+    _used &= ~(1 << sn);
+    w5100_release(_dev);
+
+    DEBUG("[w5100_sock] closed socket %u\n", (unsigned)sn);
+}
+
+void w5100_sock_local(uint8_t sn, struct _sock_tl_ep *ep)
+{
+    assert(sn < W5100_SOCK_NUMOF);
+
+    memset(ep, 0, sizeof(*ep));
+    ep->family = AF_INET;
+    memcpy(ep->addr.ipv4, _addr, sizeof(_addr));
+    ep->port = _port[sn];
+}
+
+void w5100_sock_set_remote(uint8_t sn, const struct _sock_tl_ep *ep)
+{
+    w5100_acquire(_dev);
+    w5100_wchunk(_dev, SN_BASE(sn) + SN_DIPR0, ep->addr.ipv4,
+                 sizeof(ep->addr.ipv4));
+    _wreg(sn, SN_DPORT0, (uint8_t)(ep->port >> 8));
+    _wreg(sn, SN_DPORT1, (uint8_t)(ep->port & 0xff));
+    w5100_release(_dev);
+}
+
+void w5100_sock_get_remote(uint8_t sn, struct _sock_tl_ep *ep)
+{
+    memset(ep, 0, sizeof(*ep));
+    ep->family = AF_INET;
+    w5100_acquire(_dev);
+    w5100_rchunk(_dev, SN_BASE(sn) + SN_DIPR0, ep->addr.ipv4,
+                 sizeof(ep->addr.ipv4));
+    ep->port = w5100_raddr(_dev, SN_BASE(sn) + SN_DPORT0,
+                           SN_BASE(sn) + SN_DPORT1);
+    w5100_release(_dev);
+}
+
+void w5100_sock_cmd(uint8_t sn, uint8_t cmd)
+{
+    w5100_acquire(_dev);
+    _wreg(sn, SN_CR, cmd);
+    while (_rreg(sn, SN_CR)) {}
+    if (cmd == CR_OPEN) {
+        /* flags kept for an earlier connection end with it */
+        _pending[sn] = 0;
+    }
+    w5100_release(_dev);
+}
+
+uint8_t w5100_sock_state(uint8_t sn)
+{
+    uint8_t sr;
+
+    w5100_acquire(_dev);
+    sr = _rreg(sn, SN_SR);
+    w5100_release(_dev);
+    return sr;
+}
+
+uint16_t w5100_sock_rx_size(uint8_t sn)
+{
+    uint16_t size;
+
+    w5100_acquire(_dev);
+    size = _raddr_stable(sn, SN_RX_RSR0);
+    w5100_release(_dev);
+    return size;
+}
+
+void w5100_sock_read(uint8_t sn, uint16_t offset, void *data, size_t len)
+{
+    w5100_acquire(_dev);
+    uint16_t ptr = w5100_raddr(_dev, SN_BASE(sn) + SN_RX_RD0,
+                               SN_BASE(sn) + SN_RX_RD1) + offset;
+    uint16_t pos = ptr & SN_MASK;
+
+    if ((pos + len) > SN_MEMSIZE) {
+        size_t limit = SN_MEMSIZE - pos;
+
+        w5100_rchunk(_dev, SN_RX_BASE(sn) + pos, data, limit);
+        w5100_rchunk(_dev, SN_RX_BASE(sn), (uint8_t *)data + limit,
+                     len - limit);
+    }
+    else {
+        w5100_rchunk(_dev, SN_RX_BASE(sn) + pos, data, len);
+    }
+    w5100_release(_dev);
+}
+
+void w5100_sock_read_done(uint8_t sn, uint16_t len)
+{
+    w5100_acquire(_dev);
+    uint16_t ptr = w5100_raddr(_dev, SN_BASE(sn) + SN_RX_RD0,
+                               SN_BASE(sn) + SN_RX_RD1);
+
+    w5100_waddr(_dev, SN_BASE(sn) + SN_RX_RD0, SN_BASE(sn) + SN_RX_RD1,
+                ptr + len);
+    _wreg(sn, SN_CR, CR_RECV);
+    while (_rreg(sn, SN_CR)) {}
+    w5100_release(_dev);
+}
+
+uint16_t w5100_sock_tx_free(uint8_t sn)
+{
+    uint16_t size;
+
+    w5100_acquire(_dev);
+    size = _raddr_stable(sn, SN_TX_FSR0);
+    w5100_release(_dev);
+    return size;
+}
+
+int w5100_sock_send(uint8_t sn, const void *data, size_t len)
+{
+    uint32_t timeout = SOCK_NO_TIMEOUT;
+    uint8_t flags = IR_SEND_OK | IR_TIMEOUT;
+    uint8_t sr;
+    int ir;
+
+    assert(len <= SN_MEMSIZE);
+
+    w5100_acquire(_dev);
+    uint16_t ptr = w5100_raddr(_dev, SN_BASE(sn) + SN_TX_WR0,
+                               SN_BASE(sn) + SN_TX_WR1);
+    uint16_t pos = ptr & SN_MASK;
+
+    if ((pos + len) > SN_MEMSIZE) {
+        size_t limit = SN_MEMSIZE - pos;
+
+        w5100_wchunk(_dev, SN_TX_BASE(sn) + pos, data, limit);
+        w5100_wchunk(_dev, SN_TX_BASE(sn), (const uint8_t *)data + limit,
+                     len - limit);
+    }
+    else {
+        w5100_wchunk(_dev, SN_TX_BASE(sn) + pos, data, len);
+    }
+    w5100_waddr(_dev, SN_BASE(sn) + SN_TX_WR0, SN_BASE(sn) + SN_TX_WR1,
+                ptr + len);
+    _wreg(sn, SN_CR, CR_SEND);
+    while (_rreg(sn, SN_CR)) {}
+    w5100_release(_dev);
+
+    /* a reset by the peer closes the socket without IR_SEND_OK */
+    if (_mode[sn] == MR_TCP) {
+        flags |= IR_DISCON;
+    }
+    /* the device retries on its own (RTR and RCR registers), so there is no
+     * timeout here */
+    while (1) {
+        ir = w5100_sock_wait(sn, flags, &timeout);
+        if (ir & IR_SEND_OK) {
+            return 0;
+        }
+        if (ir & IR_TIMEOUT) {
+            return -ETIMEDOUT;
+        }
+        /* IR_DISCON after a FIN of the peer, which still takes data */
+        sr = w5100_sock_state(sn);
+        if ((sr != SR_ESTABLISHED) && (sr != SR_CLOSE_WAIT)) {
+            return -ECONNRESET;
+        }
+    }
+}
+
+int w5100_sock_wait(uint8_t sn, uint8_t flags, uint32_t *timeout)
+{
+    uint32_t start = xtimer_now_usec();
+    bool expired = false;
+    int res;
+
+    assert(sn < W5100_SOCK_NUMOF);
+
+    w5100_acquire(_dev);
+    while (1) {
+        uint8_t ir = _rreg(sn, SN_IR);
+
+        if (ir != 0) {
+            /* the device flags are always cleared to release the interrupt
+             * line, other waiters take theirs from _pending */
+            _wreg(sn, SN_IR, ir);
+            _pending[sn] |= ir;
+            _wake(sn);
+        }
+        if (_pending[sn] & flags) {
+            res = _pending[sn] & flags;
+            _pending[sn] &= ~res;
+            if (_mode[sn] == MR_TCP) {
+                /* the connection ends, every waiter needs to see that */
+                _pending[sn] |= (res & (IR_DISCON | IR_TIMEOUT));
+            }
+            break;
+        }
+        if (expired) {
+            res = -ETIMEDOUT;
+            break;
+        }
+        if (*timeout == 0) {
+            res = -EAGAIN;
+            break;
+        }
+        /* enable the interrupt of the socket, which fires right away if a flag
+         * was set in the meantime */
+        _sleeping[sn]++;
+        _waiting |= (1 << sn);
+        w5100_wreg(_dev, REG_IMR, _waiting);
+        w5100_release(_dev);
+
+        if (*timeout == SOCK_NO_TIMEOUT) {
+            mutex_lock(&_wait[sn]);
+        }
+        else {
+            uint32_t elapsed = xtimer_now_usec() - start;
+
+            if ((elapsed >= *timeout) ||
+                (xtimer_mutex_lock_timeout(&_wait[sn],
+                                           *timeout - elapsed) < 0)) {
+                expired = true;
+            }
+        }
+
+        w5100_acquire(_dev);
+        if (--_sleeping[sn] == 0) {
+            _waiting &= ~(1 << sn);
+        }
+        w5100_wreg(_dev, REG_IMR, _waiting);
+        _kick();
+    }
+    w5100_release(_dev);
+
+    if (*timeout != SOCK_NO_TIMEOUT) {
+        uint32_t elapsed = xtimer_now_usec() - start;
+
+        *timeout = (expired || (elapsed >= *timeout)) ? 0 : *timeout - elapsed;
+    }
+    return res;
+}
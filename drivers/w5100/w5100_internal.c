@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2016-2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_w5100
+ * @{
+ *
+ * @file
+ * @brief       Register access functions for W5100 devices
+ *
+ * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
+ *
+ * @}
+ */
+
+#include "log.h"
+#include "luid.h"
+
+#include "net/ethernet.h"
+
+#include "w5100_internal.h"
+#include "w5100_regs.h"
+
+#define ENABLE_DEBUG        (0)
+#include "debug.h"
+
+#define RMSR_DEFAULT_VALUE  (0x55)
+
+static inline void send_addr(w5100_t *dev, uint16_t addr)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    spi_transfer_byte(dev->p.spi, dev->p.cs, true, (addr >> 8));
+    spi_transfer_byte(dev->p.spi, dev->p.cs, true, (addr & 0xff));
+#else
+    spi_transfer_byte(dev->p.spi, dev->p.cs, true, (addr & 0xff));
+    spi_transfer_byte(dev->p.spi, dev->p.cs, true, (addr >> 8));
+#endif
+}
+
+uint8_t w5100_rreg(w5100_t *dev, uint16_t reg)
+{
+    spi_transfer_byte(dev->p.spi, dev->p.cs, true, CMD_READ);
+    send_addr(dev, reg);
+    return spi_transfer_byte(dev->p.spi, dev->p.cs, false, 0);
+}
+
+void w5100_wreg(w5100_t *dev, uint16_t reg, uint8_t data)
+{
+    spi_transfer_byte(dev->p.spi, dev->p.cs, true, CMD_WRITE);
+    send_addr(dev, reg);
+    spi_transfer_byte(dev->p.spi, dev->p.cs, false, data);
+}
+
+uint16_t w5100_raddr(w5100_t *dev, uint16_t addr_high, uint16_t addr_low)
+{
+    uint16_t res = (w5100_rreg(dev, addr_high) << 8);
+    res |= w5100_rreg(dev, addr_low);
+    return res;
+}
+
+void w5100_waddr(w5100_t *dev,
+                 uint16_t addr_high, uint16_t addr_low, uint16_t val)
+{
+    w5100_wreg(dev, addr_high, (uint8_t)(val >> 8));
+    w5100_wreg(dev, addr_low, (uint8_t)(val & 0xff));
+}
+
+void w5100_rchunk(w5100_t *dev, uint16_t addr, uint8_t *data, size_t len)
+{
+    /* reading a chunk must be split in multiple single byte reads, as the
+     * device does not support auto address increment via SPI */
+    for (int i = 0; i < (int)len; i++) {
+        data[i] = w5100_rreg(dev, addr++);
+    }
+}
+
+void w5100_wchunk(w5100_t *dev, uint16_t addr, const uint8_t *data, size_t len)
+{
+    /* writing a chunk must be split in multiple single byte writes, as the
+     * device does not support auto address increment via SPI */
+    for (int i = 0; i < (int)len; i++) {
+        w5100_wreg(dev, addr++, data[i]);
+    }
+}
+
+int w5100_reset(w5100_t *dev)
+{
+    uint8_t hwaddr[ETHERNET_ADDR_LEN];
+
+    /* test the SPI connection by reading the value of the RMSR register */
+    if (w5100_rreg(dev, REG_TMSR) != RMSR_DEFAULT_VALUE) {
+        LOG_ERROR("[w5100] error: no SPI connection\n");
+        return W5100_ERR_BUS;
+    }
+
+    /* reset the device */
+    w5100_wreg(dev, REG_MODE, MODE_RESET);
+    while (w5100_rreg(dev, REG_MODE) & MODE_RESET) {};
+
+    /* initialize the device, start with writing the MAC address */
+    luid_get(hwaddr, ETHERNET_ADDR_LEN);
+    hwaddr[0] &= ~0x03;         /* no group address and not globally unique */
+    w5100_wchunk(dev, REG_SHAR0, hwaddr, ETHERNET_ADDR_LEN);
+
+    return 0;
+}
@@ -110,13 +110,201 @@ static void _at_cmd(xbee_t *dev, const char *cmd)
     uart_write(dev->p.uart, (uint8_t *)cmd, strlen(cmd));
 }
 
-static void isr_resp_timeout(void *arg)
+/*
+ * Interrupt callbacks
+ */
+void xbee_rx_cb(void *arg, uint8_t c)
 {
     xbee_t *dev = (xbee_t *)arg;
 
-    if (mutex_trylock(&(dev->resp_lock)) == 0) {
-        dev->int_state = XBEE_INT_STATE_IDLE;
+    if (tsrb_add_one(&dev->rx_rb, (char)c) < 0) {
+        dev->rx_stats.overrun++;
+        return;
+    }
+    /* wake up the thread once the FSM can make progress */
+    if (!dev->rx_pending && (tsrb_avail(&dev->rx_rb) >= dev->rx_need)) {
+        dev->rx_pending = 1;
+        /* a thread waiting for an AT command response parses on its own */
+        mutex_unlock(&(dev->resp_lock));
+        if (dev->event_callback) {
+            dev->event_callback((netdev_t *)dev, NETDEV_EVENT_ISR);
+        }
+    }
+}
+
+/*
+ * Parsing of received data in thread context
+ */
+static void _rx_reset(xbee_t *dev)
+{
+    tsrb_init(&dev->rx_rb, dev->rx_rb_buf, XBEE_RX_BUF_SIZE);
+    dev->rx_need = 1;
+    dev->rx_pending = 0;
+    dev->int_state = XBEE_INT_STATE_IDLE;
+    dev->rx_count = 0;
+    dev->rx_limit = 0;
+    memset(&dev->rx_stats, 0, sizeof(dev->rx_stats));
+}
+
+static void _rx_skip(xbee_t *dev, uint16_t len)
+{
+    dev->int_size = len;
+    dev->int_state = XBEE_INT_STATE_SKIP;
+}
+
+static void _rx_type(xbee_t *dev, uint8_t type)
+{
+    /* bytes following the type, including the checksum */
+    uint16_t left = dev->int_size;
+
+    if ((type == API_ID_RX_SHORT_ADDR) || (type == API_ID_RX_LONG_ADDR)) {
+        if (left >= XBEE_MAX_PKT_LENGTH) {
+            DEBUG("[xbee] rx: packet too large\n");
+            dev->rx_stats.dropped++;
+            _rx_skip(dev, left);
+            return;
+        }
+        dev->rx_limit = left + 1;
+        dev->rx_count = 0;
+        dev->rx_buf[dev->rx_count++] = type;
+        dev->int_state = XBEE_INT_STATE_RX;
+    }
+    else if ((type == API_ID_AT_RESP) && (left <= XBEE_MAX_RESP_LENGTH)) {
+        dev->resp_limit = left;
+        dev->resp_count = 0;
+        dev->int_state = XBEE_INT_STATE_RESP;
+    }
+    else {
+        _rx_skip(dev, left);
+    }
+}
+
+static void _rx_resp_done(xbee_t *dev)
+{
+    if ((uint8_t)(_cksum(0, dev->resp_buf, dev->resp_limit) - API_ID_AT_RESP) != 0) {
+        DEBUG("[xbee] rx: invalid AT response checksum\n");
+        dev->rx_stats.cksum++;
+        /* the command waiting for the response runs into its timeout */
+        dev->resp_count = 0;
+    }
+    dev->int_state = XBEE_INT_STATE_IDLE;
+}
+
+static void _rx_pkt_done(xbee_t *dev)
+{
+    dev->int_state = XBEE_INT_STATE_IDLE;
+    if (_cksum(0, dev->rx_buf, dev->rx_limit) != 0) {
+        DEBUG("[xbee] rx: invalid RX checksum\n");
+        dev->rx_stats.cksum++;
+        dev->rx_count = 0;
+        return;
     }
+    dev->rx_stats.frames++;
+    if (dev->event_callback) {
+        DEBUG("[xbee] rx: data available, waiting for read\n");
+        dev->event_callback((netdev_t *)dev, NETDEV_EVENT_RX_COMPLETE);
+    }
+    if (dev->rx_count != 0) {
+        /* nobody read the packet, make room for the next one */
+        dev->rx_stats.dropped++;
+        dev->rx_count = 0;
+    }
+}
+
+static uint16_t _rx_need(const xbee_t *dev)
+{
+    switch (dev->int_state) {
+        case XBEE_INT_STATE_IDLE:
+            /* start delimiter and frame size */
+            return 3;
+        case XBEE_INT_STATE_RX:
+            return dev->rx_limit - dev->rx_count;
+        case XBEE_INT_STATE_RESP:
+            return dev->resp_limit - dev->resp_count;
+        case XBEE_INT_STATE_SKIP:
+            return (dev->int_size < XBEE_MAX_PKT_LENGTH) ?
+                   dev->int_size : XBEE_MAX_PKT_LENGTH;
+        default:
+            return 1;
+    }
+}
+
+static void _rx_parse(xbee_t *dev)
+{
+    do {
+        while (!tsrb_empty(&dev->rx_rb)) {
+            uint8_t c;
+            unsigned n;
+
+            switch (dev->int_state) {
+                case XBEE_INT_STATE_IDLE:
+                    /* check for beginning of new data frame */
+                    if ((uint8_t)tsrb_get_one(&dev->rx_rb) == API_START_DELIMITER) {
+                        dev->int_state = XBEE_INT_STATE_SIZE1;
+                    }
+                    break;
+                case XBEE_INT_STATE_SIZE1:
+                    c = (uint8_t)tsrb_get_one(&dev->rx_rb);
+                    dev->int_size = ((uint16_t)c) << 8;
+                    dev->int_state = XBEE_INT_STATE_SIZE2;
+                    break;
+                case XBEE_INT_STATE_SIZE2:
+                    c = (uint8_t)tsrb_get_one(&dev->rx_rb);
+                    dev->int_size += c;
+                    if ((dev->int_size == 0) ||
+                        (dev->int_size > XBEE_MAX_PKT_LENGTH)) {
+                        /* no valid frame, look for the next start delimiter */
+                        dev->rx_stats.dropped++;
+                        dev->int_state = XBEE_INT_STATE_IDLE;
+                    }
+                    else {
+                        dev->int_state = XBEE_INT_STATE_TYPE;
+                    }
+                    break;
+                case XBEE_INT_STATE_TYPE:
+                    _rx_type(dev, (uint8_t)tsrb_get_one(&dev->rx_rb));
+                    break;
+                case XBEE_INT_STATE_RESP:
+                    n = tsrb_get(&dev->rx_rb,
+                                 (char *)&dev->resp_buf[dev->resp_count],
+                                 dev->resp_limit - dev->resp_count);
+                    dev->resp_count += n;
+                    if (dev->resp_count == dev->resp_limit) {
+                        _rx_resp_done(dev);
+                    }
+                    break;
+                case XBEE_INT_STATE_RX:
+                    n = tsrb_get(&dev->rx_rb, (char *)&dev->rx_buf[dev->rx_count],
+                                 dev->rx_limit - dev->rx_count);
+                    dev->rx_count += n;
+                    if (dev->rx_count == dev->rx_limit) {
+                        _rx_pkt_done(dev);
+                    }
+                    break;
+                case XBEE_INT_STATE_SKIP:
+                    n = tsrb_avail(&dev->rx_rb);
+                    if (n > dev->int_size) {
+                        n = dev->int_size;
+                    }
+                    tsrb_read_commit(&dev->rx_rb, n);
+                    dev->int_size -= n;
+                    if (dev->int_size == 0) {
+                        dev->int_state = XBEE_INT_STATE_IDLE;
+                    }
+                    break;
+                default:
+                    /* this should never be the case */
+                    break;
+            }
+        }
+        dev->rx_need = _rx_need(dev);
+        /* data that came in before rx_need was updated did not wake us */
+    } while (tsrb_avail(&dev->rx_rb) >= dev->rx_need);
+}
+
+static void isr_resp_timeout(void *arg)
+{
+    xbee_t *dev = (xbee_t *)arg;
 
     mutex_unlock(&(dev->resp_lock));
 }
@@ -150,11 +338,15 @@ static void _api_at_cmd(xbee_t *dev, uint8_t *cmd, uint8_t size, resp_t *resp)
 
     xtimer_set(&resp_timer, RESP_TIMEOUT_USEC);
 
-    /* wait for results */
-    while ((dev->resp_limit != dev->resp_count) &&
-           (xtimer_less(
-                xtimer_diff32_64(xtimer_now64(), sent_time),
-                xtimer_ticks_from_usec(RESP_TIMEOUT_USEC)))) {
+    /* wait for results, the response is parsed in this thread */
+    while (1) {
+        dev->rx_pending = 0;
+        _rx_parse(dev);
+        if ((dev->resp_limit == dev->resp_count) ||
+            !xtimer_less(xtimer_diff32_64(xtimer_now64(), sent_time),
+                         xtimer_ticks_from_usec(RESP_TIMEOUT_USEC))) {
+            break;
+        }
         mutex_lock(&(dev->resp_lock));
     }
 
@@ -162,6 +354,13 @@ static void _api_at_cmd(xbee_t *dev, uint8_t *cmd, uint8_t size, resp_t *resp)
 
     if (dev->resp_limit != dev->resp_count) {
         DEBUG("[xbee] api_at_cmd: response timeout\n");
+        /* the parser might be stuck in the middle of a truncated frame,
+         * resynchronize on the next start delimiter */
+        if (dev->int_state != XBEE_INT_STATE_IDLE) {
+            dev->rx_count = 0;
+            dev->int_state = XBEE_INT_STATE_IDLE;
+            dev->rx_need = _rx_need(dev);
+        }
         resp->status = 255;
         mutex_unlock(&(dev->tx_lock));
 
@@ -177,71 +376,6 @@ static void _api_at_cmd(xbee_t *dev, uint8_t *cmd, uint8_t size, resp_t *resp)
     mutex_unlock(&(dev->tx_lock));
 }
 
-/*
- * Interrupt callbacks
- */
-static void _rx_cb(void *arg, uint8_t c)
-{
-    xbee_t *dev = (xbee_t *)arg;
-
-    switch (dev->int_state) {
-        case XBEE_INT_STATE_IDLE:
-            /* check for beginning of new data frame */
-            if (c == API_START_DELIMITER) {
-                dev->int_state = XBEE_INT_STATE_SIZE1;
-            }
-            break;
-        case XBEE_INT_STATE_SIZE1:
-            dev->int_size = ((uint16_t)c) << 8;
-            dev->int_state = XBEE_INT_STATE_SIZE2;
-            break;
-        case XBEE_INT_STATE_SIZE2:
-            dev->int_size += c;
-            dev->int_state = XBEE_INT_STATE_TYPE;
-            break;
-        case XBEE_INT_STATE_TYPE:
-            if (c == API_ID_RX_SHORT_ADDR || c == API_ID_RX_LONG_ADDR) {
-                /* in case old data was not processed, ignore incoming data */
-                if (dev->rx_count != 0) {
-                    dev->int_state = XBEE_INT_STATE_IDLE;
-                    return;
-                }
-                dev->rx_limit = dev->int_size + 1;
-                dev->rx_buf[dev->rx_count++] = c;
-                dev->int_state = XBEE_INT_STATE_RX;
-            }
-            else if (c == API_ID_AT_RESP) {
-                dev->resp_limit = dev->int_size;
-                dev->int_state = XBEE_INT_STATE_RESP;
-            }
-            else {
-                dev->int_state = XBEE_INT_STATE_IDLE;
-            }
-            break;
-        case XBEE_INT_STATE_RESP:
-            dev->resp_buf[dev->resp_count++] = c;
-            if (dev->resp_count == dev->resp_limit) {
-                /* here we ignore the checksum to prevent deadlocks */
-                mutex_unlock(&(dev->resp_lock));
-                dev->int_state = XBEE_INT_STATE_IDLE;
-            }
-            break;
-        case XBEE_INT_STATE_RX:
-            dev->rx_buf[dev->rx_count++] = c;
-            if (dev->rx_count == dev->rx_limit) {
-                /* packet is complete */
-                if (dev->event_callback) {
-                    dev->event_callback((netdev_t *)dev, NETDEV_EVENT_ISR);
-                }
-                dev->int_state = XBEE_INT_STATE_IDLE;
-            }
-            break;
-        default:
-            /* this should never be the case */
-            break;
-    }
-}
-
 /*
  * Getter and setter functions
  */
@@ -482,6 +616,10 @@ void xbee_setup(xbee_t *dev, const xbee_params_t *params)
     /* set peripherals to use */
     memcpy(&dev->p, params, sizeof(xbee_params_t));
 
+    /* the UART RX callback needs the ring buffer and a consistent FSM */
+    _rx_reset(dev);
+    mutex_init(&(dev->resp_lock));
+
     /* initialize pins */
     if (dev->p.pin_reset != GPIO_UNDEF) {
         gpio_init(dev->p.pin_reset, GPIO_OUT);
@@ -578,9 +716,9 @@ int xbee_init(netdev_t *dev)
     mutex_init(&(xbee->tx_lock));
     mutex_init(&(xbee->resp_lock));
     xbee->resp_limit = 1;    /* needs to be greater then 0 initially */
-    xbee->rx_count = 0;
+    _rx_reset(xbee);
     /* initialize UART and GPIO pins */
-    if (uart_init(xbee->p.uart, xbee->p.br, _rx_cb, xbee) != UART_OK) {
+    if (uart_init(xbee->p.uart, xbee->p.br, xbee_rx_cb, xbee) != UART_OK) {
         DEBUG("[xbee] init: error initializing UART\n");
         return -ENXIO;
     }
@@ -677,7 +815,7 @@ static int xbee_recv(netdev_t *dev, void *buf, size_t len, void *info)
     assert(xbee);
 
     /* make sure we have new data waiting */
-    if (xbee->rx_count != xbee->rx_limit) {
+    if ((xbee->rx_count == 0) || (xbee->rx_count != xbee->rx_limit)) {
         DEBUG("[xbee] recv: no data available for reading\n");
         return 0;
     }
@@ -707,17 +845,8 @@ static void xbee_isr(netdev_t *netdev)
 {
     xbee_t *dev = (xbee_t *)netdev;
 
-    if (dev->rx_count == dev->rx_limit) {
-        /* make sure the checksum checks out */
-        if (_cksum(0, dev->rx_buf, dev->rx_limit) != 0) {
-            DEBUG("[xbee] isr: invalid RX checksum\n");
-            dev->rx_count = 0;
-        }
-        else {
-            DEBUG("[xbee] isr: data available, waiting for read\n");
-            dev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
-        }
-    }
+    dev->rx_pending = 0;
+    _rx_parse(dev);
 }
 
 static int xbee_get(netdev_t *ndev, netopt_t opt, void *value, size_t max_len)
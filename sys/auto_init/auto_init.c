@@ -44,6 +44,10 @@
 #include "net/gnrc/ipv6.h"
 #endif
 
+#ifdef MODULE_GNRC_IPV4
+#include "net/gnrc/ipv4.h"
+#endif
+
 #ifdef MODULE_GNRC_IPV6_NETIF
 #include "net/gnrc/ipv6/netif.h"
 #endif
@@ -132,6 +136,10 @@ void auto_init(void)
     DEBUG("Auto init gnrc_ipv6 module.\n");
     gnrc_ipv6_init();
 #endif
+#ifdef MODULE_GNRC_IPV4
+    DEBUG("Auto init gnrc_ipv4 module.\n");
+    gnrc_ipv4_init();
+#endif
 #ifdef MODULE_GNRC_UDP
     DEBUG("Auto init UDP module.\n");
     gnrc_udp_init();
@@ -39,21 +39,55 @@
 #include "TestResult.h"
 #include "TestRunner.h"
 
+#ifdef CPU_NATIVE
+#include <stdlib.h>
+#include <time.h>
+#endif
+
 static TestResult result_;
 static Test* root_;
 int TestRunnerHadErrors;
 
+#ifdef CPU_NATIVE
+/* Per test durations for dist/tools/embunit_parallel, enabled by setting
+ * EMBUNIT_DURATIONS in the environment of the native process */
+static int durations_;
+static struct timespec start_;
+#endif
+
 static void TestRunner_startTest(TestListner* self,Test* test)
 {
     (void)self;
     (void)test;
     stdimpl_print(".");
+#ifdef CPU_NATIVE
+    if (durations_) {
+        clock_gettime(CLOCK_MONOTONIC, &start_);
+    }
+#endif
 }
 
 static void TestRunner_endTest(TestListner* self,Test* test)
 {
     (void)self;
     (void)test;
+#ifdef CPU_NATIVE
+    if (durations_) {
+        struct timespec end;
+        char buf[24];
+
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        stdimpl_print("\n#duration ");
+        stdimpl_print(Test_name(root_));
+        stdimpl_print(".");
+        stdimpl_print(Test_name(test));
+        stdimpl_print(" ");
+        stdimpl_lltoa(((long long)(end.tv_sec - start_.tv_sec) * 1000000LL) +
+                      ((end.tv_nsec - start_.tv_nsec) / 1000), buf, 10);
+        stdimpl_print(buf);
+        stdimpl_print("\n");
+    }
+#endif
 }
 
 static void TestRunner_addFailure(TestListner* self,Test* test,char* msg,int line,char* file)
@@ -91,6 +125,9 @@ static const TestListner testrunner_ = {
 void TestRunner_start(void)
 {
     TestResult_init(&result_, (TestListner*)&testrunner_);
+#ifdef CPU_NATIVE
+    durations_ = (getenv("EMBUNIT_DURATIONS") != NULL);
+#endif
 }
 
 void TestRunner_runTest(Test* test)
@@ -20,6 +20,9 @@
  * @}
  */
 
+/* the heap based implementation lives in evtimer_heap.c */
+#ifndef MODULE_EVTIMER_HEAP
+
 #include "div.h"
 #include "irq.h"
 #include "xtimer.h"
@@ -203,3 +206,5 @@ void evtimer_print(const evtimer_t *evtimer)
         list = list->next;
     }
 }
+
+#endif /* MODULE_EVTIMER_HEAP */
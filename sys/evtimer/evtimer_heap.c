@@ -0,0 +1,232 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_evtimer
+ * @{
+ *
+ * @file
+ * @brief       event timer implementation based on a pairing heap
+ *
+ * Alternative to the delta list in evtimer.c, enabled with the `evtimer_heap`
+ * module. Events are kept with absolute deadlines in a pairing heap, so adding
+ * an event is O(1), while removing any event is O(log n) amortized.
+ *
+ * The heap is stored intrusively in the events: evtimer_event_t::next links
+ * siblings, evtimer_event_t::child points to the leftmost child and
+ * evtimer_event_t::prev points to the parent for a leftmost child or to the
+ * left sibling otherwise.
+ *
+ * @}
+ */
+
+#ifdef MODULE_EVTIMER_HEAP
+
+#include <stdio.h>
+
+#include "irq.h"
+#include "xtimer.h"
+
+#include "evtimer.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/**
+ * @brief   Checks if @p event is in the heap of @p evtimer
+ *
+ * Relies on evtimer_event_t::prev being NULL for events that are not queued:
+ * _del_event_from_heap() clears it on removal and on firing, events that were
+ * never added need to be zero-initialized (see evtimer_add()).
+ */
+static inline bool _is_queued(const evtimer_t *evtimer,
+                              const evtimer_event_t *event)
+{
+    return (evtimer->events == event) || (event->prev != NULL);
+}
+
+/**
+ * @brief   Merge two heaps, both @p a and @p b have no siblings
+ */
+static evtimer_event_t *_meld(evtimer_event_t *a, evtimer_event_t *b)
+{
+    if (!a) {
+        return b;
+    }
+    if (!b) {
+        return a;
+    }
+    if (b->deadline < a->deadline) {
+        evtimer_event_t *tmp = a;
+        a = b;
+        b = tmp;
+    }
+    /* make b the leftmost child of a */
+    b->prev = a;
+    b->next = a->child;
+    if (a->child) {
+        a->child->prev = b;
+    }
+    a->child = b;
+    return a;
+}
+
+/**
+ * @brief   Merge a list of siblings into one heap (two-pass pairing)
+ */
+static evtimer_event_t *_merge_pairs(evtimer_event_t *first)
+{
+    evtimer_event_t *pairs = NULL;
+    evtimer_event_t *res = NULL;
+
+    /* first pass: meld pairs from left to right, collecting them in reverse
+     * order */
+    while (first) {
+        evtimer_event_t *a = first;
+        evtimer_event_t *b = a->next;
+
+        first = (b) ? b->next : NULL;
+        a->next = a->prev = NULL;
+        if (b) {
+            b->next = b->prev = NULL;
+        }
+        a = _meld(a, b);
+        a->next = pairs;
+        pairs = a;
+    }
+
+    /* second pass: meld the pairs from right to left */
+    while (pairs) {
+        evtimer_event_t *next = pairs->next;
+
+        pairs->next = NULL;
+        res = _meld(pairs, res);
+        pairs = next;
+    }
+
+    return res;
+}
+
+static void _del_event_from_heap(evtimer_t *evtimer, evtimer_event_t *event)
+{
+    evtimer_event_t *sub = _merge_pairs(event->child);
+
+    if (evtimer->events == event) {
+        evtimer->events = sub;
+    }
+    else {
+        /* unlink event from its parent or left sibling */
+        if (event->prev->child == event) {
+            event->prev->child = event->next;
+        }
+        else {
+            event->prev->next = event->next;
+        }
+        if (event->next) {
+            event->next->prev = event->prev;
+        }
+        evtimer->events = _meld(evtimer->events, sub);
+    }
+
+    event->next = event->prev = event->child = NULL;
+}
+
+static void _update_timer(evtimer_t *evtimer)
+{
+    if (evtimer->events) {
+        uint64_t now = xtimer_now_usec64();
+        uint64_t target = evtimer->events->deadline;
+        uint64_t offset = (target > now) ? (target - now) : 0;
+
+        DEBUG("evtimer: setting xtimer to %" PRIu32 ":%" PRIu32 "\n",
+              (uint32_t)(offset >> 32), (uint32_t)offset);
+        _xtimer_set64(&evtimer->timer, offset, offset >> 32);
+    }
+    else {
+        xtimer_remove(&evtimer->timer);
+    }
+}
+
+void evtimer_add(evtimer_t *evtimer, evtimer_event_t *event)
+{
+    unsigned state = irq_disable();
+
+    DEBUG("evtimer_add(): adding event with offset %" PRIu32 "\n", event->offset);
+
+    if (_is_queued(evtimer, event)) {
+        _del_event_from_heap(evtimer, event);
+    }
+    event->deadline = xtimer_now_usec64() + ((uint64_t)event->offset * US_PER_MS);
+    event->next = event->prev = event->child = NULL;
+    evtimer->events = _meld(evtimer->events, event);
+    if (evtimer->events == event) {
+        _update_timer(evtimer);
+    }
+    irq_restore(state);
+    if (sched_context_switch_request) {
+        thread_yield_higher();
+    }
+}
+
+void evtimer_del(evtimer_t *evtimer, evtimer_event_t *event)
+{
+    unsigned state = irq_disable();
+
+    DEBUG("evtimer_del(): removing event with offset %" PRIu32 "\n", event->offset);
+
+    if (_is_queued(evtimer, event)) {
+        bool was_head = (evtimer->events == event);
+
+        _del_event_from_heap(evtimer, event);
+        if (was_head) {
+            _update_timer(evtimer);
+        }
+    }
+    irq_restore(state);
+}
+
+static void _evtimer_handler(void *arg)
+{
+    DEBUG("_evtimer_handler()\n");
+
+    evtimer_t *evtimer = (evtimer_t *)arg;
+    uint64_t now = xtimer_now_usec64();
+    evtimer_event_t *event;
+
+    while ((event = evtimer->events) && (event->deadline <= now)) {
+        _del_event_from_heap(evtimer, event);
+        evtimer->callback(event);
+    }
+
+    _update_timer(evtimer);
+}
+
+void evtimer_init(evtimer_t *evtimer, evtimer_callback_t handler)
+{
+    evtimer->callback = handler;
+    evtimer->timer.callback = _evtimer_handler;
+    evtimer->timer.arg = (void *)evtimer;
+    evtimer->events = NULL;
+}
+
+static void _print(const evtimer_event_t *event, uint64_t now)
+{
+    while (event) {
+        printf("ev offset=%u\n", (event->deadline > now) ?
+               (unsigned)((event->deadline - now) / US_PER_MS) : 0);
+        _print(event->child, now);
+        event = event->next;
+    }
+}
+
+void evtimer_print(const evtimer_t *evtimer)
+{
+    _print(evtimer->events, xtimer_now_usec64());
+}
+
+#endif /* MODULE_EVTIMER_HEAP */
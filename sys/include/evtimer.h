@@ -31,6 +31,12 @@
  *   example.
  * - uses @ref sys_xtimer "xtimer" as backend
  *
+ * By default, events are kept in a list sorted by their offsets, which makes
+ * adding and removing events O(n). For timers with many pending events, the
+ * `evtimer_heap` module keeps them in a pairing heap with absolute deadlines
+ * instead, making adding O(1) and removing O(log n) (amortized), at the cost
+ * of three more words of memory per event.
+ *
  * @{
  *
  * @file
@@ -56,6 +62,12 @@ extern "C" {
  */
 typedef struct evtimer_event {
     struct evtimer_event *next; /**< the next event in the queue */
+#if defined(MODULE_EVTIMER_HEAP) || defined(DOXYGEN)
+    struct evtimer_event *child;    /**< leftmost child in the heap */
+    struct evtimer_event *prev;     /**< parent if leftmost child, previous
+                                         sibling otherwise */
+    uint64_t deadline;          /**< absolute deadline in microseconds */
+#endif
     uint32_t offset;            /**< offset in milliseconds from previous event */
 } evtimer_event_t;
 
@@ -85,6 +97,15 @@ void evtimer_init(evtimer_t *evtimer, evtimer_callback_t handler);
 /**
  * @brief   Adds event to an event timer
  *
+ * @note    With `evtimer_heap`, evtimer_event_t::offset is not modified, and
+ *          an event that is already queued is rescheduled.
+ *
+ * @pre     With `evtimer_heap`, an event that was never added before must
+ *          have evtimer_event_t::prev set to NULL (e.g. by zero-initializing
+ *          it), as it is used to tell whether the event is queued. Events
+ *          that fired or were removed with evtimer_del() have their heap
+ *          pointers cleared and can be added again as they are.
+ *
  * @param[in] evtimer       An event timer
  * @param[in] event         An event
  */
@@ -93,6 +114,9 @@ void evtimer_add(evtimer_t *evtimer, evtimer_event_t *event);
 /**
  * @brief   Removes an event from an event timer
  *
+ * @pre     With `evtimer_heap`, the same precondition as for evtimer_add()
+ *          applies to events that were never added.
+ *
  * @param[in] evtimer       An event timer
  * @param[in] event         An event
  */
@@ -35,8 +35,12 @@ extern "C" {
  * @brief   Context structure for isrpipe
  */
 typedef struct {
-    mutex_t mutex;      /**< isrpipe mutex */
-    tsrb_t tsrb;        /**< isrpipe thread safe ringbuffer */
+    mutex_t mutex;          /**< isrpipe mutex */
+    tsrb_t tsrb;            /**< isrpipe thread safe ringbuffer */
+    size_t watermark;       /**< fill level waking the reader, 0 to wake
+                                 the reader on every byte */
+    uint32_t idle_timeout;  /**< idle time in us after which the reader is
+                                 woken below the watermark */
 } isrpipe_t;
 
 /**
@@ -64,6 +68,35 @@ void isrpipe_init(isrpipe_t *isrpipe, char *buf, size_t bufsize);
  */
 int isrpipe_write_one(isrpipe_t *isrpipe, char c);
 
+/**
+ * @brief   Put data into the isrpipe's buffer
+ *
+ * @param[in]   isrpipe     isrpipe object to operate on
+ * @param[in]   buf         data to add to the isrpipe buffer
+ * @param[in]   count       number of bytes in @p buf
+ *
+ * @returns     number of bytes added, less than @p count if the buffer is full
+ */
+int isrpipe_write(isrpipe_t *isrpipe, const char *buf, size_t count);
+
+/**
+ * @brief   Configure the isrpipe to wake its reader on a watermark
+ *
+ * By default, the reader is woken for every byte written into the isrpipe.
+ * With a watermark set, isrpipe_read() and isrpipe_read_timeout() return once
+ * @p watermark bytes (or the number of bytes requested, if smaller) are
+ * available, or when no data arrived for @p idle_timeout microseconds while
+ * data is pending. isrpipe_read_timeout() additionally returns the data
+ * pending so far when its timeout expires. This
+ * reduces the number of context switches for high-rate streams considerably.
+ *
+ * @param[in]   isrpipe         isrpipe object to operate on
+ * @param[in]   watermark       fill level waking the reader, 0 to disable
+ * @param[in]   idle_timeout    idle time in microseconds
+ */
+void isrpipe_set_watermark(isrpipe_t *isrpipe, size_t watermark,
+                           uint32_t idle_timeout);
+
 /**
  * @brief   Read data from isrpipe (blocking)
  *
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_arp ARP
+ * @ingroup     net
+ * @brief       Provides ARP header and helper functions
+ * @see <a href="https://tools.ietf.org/html/rfc826">
+ *          RFC 826
+ *      </a>
+ * @{
+ *
+ * @file
+ * @brief   ARP header definitions
+ */
+#ifndef NET_ARP_H
+#define NET_ARP_H
+
+#include <stdint.h>
+
+#include "byteorder.h"
+#include "net/ethernet/hdr.h"
+#include "net/ipv4/addr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    Hardware types
+ * @{
+ */
+#define ARP_HTYPE_ETHERNET      (1U)    /**< Ethernet (10Mb) */
+/** @} */
+
+/**
+ * @name    Operation codes
+ * @{
+ */
+#define ARP_OP_REQUEST          (1U)    /**< request */
+#define ARP_OP_REPLY            (2U)    /**< reply */
+/** @} */
+
+/**
+ * @brief   ARP packet for IPv4 over Ethernet
+ *
+ * @details The structure of the packet is as follows:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.unparsed}
+ *  0                   1                   2                   3
+ *  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+ * +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ * |         Hardware Type         |         Protocol Type         |
+ * +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ * |  HW Addr Len  | Prot Addr Len |           Operation           |
+ * +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ * |                Sender Hardware Address (6 bytes)              |
+ * +                               +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ * |                               | Sender Protocol Address (4 b) |
+ * +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+                               +
+ * |                               |                               |
+ * +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+                               +
+ * |                Target Hardware Address (6 bytes)              |
+ * +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ * |                Target Protocol Address (4 bytes)              |
+ * +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+typedef struct __attribute__((packed)) {
+    network_uint16_t htype;             /**< hardware type */
+    network_uint16_t ptype;             /**< protocol type (ether type) */
+    uint8_t hlen;                       /**< hardware address length */
+    uint8_t plen;                       /**< protocol address length */
+    network_uint16_t op;                /**< operation */
+    uint8_t sha[ETHERNET_ADDR_LEN];     /**< sender hardware address */
+    ipv4_addr_t spa;                    /**< sender protocol address */
+    uint8_t tha[ETHERNET_ADDR_LEN];     /**< target hardware address */
+    ipv4_addr_t tpa;                    /**< target protocol address */
+} arp_hdr_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_ARP_H */
+/** @} */
@@ -25,6 +25,7 @@
 #include "byteorder.h"
 #include "kernel_types.h"
 #include "net/ipv6/hdr.h"
+#include "net/gnrc/pkt.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -58,6 +59,18 @@ gnrc_pktsnip_t *gnrc_icmpv6_echo_build(uint8_t type, uint16_t id, uint16_t seq,
 void gnrc_icmpv6_echo_req_handle(kernel_pid_t iface, ipv6_hdr_t *ipv6_hdr,
                                  icmpv6_echo_t *echo, uint16_t len);
 
+/**
+ * @brief   Replies to an ICMPv6 echo request by turning it into the reply
+ *
+ * Other than gnrc_icmpv6_echo_req_handle() this does not allocate a new
+ * packet, but reuses the buffer of the request if no other thread holds it.
+ *
+ * @param[in] iface The interface the echo request was received on.
+ * @param[in] pkt   The echo request, starting with its ICMPv6 snip. Is
+ *                  released or sent by this function.
+ */
+void gnrc_icmpv6_echo_req_reply(kernel_pid_t iface, gnrc_pktsnip_t *pkt);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_ipv4 IPv4
+ * @ingroup     net_gnrc
+ * @brief       GNRC's IPv4 implementation
+ *
+ * The IPv4 control thread understands messages of type
+ *
+ *  * @ref GNRC_NETAPI_MSG_TYPE_RCV, and
+ *  * @ref GNRC_NETAPI_MSG_TYPE_SND,
+ *
+ * and shares the packet buffer and the network registry with IPv6, so both
+ * stacks can run side by side on the same interfaces. Received packets are
+ * demultiplexed by their protocol number, i.e. UDP packets reach
+ * @ref net_gnrc_udp and from there @ref net_sock_udp like their IPv6
+ * counterparts.
+ *
+ * Each interface has at most one IPv4 address (see @ref net_gnrc_ipv4_netif).
+ * Destinations within the prefix of an interface are resolved with
+ * @ref net_gnrc_ipv4_arp, all other destinations are routed via
+ * @ref gnrc_ipv4_fib_table. Add a default route with a destination of
+ * `0.0.0.0` to reach hosts outside of the attached networks.
+ *
+ * Fragmented packets, IP options, and forwarding between interfaces are not
+ * supported.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Definitions for GNRC's IPv4 implementation
+ */
+#ifndef NET_GNRC_IPV4_H
+#define NET_GNRC_IPV4_H
+
+#include "kernel_types.h"
+#include "net/fib.h"
+#include "net/gnrc.h"
+#include "net/ipv4/hdr.h"
+#include "net/gnrc/ipv4/hdr.h"
+#include "net/gnrc/ipv4/icmp.h"
+#include "net/gnrc/ipv4/netif.h"
+#ifdef MODULE_GNRC_IPV4_ARP
+#include "net/gnrc/ipv4/arp.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Default stack size to use for the IPv4 thread
+ */
+#ifndef GNRC_IPV4_STACK_SIZE
+#define GNRC_IPV4_STACK_SIZE        (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Default priority for the IPv4 thread
+ */
+#ifndef GNRC_IPV4_PRIO
+#define GNRC_IPV4_PRIO              (THREAD_PRIORITY_MAIN - 3)
+#endif
+
+/**
+ * @brief   Default message queue size to use for the IPv4 thread.
+ */
+#ifndef GNRC_IPV4_MSG_QUEUE_SIZE
+#define GNRC_IPV4_MSG_QUEUE_SIZE    (8U)
+#endif
+
+/**
+ * @brief   Maximum number of entries in the IPv4 FIB table.
+ */
+#ifndef GNRC_IPV4_FIB_TABLE_SIZE
+#define GNRC_IPV4_FIB_TABLE_SIZE    (5)
+#endif
+
+/**
+ * @brief   Time to live for packets sent by this node
+ */
+#ifndef GNRC_IPV4_DEFAULT_TTL
+#define GNRC_IPV4_DEFAULT_TTL       (64U)
+#endif
+
+/**
+ * @brief   The PID to the IPv4 thread.
+ *
+ * @note    Use @ref gnrc_ipv4_init() to initialize. **Do not set by hand**.
+ *
+ * @details This variable is preferred for IPv4 internal communication *only*.
+ *          Please use @ref net_gnrc_netreg for external communication.
+ */
+extern kernel_pid_t gnrc_ipv4_pid;
+
+/**
+ * @brief   The forwarding information base (FIB) for the IPv4 stack.
+ *
+ * @see @ref net_fib
+ */
+extern fib_table_t gnrc_ipv4_fib_table;
+
+/**
+ * @brief   Initialization of the IPv4 thread.
+ *
+ * @return  The PID to the IPv4 thread, on success.
+ * @return  a negative errno on error.
+ * @return  -EOVERFLOW, if there are too many threads running already
+ * @return  -EEXIST, if IPv4 was already initialized.
+ */
+kernel_pid_t gnrc_ipv4_init(void);
+
+/**
+ * @brief   Get the IPv4 header from a given list of @ref gnrc_pktsnip_t
+ *
+ *          This function may be used with e.g. a pointer to a (full) UDP datagram.
+ *
+ * @param[in] pkt    The pointer to the first @ref gnrc_pktsnip_t of the
+ *                   packet.
+ *
+ * @return A pointer to the @ref ipv4_hdr_t of the packet.
+ * @return NULL if the packet does not contain an IPv4 header.
+ */
+ipv4_hdr_t *gnrc_ipv4_get_header(gnrc_pktsnip_t *pkt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_IPV4_H */
+/** @} */
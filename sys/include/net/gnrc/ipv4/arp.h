@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_ipv4_arp ARP
+ * @ingroup     net_gnrc_ipv4
+ * @brief       Address resolution for IPv4 over Ethernet
+ * @see <a href="https://tools.ietf.org/html/rfc826">
+ *          RFC 826
+ *      </a>
+ *
+ * The ARP cache is run by the IPv4 thread. While an address is resolved, the
+ * latest packet to that address is queued in its cache entry, older ones are
+ * dropped. Requests are retransmitted every @ref GNRC_IPV4_ARP_RETRANS_TIMER
+ * up to @ref GNRC_IPV4_ARP_MAX_RETRANS times.
+ *
+ * @{
+ *
+ * @file
+ * @brief   Definitions for GNRC's ARP implementation
+ */
+#ifndef NET_GNRC_IPV4_ARP_H
+#define NET_GNRC_IPV4_ARP_H
+
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "msg.h"
+#include "net/arp.h"
+#include "net/gnrc/pkt.h"
+#include "net/ipv4/addr.h"
+#include "timex.h"
+#include "xtimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of entries in the ARP cache
+ */
+#ifndef GNRC_IPV4_ARP_CACHE_SIZE
+#define GNRC_IPV4_ARP_CACHE_SIZE        (8U)
+#endif
+
+/**
+ * @brief   Time between retransmissions of a request in microseconds
+ */
+#ifndef GNRC_IPV4_ARP_RETRANS_TIMER
+#define GNRC_IPV4_ARP_RETRANS_TIMER     (1U * US_PER_SEC)
+#endif
+
+/**
+ * @brief   Number of retransmissions before a resolution fails
+ */
+#ifndef GNRC_IPV4_ARP_MAX_RETRANS
+#define GNRC_IPV4_ARP_MAX_RETRANS       (3U)
+#endif
+
+/**
+ * @brief   Time a resolved entry stays valid in microseconds
+ */
+#ifndef GNRC_IPV4_ARP_REACHABLE_TIME
+#define GNRC_IPV4_ARP_REACHABLE_TIME    (300U * US_PER_SEC)
+#endif
+
+/**
+ * @brief   Message type for request retransmissions
+ */
+#define GNRC_IPV4_ARP_MSG_RETRANS       (0x0230)
+
+/**
+ * @name    States of a cache entry
+ * @{
+ */
+#define GNRC_IPV4_ARP_STATE_EMPTY       (0U)    /**< entry is unused */
+#define GNRC_IPV4_ARP_STATE_INCOMPLETE  (1U)    /**< resolution in progress */
+#define GNRC_IPV4_ARP_STATE_REACHABLE   (2U)    /**< address is resolved */
+#define GNRC_IPV4_ARP_STATE_STATIC      (3U)    /**< entry does not expire */
+/** @} */
+
+/**
+ * @brief   ARP cache entry
+ */
+typedef struct {
+    xtimer_t timer;                     /**< retransmission timer */
+    msg_t msg;                          /**< retransmission message */
+    gnrc_pktsnip_t *pending;            /**< packet waiting for resolution */
+    uint32_t expires;                   /**< time the entry expires at (in
+                                         *   microseconds) */
+    ipv4_addr_t addr;                   /**< IPv4 address */
+    kernel_pid_t iface;                 /**< interface of the entry */
+    uint8_t l2addr[ETHERNET_ADDR_LEN];  /**< link layer address */
+    uint8_t state;                      /**< state of the entry */
+    uint8_t retrans;                    /**< requests left to send */
+} gnrc_ipv4_arp_t;
+
+/**
+ * @brief   Resolves the link layer address of a next hop.
+ *
+ * @pre Called from the IPv4 thread.
+ *
+ * @param[in] iface     The interface to resolve @p addr on.
+ * @param[in] addr      The address of the next hop.
+ * @param[in] pkt       The packet to send to @p addr. The first snip must
+ *                      be a netif header with a destination address of
+ *                      @ref ETHERNET_ADDR_LEN bytes.
+ *
+ * @return  1, if @p addr was resolved. The destination address of the netif
+ *          header is set and @p pkt can be sent.
+ * @return  0, if @p pkt was queued until @p addr is resolved. @p pkt is
+ *          sent or released by ARP.
+ * @return  -ENOMEM, if there is no free cache entry or the request could not
+ *          be allocated. @p pkt is not released.
+ */
+int gnrc_ipv4_arp_resolve(kernel_pid_t iface, const ipv4_addr_t *addr,
+                          gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Handles a received ARP packet.
+ *
+ * @pre Called from the IPv4 thread.
+ *
+ * Answers requests for addresses of the receiving interface and updates the
+ * cache.
+ *
+ * @param[in] pkt   The ARP packet, the packet is released.
+ */
+void gnrc_ipv4_arp_receive(gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Retransmits the request of an incomplete entry or drops it.
+ *
+ * @pre Called from the IPv4 thread.
+ *
+ * @param[in] entry The entry from a @ref GNRC_IPV4_ARP_MSG_RETRANS message.
+ */
+void gnrc_ipv4_arp_retrans(gnrc_ipv4_arp_t *entry);
+
+/**
+ * @brief   Adds a static entry to the cache
+ *
+ * @param[in] iface     The interface of the entry.
+ * @param[in] addr      An IPv4 address.
+ * @param[in] l2addr    The link layer address of @p addr.
+ *
+ * @return  0, on success.
+ * @return  -ENOMEM, if the cache is full.
+ */
+int gnrc_ipv4_arp_add(kernel_pid_t iface, const ipv4_addr_t *addr,
+                      const uint8_t *l2addr);
+
+/**
+ * @brief   Removes an entry from the cache
+ *
+ * A packet still waiting for the entry is released.
+ *
+ * @param[in] addr      An IPv4 address.
+ */
+void gnrc_ipv4_arp_remove(const ipv4_addr_t *addr);
+
+/**
+ * @brief   Gets an entry of the cache
+ *
+ * @param[in] idx   Index of the entry, less than
+ *                  @ref GNRC_IPV4_ARP_CACHE_SIZE.
+ *
+ * @return  The entry at @p idx. Check gnrc_ipv4_arp_t::state for unused
+ *          entries.
+ */
+const gnrc_ipv4_arp_t *gnrc_ipv4_arp_get(unsigned idx);
+
+/**
+ * @brief   Removes all entries from the cache
+ */
+void gnrc_ipv4_arp_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_IPV4_ARP_H */
+/** @} */
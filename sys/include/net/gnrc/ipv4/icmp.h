@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_ipv4_icmp ICMP
+ * @ingroup     net_gnrc_ipv4
+ * @brief       Basic implementation of ICMP for IPv4
+ *
+ * Echo requests addressed to this node are answered by the IPv4 thread,
+ * all ICMP messages are also handed to threads registered for
+ * @ref GNRC_NETTYPE_ICMP.
+ *
+ * @{
+ *
+ * @file
+ * @brief   Definitions for GNRC's ICMP implementation
+ */
+#ifndef NET_GNRC_IPV4_ICMP_H
+#define NET_GNRC_IPV4_ICMP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "net/icmp.h"
+#include "net/gnrc/pkt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Demultiplexes a received ICMP packet.
+ *
+ * Answers echo requests.
+ *
+ * @param[in] iface The receiving interface.
+ * @param[in] pkt   The packet, starting with the ICMP message. The packet is
+ *                  released.
+ */
+void gnrc_ipv4_icmp_demux(kernel_pid_t iface, gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Builds an ICMP echo message and adds it to the packet buffer.
+ *
+ * @param[in] type      Type of the echo message. Must be either
+ *                      @ref ICMP_ECHO_REQ or @ref ICMP_ECHO_REP.
+ * @param[in] id        ID for the echo message in host byte-order
+ * @param[in] seq       Sequence number for the echo message in host byte-order
+ * @param[in] data      Payload for the echo message
+ * @param[in] data_len  Length of @p data
+ *
+ * @return  The echo message on success
+ * @return  NULL, on failure
+ */
+gnrc_pktsnip_t *gnrc_ipv4_icmp_echo_build(uint8_t type, uint16_t id,
+                                          uint16_t seq, uint8_t *data,
+                                          size_t data_len);
+
+/**
+ * @brief   Calculates the checksum for an ICMP packet.
+ *
+ * @param[in] hdr           The header the checksum should be calculated
+ *                          for.
+ * @param[in] pseudo_hdr    The IPv4 header. Unused, since ICMP has no pseudo
+ *                          header, but kept for @ref gnrc_netreg_calc_csum().
+ *
+ * @return  0, on success.
+ * @return  -EINVAL, if gnrc_pktsnip_t::type of @p pkt was not
+ *          @ref GNRC_NETTYPE_ICMP
+ * @return  -EFAULT, if @p hdr is NULL.
+ */
+int gnrc_ipv4_icmp_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_IPV4_ICMP_H */
+/** @} */
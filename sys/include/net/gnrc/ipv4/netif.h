@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_ipv4_netif IPv4 network interfaces
+ * @ingroup     net_gnrc_ipv4
+ * @brief       IPv4 specific information on @ref net_gnrc_netif.
+ *
+ * Every interface holds at most one IPv4 address with its prefix length.
+ *
+ * @{
+ *
+ * @file
+ * @brief   Definitions for IPv4 specific information of network interfaces.
+ */
+#ifndef NET_GNRC_IPV4_NETIF_H
+#define NET_GNRC_IPV4_NETIF_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "net/ipv4/addr.h"
+#include "net/gnrc/netif.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of interfaces with IPv4 support
+ */
+#ifndef GNRC_IPV4_NETIF_NUMOF
+#define GNRC_IPV4_NETIF_NUMOF   (GNRC_NETIF_NUMOF)
+#endif
+
+/**
+ * @brief   Definition of IPv4 interface type.
+ */
+typedef struct {
+    ipv4_addr_t addr;           /**< address of the interface */
+    ipv4_addr_t bcast;          /**< directed broadcast address of the prefix */
+    kernel_pid_t pid;           /**< PID of the interface,
+                                 *   KERNEL_PID_UNDEF for unused entries */
+    uint16_t mtu;               /**< maximum IPv4 packet size, 0 until the
+                                 *   first packet is sent over the interface */
+    uint8_t prefix_len;         /**< prefix length of @ref addr */
+} gnrc_ipv4_netif_t;
+
+/**
+ * @brief   Sets the IPv4 address of an interface.
+ *
+ * Replaces the current address of @p pid, if there is one.
+ *
+ * @param[in] pid           The PID to the interface.
+ * @param[in] addr          The address.
+ * @param[in] prefix_len    Length of the network prefix of @p addr
+ *                          (between 1 and 32).
+ *
+ * @return  0, on success.
+ * @return  -EINVAL, if @p prefix_len is out of range.
+ * @return  -ENOMEM, if all interface entries are in use.
+ */
+int gnrc_ipv4_netif_add_addr(kernel_pid_t pid, const ipv4_addr_t *addr,
+                             uint8_t prefix_len);
+
+/**
+ * @brief   Removes the IPv4 address from an interface.
+ *
+ * @param[in] pid   The PID to the interface.
+ */
+void gnrc_ipv4_netif_remove_addr(kernel_pid_t pid);
+
+/**
+ * @brief   Get the IPv4 information of an interface.
+ *
+ * @param[in] pid   The PID to the interface.
+ *
+ * @return  The IPv4 information of @p pid.
+ * @return  NULL, if @p pid has no IPv4 address.
+ */
+gnrc_ipv4_netif_t *gnrc_ipv4_netif_get(kernel_pid_t pid);
+
+/**
+ * @brief   Iterates over all interfaces with an IPv4 address.
+ *
+ * @param[in] prev  The previous interface. NULL to get the first one.
+ *
+ * @return  The IPv4 information of the interface after @p prev.
+ * @return  NULL, if there are no more interfaces.
+ */
+gnrc_ipv4_netif_t *gnrc_ipv4_netif_get_next(const gnrc_ipv4_netif_t *prev);
+
+/**
+ * @brief   Searches the interface that has @p addr assigned.
+ *
+ * @param[in] addr  An IPv4 address.
+ *
+ * @return  The IPv4 information of the interface.
+ * @return  NULL, if no interface has @p addr.
+ */
+gnrc_ipv4_netif_t *gnrc_ipv4_netif_find_by_addr(const ipv4_addr_t *addr);
+
+/**
+ * @brief   Searches the interface @p addr is on-link to.
+ *
+ * @param[in] addr  An IPv4 address.
+ *
+ * @return  The IPv4 information of the interface with the longest prefix
+ *          matching @p addr.
+ * @return  NULL, if @p addr is not on-link to any interface.
+ */
+gnrc_ipv4_netif_t *gnrc_ipv4_netif_find_by_prefix(const ipv4_addr_t *addr);
+
+/**
+ * @brief   Checks if @p addr is a broadcast address for @p netif
+ *
+ * @param[in] netif An IPv4 interface.
+ * @param[in] addr  An IPv4 address.
+ *
+ * @return  true, if @p addr is the limited broadcast address or the directed
+ *          broadcast address of @p netif's prefix.
+ * @return  false, otherwise.
+ */
+static inline bool gnrc_ipv4_netif_is_bcast(const gnrc_ipv4_netif_t *netif,
+                                            const ipv4_addr_t *addr)
+{
+    return (addr->u32.u32 == 0xffffffff) ||
+           (addr->u32.u32 == netif->bcast.u32.u32);
+}
+
+/**
+ * @brief   Removes all IPv4 addresses.
+ */
+void gnrc_ipv4_netif_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_IPV4_NETIF_H */
+/** @} */
@@ -32,11 +32,80 @@
 #include "kernel_types.h"
 #include "net/gnrc/pkt.h"
 #include "net/ipv6/ext.h"
+#include "net/ipv6/ext/opt.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief   Maximum number of extension headers recorded by one call of
+ *          gnrc_ipv6_ext_walk()
+ */
+#ifndef GNRC_IPV6_EXT_WALK_NUMOF
+#define GNRC_IPV6_EXT_WALK_NUMOF            (8U)
+#endif
+
+/**
+ * @brief   Drop packets with unrecognized options according to the action
+ *          encoded in the option type
+ *
+ * Unrecognized options are skipped by default, since e.g. the RPL option
+ * (RFC 6553) has no handler registered unless an application provides one.
+ * If enabled, an ICMPv6 parameter problem message is sent for options of
+ * type 10xxxxxx, and for 11xxxxxx if the destination is not multicast
+ * (RFC 8200, section 4.2). This needs the `gnrc_icmpv6` module.
+ */
+#ifndef GNRC_IPV6_EXT_OPT_DISCARD_UNKNOWN
+#define GNRC_IPV6_EXT_OPT_DISCARD_UNKNOWN   (0)
+#endif
+
+/**
+ * @brief   Extension headers found by gnrc_ipv6_ext_walk()
+ */
+typedef struct {
+    uint16_t offset[GNRC_IPV6_EXT_WALK_NUMOF];  /**< offsets of the headers */
+    uint8_t type[GNRC_IPV6_EXT_WALK_NUMOF];     /**< protocol numbers of the
+                                                 *   headers */
+    uint16_t len;       /**< length of all walked headers */
+    uint8_t numof;      /**< number of walked headers */
+    uint8_t nh;         /**< protocol number of the header after the walked
+                         *   ones */
+} gnrc_ipv6_ext_walk_t;
+
+/**
+ * @brief   Option handler callback
+ *
+ * @param[in] pkt   The packet, its first snip starting with the extension
+ *                  headers.
+ * @param[in] ext   Protocol number of the header containing the option
+ *                  (@ref PROTNUM_IPV6_EXT_HOPOPT or
+ *                  @ref PROTNUM_IPV6_EXT_DST).
+ * @param[in] opt   The option. Its data is within the bounds of @p pkt.
+ *
+ * @return  0, to continue with the packet.
+ * @return  negative errno, to drop the packet.
+ */
+typedef int (*gnrc_ipv6_ext_opt_cb_t)(gnrc_pktsnip_t *pkt, uint8_t ext,
+                                      const ipv6_ext_opt_t *opt);
+
+/**
+ * @brief   Option handler
+ */
+typedef struct gnrc_ipv6_ext_opt_handler {
+    struct gnrc_ipv6_ext_opt_handler *next; /**< next handler (internal) */
+    gnrc_ipv6_ext_opt_cb_t cb;              /**< the callback */
+    uint8_t type;                           /**< option type to handle */
+} gnrc_ipv6_ext_opt_handler_t;
+
+/**
+ * @brief   Static initializer for gnrc_ipv6_ext_opt_handler_t
+ *
+ * @param[in] type  Option type.
+ * @param[in] cb    Callback.
+ */
+#define GNRC_IPV6_EXT_OPT_HANDLER_INIT(type, cb)    { NULL, (cb), (type) }
+
 /**
  * @brief   Demultiplex extension headers according to @p nh.
  *
@@ -62,6 +131,50 @@ void gnrc_ipv6_ext_demux(kernel_pid_t iface,
                          gnrc_pktsnip_t *pkt,
                          uint8_t nh);
 
+/**
+ * @brief   Walks the extension headers at the start of a snip
+ *
+ * Validates the length of all headers and the options of hop-by-hop and
+ * destination options headers and calls the registered option handlers,
+ * without changing the packet. Stops at the first header that is not an
+ * extension header, at a fragment header that is not an atomic fragment
+ * (with module `gnrc_ipv6_ext_frag`), at a routing header with segments left
+ * (with module `gnrc_rpl_srh`), or after @ref GNRC_IPV6_EXT_WALK_NUMOF
+ * headers.
+ *
+ * @param[out] walk The walked headers.
+ * @param[in] pkt   A packet, its first snip starting with an extension
+ *                  header.
+ * @param[in] nh    Protocol number of the first header.
+ *
+ * @return  0 on success.
+ * @return  -EBADMSG, if a header or option exceeds the snip, or a
+ *          hop-by-hop options header is not the first header.
+ * @return  -ENOTSUP, for an encapsulating security payload header.
+ * @return  negative errno of an option handler, that requested to drop the
+ *          packet.
+ */
+int gnrc_ipv6_ext_walk(gnrc_ipv6_ext_walk_t *walk, gnrc_pktsnip_t *pkt,
+                       uint8_t nh);
+
+/**
+ * @brief   Registers an option handler
+ *
+ * Handlers are called by gnrc_ipv6_ext_walk() for each option of their
+ * type. Only the first handler registered for a type is called.
+ *
+ * @param[in] handler   An initialized handler, must stay valid until
+ *                      unregistered.
+ */
+void gnrc_ipv6_ext_opt_register(gnrc_ipv6_ext_opt_handler_t *handler);
+
+/**
+ * @brief   Unregisters an option handler
+ *
+ * @param[in] handler   A registered handler.
+ */
+void gnrc_ipv6_ext_opt_unregister(gnrc_ipv6_ext_opt_handler_t *handler);
+
 /**
  * @brief   Builds an extension header for sending.
  *
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_ipv6_ext_frag Support for IPv6 fragmentation extension
+ * @ingroup     net_gnrc_ipv6_ext
+ * @brief       GNRC implementation of IPv6 fragmentation extension
+ *
+ * Packets exceeding the MTU of a non-6LoWPAN interface are split into
+ * fragments on sending. Received fragments are reassembled in a reassembly
+ * buffer of @ref GNRC_IPV6_EXT_FRAG_RBUF_SIZE entries. The reassembled
+ * datagram is kept in a single snip in the packet buffer that grows with the
+ * received fragments, up to @ref GNRC_IPV6_EXT_FRAG_MAX_SIZE bytes. While
+ * growing, the old and the new buffer and the received fragment occupy the
+ * packet buffer at the same time, so choose @ref GNRC_PKTBUF_SIZE
+ * accordingly.
+ * Incomplete datagrams are dropped @ref GNRC_IPV6_EXT_FRAG_RBUF_TIMEOUT
+ * after their first fragment arrived, or when a new datagram needs the
+ * entry. A timer sends a @ref GNRC_IPV6_EXT_FRAG_RBUF_GC message to the
+ * thread that received the fragment when the oldest datagram times out. Datagrams with overlapping fragments are dropped as required by
+ * [RFC 5722](https://tools.ietf.org/html/rfc5722), exact duplicates of
+ * fragments are ignored.
+ *
+ * @{
+ *
+ * @file
+ * @brief       GNRC IPv6 fragmentation definitions
+ */
+#ifndef NET_GNRC_IPV6_EXT_FRAG_H
+#define NET_GNRC_IPV6_EXT_FRAG_H
+
+#include <stdint.h>
+
+#include "net/gnrc/pkt.h"
+#include "net/ipv6/ext/frag.h"
+#include "timex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of datagrams that can be reassembled at the same time
+ */
+#ifndef GNRC_IPV6_EXT_FRAG_RBUF_SIZE
+#define GNRC_IPV6_EXT_FRAG_RBUF_SIZE        (2U)
+#endif
+
+/**
+ * @brief   Number of fragments that can be stored over all datagrams in
+ *          the reassembly buffer
+ */
+#ifndef GNRC_IPV6_EXT_FRAG_LIMITS_POOL_SIZE
+#define GNRC_IPV6_EXT_FRAG_LIMITS_POOL_SIZE (GNRC_IPV6_EXT_FRAG_RBUF_SIZE * 8U)
+#endif
+
+/**
+ * @brief   Maximum size of a reassembled datagram (without IPv6 header)
+ */
+#ifndef GNRC_IPV6_EXT_FRAG_MAX_SIZE
+#define GNRC_IPV6_EXT_FRAG_MAX_SIZE         (4096U)
+#endif
+
+/**
+ * @brief   Timeout for reassembly in microseconds
+ *
+ * RFC 8200 suggests 60 seconds, which is way too long to keep the packet
+ * buffer occupied on a constrained node.
+ */
+#ifndef GNRC_IPV6_EXT_FRAG_RBUF_TIMEOUT
+#define GNRC_IPV6_EXT_FRAG_RBUF_TIMEOUT     (10U * US_PER_SEC)
+#endif
+
+/**
+ * @brief   Message type for reassembly buffer garbage collection
+ *
+ * Call gnrc_ipv6_ext_frag_rbuf_gc() on reception.
+ */
+#define GNRC_IPV6_EXT_FRAG_RBUF_GC          (0x0226)
+
+/**
+ * @brief   Fragmentation state of a packet to send
+ */
+typedef struct {
+    gnrc_pktsnip_t *pkt;    /**< the packet to fragment, starting with its
+                             *   netif header, NULL when done */
+    uint32_t id;            /**< identification of the fragments */
+    uint16_t mtu;           /**< MTU of the interface */
+    uint16_t offset;        /**< offset of the next fragment */
+    uint16_t unfrag_len;    /**< length of the IPv6 header and the
+                             *   unfragmentable extension headers */
+    uint16_t frag_len;      /**< length of the fragmentable part */
+    uint16_t nh_pos;        /**< offset of the next header field pointing
+                             *   to the fragmentable part */
+    uint8_t nh;             /**< first header of the fragmentable part */
+} gnrc_ipv6_ext_frag_send_t;
+
+/**
+ * @brief   Prepares fragmentation of a packet
+ *
+ * @param[out] state    Fragmentation state.
+ * @param[in] pkt       An IPv6 packet, starting with its netif header.
+ * @param[in] mtu       MTU of the interface the packet is sent over.
+ *
+ * @return  0 on success. Get the fragments with gnrc_ipv6_ext_frag_next().
+ * @return  -EMSGSIZE, if the unfragmentable part does not fit into @p mtu.
+ *          @p pkt is released in that case.
+ */
+int gnrc_ipv6_ext_frag_init(gnrc_ipv6_ext_frag_send_t *state,
+                            gnrc_pktsnip_t *pkt, uint16_t mtu);
+
+/**
+ * @brief   Builds the next fragment of a packet
+ *
+ * Each fragment is allocated separately in the packet buffer, so only the
+ * fragments not sent yet and the original packet occupy it at the same time.
+ * The original packet is released with the last fragment.
+ *
+ * @param[in,out] state Fragmentation state, initialized with
+ *                      gnrc_ipv6_ext_frag_init().
+ *
+ * @return  The next fragment, starting with a copy of the netif header.
+ * @return  NULL, when all fragments were built or the packet buffer is full.
+ *          The original packet is released in both cases.
+ */
+gnrc_pktsnip_t *gnrc_ipv6_ext_frag_next(gnrc_ipv6_ext_frag_send_t *state);
+
+/**
+ * @brief   Adds a received fragment to the reassembly buffer
+ *
+ * @param[in] pkt   A received fragment. The first snip must start with the
+ *                  fragment header, the IPv6 header and netif header must be
+ *                  marked. @p pkt is released.
+ *
+ * @return  The reassembled datagram, when @p pkt completed it. The first
+ *          snip holds the payload and is followed by an IPv6 header with the
+ *          next header of the fragmentable part and the netif header of
+ *          @p pkt.
+ * @return  NULL, when the datagram is not complete yet or @p pkt is
+ *          invalid.
+ */
+gnrc_pktsnip_t *gnrc_ipv6_ext_frag_reass(gnrc_pktsnip_t *pkt);
+
+/**
+ * @brief   Drops all incomplete datagrams from the reassembly buffer
+ */
+void gnrc_ipv6_ext_frag_rbuf_reset(void);
+
+/**
+ * @brief   Drops timed out datagrams from the reassembly buffer
+ *
+ * Rearms the timer for the next datagram to time out.
+ */
+void gnrc_ipv6_ext_frag_rbuf_gc(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_IPV6_EXT_FRAG_H */
+/** @} */
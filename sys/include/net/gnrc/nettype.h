@@ -79,6 +79,13 @@ typedef enum {
 #endif
 #ifdef MODULE_GNRC_ICMPV6
     GNRC_NETTYPE_ICMPV6,        /**< Protocol is ICMPv6 */
+#endif
+#ifdef MODULE_GNRC_IPV4
+    GNRC_NETTYPE_IPV4,          /**< Protocol is IPv4 */
+    GNRC_NETTYPE_ICMP,          /**< Protocol is ICMP (for IPv4) */
+#endif
+#ifdef MODULE_GNRC_IPV4_ARP
+    GNRC_NETTYPE_ARP,           /**< Protocol is ARP */
 #endif
     /**
      * @}
@@ -136,6 +143,14 @@ static inline gnrc_nettype_t gnrc_nettype_from_ethertype(uint16_t type)
         case ETHERTYPE_IPV6:
             return GNRC_NETTYPE_IPV6;
 #endif
+#ifdef MODULE_GNRC_IPV4
+        case ETHERTYPE_IPV4:
+            return GNRC_NETTYPE_IPV4;
+#endif
+#ifdef MODULE_GNRC_IPV4_ARP
+        case ETHERTYPE_ARP:
+            return GNRC_NETTYPE_ARP;
+#endif
 #ifdef MODULE_CCN_LITE
         case ETHERTYPE_NDN:
             return GNRC_NETTYPE_CCN;
@@ -163,6 +178,14 @@ static inline uint16_t gnrc_nettype_to_ethertype(gnrc_nettype_t type)
         case GNRC_NETTYPE_IPV6:
             return ETHERTYPE_IPV6;
 #endif
+#ifdef MODULE_GNRC_IPV4
+        case GNRC_NETTYPE_IPV4:
+            return ETHERTYPE_IPV4;
+#endif
+#ifdef MODULE_GNRC_IPV4_ARP
+        case GNRC_NETTYPE_ARP:
+            return ETHERTYPE_ARP;
+#endif
 #ifdef MODULE_CCN_LITE
         case GNRC_NETTYPE_CCN:
             return ETHERTYPE_NDN;
@@ -194,6 +217,12 @@ static inline gnrc_nettype_t gnrc_nettype_from_protnum(uint8_t num)
         case PROTNUM_IPV6:
             return GNRC_NETTYPE_IPV6;
 #endif
+#ifdef MODULE_GNRC_IPV4
+        case PROTNUM_ICMP:
+            return GNRC_NETTYPE_ICMP;
+        case PROTNUM_IPV4:
+            return GNRC_NETTYPE_IPV4;
+#endif
 #ifdef MODULE_GNRC_TCP
         case PROTNUM_TCP:
             return GNRC_NETTYPE_TCP;
@@ -239,6 +268,12 @@ static inline uint8_t gnrc_nettype_to_protnum(gnrc_nettype_t type)
         case GNRC_NETTYPE_IPV6:
             return PROTNUM_IPV6;
 #endif
+#ifdef MODULE_GNRC_IPV4
+        case GNRC_NETTYPE_ICMP:
+            return PROTNUM_ICMP;
+        case GNRC_NETTYPE_IPV4:
+            return PROTNUM_IPV4;
+#endif
 #ifdef MODULE_GNRC_TCP
         case GNRC_NETTYPE_TCP:
             return PROTNUM_TCP;
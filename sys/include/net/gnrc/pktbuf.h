@@ -284,6 +284,30 @@ gnrc_pktsnip_t *gnrc_pktbuf_duplicate_upto(gnrc_pktsnip_t *pkt, gnrc_nettype_t t
  * @details Statistics include maximum number of reserved bytes.
  */
 void gnrc_pktbuf_stats(void);
+
+/**
+ * @brief   Gets the number of bytes currently allocated in the packet buffer
+ *          and the highest number of bytes allocated at once.
+ *
+ * @note    Only available with DEVELHELP defined.
+ *
+ * @details Both include the snips and the alignment of all allocations.
+ *
+ * @param[out] max_used The highest number of bytes allocated at once since
+ *                      the last call of gnrc_pktbuf_reset_max_used().
+ *                      May be NULL.
+ *
+ * @return  The number of bytes currently allocated.
+ */
+size_t gnrc_pktbuf_get_used(size_t *max_used);
+
+/**
+ * @brief   Resets the high-water mark of gnrc_pktbuf_get_used() to the
+ *          number of bytes currently allocated.
+ *
+ * @note    Only available with DEVELHELP defined.
+ */
+void gnrc_pktbuf_reset_max_used(void);
 #endif
 
 /* for testing */
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_pktfilter  GNRC packet filter
+ * @ingroup     net_gnrc
+ * @brief       Packet filter applied to all received packets
+ *
+ * With the `gnrc_pktfilter` module, @ref gnrc_pktfilter is evaluated for
+ * every packet received by the Ethernet and IEEE 802.15.4 netdev adapters
+ * (link layer source and destination address) and by the IPv6 layer (IPv6
+ * addresses, next header and, for UDP and TCP packets without extension
+ * headers, destination port).
+ *
+ * @{
+ *
+ * @file
+ * @brief       GNRC packet filter definitions
+ */
+#ifndef NET_GNRC_PKTFILTER_H
+#define NET_GNRC_PKTFILTER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "net/ipv6/hdr.h"
+#include "net/pktfilter.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of rules of @ref gnrc_pktfilter
+ */
+#ifndef GNRC_PKTFILTER_RULES
+#define GNRC_PKTFILTER_RULES        (16U)
+#endif
+
+/**
+ * @brief   Size of the hash table of @ref gnrc_pktfilter, power of 2
+ */
+#ifndef GNRC_PKTFILTER_TABLE_SIZE
+#define GNRC_PKTFILTER_TABLE_SIZE   (32U)
+#endif
+
+/**
+ * @brief   The packet filter applied to received packets
+ */
+extern pktfilter_t gnrc_pktfilter;
+
+/**
+ * @brief   Evaluate @ref gnrc_pktfilter for a received link layer frame
+ *
+ * @param[in] src       source address
+ * @param[in] src_len   length of @p src
+ * @param[in] dst       destination address, may be NULL
+ * @param[in] dst_len   length of @p dst
+ *
+ * @return  true if the frame passes
+ */
+static inline bool gnrc_pktfilter_l2(const uint8_t *src, size_t src_len,
+                                     const uint8_t *dst, size_t dst_len)
+{
+    pktfilter_pkt_t pkt = {
+        .l2_src = src, .l2_src_len = src_len,
+        .l2_dst = dst, .l2_dst_len = dst_len,
+        .proto = PKTFILTER_PROTO_ANY, .port = PKTFILTER_PORT_ANY,
+    };
+
+    return pktfilter_pass(&gnrc_pktfilter, &pkt);
+}
+
+/**
+ * @brief   Evaluate @ref gnrc_pktfilter for a received IPv6 packet
+ *
+ * @param[in] hdr       IPv6 header, followed by the payload
+ * @param[in] len       length of @p hdr including the payload available
+ *
+ * @return  true if the packet passes
+ */
+bool gnrc_pktfilter_ipv6(const ipv6_hdr_t *hdr, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_PKTFILTER_H */
+/** @} */
@@ -26,35 +26,183 @@
 #include <stdint.h>
 
 #include "priority_queue.h"
+#include "priority_heap.h"
 #include "net/gnrc/pkt.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#if defined(MODULE_GNRC_PRIORITY_PKTQUEUE_HEAP) && \
+    defined(MODULE_GNRC_PRIORITY_PKTQUEUE_DRR)
+#error "gnrc_priority_pktqueue_heap and gnrc_priority_pktqueue_drr are exclusive"
+#endif
+
+#if defined(MODULE_GNRC_PRIORITY_PKTQUEUE_HEAP) || defined(DOXYGEN)
 /**
  * @brief data type for gnrc priority packet queue nodes
+ *
+ * With the `gnrc_priority_pktqueue_heap` module the queue is a binary heap
+ * (see @ref priority_heap.h) instead of a sorted list, which keeps adding and
+ * removing packets O(log n) for long queues.
  */
 typedef struct gnrc_priority_pktqueue_node {
-    struct gnrc_priority_pktqueue_node *next;   /**< next queue node */
-    uint32_t priority;                          /**< queue node priority */
+    priority_heap_node_t node;                  /**< heap node, holds the
+                                                 *   priority */
     gnrc_pktsnip_t *pkt;                        /**< queue node data */
 } gnrc_priority_pktqueue_node_t;
 
 /**
  * @brief data type for gnrc priority packet queues
  */
-typedef priority_queue_t gnrc_priority_pktqueue_t;
+typedef priority_heap_t gnrc_priority_pktqueue_t;
+
+/**
+ * @brief Static initializer for gnrc_priority_pktqueue_node_t.
+ */
+#define PRIORITY_PKTQUEUE_NODE_INIT(priority, pkt) \
+    { { NULL, NULL, NULL, priority, 0 }, pkt }
+
+/**
+ * @brief Static initializer for gnrc_priority_pktqueue_t.
+ */
+#define PRIORITY_PKTQUEUE_INIT PRIORITY_HEAP_INIT
+#else
+/**
+ * @brief data type for gnrc priority packet queue nodes
+ */
+typedef struct gnrc_priority_pktqueue_node {
+    struct gnrc_priority_pktqueue_node *next;   /**< next queue node */
+    uint32_t priority;                          /**< queue node priority */
+    gnrc_pktsnip_t *pkt;                        /**< queue node data */
+} gnrc_priority_pktqueue_node_t;
 
 /**
  * @brief Static initializer for gnrc_priority_pktqueue_node_t.
  */
 #define PRIORITY_PKTQUEUE_NODE_INIT(priority, pkt) { NULL, priority, pkt }
 
+#ifdef MODULE_GNRC_PRIORITY_PKTQUEUE_DRR
+/**
+ * @name    Deficit round robin queueing
+ *
+ * With the `gnrc_priority_pktqueue_drr` module the priority of a node selects
+ * a traffic class instead of a position in the queue. Each class is a FIFO
+ * with optional packet and byte limits. Packets of
+ * @ref GNRC_PRIORITY_PKTQUEUE_CLASS_CONTROL are always sent first. All other
+ * classes are served by deficit round robin: per round, a class may send up
+ * to its quantum in bytes, so none of them can starve the others. Priorities
+ * beyond the last class are put into the last class.
+ * @{
+ */
+/**
+ * @brief   Number of traffic classes, including the control class
+ */
+#ifndef GNRC_PRIORITY_PKTQUEUE_CLASSES
+#define GNRC_PRIORITY_PKTQUEUE_CLASSES      (4U)
+#endif
+
+/**
+ * @brief   Default quantum of the last class in bytes
+ *
+ * The default quantum doubles with each class towards class 1, i.e. lower
+ * priority values get a larger share of the link.
+ */
+#ifndef GNRC_PRIORITY_PKTQUEUE_QUANTUM
+#define GNRC_PRIORITY_PKTQUEUE_QUANTUM      (128U)
+#endif
+
+/**
+ * @brief   Class of control traffic, see gnrc_priority_pktqueue_classify()
+ *
+ * This class is served before all others and has no quantum. Limit it with
+ * gnrc_priority_pktqueue_set_class() if its traffic is not trusted.
+ */
+#define GNRC_PRIORITY_PKTQUEUE_CLASS_CONTROL    (0U)
+
+/**
+ * @brief   Configuration of a traffic class, shared by all queues
+ */
+typedef struct {
+    uint16_t quantum;               /**< bytes per round, 0 for the default */
+    uint16_t max_pkts;              /**< packets per queue, 0 for no limit */
+    uint16_t max_bytes;             /**< bytes per queue, 0 for no limit */
+} gnrc_priority_pktqueue_class_conf_t;
+
+/**
+ * @brief   State of a traffic class within a queue
+ */
+typedef struct {
+    gnrc_priority_pktqueue_node_t *first;   /**< oldest packet of the class */
+    gnrc_priority_pktqueue_node_t *last;    /**< newest packet of the class */
+    uint32_t deficit;                       /**< bytes the class may still send */
+    uint16_t bytes;                         /**< bytes queued */
+    uint16_t pkts;                          /**< packets queued */
+} gnrc_priority_pktqueue_class_t;
+
+/**
+ * @brief data type for gnrc priority packet queues
+ */
+typedef struct {
+    /**
+     * @brief   traffic classes
+     */
+    gnrc_priority_pktqueue_class_t classes[GNRC_PRIORITY_PKTQUEUE_CLASSES];
+    uint8_t current;                /**< class in service */
+    uint8_t granted;                /**< current class got its quantum */
+} gnrc_priority_pktqueue_t;
+
+/**
+ * @brief Static initializer for gnrc_priority_pktqueue_t.
+ */
+#define PRIORITY_PKTQUEUE_INIT { { { NULL, NULL, 0, 0, 0 } }, 0, 0 }
+
+/**
+ * @brief   Configures a traffic class for all queues
+ *
+ * @pre     No queue holds packets of @p cls
+ *
+ * @param[in] cls   the traffic class, must be smaller than
+ *                  @ref GNRC_PRIORITY_PKTQUEUE_CLASSES
+ * @param[in] conf  the configuration, must not be NULL
+ */
+void gnrc_priority_pktqueue_set_class(unsigned cls,
+                                      const gnrc_priority_pktqueue_class_conf_t *conf);
+
+/**
+ * @brief   Gets the traffic class for a packet to be queued
+ *
+ * ICMPv6 packets (e.g. RPL and neighbor discovery), ICMP and ARP packets go
+ * to @ref GNRC_PRIORITY_PKTQUEUE_CLASS_CONTROL. All other packets go to the
+ * classes after it, starting with class 1 for @p priority 0.
+ *
+ * Control traffic is recognized by its ICMPv6, ICMP or ARP snip. Link layer
+ * fragments, e.g. 6LoWPAN fragments, don't carry these snips anymore, so
+ * fragments of control traffic go to the class selected by @p priority.
+ * The same holds for received frames, which are not parsed before they are
+ * handed to the upper layer: the `gnrc_mac` RX queues use this function as
+ * well, so received packets never end up in the control class, but they all
+ * go to the class selected by @p priority.
+ *
+ * @param[in] pkt       the packet, must not be NULL
+ * @param[in] priority  the priority given by the MAC layer
+ *
+ * @return  the priority to use for the queue node of @p pkt
+ */
+uint32_t gnrc_priority_pktqueue_classify(gnrc_pktsnip_t *pkt, uint32_t priority);
+/** @} */
+#else
+/**
+ * @brief data type for gnrc priority packet queues
+ */
+typedef priority_queue_t gnrc_priority_pktqueue_t;
+
 /**
  * @brief Static initializer for gnrc_priority_pktqueue_t.
  */
 #define PRIORITY_PKTQUEUE_INIT { NULL }
+#endif
+#endif
 
 /**
  * @brief   Initialize a gnrc priority packet queue node object.
@@ -70,8 +218,13 @@ static inline void gnrc_priority_pktqueue_node_init(gnrc_priority_pktqueue_node_
                                                     uint32_t priority,
                                                     gnrc_pktsnip_t *pkt)
 {
+#ifdef MODULE_GNRC_PRIORITY_PKTQUEUE_HEAP
+    priority_heap_node_init(&node->node);
+    node->node.priority = priority;
+#else
     node->next = NULL;
     node->priority = priority;
+#endif
     node->pkt = pkt;
 }
 
@@ -127,9 +280,13 @@ gnrc_pktsnip_t *gnrc_priority_pktqueue_head(gnrc_priority_pktqueue_t *queue);
  *
  * @param[in,out]   queue   the gnrc priority packet queue, must not be NULL
  * @param[in]       node    the node to add.
+ *
+ * @return  0 on success
+ * @return  -ENOBUFS, if the class of @p node is full (only with the
+ *          `gnrc_priority_pktqueue_drr` module). @p node was not added then.
  */
-void gnrc_priority_pktqueue_push(gnrc_priority_pktqueue_t *queue,
-                                 gnrc_priority_pktqueue_node_t *node);
+int gnrc_priority_pktqueue_push(gnrc_priority_pktqueue_t *queue,
+                                gnrc_priority_pktqueue_node_t *node);
 
 #ifdef __cplusplus
 }
@@ -29,6 +29,27 @@
 extern "C" {
 #endif
 
+/**
+ * @name    ICMPv4 message types
+ * @see     <a href="https://www.iana.org/assignments/icmp-parameters/icmp-parameters.xhtml#icmp-parameters-types">
+ *              IANA, ICMP Type Numbers
+ *          </a>
+ * @{
+ */
+#define ICMP_ECHO_REP           (0)     /**< Echo reply */
+#define ICMP_DST_UNR            (3)     /**< Destination unreachable */
+#define ICMP_ECHO_REQ           (8)     /**< Echo request */
+#define ICMP_TIME_EXC           (11)    /**< Time exceeded */
+/** @} */
+
+/**
+ * @brief   General ICMPv4 message format.
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t type;           /**< message type */
+    uint8_t code;           /**< message code */
+    network_uint16_t csum;  /**< checksum */
+} icmp_hdr_t;
 
 /**
  * @brief   Echo request and response message format.
@@ -60,6 +60,9 @@ extern "C" {
 #define IEEE802154_FCF_ACK_REQ              (0x20)  /**< acknowledgement requested from receiver */
 #define IEEE802154_FCF_PAN_COMP             (0x40)  /**< compress source PAN ID */
 
+#define IEEE802154_FCF_SEQ_SUPPR            (0x01)  /**< no sequence number (2015 frames) */
+#define IEEE802154_FCF_IE_PRESENT           (0x02)  /**< information elements present (2015 frames) */
+
 #define IEEE802154_FCF_DST_ADDR_MASK        (0x0c)
 #define IEEE802154_FCF_DST_ADDR_VOID        (0x00)  /**< no destination address */
 #define IEEE802154_FCF_DST_ADDR_RESV        (0x04)  /**< reserved address mode */
@@ -69,6 +72,7 @@ extern "C" {
 #define IEEE802154_FCF_VERS_MASK            (0x30)
 #define IEEE802154_FCF_VERS_V0              (0x00)
 #define IEEE802154_FCF_VERS_V1              (0x10)
+#define IEEE802154_FCF_VERS_V2              (0x20)
 
 #define IEEE802154_FCF_SRC_ADDR_MASK        (0xc0)
 #define IEEE802154_FCF_SRC_ADDR_VOID        (0x00)  /**< no source address */
@@ -77,6 +81,64 @@ extern "C" {
 #define IEEE802154_FCF_SRC_ADDR_LONG        (0xc0)  /**< source address length is 8 */
 /** @} */
 
+/**
+ * @brief   Auxiliary security header and information element definitions
+ * @{
+ */
+#define IEEE802154_SCF_LEVEL_MASK           (0x07)  /**< security level */
+#define IEEE802154_SCF_KEYMODE_MASK         (0x18)  /**< key identifier mode */
+#define IEEE802154_SCF_KEYMODE_SHIFT        (3U)
+#define IEEE802154_SCF_FC_SUPPR             (0x20)  /**< no frame counter (2015 frames) */
+
+#define IEEE802154_IE_HT1                   (0x7e)  /**< header termination 1,
+                                                     *   payload IEs follow */
+#define IEEE802154_IE_HT2                   (0x7f)  /**< header termination 2,
+                                                     *   payload follows */
+/** @} */
+
+/**
+ * @brief   Flags of ieee802154_mhr_t::flags
+ * @{
+ */
+#define IEEE802154_MHR_SEQ                  (0x01)  /**< sequence number present */
+#define IEEE802154_MHR_SECURITY             (0x02)  /**< auxiliary security
+                                                     *   header present */
+#define IEEE802154_MHR_HDR_IE               (0x04)  /**< header IEs present */
+#define IEEE802154_MHR_PAYLOAD_IE           (0x08)  /**< payload IEs follow the
+                                                     *   header */
+/** @} */
+
+/**
+ * @brief   Decoded IEEE 802.15.4 MAC header
+ *
+ * Filled by ieee802154_parse_mhr(), so the header only needs to be decoded
+ * once per frame.
+ */
+typedef struct {
+    uint8_t fcf[IEEE802154_FCF_LEN];        /**< frame control field */
+    uint8_t flags;                          /**< IEEE802154_MHR_* flags */
+    uint8_t seq;                            /**< sequence number */
+    uint8_t hdr_len;                        /**< length of the whole MAC
+                                             *   header */
+    uint8_t dst_len;                        /**< length of ieee802154_mhr_t::dst */
+    uint8_t src_len;                        /**< length of ieee802154_mhr_t::src */
+    uint8_t sec_ctrl;                       /**< security control field */
+    le_uint16_t dst_pan;                    /**< destination PAN ID */
+    le_uint16_t src_pan;                    /**< source PAN ID, equals
+                                             *   ieee802154_mhr_t::dst_pan
+                                             *   if compressed */
+    uint8_t dst[IEEE802154_LONG_ADDRESS_LEN];   /**< destination address in
+                                                 *   network byte order */
+    uint8_t src[IEEE802154_LONG_ADDRESS_LEN];   /**< source address in
+                                                 *   network byte order */
+    uint32_t frame_cnt;                     /**< security frame counter */
+    uint8_t sec_offset;                     /**< offset of the auxiliary
+                                             *   security header */
+    uint8_t ie_offset;                      /**< offset of the header IEs */
+    uint8_t ie_len;                         /**< length of the header IEs
+                                             *   without termination */
+} ieee802154_mhr_t;
+
 /**
  * @brief   Channel ranges
  * @{
@@ -179,6 +241,24 @@ size_t ieee802154_set_frame_hdr(uint8_t *buf, const uint8_t *src, size_t src_len
                                 le_uint16_t src_pan, le_uint16_t dst_pan,
                                 uint8_t flags, uint8_t seq);
 
+/**
+ * @brief   Decodes a MAC header in a single pass.
+ *
+ * Supports frame versions 2003, 2006 and 2015, including PAN ID compression
+ * of 2015 frames, the auxiliary security header and header information
+ * elements.
+ *
+ * @see IEEE Std 802.15.4-2015, 7.2 General MAC frame format.
+ *
+ * @param[in] buf       The frame.
+ * @param[in] len       Length of @p buf.
+ * @param[out] mhr      The decoded header.
+ *
+ * @return  Length of the MAC header on success.
+ * @return  -EINVAL, if @p buf is not a valid frame.
+ */
+int ieee802154_parse_mhr(const uint8_t *buf, size_t len, ieee802154_mhr_t *mhr);
+
 /**
  * @brief   Get length of MAC header.
  *
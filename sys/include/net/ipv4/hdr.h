@@ -21,10 +21,20 @@
 #define NET_IPV4_HDR_H
 
 #include "byteorder.h"
+#include "net/inet_csum.h"
 #include "net/ipv4/addr.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
+/**
+ * @name    Flags as returned by ipv4_hdr_get_flags()
+ * @{
+ */
+#define IPV4_HDR_FLAG_DF        (0x02)  /**< don't fragment */
+#define IPV4_HDR_FLAG_MF        (0x01)  /**< more fragments */
+/** @} */
+
 /**
  * @brief Data type to represent an IPv4 packet header.
  *
@@ -92,7 +102,7 @@ typedef struct __attribute__((packed)) {
 
 
 /**
- * @brief   Sets the version field of @p hdr to 6
+ * @brief   Sets the version field of @p hdr to 4
  *
  * @param[out] hdr  Pointer to an IPv4 header.
  */
@@ -123,7 +133,7 @@ static inline uint8_t ipv4_hdr_get_version(ipv4_hdr_t *hdr)
 static inline void ipv4_hdr_set_ihl(ipv4_hdr_t *hdr, uint16_t ihl)
 {
     hdr->v_ih &= 0xf0;
-    hdr->v_ih |= 0x0f & (ihl >> 5);
+    hdr->v_ih |= 0x0f & (ihl >> 2);
 }
 
 /**
@@ -135,7 +145,7 @@ static inline void ipv4_hdr_set_ihl(ipv4_hdr_t *hdr, uint16_t ihl)
  */
 static inline uint16_t ipv4_hdr_get_ihl(ipv4_hdr_t *hdr)
 {
-    return (hdr->v_ih & 0x0f) << 5;
+    return (hdr->v_ih & 0x0f) << 2;
 }
 
 /**
@@ -187,6 +197,33 @@ static inline uint16_t ipv4_hdr_get_fo(ipv4_hdr_t *hdr)
     return (((hdr->fl_fo.u8[0] & 0x1f) << 8) + hdr->fl_fo.u8[1]);
 }
 
+/**
+ * @brief   Calculates the Internet Checksum for the IPv4 Pseudo Header.
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc768">
+ *          RFC 768
+ *      </a>
+ *
+ * @param[in] sum       Preinialized value of the sum.
+ * @param[in] hdr       An IPv4 header to derive the Pseudo Header from.
+ * @param[in] prot_num  The @ref net_protnum you want to calculate the
+ *                      checksum for.
+ * @param[in] len       The upper-layer packet length for the pseudo header.
+ *
+ * @return  The non-normalized Internet Checksum of the given IPv4 pseudo header.
+ */
+static inline uint16_t ipv4_hdr_inet_csum(uint16_t sum, ipv4_hdr_t *hdr,
+                                          uint8_t prot_num, uint16_t len)
+{
+    if ((sum + len + prot_num) > 0xffff) {
+        /* increment by one for overflow to keep it as 1's complement sum */
+        sum++;
+    }
+
+    return inet_csum(sum + len + prot_num, hdr->src.u8,
+                     (2 * sizeof(ipv4_addr_t)));
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_ipv6_ext_opt IPv6 options
+ * @ingroup     net_ipv6_ext
+ * @brief       Options of the hop-by-hop and destination options headers
+ * @see <a href="https://tools.ietf.org/html/rfc8200#section-4.2">
+ *          RFC 8200, section 4.2
+ *      </a>
+ * @{
+ *
+ * @file
+ * @brief   IPv6 option definitions
+ */
+#ifndef NET_IPV6_EXT_OPT_H
+#define NET_IPV6_EXT_OPT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    Option types
+ * @{
+ */
+#define IPV6_EXT_OPT_PAD1       (0x00U) /**< Pad1 (single byte, no length) */
+#define IPV6_EXT_OPT_PADN       (0x01U) /**< PadN */
+#define IPV6_EXT_OPT_RPL        (0x63U) /**< RPL option (RFC 6553) */
+/** @} */
+
+/**
+ * @name    Action for unrecognized options, encoded in the highest two bits
+ *          of the option type
+ * @{
+ */
+#define IPV6_EXT_OPT_ACTION_MASK        (0xc0U)
+#define IPV6_EXT_OPT_ACTION_SKIP        (0x00U) /**< skip the option */
+#define IPV6_EXT_OPT_ACTION_DISCARD     (0x40U) /**< discard the packet */
+#define IPV6_EXT_OPT_ACTION_DISCARD_ERR (0x80U) /**< discard the packet and
+                                                 *   send ICMPv6 parameter
+                                                 *   problem */
+#define IPV6_EXT_OPT_ACTION_DISCARD_ERR_UCAST (0xc0U)  /**< as
+                                                 *   @ref IPV6_EXT_OPT_ACTION_DISCARD_ERR,
+                                                 *   but only send ICMPv6 for
+                                                 *   non-multicast destinations */
+/** @} */
+
+/**
+ * @brief   Option header (all but @ref IPV6_EXT_OPT_PAD1)
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t type;   /**< option type */
+    uint8_t len;    /**< length of the option data in byte */
+} ipv6_ext_opt_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_IPV6_EXT_OPT_H */
+/** @} */
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_lora    LoRa
+ * @ingroup     net
+ * @brief       LoRa time on air and regional duty cycle accounting
+ *
+ * The time on air of a LoRa frame follows the formula of the SX1272/SX1276
+ * data sheets (section 4.1.1.7), computed in integer microseconds.
+ *
+ * Regional regulations like ETSI EN 300 220 limit the share of time a device
+ * may transmit within a sub-band. The duty cycle accounting keeps one state
+ * per sub-band of a band table: a transmission of @f$T_{air}@f$ in a sub-band
+ * with duty cycle @f$d@f$ closes that sub-band until @f$T_{air} / d@f$ after
+ * the start of the transmission, as done for the LoRaWAN EU868 region.
+ * Frequencies outside all sub-bands of the table are not limited.
+ *
+ * @{
+ *
+ * @file
+ * @brief       LoRa time on air and duty cycle definitions
+ */
+
+#ifndef NET_LORA_H
+#define NET_LORA_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    Flags for lora_modulation_t::flags
+ * @{
+ */
+#define LORA_FLAG_CRC               (0x01)  /**< payload CRC enabled */
+#define LORA_FLAG_IMPLICIT_HEADER   (0x02)  /**< implicit header mode */
+#define LORA_FLAG_LOW_DATARATE_OPT  (0x04)  /**< low data rate optimization */
+/** @} */
+
+/**
+ * @brief   Maximal number of sub-bands of a band table
+ */
+#ifndef LORA_DUTY_BANDS_MAX
+#define LORA_DUTY_BANDS_MAX         (6U)
+#endif
+
+/**
+ * @brief   Number of sub-bands in @ref lora_duty_bands_eu868
+ */
+#define LORA_DUTY_BANDS_EU868_NUMOF (6U)
+
+/**
+ * @brief   LoRa modulation parameters
+ */
+typedef struct {
+    uint16_t bandwidth;             /**< bandwidth in kHz (125, 250 or 500) */
+    uint16_t preamble_len;          /**< programmed preamble length in symbols */
+    uint8_t sf;                     /**< spreading factor (6 to 12) */
+    uint8_t cr;                     /**< coding rate 4/(4 + cr) (1 to 4) */
+    uint8_t flags;                  /**< LORA_FLAG_* */
+} lora_modulation_t;
+
+/**
+ * @brief   Sub-band with a duty cycle limit
+ */
+typedef struct {
+    uint32_t min_freq;              /**< lowest channel frequency in Hz */
+    uint32_t max_freq;              /**< highest channel frequency in Hz */
+    uint16_t duty;                  /**< duty cycle in 1/1000 */
+} lora_duty_band_t;
+
+/**
+ * @brief   Duty cycle accounting state
+ */
+typedef struct {
+    const lora_duty_band_t *bands;      /**< band table */
+    unsigned numof;                     /**< number of sub-bands in @p bands */
+    uint64_t ready[LORA_DUTY_BANDS_MAX];    /**< time (in us) from which on
+                                             *   each sub-band may be used
+                                             *   again */
+} lora_duty_t;
+
+/**
+ * @brief   Sub-bands of the 863 to 870 MHz band as used by LoRaWAN EU868
+ *
+ * 863.0 - 865.0 MHz: 0.1 %, 865.0 - 868.0 MHz: 1 %, 868.0 - 868.6 MHz: 1 %,
+ * 868.7 - 869.2 MHz: 0.1 %, 869.4 - 869.65 MHz: 10 %, 869.7 - 870.0 MHz: 1 %
+ */
+extern const lora_duty_band_t lora_duty_bands_eu868[LORA_DUTY_BANDS_EU868_NUMOF];
+
+/**
+ * @brief   Computes the duration of a symbol
+ *
+ * @param[in] mod       modulation parameters
+ *
+ * @return  symbol duration in us
+ */
+uint32_t lora_symbol_time(const lora_modulation_t *mod);
+
+/**
+ * @brief   Computes the time on air of a frame
+ *
+ * @param[in] mod           modulation parameters
+ * @param[in] payload_len   payload length in bytes
+ *
+ * @return  time on air in us, including the preamble
+ */
+uint32_t lora_time_on_air(const lora_modulation_t *mod, uint8_t payload_len);
+
+/**
+ * @brief   Initializes the duty cycle accounting with all sub-bands open
+ *
+ * @pre     @p numof <= @ref LORA_DUTY_BANDS_MAX
+ *
+ * @param[out] duty     duty cycle accounting state
+ * @param[in] bands     band table, sub-bands must not overlap
+ * @param[in] numof     number of sub-bands in @p bands
+ */
+void lora_duty_init(lora_duty_t *duty, const lora_duty_band_t *bands,
+                    unsigned numof);
+
+/**
+ * @brief   Gets the time until a transmission on a channel is allowed
+ *
+ * @param[in] duty      duty cycle accounting state
+ * @param[in] freq      channel frequency in Hz
+ * @param[in] now       current time in us
+ *
+ * @return  time to wait in us, 0 if a transmission is allowed now
+ */
+uint64_t lora_duty_wait(const lora_duty_t *duty, uint32_t freq, uint64_t now);
+
+/**
+ * @brief   Accounts a transmission
+ *
+ * @param[in,out] duty      duty cycle accounting state
+ * @param[in] freq          channel frequency in Hz
+ * @param[in] now           start of the transmission in us
+ * @param[in] time_on_air   time on air of the transmission in us
+ */
+void lora_duty_account(lora_duty_t *duty, uint32_t freq, uint64_t now,
+                       uint32_t time_on_air);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_LORA_H */
+/** @} */
@@ -342,6 +342,17 @@ typedef enum {
      */
     NETOPT_IQ_INVERT,
 
+    /**
+     * @brief   Enable/disable computing and checking transport layer
+     *          checksums in the device
+     *
+     * If enabled, the device fills in the checksum of outgoing datagrams
+     * that have the checksum field set to zero and fails to receive
+     * datagrams with a wrong checksum. Which protocols are covered depends
+     * on the device.
+     */
+    NETOPT_CHECKSUM_OFFLOAD,
+
     /* add more options if needed */
 
     /**
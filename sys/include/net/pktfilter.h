@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_pktfilter   Packet filter
+ * @ingroup     net
+ * @brief       Rule based packet filter for link layer and IPv6 addresses
+ *
+ * Unlike @ref net_l2filter and the IPv6 black- and whitelists, which scan
+ * their address lists linearly for every packet, the rules of a packet
+ * filter are kept in a hash table. Every rule matches an address prefix of
+ * one address field (link layer or IPv6, source or destination), optionally
+ * combined with a protocol (IPv6 next header) and destination port.
+ *
+ * A lookup probes the hash table once per prefix length used by any rule of
+ * the address field, from the longest to the shortest, so exact matches
+ * (full length prefixes) cost a single hash lookup independent of the number
+ * of rules, and prefixes are matched longest first. If rules for the source
+ * and the destination address match, the rule added first wins.
+ *
+ * The memory for rules and hash table is provided by the user. Adding,
+ * removing and evaluating rules is serialized by a mutex of the filter, so a
+ * filter can be shared by several threads, but not used in interrupt context.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Packet filter definitions
+ */
+
+#ifndef NET_PKTFILTER_H
+#define NET_PKTFILTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+
+#include "mutex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximal length of addresses in bytes
+ */
+#define PKTFILTER_ADDR_MAXLEN       (16U)
+
+/**
+ * @brief   Value for pktfilter_rule_t::proto matching any protocol
+ */
+#define PKTFILTER_PROTO_ANY         (0xffU)
+
+/**
+ * @brief   Value for pktfilter_rule_t::port matching any port
+ */
+#define PKTFILTER_PORT_ANY          (0U)
+
+/**
+ * @brief   Address fields a rule can match
+ */
+typedef enum {
+    PKTFILTER_L2_SRC = 0,           /**< link layer source address */
+    PKTFILTER_L2_DST,               /**< link layer destination address */
+    PKTFILTER_IPV6_SRC,             /**< IPv6 source address */
+    PKTFILTER_IPV6_DST,             /**< IPv6 destination address */
+    PKTFILTER_FIELD_NUMOF,          /**< number of address fields */
+} pktfilter_field_t;
+
+/**
+ * @brief   Rule actions
+ */
+typedef enum {
+    PKTFILTER_ACCEPT = 0,           /**< let the packet pass */
+    PKTFILTER_DROP,                 /**< drop the packet */
+    PKTFILTER_COUNT,                /**< count the packet and let it pass */
+    PKTFILTER_RATELIMIT,            /**< let the packet pass, if the rate
+                                     *   limit of the rule is not exceeded */
+} pktfilter_action_t;
+
+/**
+ * @brief   Filter rule
+ *
+ * Fill in the public members and add the rule with pktfilter_add().
+ */
+typedef struct {
+    uint8_t addr[PKTFILTER_ADDR_MAXLEN];    /**< address (prefix) to match */
+    uint8_t addr_len;           /**< length of matched addresses in byte */
+    uint8_t prefix_len;         /**< prefix length in bit */
+    uint8_t field;              /**< address field, see pktfilter_field_t */
+    uint8_t action;             /**< action, see pktfilter_action_t */
+    uint8_t proto;              /**< IPv6 next header to match, or
+                                 *   @ref PKTFILTER_PROTO_ANY */
+    uint16_t port;              /**< destination port to match, or
+                                 *   @ref PKTFILTER_PORT_ANY */
+    uint16_t rate;              /**< packets per second for
+                                 *   @ref PKTFILTER_RATELIMIT */
+    uint16_t burst;             /**< bucket size for
+                                 *   @ref PKTFILTER_RATELIMIT */
+    uint16_t tokens;            /**< available packets (internal) */
+    uint16_t next;              /**< next rule with the same key (internal) */
+    uint32_t last;              /**< last token refill in us (internal) */
+    uint32_t hits;              /**< number of packets matching this rule */
+} pktfilter_rule_t;
+
+/**
+ * @brief   Packet filter
+ */
+typedef struct {
+    pktfilter_rule_t *rules;    /**< rule storage */
+    uint16_t *table;            /**< hash table storage */
+    uint16_t rules_max;         /**< size of pktfilter_t::rules */
+    uint16_t rules_numof;       /**< number of rules in use */
+    uint16_t table_size;        /**< size of pktfilter_t::table, power of 2 */
+    uint16_t table_used;        /**< number of used hash table buckets */
+    mutex_t mutex;              /**< serializes access to the filter */
+    uint8_t default_action;     /**< action if no rule matches */
+    /** prefix lengths in use, per address field */
+    uint8_t lens[PKTFILTER_FIELD_NUMOF][(PKTFILTER_ADDR_MAXLEN * 8 + 8) / 8];
+} pktfilter_t;
+
+/**
+ * @brief   Static initializer for pktfilter_t
+ *
+ * @param[in] rules         array of pktfilter_rule_t
+ * @param[in] table         array of uint16_t, should have at least twice
+ *                          as many elements as @p rules, must be a power of 2
+ */
+#define PKTFILTER_INIT(rules, table) \
+    { (rules), (table), sizeof(rules) / sizeof((rules)[0]), 0, \
+      sizeof(table) / sizeof((table)[0]), 0, MUTEX_INIT, PKTFILTER_ACCEPT, \
+      { { 0 } } }
+
+/**
+ * @brief   Packet properties a filter is evaluated on
+ *
+ * Set the fields not known for a packet to NULL, respectively
+ * @ref PKTFILTER_PROTO_ANY and @ref PKTFILTER_PORT_ANY.
+ */
+typedef struct {
+    const uint8_t *l2_src;      /**< link layer source address */
+    const uint8_t *l2_dst;      /**< link layer destination address */
+    const uint8_t *ipv6_src;    /**< IPv6 source address */
+    const uint8_t *ipv6_dst;    /**< IPv6 destination address */
+    uint8_t l2_src_len;         /**< length of pktfilter_pkt_t::l2_src */
+    uint8_t l2_dst_len;         /**< length of pktfilter_pkt_t::l2_dst */
+    uint8_t proto;              /**< IPv6 next header */
+    uint16_t port;              /**< transport layer destination port */
+} pktfilter_pkt_t;
+
+/**
+ * @brief   Initialize a packet filter
+ *
+ * @param[out] filter       the filter
+ * @param[in] rules         rule storage
+ * @param[in] rules_max     number of elements in @p rules
+ * @param[in] table         hash table storage, should have at least twice
+ *                          as many elements as @p rules
+ * @param[in] table_size    number of elements in @p table, must be a power
+ *                          of 2
+ */
+void pktfilter_init(pktfilter_t *filter, pktfilter_rule_t *rules,
+                    uint16_t rules_max, uint16_t *table, uint16_t table_size);
+
+/**
+ * @brief   Add a rule to the filter
+ *
+ * The rule is copied into the filter. Address bits beyond the prefix length
+ * are ignored.
+ *
+ * @param[in,out] filter    the filter
+ * @param[in] rule          the rule to add
+ *
+ * @return  index of the rule on success
+ * @return  -ENOMEM if no rule or hash table slot is left
+ * @return  -EINVAL if the rule is invalid
+ */
+int pktfilter_add(pktfilter_t *filter, const pktfilter_rule_t *rule);
+
+/**
+ * @brief   Remove a rule from the filter
+ *
+ * The indexes of rules added after the removed rule are decreased by one.
+ *
+ * @param[in,out] filter    the filter
+ * @param[in] idx           index of the rule
+ *
+ * @return  0 on success
+ * @return  -ENOENT if there is no rule with index @p idx
+ */
+int pktfilter_del(pktfilter_t *filter, unsigned idx);
+
+/**
+ * @brief   Remove all rules from the filter
+ *
+ * @param[in,out] filter    the filter
+ */
+void pktfilter_clear(pktfilter_t *filter);
+
+/**
+ * @brief   Find the rule matching a packet
+ *
+ * Does not lock the filter, the caller must make sure that no rules are
+ * added or removed until it is done with the returned rule.
+ *
+ * @param[in] filter        the filter
+ * @param[in] pkt           properties of the packet
+ *
+ * @return  the matching rule, NULL if no rule matches
+ */
+pktfilter_rule_t *pktfilter_match(const pktfilter_t *filter,
+                                  const pktfilter_pkt_t *pkt);
+
+/**
+ * @brief   Evaluate the filter for a packet
+ *
+ * Finds the matching rule, updates its counters and applies its action.
+ *
+ * @param[in,out] filter    the filter
+ * @param[in] pkt           properties of the packet
+ *
+ * @return  true if the packet passes
+ * @return  false if the packet is to be dropped
+ */
+bool pktfilter_pass(pktfilter_t *filter, const pktfilter_pkt_t *pkt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_PKTFILTER_H */
+/** @} */
@@ -113,6 +113,7 @@ extern "C" {
  * @brief       Flags to (de)activate certain functionalities
  * @{
  */
+#define SOCK_HAS_IPV4       /**< activate IPv4 support */
 #define SOCK_HAS_IPV6       /**< activate IPv6 support */
 /** @} */
 #endif
@@ -41,6 +41,12 @@ extern "C" {
 /** @brief UHCP port number (as string for e.g., getaddrinfo() service arg */
 #define UHCP_PORT_STR   "12345"
 
+/** @brief Length of the optional client identifier in request packets */
+#define UHCP_CLIENT_ID_LEN      (8U)
+
+/** @brief Lifetime value of an assigned prefix that never expires */
+#define UHCP_LIFETIME_INFINITE  (0xFFFFU)
+
 /** @brief Enum containing possible UHCP packet types */
 typedef enum {
     UHCP_REQ,               /**< packet is a request packet */
@@ -66,9 +72,27 @@ typedef struct __attribute__((packed)) {
     uint8_t prefix_len;     /**< contains the requested prefix length */
 } uhcp_req_t;
 
+/**
+ * @brief struct for request packets carrying a client identifier
+ *
+ * The client identifier allows servers to assign distinct prefixes to
+ * several clients, e.g. border routers sharing one backbone link. Servers
+ * treat requests without it like requests identified by the source address.
+ *
+ * @extends uhcp_req_t
+ */
+typedef struct __attribute__((packed)) {
+    uhcp_req_t req;         /**< member holding parent type */
+    uint8_t client_id[UHCP_CLIENT_ID_LEN];  /**< unique client identifier */
+} uhcp_req_id_t;
+
 /**
  * @brief struct for push packets
  *
+ * The prefix is followed by its lifetime in seconds (16 bit, network byte
+ * order). Packets without lifetime are treated as assigning the prefix with
+ * @ref UHCP_LIFETIME_INFINITE.
+ *
  * @extends uhcp_hdr_t
  */
 typedef struct __attribute__((packed)) {
@@ -103,12 +127,15 @@ void uhcp_handle_udp(uint8_t *buf, size_t len, uint8_t *src, uint16_t port, uhcp
  *
  * @internal
  *
- * @param[in]   req     ptr to UHCP request header
- * @param[in]   src     ptr to IPv6 source address
- * @param[in]   port    source port of packet
- * @param[in]   iface   number of interface the packet came in
+ * @param[in]   req         ptr to UHCP request header
+ * @param[in]   client_id   ptr to the client identifier, NULL if the request
+ *                          did not contain one
+ * @param[in]   src         ptr to IPv6 source address
+ * @param[in]   port        source port of packet
+ * @param[in]   iface       number of interface the packet came in
  */
-void uhcp_handle_req(uhcp_req_t *req, uint8_t *src, uint16_t port, uhcp_iface_t iface);
+void uhcp_handle_req(uhcp_req_t *req, const uint8_t *client_id, uint8_t *src,
+                     uint16_t port, uhcp_iface_t iface);
 
 /**
  * @brief handle incoming UHCP push packet
@@ -119,11 +146,43 @@ void uhcp_handle_req(uhcp_req_t *req, uint8_t *src, uint16_t port, uhcp_iface_t
  * @internal
  *
  * @param[in]   req     ptr to UHCP push header
+ * @param[in]   len     length of the push packet
  * @param[in]   src     ptr to IPv6 source address
  * @param[in]   port    source port of packet
  * @param[in]   iface   number of interface the packet came in
  */
-void uhcp_handle_push(uhcp_push_t *req, uint8_t *src, uint16_t port, uhcp_iface_t iface);
+void uhcp_handle_push(uhcp_push_t *req, size_t len, uint8_t *src, uint16_t port,
+                      uhcp_iface_t iface);
+
+/**
+ * @brief select the prefix to assign to a client
+ *
+ * Supposed to be implemented by UHCP server implementations.
+ *
+ * @param[in]   client_id   client identifier, NULL if the client did not
+ *                          send one
+ * @param[in]   src         ptr to IPv6 source address of the request
+ * @param[out]  prefix      prefix to assign (16 bytes)
+ * @param[out]  prefix_len  length of the prefix to assign
+ * @param[out]  lifetime    lifetime of the assignment in seconds
+ *
+ * @return      0 on success
+ * @return      -1 if no prefix is available for the client
+ */
+int uhcp_server_lease(const uint8_t *client_id, const uint8_t *src,
+                      uint8_t *prefix, uint8_t *prefix_len, uint16_t *lifetime);
+
+/**
+ * @brief get the identifier to send in requests
+ *
+ * Supposed to be implemented by UHCP client implementations.
+ *
+ * @param[out]  client_id   client identifier (@ref UHCP_CLIENT_ID_LEN bytes)
+ *
+ * @return      0 on success
+ * @return      -1 if no identifier should be sent
+ */
+int uhcp_client_id(uint8_t *client_id);
 
 /**
  * @brief handle incoming prefix (as parsed from push packet)
@@ -136,10 +195,15 @@ void uhcp_handle_push(uhcp_push_t *req, uint8_t *src, uint16_t port, uhcp_iface_
  * If the function is called with a different prefix than before, the old
  * prefix *MUST* be considered obsolete.
  *
+ * If the function is called with a lifetime of 0, the lease of the prefix
+ * expired and the prefix *MUST* be removed.
+ *
  * @param[in]   prefix      ptr to assigned prefix
  * @param[in]   prefix_len  length of assigned prefix
- * @param[in]   lifetime    lifetime of prefix
- * @param[in]   src         ptr to IPv6 source address
+ * @param[in]   lifetime    lifetime of prefix in seconds, see
+ *                          @ref UHCP_LIFETIME_INFINITE
+ * @param[in]   src         ptr to IPv6 source address, NULL for an expired
+ *                          prefix
  * @param[in]   iface       number of interface the packet came in
  */
 void uhcp_handle_prefix(uint8_t *prefix, uint8_t prefix_len, uint16_t lifetime, uint8_t *src, uhcp_iface_t iface);
@@ -158,6 +222,53 @@ static inline void uhcp_hdr_set(uhcp_hdr_t *hdr, uhcp_type_t type)
     hdr->ver_type = (UHCP_VER << 4) | (type & 0xF);
 }
 
+/**
+ * @brief get the length of a push packet including the lifetime
+ *
+ * @param[in]   prefix_len  length of the assigned prefix
+ *
+ * @return  length of the push packet
+ */
+static inline size_t uhcp_push_len(uint8_t prefix_len)
+{
+    return sizeof(uhcp_push_t) + ((prefix_len + 7) >> 3) + sizeof(uint16_t);
+}
+
+/**
+ * @brief set the lifetime of a push packet
+ *
+ * @pre     uhcp_push_t::prefix_len is set
+ *
+ * @param[out]  push        push packet
+ * @param[in]   lifetime    lifetime in seconds
+ */
+static inline void uhcp_push_set_lifetime(uhcp_push_t *push, uint16_t lifetime)
+{
+    uint8_t *pos = push->prefix + ((push->prefix_len + 7) >> 3);
+
+    pos[0] = lifetime >> 8;
+    pos[1] = lifetime & 0xff;
+}
+
+/**
+ * @brief get the lifetime of a push packet
+ *
+ * @param[in]   push    push packet
+ * @param[in]   len     length of the push packet
+ *
+ * @return  lifetime in seconds, @ref UHCP_LIFETIME_INFINITE if the packet
+ *          does not contain any
+ */
+static inline uint16_t uhcp_push_get_lifetime(const uhcp_push_t *push, size_t len)
+{
+    const uint8_t *pos = push->prefix + ((push->prefix_len + 7) >> 3);
+
+    if (len < uhcp_push_len(push->prefix_len)) {
+        return UHCP_LIFETIME_INFINITE;
+    }
+    return (pos[0] << 8) | pos[1];
+}
+
 /**
  * @brief UDP send function used by UHCP client / server
  *
@@ -25,6 +25,9 @@
  *
  * In order to use this module, you'll need to implement pm_set().
  *
+ * With the `pm_tickless` module, the selected mode additionally has to fit
+ * before the next timer deadline, see @ref sys_pm_tickless.
+ *
  * @file
  * @brief       Layered low power mode infrastructure
  *
@@ -38,6 +41,10 @@
 #include "periph/pm.h"
 #include "periph_cpu.h"
 
+#ifdef MODULE_PM_TICKLESS
+#include "pm_tickless.h"
+#endif
+
 #ifdef __cplusplus
  extern "C" {
 #endif
@@ -68,6 +75,21 @@ void pm_unblock(unsigned mode);
  */
 void pm_set(unsigned mode);
 
+#if defined(MODULE_PM_TICKLESS) || defined(DOXYGEN)
+/**
+ * @brief   Get the residency statistics of all power modes
+ *
+ * @return  array of PM_NUM_MODES + 1 entries, the last one accounting for the
+ *          implicit idle mode
+ */
+const pm_tickless_stats_t *pm_layered_stats(void);
+
+/**
+ * @brief   Reset the residency statistics of all power modes
+ */
+void pm_layered_stats_reset(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
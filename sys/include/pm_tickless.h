@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_pm_tickless Tickless idle policy
+ * @ingroup     sys_pm_layered
+ * @{
+ *
+ * This module lets @ref sys_pm_layered take the next timer deadline into
+ * account when selecting a power mode.
+ *
+ * Every power mode is described by its exit latency (the time needed to wake
+ * up from it) and its break-even time (the minimum time the MCU has to stay in
+ * the mode to save energy compared to the next higher mode). When idling, the
+ * deepest unblocked mode is selected whose exit latency and break-even time
+ * both fit before the next xtimer interrupt. If none fits, the implicit idle
+ * mode (PM_NUM_MODES) is used.
+ *
+ * CPUs can provide the mode parameters by defining `PM_TICKLESS_MODES` in
+ * periph_cpu.h as initializer for an array of @ref pm_tickless_mode_t with
+ * PM_NUM_MODES entries, where index 0 is the lowest power mode.
+ *
+ * The time spent in each mode is recorded and can be queried with
+ * pm_layered_stats().
+ *
+ * @file
+ * @brief       Tickless idle policy
+ */
+
+#ifndef PM_TICKLESS_H
+#define PM_TICKLESS_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Parameters of a power mode
+ */
+typedef struct {
+    uint32_t exit_latency;      /**< time needed to wake up in us */
+    uint32_t break_even;        /**< minimum residency to pay off in us */
+} pm_tickless_mode_t;
+
+/**
+ * @brief   Residency statistics of a power mode
+ */
+typedef struct {
+    uint32_t entries;           /**< number of times the mode was entered */
+    uint64_t residency;         /**< total time spent in the mode in us */
+} pm_tickless_stats_t;
+
+/**
+ * @brief   Select the deepest power mode fitting before a deadline
+ *
+ * @param[in] modes     parameters of all power modes, lowest mode first
+ * @param[in] numof     number of entries in @p modes
+ * @param[in] lowest    lowest mode that is not blocked
+ * @param[in] time_left time until the next deadline in us
+ *
+ * @return  selected mode, in the range from @p lowest to @p numof
+ * @return  @p numof, if no mode fits (idle without entering a power mode)
+ */
+unsigned pm_tickless_select(const pm_tickless_mode_t *modes, unsigned numof,
+                            unsigned lowest, uint32_t time_left);
+
+/**
+ * @brief   Account a stay in a power mode
+ *
+ * @param[in,out] stats     statistics of the mode that was left
+ * @param[in] residency     time spent in the mode in us
+ */
+static inline void pm_tickless_record(pm_tickless_stats_t *stats,
+                                      uint32_t residency)
+{
+    stats->entries++;
+    stats->residency += residency;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PM_TICKLESS_H */
+/** @} */
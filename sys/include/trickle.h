@@ -39,8 +39,13 @@ typedef struct {
     void *args;                 /**< callback function arguments */
 } trickle_callback_t;
 
+/**
+ * @brief forward declaration of the trickle manager
+ */
+typedef struct trickle_mgr trickle_mgr_t;
+
 /** @brief all state variables for a trickle timer */
-typedef struct {
+typedef struct trickle {
     uint8_t k;                      /**< redundancy constant */
     uint8_t Imax;                   /**< maximum interval size, described as doublings */
     uint16_t c;                     /**< counter */
@@ -54,8 +59,39 @@ typedef struct {
     uint64_t msg_time;              /**< interval in ms */
     xtimer_t msg_timer;             /**< xtimer to send a msg_t to the target thread
                                          for a new interval */
+    uint32_t tx_count;              /**< number of times the callback was called */
+    uint32_t suppress_count;        /**< number of times the callback was
+                                         suppressed, because c >= k */
+    trickle_mgr_t *mgr;             /**< manager driving this trickle timer,
+                                         NULL if it uses its own xtimer */
+    struct trickle *next;           /**< next trickle timer in the manager's
+                                         deadline queue */
+    uint64_t deadline;              /**< absolute time of the next callback in
+                                         microseconds, if managed */
 } trickle_t;
 
+/**
+ * @brief   Trickle manager
+ *
+ * Drives many trickle timers from one xtimer. All managed timers are kept in
+ * a queue sorted by their next callback time. When the manager's timer fires,
+ * all timers due within the next trickle_mgr_t::slack milliseconds are handled
+ * in the same wakeup, which reduces the number of wakeups considerably with
+ * many trickle timers.
+ *
+ * Firing early by up to the slack does not break the trickle algorithm, as the
+ * next interval is always computed from the scheduled callback time.
+ */
+struct trickle_mgr {
+    trickle_t *queue;               /**< managed timers, sorted by deadline */
+    uint32_t slack;                 /**< coalescing window in ms */
+    uint32_t wakeups;               /**< number of timer wakeups handled */
+    kernel_pid_t pid;               /**< pid of the thread handling the manager */
+    trickle_t *firing;              /**< timer currently being handled */
+    msg_t msg;                      /**< the msg_t to use for wakeups */
+    xtimer_t timer;                 /**< xtimer of the manager */
+};
+
 /**
  * @brief resets the trickle timer
  *
@@ -112,6 +148,46 @@ void trickle_interval(trickle_t *trickle);
  */
 void trickle_callback(trickle_t *trickle);
 
+/**
+ * @brief initialize a trickle manager
+ *
+ * @param[out] mgr      trickle manager
+ * @param[in] pid       thread that handles the manager's messages, it must
+ *                      call trickle_mgr_handle() for messages of type
+ *                      @p msg_type
+ * @param[in] msg_type  msg_t.type for messages
+ * @param[in] slack     coalescing window in ms
+ */
+void trickle_mgr_init(trickle_mgr_t *mgr, kernel_pid_t pid, uint16_t msg_type,
+                      uint32_t slack);
+
+/**
+ * @brief start a trickle timer driven by a trickle manager
+ *
+ * Afterwards, the trickle timer is used with trickle_stop(),
+ * trickle_reset_timer() and trickle_increment_counter() as usual.
+ *
+ * @pre `Imin > 0`
+ * @pre `(Imin << Imax) < (UINT32_MAX / 2)` to avoid overflow of uint32_t
+ *
+ * @param[in] mgr                   trickle manager
+ * @param[in] trickle               trickle timer
+ * @param[in] Imin                  minimum interval
+ * @param[in] Imax                  maximum interval
+ * @param[in] k                     redundancy constant
+ */
+void trickle_mgr_start(trickle_mgr_t *mgr, trickle_t *trickle, uint32_t Imin,
+                       uint8_t Imax, uint8_t k);
+
+/**
+ * @brief handle a wakeup of a trickle manager
+ *
+ * Calls trickle_callback() for all managed timers that are due.
+ *
+ * @param[in] mgr       trickle manager
+ */
+void trickle_mgr_handle(trickle_mgr_t *mgr);
+
 #ifdef __cplusplus
 }
 #endif
@@ -19,6 +19,12 @@
  * This ringbuffer implementation can be used without locking if
  * there's only one producer and one consumer.
  *
+ * tsrb_get() and tsrb_add() copy contiguous segments using at most two memcpy
+ * calls. For zero-copy access, tsrb_read_contiguous() and
+ * tsrb_write_contiguous() return a pointer to the contiguous part of the
+ * buffer that can be read or written directly, which is then released to the
+ * other side with tsrb_read_commit() or tsrb_write_commit().
+ *
  * @note Buffer size must be a power of two!
  *
  * @author      Kaspar Schleiser <kaspar@schleiser.de>
@@ -146,6 +152,51 @@ int tsrb_add_one(tsrb_t *rb, char c);
  */
 int tsrb_add(tsrb_t *rb, const char *src, size_t n);
 
+/**
+ * @brief       Get the contiguous readable part of the ringbuffer
+ *
+ * The data stays in the ringbuffer until it is released with
+ * tsrb_read_commit(). Call this function again after committing to get the
+ * remaining data, if the data wraps around the end of the buffer.
+ *
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[out]  ptr start of the readable data
+ * @return      nr of bytes readable at @p ptr
+ */
+unsigned tsrb_read_contiguous(const tsrb_t *rb, char **ptr);
+
+/**
+ * @brief       Release bytes read with tsrb_read_contiguous()
+ *
+ * @pre         @p n <= tsrb_avail(@p rb)
+ *
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[in]   n   nr of bytes to release
+ */
+void tsrb_read_commit(tsrb_t *rb, unsigned n);
+
+/**
+ * @brief       Get the contiguous writable part of the ringbuffer
+ *
+ * Data written to @p ptr is made available to the reader with
+ * tsrb_write_commit().
+ *
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[out]  ptr start of the writable space
+ * @return      nr of bytes writable at @p ptr
+ */
+unsigned tsrb_write_contiguous(const tsrb_t *rb, char **ptr);
+
+/**
+ * @brief       Make bytes written via tsrb_write_contiguous() available
+ *
+ * @pre         @p n <= tsrb_free(@p rb)
+ *
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[in]   n   nr of bytes to add
+ */
+void tsrb_write_commit(tsrb_t *rb, unsigned n);
+
 #ifdef __cplusplus
 }
 #endif
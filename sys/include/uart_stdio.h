@@ -49,6 +49,58 @@ extern "C" {
 #define UART_STDIO_RX_BUFSIZE    (64)
 #endif
 
+#ifndef UART_STDIO_TX_BUFSIZE
+/**
+ * @brief Transmit buffer size for STDIO, must be a power of two
+ *
+ * Only used with the `uart_stdio_tx_buf` module.
+ */
+#define UART_STDIO_TX_BUFSIZE    (256)
+#endif
+
+/**
+ * @name    Transmit buffer overflow policies
+ *
+ * Selects what uart_stdio_write() does when the transmit buffer of the
+ * `uart_stdio_tx_buf` module is full.
+ * @{
+ */
+#define UART_STDIO_TX_BLOCK         (0) /**< block until there is space */
+#define UART_STDIO_TX_DROP          (1) /**< drop the data that does not fit */
+#define UART_STDIO_TX_DROP_OLDEST   (2) /**< drop the oldest buffered data */
+/** @} */
+
+#ifndef UART_STDIO_TX_CHUNK
+/**
+ * @brief Number of bytes the drain thread takes out of the transmit buffer at
+ *        once
+ *
+ * Only used with the `uart_stdio_tx_buf` module.
+ */
+#define UART_STDIO_TX_CHUNK      (32)
+#endif
+
+#ifndef UART_STDIO_TX_POLICY
+/**
+ * @brief Transmit buffer overflow policy for STDIO
+ */
+#define UART_STDIO_TX_POLICY     UART_STDIO_TX_BLOCK
+#endif
+
+#ifndef UART_STDIO_TX_PRIO
+/**
+ * @brief Priority of the thread draining the transmit buffer
+ */
+#define UART_STDIO_TX_PRIO       (THREAD_PRIORITY_IDLE - 1)
+#endif
+
+#ifndef UART_STDIO_TX_STACKSIZE
+/**
+ * @brief Stack size of the thread draining the transmit buffer
+ */
+#define UART_STDIO_TX_STACKSIZE  (THREAD_STACKSIZE_DEFAULT)
+#endif
+
 /**
  * @brief initialize the module
  */
@@ -76,6 +128,24 @@ int uart_stdio_read(char* buffer, int len);
  */
 int uart_stdio_write(const char* buffer, int len);
 
+/**
+ * @brief write out all buffered data synchronously
+ *
+ * With the `uart_stdio_tx_buf` module, uart_stdio_write() only copies the data
+ * into a transmit buffer, which is drained by a low priority thread. This
+ * function writes out the buffer contents from the calling context with
+ * interrupts disabled, so it can be used in panic paths. Without the module,
+ * it does nothing.
+ */
+void uart_stdio_flush(void);
+
+/**
+ * @brief get the number of bytes dropped due to a full transmit buffer
+ *
+ * @return nr of dropped bytes, always 0 without the `uart_stdio_tx_buf` module
+ */
+unsigned uart_stdio_tx_dropped(void);
+
 /**
  * @brief internal callback for periph/uart drivers
  *
@@ -86,9 +86,23 @@ typedef struct xtimer {
  */
 static inline xtimer_ticks32_t xtimer_now(void);
 
+/**
+ * @brief get a coarse approximation of the current system time
+ *
+ * Returns the time of the last xtimer interrupt, which costs only a single
+ * memory read. The value never is ahead of xtimer_now(), but lags behind by up
+ * to the time between two xtimer interrupts. As xtimer wakes up at least once
+ * per low-level timer period, this is bounded by one period.
+ *
+ * @return  time of the last xtimer interrupt as 32bit time stamp
+ */
+static inline xtimer_ticks32_t xtimer_now_coarse(void);
+
 /**
  * @brief get the current system time as 64bit time stamp
  *
+ * This is lock-free and safe to call from interrupt context.
+ *
  * @return  current time as 64bit time stamp
  */
 static inline xtimer_ticks64_t xtimer_now64(void);
@@ -114,6 +128,17 @@ static inline uint32_t xtimer_now_usec(void);
  */
 static inline uint64_t xtimer_now_usec64(void);
 
+/**
+ * @brief get the time left until the next xtimer interrupt
+ *
+ * This includes the wakeup xtimer schedules at the end of each low-level timer
+ * period, even if no timer is pending. Power management can use this to pick a
+ * low power mode that pays off before the next wakeup.
+ *
+ * @return  ticks until the low-level timer fires next, 0 if it is due
+ */
+xtimer_ticks32_t xtimer_left_until_next(void);
+
 /**
  * @brief xtimer initialization function
  *
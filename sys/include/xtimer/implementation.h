@@ -32,6 +32,7 @@ extern "C" {
 #if XTIMER_MASK
 extern volatile uint32_t _xtimer_high_cnt;
 #endif
+extern volatile uint32_t _xtimer_coarse_now;
 
 /**
  * @brief IPC message type for xtimer msg callback
@@ -117,6 +118,13 @@ static inline xtimer_ticks32_t xtimer_now(void)
     return ret;
 }
 
+static inline xtimer_ticks32_t xtimer_now_coarse(void)
+{
+    xtimer_ticks32_t ret;
+    ret.ticks32 = _xtimer_coarse_now;
+    return ret;
+}
+
 static inline xtimer_ticks64_t xtimer_now64(void)
 {
     xtimer_ticks64_t ret;
@@ -26,6 +26,27 @@ void isrpipe_init(isrpipe_t *isrpipe, char *buf, size_t bufsize)
 {
     mutex_init(&isrpipe->mutex);
     tsrb_init(&isrpipe->tsrb, buf, bufsize);
+    isrpipe->watermark = 0;
+    isrpipe->idle_timeout = 0;
+}
+
+void isrpipe_set_watermark(isrpipe_t *isrpipe, size_t watermark,
+                           uint32_t idle_timeout)
+{
+    isrpipe->watermark = watermark;
+    isrpipe->idle_timeout = idle_timeout;
+}
+
+static void _wake(isrpipe_t *isrpipe, unsigned added)
+{
+    unsigned avail = tsrb_avail(&isrpipe->tsrb);
+
+    /* with a watermark, only wake the reader for the first bytes (so it can
+     * start its idle timer) and once the watermark is reached */
+    if (!isrpipe->watermark || (avail <= added) ||
+        (avail >= isrpipe->watermark)) {
+        mutex_unlock(&isrpipe->mutex);
+    }
 }
 
 int isrpipe_write_one(isrpipe_t *isrpipe, char c)
@@ -33,20 +54,21 @@ int isrpipe_write_one(isrpipe_t *isrpipe, char c)
     int res = tsrb_add_one(&isrpipe->tsrb, c);
 
     /* `res` is either 0 on success or -1 when the buffer is full. Either way,
-     * unlocking the mutex is fine.
+     * waking the reader is fine.
      */
-    mutex_unlock(&isrpipe->mutex);
+    _wake(isrpipe, 1);
 
     return res;
 }
 
-int isrpipe_read(isrpipe_t *isrpipe, char *buffer, size_t count)
+int isrpipe_write(isrpipe_t *isrpipe, const char *buf, size_t count)
 {
-    int res;
+    int res = tsrb_add(&isrpipe->tsrb, buf, count);
 
-    while (!(res = tsrb_get(&isrpipe->tsrb, buffer, count))) {
-        mutex_lock(&isrpipe->mutex);
+    if (res) {
+        _wake(isrpipe, res);
     }
+
     return res;
 }
 
@@ -63,6 +85,55 @@ static void _cb(void *arg)
     mutex_unlock(_timeout->mutex);
 }
 
+/**
+ * @brief   Wait until the watermark is reached or the stream went idle
+ *
+ * @p expired points to the flag of an overall timeout running on the same
+ * mutex, or is NULL for none. The wait ends early once it is set.
+ */
+static void _wait_watermark(isrpipe_t *isrpipe, size_t count,
+                            const int *expired)
+{
+    size_t want = (count < isrpipe->watermark) ? count : isrpipe->watermark;
+    _isrpipe_timeout_t _timeout = { .mutex = &isrpipe->mutex, .flag = 0 };
+    xtimer_t timer = { .callback = _cb, .arg = &_timeout };
+    unsigned writes;
+
+    while (tsrb_empty(&isrpipe->tsrb)) {
+        if (expired && *expired) {
+            return;
+        }
+        mutex_lock(&isrpipe->mutex);
+    }
+
+    /* wait for the watermark, or until no new data arrived for a whole idle
+     * timeout period */
+    do {
+        writes = isrpipe->tsrb.writes;
+        if ((tsrb_avail(&isrpipe->tsrb) >= want) || (expired && *expired)) {
+            break;
+        }
+        _timeout.flag = 0;
+        xtimer_set(&timer, isrpipe->idle_timeout);
+        mutex_lock(&isrpipe->mutex);
+        xtimer_remove(&timer);
+    } while (!_timeout.flag || (isrpipe->tsrb.writes != writes));
+}
+
+int isrpipe_read(isrpipe_t *isrpipe, char *buffer, size_t count)
+{
+    int res;
+
+    if (isrpipe->watermark) {
+        _wait_watermark(isrpipe, count, NULL);
+    }
+
+    while (!(res = tsrb_get(&isrpipe->tsrb, buffer, count))) {
+        mutex_lock(&isrpipe->mutex);
+    }
+    return res;
+}
+
 int isrpipe_read_timeout(isrpipe_t *isrpipe, char *buffer, size_t count, uint32_t timeout)
 {
     int res;
@@ -72,12 +143,18 @@ int isrpipe_read_timeout(isrpipe_t *isrpipe, char *buffer, size_t count, uint32_
     xtimer_t timer = { .callback = _cb, .arg = &_timeout };
 
     xtimer_set(&timer, timeout);
+    if (isrpipe->watermark) {
+        _wait_watermark(isrpipe, count, &_timeout.flag);
+    }
+
+    /* check the flag before blocking: the watermark wait might already have
+     * consumed the unlock of an expired timeout */
     while (!(res = tsrb_get(&isrpipe->tsrb, buffer, count))) {
-        mutex_lock(&isrpipe->mutex);
         if (_timeout.flag) {
             res = -ETIMEDOUT;
             break;
         }
+        mutex_lock(&isrpipe->mutex);
     }
 
     xtimer_remove(&timer);
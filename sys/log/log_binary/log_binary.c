@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_log_binary
+ * @{
+ *
+ * @file
+ * @brief       Binary log module implementation
+ *
+ * A record consists of 32-bit words: the header, the format string address,
+ * the timestamp in microseconds (if LOG_BINARY_HDR_TIME is set in the header)
+ * and the arguments.
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+
+#include "irq.h"
+#include "tsrb.h"
+#include "log_module.h"
+
+#ifdef MODULE_XTIMER
+#include "xtimer.h"
+#endif
+
+/* header, format string, timestamp and arguments */
+#define RECORD_WORDS_MAX    (3U + LOG_BINARY_ARGS_MAX)
+
+static char _buf[LOG_BINARY_BUFSIZE];
+static tsrb_t _rb = TSRB_INIT(_buf);
+static unsigned _dropped;
+
+void log_binary_write(uint32_t hdr, const char *format, ...)
+{
+    uint32_t record[RECORD_WORDS_MAX];
+    unsigned nargs = hdr & LOG_BINARY_HDR_NARGS;
+    unsigned len = 0;
+    va_list args;
+
+    record[len++] = hdr;
+    record[len++] = (uint32_t)(uintptr_t)format;
+#ifdef MODULE_XTIMER
+    record[0] |= LOG_BINARY_HDR_TIME;
+    record[len++] = xtimer_now_usec();
+#endif
+    va_start(args, format);
+    for (unsigned i = 0; i < nargs; i++) {
+        record[len++] = va_arg(args, uint32_t);
+    }
+    va_end(args);
+
+    /* the critical section only serializes writers, the reader in
+     * log_binary_dump() does not need it */
+    unsigned state = irq_disable();
+    if (tsrb_free(&_rb) >= (len * sizeof(uint32_t))) {
+        tsrb_add(&_rb, (char *)record, len * sizeof(uint32_t));
+    }
+    else {
+        _dropped++;
+    }
+    irq_restore(state);
+}
+
+void log_binary_dump(void)
+{
+    uint32_t record[RECORD_WORDS_MAX];
+
+    while (tsrb_get(&_rb, (char *)record, sizeof(uint32_t))) {
+        unsigned len = 1 + (record[0] & LOG_BINARY_HDR_NARGS);
+
+        if (record[0] & LOG_BINARY_HDR_TIME) {
+            len++;
+        }
+        tsrb_get(&_rb, (char *)&record[1], len * sizeof(uint32_t));
+
+        printf("LOGB");
+        for (unsigned i = 0; i <= len; i++) {
+            printf(" %08" PRIx32, record[i]);
+        }
+        puts("");
+    }
+
+    if (_dropped) {
+        unsigned state = irq_disable();
+        unsigned dropped = _dropped;
+        _dropped = 0;
+        irq_restore(state);
+
+        printf("LOGB-DROPPED %u\n", dropped);
+    }
+}
+
+unsigned log_binary_dropped(void)
+{
+    return _dropped;
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_log_binary Binary log module
+ * @ingroup     sys
+ * @brief       Deferred logging module recording binary log records
+ *
+ * Instead of formatting the log message at call time, this module only
+ * records the address of the format string, the log level and the raw
+ * arguments into a ring buffer. This takes a small, constant amount of time,
+ * so logging hardly perturbs the timing of the code being debugged.
+ *
+ * The records are written out later with log_binary_dump(), as lines starting
+ * with "LOGB", which are decoded on the host with
+ * `dist/tools/log_binary/log_binary_decode.py`, using the format strings
+ * contained in the application's ELF file.
+ *
+ * Limitations:
+ * - all arguments are recorded as 32-bit values, so 64-bit integers and
+ *   floating point arguments are not supported
+ * - string arguments are recorded as pointers, they can only be decoded if
+ *   they point to constant data contained in the ELF file
+ * - at most @ref LOG_BINARY_ARGS_MAX arguments are supported per call
+ *
+ * @{
+ *
+ * @file
+ * @brief       log_module header
+ */
+
+#ifndef LOG_MODULE_H
+#define LOG_MODULE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef LOG_BINARY_BUFSIZE
+/**
+ * @brief   Size of the log record buffer in bytes, must be a power of two
+ */
+#define LOG_BINARY_BUFSIZE      (1024U)
+#endif
+
+/**
+ * @brief   Maximum number of arguments per log call
+ */
+#define LOG_BINARY_ARGS_MAX     (8U)
+
+/**
+ * @name    Log record header layout
+ * @{
+ */
+#define LOG_BINARY_HDR_NARGS    (0x000000ffUL)  /**< number of arguments */
+#define LOG_BINARY_HDR_LEVEL    (0x0000ff00UL)  /**< log level */
+#define LOG_BINARY_HDR_TIME     (0x00010000UL)  /**< timestamp present */
+/** @} */
+
+/**
+ * @cond INTERNAL
+ */
+/* the format string is counted as well, so the variadic part is never empty,
+ * which C99 does not allow, and a trailing dummy argument is added for the
+ * same reason */
+#define _LOG_BINARY_NARGS(...) \
+    _LOG_BINARY_NARGS_(__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0, _)
+#define _LOG_BINARY_NARGS_(_f, _1, _2, _3, _4, _5, _6, _7, _8, N, ...) N
+#define _LOG_BINARY_FORMAT(...)         _LOG_BINARY_FORMAT_(__VA_ARGS__, _)
+#define _LOG_BINARY_FORMAT_(f, ...)     (f)
+
+#define _LOG_BINARY_CAT(a, b)   _LOG_BINARY_CAT_(a, b)
+#define _LOG_BINARY_CAT_(a, b)  a ## b
+
+/* the format string is passed along and dropped by the last step */
+#define _LOG_BINARY_ARG(x)      ((uint32_t)(uintptr_t)(x))
+#define _LOG_BINARY_MAP0(f)
+#define _LOG_BINARY_MAP1(f, a)      , _LOG_BINARY_ARG(a)
+#define _LOG_BINARY_MAP2(f, a, ...) , _LOG_BINARY_ARG(a) _LOG_BINARY_MAP1(f, __VA_ARGS__)
+#define _LOG_BINARY_MAP3(f, a, ...) , _LOG_BINARY_ARG(a) _LOG_BINARY_MAP2(f, __VA_ARGS__)
+#define _LOG_BINARY_MAP4(f, a, ...) , _LOG_BINARY_ARG(a) _LOG_BINARY_MAP3(f, __VA_ARGS__)
+#define _LOG_BINARY_MAP5(f, a, ...) , _LOG_BINARY_ARG(a) _LOG_BINARY_MAP4(f, __VA_ARGS__)
+#define _LOG_BINARY_MAP6(f, a, ...) , _LOG_BINARY_ARG(a) _LOG_BINARY_MAP5(f, __VA_ARGS__)
+#define _LOG_BINARY_MAP7(f, a, ...) , _LOG_BINARY_ARG(a) _LOG_BINARY_MAP6(f, __VA_ARGS__)
+#define _LOG_BINARY_MAP8(f, a, ...) , _LOG_BINARY_ARG(a) _LOG_BINARY_MAP7(f, __VA_ARGS__)
+/** @endcond */
+
+/**
+ * @brief   log_write overridden function
+ *
+ * Converts all arguments to uint32_t and records them, together with the log
+ * level and the format string's address.
+ *
+ * @param[in] level     log level
+ * @param[in] ...       format string and its arguments
+ */
+#define log_write(level, ...) \
+    log_binary_write(((unsigned)(level) << 8) | \
+                     _LOG_BINARY_NARGS(__VA_ARGS__), \
+                     _LOG_BINARY_FORMAT(__VA_ARGS__) \
+                     _LOG_BINARY_CAT(_LOG_BINARY_MAP, \
+                                     _LOG_BINARY_NARGS(__VA_ARGS__))(__VA_ARGS__))
+
+/**
+ * @brief   Record a log message
+ *
+ * Use log_write() instead, which converts the arguments as needed.
+ *
+ * @param[in] hdr       record header, see @ref LOG_BINARY_HDR_NARGS and
+ *                      @ref LOG_BINARY_HDR_LEVEL
+ * @param[in] format    format string
+ * @param[in] ...       arguments, each of type uint32_t
+ */
+void log_binary_write(uint32_t hdr, const char *format, ...);
+
+/**
+ * @brief   Write out and remove all recorded log messages
+ *
+ * Each record is printed as one line containing "LOGB" followed by the
+ * record's words in hex. If records were dropped because the buffer was full,
+ * a line "LOGB-DROPPED <n>" is printed in addition.
+ */
+void log_binary_dump(void);
+
+/**
+ * @brief   Get the number of records dropped because the buffer was full
+ *
+ * @return  number of dropped records since the last log_binary_dump()
+ */
+unsigned log_binary_dropped(void);
+
+#ifdef __cplusplus
+}
+#endif
+/**@}*/
+#endif /* LOG_MODULE_H */
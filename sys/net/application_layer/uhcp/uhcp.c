@@ -47,7 +47,11 @@ void uhcp_handle_udp(uint8_t *buf, size_t len, uint8_t *src, uint16_t port, uhcp
                 puts("error: request too small\n");
             }
             else {
-                uhcp_handle_req((uhcp_req_t*)hdr, src, port, iface);
+                const uint8_t *client_id = NULL;
+                if (len >= sizeof(uhcp_req_id_t)) {
+                    client_id = ((uhcp_req_id_t *)hdr)->client_id;
+                }
+                uhcp_handle_req((uhcp_req_t*)hdr, client_id, src, port, iface);
             }
             break;
 #endif
@@ -61,7 +65,7 @@ void uhcp_handle_udp(uint8_t *buf, size_t len, uint8_t *src, uint16_t port, uhcp
                     puts("error: request too small\n");
                 }
                 else {
-                    uhcp_handle_push(push, src, port, iface);
+                    uhcp_handle_push(push, len, src, port, iface);
                 }
                 break;
             }
@@ -72,18 +76,28 @@ void uhcp_handle_udp(uint8_t *buf, size_t len, uint8_t *src, uint16_t port, uhcp
 }
 
 #ifdef UHCP_SERVER
-extern char _prefix[16];
-extern unsigned _prefix_len;
-void uhcp_handle_req(uhcp_req_t *req, uint8_t *src, uint16_t port, uhcp_iface_t iface)
+void uhcp_handle_req(uhcp_req_t *req, const uint8_t *client_id, uint8_t *src,
+                     uint16_t port, uhcp_iface_t iface)
 {
-    size_t prefix_bytes = (_prefix_len + 7)>>3;
-    uint8_t packet[sizeof(uhcp_push_t) + prefix_bytes];
+    (void)req;
+    uint8_t prefix[16];
+    uint8_t prefix_len;
+    uint16_t lifetime;
+
+    if (uhcp_server_lease(client_id, src, prefix, &prefix_len, &lifetime) < 0) {
+        puts("uhcp_handle_req(): no prefix available for client");
+        return;
+    }
+
+    size_t prefix_bytes = (prefix_len + 7)>>3;
+    uint8_t packet[uhcp_push_len(prefix_len)];
 
     uhcp_push_t *reply = (uhcp_push_t *)packet;
     uhcp_hdr_set(&reply->hdr, UHCP_PUSH);
 
-    reply->prefix_len = _prefix_len;
-    memcpy(reply->prefix, _prefix, prefix_bytes);
+    reply->prefix_len = prefix_len;
+    memcpy(reply->prefix, prefix, prefix_bytes);
+    uhcp_push_set_lifetime(reply, lifetime);
 
     int res = udp_sendto(packet, sizeof(packet), src, port, iface);
     if (res == -1) {
@@ -93,8 +107,10 @@ void uhcp_handle_req(uhcp_req_t *req, uint8_t *src, uint16_t port, uhcp_iface_t
 #endif /* UHCP_SERVER */
 
 #ifdef UHCP_CLIENT
-void uhcp_handle_push(uhcp_push_t *req, uint8_t *src, uint16_t port, uhcp_iface_t iface)
+void uhcp_handle_push(uhcp_push_t *req, size_t len, uint8_t *src, uint16_t port,
+                      uhcp_iface_t iface)
 {
+    uint16_t lifetime = uhcp_push_get_lifetime(req, len);
     char addr_str[INET6_ADDRSTRLEN];
     char prefix_str[INET6_ADDRSTRLEN];
     inet_ntop(AF_INET6, src, addr_str, INET6_ADDRSTRLEN);
@@ -105,7 +121,8 @@ void uhcp_handle_push(uhcp_push_t *req, uint8_t *src, uint16_t port, uhcp_iface_
 
     inet_ntop(AF_INET6, prefix, prefix_str, INET6_ADDRSTRLEN);
 
-    printf("uhcp: push from %s:%u prefix=%s/%u\n", addr_str, (unsigned)port, prefix_str, req->prefix_len);
-    uhcp_handle_prefix(prefix, req->prefix_len, 0xFFFF, src, iface);
+    printf("uhcp: push from %s:%u prefix=%s/%u lifetime=%u\n", addr_str,
+           (unsigned)port, prefix_str, req->prefix_len, (unsigned)lifetime);
+    uhcp_handle_prefix(prefix, req->prefix_len, lifetime, src, iface);
 }
 #endif
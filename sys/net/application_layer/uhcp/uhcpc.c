@@ -7,17 +7,37 @@
  */
 
 #include <arpa/inet.h>
+#include <string.h>
 
 #include "net/af.h"
 #include "net/sock/udp.h"
 #include "net/uhcp.h"
 #include "xtimer.h"
 
+/**
+ * @brief Refresh interval for prefixes without lifetime (in seconds)
+ */
+#define UHCP_CLIENT_REFRESH_INFINITE    (60U)
+
+static int _is_push(const uint8_t *buf, size_t len)
+{
+    const uhcp_push_t *push = (const uhcp_push_t *)buf;
+
+    return (len >= sizeof(uhcp_push_t)) &&
+           (ntohl(push->hdr.uhcp_magic) == UHCP_MAGIC) &&
+           ((push->hdr.ver_type & 0xF) == UHCP_PUSH) &&
+           (push->prefix_len <= 128) &&
+           (len >= sizeof(uhcp_push_t) + ((push->prefix_len + 7) >> 3));
+}
+
 /**
  * @brief Request prefix from uhcp server
  *
  * Never returns.
  * Calls @c uhcp_handle_prefix() when a prefix or prefix change is received.
+ * The prefix is refreshed after half of its lifetime. If it cannot be
+ * refreshed before it expires, @c uhcp_handle_prefix() is called with a
+ * lifetime of 0.
  *
  * @param[in]   iface   interface to request prefix on
  */
@@ -31,25 +51,57 @@ void uhcp_client(uhcp_iface_t iface)
     inet_pton(AF_INET6, "ff15::abcd", req_target.addr.ipv6);
 
     /* prepare UHCP header */
-    uhcp_req_t req;
-    uhcp_hdr_set(&req.hdr, UHCP_REQ);
-    req.prefix_len = 64;
+    uhcp_req_id_t req;
+    size_t req_len = sizeof(uhcp_req_t);
+    uhcp_hdr_set(&req.req.hdr, UHCP_REQ);
+    req.req.prefix_len = 64;
+    if (uhcp_client_id(req.client_id) == 0) {
+        req_len = sizeof(uhcp_req_id_t);
+    }
 
     /* create listening socket */
     int res = sock_udp_create(&sock, &local, NULL, 0);
 
-    uint8_t buf[sizeof(uhcp_push_t) + 16];
+    uint8_t buf[sizeof(uhcp_push_t) + 16 + sizeof(uint16_t)];
+
+    /* currently assigned prefix, expires == 0 if none or infinite */
+    uint8_t lease_prefix[16];
+    uint8_t lease_prefix_len = 0;
+    uint64_t lease_expires = 0;
 
     while(1) {
         puts("uhcp_client(): sending REQ...");
-        sock_udp_send(&sock, &req, sizeof(uhcp_req_t), &req_target);
+        sock_udp_send(&sock, &req, req_len, &req_target);
         res = sock_udp_recv(&sock, buf, sizeof(buf), 10U*US_PER_SEC, &remote);
         if (res > 0) {
             uhcp_handle_udp(buf, res, remote.addr.ipv6, remote.port, iface);
-            xtimer_sleep(60);
+            if (_is_push(buf, res)) {
+                uhcp_push_t *push = (uhcp_push_t *)buf;
+                uint16_t lifetime = uhcp_push_get_lifetime(push, res);
+                uint32_t refresh = UHCP_CLIENT_REFRESH_INFINITE;
+
+                memset(lease_prefix, 0, sizeof(lease_prefix));
+                memcpy(lease_prefix, push->prefix, (push->prefix_len + 7) >> 3);
+                lease_prefix_len = push->prefix_len;
+                lease_expires = 0;
+                /* a lifetime of 0 withdraws the prefix, uhcp_handle_prefix()
+                 * already removed it then */
+                if ((lifetime != 0) && (lifetime != UHCP_LIFETIME_INFINITE)) {
+                    lease_expires = xtimer_now_usec64() +
+                                    ((uint64_t)lifetime * US_PER_SEC);
+                    refresh = (lifetime > 1) ? (lifetime / 2U) : 1;
+                }
+                xtimer_sleep(refresh);
+            }
         }
         else {
             puts("uhcp_client(): no reply received");
+            if (lease_expires && (xtimer_now_usec64() >= lease_expires)) {
+                puts("uhcp_client(): prefix expired");
+                uhcp_handle_prefix(lease_prefix, lease_prefix_len, 0, NULL,
+                                   iface);
+                lease_expires = 0;
+            }
         }
     }
 }
@@ -0,0 +1,319 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_pktfilter
+ * @{
+ *
+ * @file
+ * @brief       Packet filter implementation
+ *
+ * The hash table is open addressed with linear probing. Every bucket holds
+ * the index (+1) of the first rule with a given key (address field, address
+ * length, prefix length and masked address). Rules with the same key but
+ * different protocol or port are chained through pktfilter_rule_t::next in
+ * the order they were added.
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "assert.h"
+#include "xtimer.h"
+#include "net/pktfilter.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define CHAIN_END       (UINT16_MAX)
+
+static uint32_t _hash(uint8_t field, uint8_t addr_len, uint8_t prefix_len,
+                      const uint8_t *addr)
+{
+    /* FNV-1a */
+    uint32_t hash = 2166136261U;
+    uint8_t head[] = { field, addr_len, prefix_len };
+
+    for (unsigned i = 0; i < sizeof(head); i++) {
+        hash = (hash ^ head[i]) * 16777619U;
+    }
+    for (unsigned i = 0; i < (unsigned)((prefix_len + 7) >> 3); i++) {
+        hash = (hash ^ addr[i]) * 16777619U;
+    }
+    return hash;
+}
+
+static void _mask(uint8_t *dst, const uint8_t *src, uint8_t addr_len,
+                  uint8_t prefix_len)
+{
+    unsigned bytes = prefix_len >> 3;
+
+    memset(dst, 0, PKTFILTER_ADDR_MAXLEN);
+    memcpy(dst, src, bytes);
+    if ((prefix_len & 0x7) && (bytes < addr_len)) {
+        dst[bytes] = src[bytes] & (0xff << (8 - (prefix_len & 0x7)));
+    }
+}
+
+static inline bool _same_key(const pktfilter_rule_t *rule, uint8_t field,
+                             uint8_t addr_len, uint8_t prefix_len,
+                             const uint8_t *addr)
+{
+    return (rule->field == field) && (rule->addr_len == addr_len) &&
+           (rule->prefix_len == prefix_len) &&
+           (memcmp(rule->addr, addr, (prefix_len + 7) >> 3) == 0);
+}
+
+/**
+ * @brief   Find the hash table bucket for a key
+ *
+ * @return  the bucket holding the key, or the empty bucket to put it in
+ */
+static uint16_t *_bucket(const pktfilter_t *filter, uint8_t field,
+                         uint8_t addr_len, uint8_t prefix_len,
+                         const uint8_t *addr)
+{
+    uint16_t mask = filter->table_size - 1;
+    uint16_t pos = _hash(field, addr_len, prefix_len, addr) & mask;
+
+    while (filter->table[pos] != 0) {
+        const pktfilter_rule_t *rule = &filter->rules[filter->table[pos] - 1];
+        if (_same_key(rule, field, addr_len, prefix_len, addr)) {
+            break;
+        }
+        pos = (pos + 1) & mask;
+    }
+    return &filter->table[pos];
+}
+
+static int _insert(pktfilter_t *filter, uint16_t idx)
+{
+    pktfilter_rule_t *rule = &filter->rules[idx];
+    uint16_t *bucket = _bucket(filter, rule->field, rule->addr_len,
+                               rule->prefix_len, rule->addr);
+
+    rule->next = CHAIN_END;
+    if (*bucket == 0) {
+        /* keep at least one bucket empty, so probing terminates */
+        if (filter->table_used >= (filter->table_size - 1)) {
+            return -ENOMEM;
+        }
+        filter->table_used++;
+        *bucket = idx + 1;
+    }
+    else {
+        /* append, so rules added earlier are found first */
+        pktfilter_rule_t *last = &filter->rules[*bucket - 1];
+        while (last->next != CHAIN_END) {
+            last = &filter->rules[last->next];
+        }
+        last->next = idx;
+    }
+    filter->lens[rule->field][rule->prefix_len >> 3] |=
+        (0x80 >> (rule->prefix_len & 0x7));
+    return 0;
+}
+
+static void _rebuild(pktfilter_t *filter)
+{
+    memset(filter->table, 0, filter->table_size * sizeof(uint16_t));
+    memset(filter->lens, 0, sizeof(filter->lens));
+    filter->table_used = 0;
+    for (uint16_t i = 0; i < filter->rules_numof; i++) {
+        /* can't fail, the table held all rules before */
+        _insert(filter, i);
+    }
+}
+
+void pktfilter_init(pktfilter_t *filter, pktfilter_rule_t *rules,
+                    uint16_t rules_max, uint16_t *table, uint16_t table_size)
+{
+    assert(filter && rules && table);
+    /* table size must be a power of two */
+    assert((table_size > 1) && !(table_size & (table_size - 1)));
+
+    filter->rules = rules;
+    filter->rules_max = rules_max;
+    filter->table = table;
+    filter->table_size = table_size;
+    filter->default_action = PKTFILTER_ACCEPT;
+    mutex_init(&filter->mutex);
+    pktfilter_clear(filter);
+}
+
+int pktfilter_add(pktfilter_t *filter, const pktfilter_rule_t *rule)
+{
+    assert(filter && rule);
+
+    if ((rule->field >= PKTFILTER_FIELD_NUMOF) ||
+        (rule->addr_len > PKTFILTER_ADDR_MAXLEN) ||
+        (rule->prefix_len > (rule->addr_len * 8))) {
+        return -EINVAL;
+    }
+
+    mutex_lock(&filter->mutex);
+    if (filter->rules_numof >= filter->rules_max) {
+        mutex_unlock(&filter->mutex);
+        return -ENOMEM;
+    }
+
+    uint16_t idx = filter->rules_numof;
+    pktfilter_rule_t *dst = &filter->rules[idx];
+
+    *dst = *rule;
+    _mask(dst->addr, rule->addr, rule->addr_len, rule->prefix_len);
+    dst->tokens = dst->burst;
+    dst->last = xtimer_now_usec();
+    dst->hits = 0;
+
+    if (_insert(filter, idx) < 0) {
+        mutex_unlock(&filter->mutex);
+        return -ENOMEM;
+    }
+    filter->rules_numof++;
+    mutex_unlock(&filter->mutex);
+
+    DEBUG("pktfilter: added rule %u (field %u, /%u)\n", (unsigned)idx,
+          (unsigned)rule->field, (unsigned)rule->prefix_len);
+    return idx;
+}
+
+int pktfilter_del(pktfilter_t *filter, unsigned idx)
+{
+    assert(filter);
+
+    mutex_lock(&filter->mutex);
+    if (idx >= filter->rules_numof) {
+        mutex_unlock(&filter->mutex);
+        return -ENOENT;
+    }
+    memmove(&filter->rules[idx], &filter->rules[idx + 1],
+            (filter->rules_numof - idx - 1) * sizeof(pktfilter_rule_t));
+    filter->rules_numof--;
+    _rebuild(filter);
+    mutex_unlock(&filter->mutex);
+    return 0;
+}
+
+void pktfilter_clear(pktfilter_t *filter)
+{
+    assert(filter);
+
+    mutex_lock(&filter->mutex);
+    filter->rules_numof = 0;
+    _rebuild(filter);
+    mutex_unlock(&filter->mutex);
+}
+
+/**
+ * @brief   Longest prefix match for one address field
+ */
+static pktfilter_rule_t *_lookup(const pktfilter_t *filter, uint8_t field,
+                                 const uint8_t *addr, uint8_t addr_len,
+                                 const pktfilter_pkt_t *pkt)
+{
+    const uint8_t *lens = filter->lens[field];
+    uint8_t key[PKTFILTER_ADDR_MAXLEN];
+
+    if (!addr) {
+        return NULL;
+    }
+
+    for (int len = addr_len * 8; len >= 0; len--) {
+        if (!(lens[len >> 3] & (0x80 >> (len & 0x7)))) {
+            continue;
+        }
+        _mask(key, addr, addr_len, len);
+        uint16_t head = *_bucket(filter, field, addr_len, len, key);
+        while (head != 0) {
+            pktfilter_rule_t *rule = &filter->rules[head - 1];
+            if (((rule->proto == PKTFILTER_PROTO_ANY) ||
+                 (rule->proto == pkt->proto)) &&
+                ((rule->port == PKTFILTER_PORT_ANY) ||
+                 (rule->port == pkt->port))) {
+                return rule;
+            }
+            head = (rule->next == CHAIN_END) ? 0 : (rule->next + 1);
+        }
+    }
+    return NULL;
+}
+
+static inline pktfilter_rule_t *_first(pktfilter_rule_t *a, pktfilter_rule_t *b)
+{
+    if (!a || (b && (b < a))) {
+        return b;
+    }
+    return a;
+}
+
+pktfilter_rule_t *pktfilter_match(const pktfilter_t *filter,
+                                  const pktfilter_pkt_t *pkt)
+{
+    assert(filter && pkt);
+
+    pktfilter_rule_t *res;
+
+    res = _lookup(filter, PKTFILTER_L2_SRC, pkt->l2_src, pkt->l2_src_len, pkt);
+    res = _first(res, _lookup(filter, PKTFILTER_L2_DST, pkt->l2_dst,
+                              pkt->l2_dst_len, pkt));
+    res = _first(res, _lookup(filter, PKTFILTER_IPV6_SRC, pkt->ipv6_src,
+                              16, pkt));
+    res = _first(res, _lookup(filter, PKTFILTER_IPV6_DST, pkt->ipv6_dst,
+                              16, pkt));
+    return res;
+}
+
+static bool _take_token(pktfilter_rule_t *rule)
+{
+    uint32_t now = xtimer_now_usec();
+    uint64_t add = ((uint64_t)(now - rule->last) * rule->rate) / US_PER_SEC;
+
+    if (add > 0) {
+        rule->tokens = (add >= (uint64_t)(rule->burst - rule->tokens)) ?
+                       rule->burst : (rule->tokens + add);
+        rule->last = now;
+    }
+    if (rule->tokens == 0) {
+        return false;
+    }
+    rule->tokens--;
+    return true;
+}
+
+bool pktfilter_pass(pktfilter_t *filter, const pktfilter_pkt_t *pkt)
+{
+    pktfilter_rule_t *rule;
+    bool res;
+
+    mutex_lock(&filter->mutex);
+    rule = pktfilter_match(filter, pkt);
+    if (!rule) {
+        res = (filter->default_action != PKTFILTER_DROP);
+        mutex_unlock(&filter->mutex);
+        return res;
+    }
+
+    rule->hits++;
+    switch (rule->action) {
+        case PKTFILTER_DROP:
+            DEBUG("pktfilter: packet dropped by rule %u\n",
+                  (unsigned)(rule - filter->rules));
+            res = false;
+            break;
+        case PKTFILTER_RATELIMIT:
+            res = _take_token(rule);
+            break;
+        default:
+            res = true;
+            break;
+    }
+    mutex_unlock(&filter->mutex);
+    return res;
+}
@@ -26,6 +26,7 @@ static kernel_pid_t gnrc_wireless_interface;
 static void set_interface_roles(void)
 {
     kernel_pid_t ifs[GNRC_NETIF_NUMOF];
+    kernel_pid_t second_wired = KERNEL_PID_UNDEF;
     size_t numof = gnrc_netif_get(ifs);
 
     for (size_t i = 0; i < numof && i < GNRC_NETIF_NUMOF; i++) {
@@ -48,24 +49,72 @@ static void set_interface_roles(void)
         else if ((!gnrc_wireless_interface) && (is_wired != 1)) {
             gnrc_wireless_interface = dev;
         }
+        else if ((!second_wired) && (is_wired == 1)) {
+            second_wired = dev;
+        }
 
         if (gnrc_border_interface && gnrc_wireless_interface) {
             break;
         }
     }
 
+    /* e.g. native with two tap interfaces: use the second one as downstream
+     * interface */
+    if (!gnrc_wireless_interface) {
+        gnrc_wireless_interface = second_wired;
+    }
+
     LOG_INFO("gnrc_uhcpc: Using %u as border interface and %u as wireless interface.\n", gnrc_border_interface, gnrc_wireless_interface);
 }
 
 static ipv6_addr_t _prefix;
+static uint8_t _prefix_len;
+
+static void _set_lifetime(ipv6_addr_t *addr, uint16_t lifetime)
+{
+    gnrc_ipv6_netif_addr_t *netif_addr = gnrc_ipv6_netif_addr_get(addr);
+
+    if (lifetime == UHCP_LIFETIME_INFINITE) {
+        netif_addr->valid = UINT32_MAX;
+        netif_addr->preferred = UINT32_MAX;
+    }
+    else {
+        /* the prefix gets refreshed after half of its lifetime */
+        netif_addr->valid = lifetime;
+        netif_addr->preferred = lifetime / 2U;
+    }
+}
+
+static void _remove_prefix(void)
+{
+    gnrc_ipv6_netif_remove_addr(gnrc_wireless_interface, &_prefix);
+    print_str("gnrc_uhcpc: uhcp_handle_prefix(): removed old prefix ");
+    ipv6_addr_print(&_prefix);
+    printf("/%u\n", (unsigned)_prefix_len);
+    ipv6_addr_set_unspecified(&_prefix);
+}
+
+int uhcp_client_id(uint8_t *client_id)
+{
+    eui64_t iid;
+
+    /* the downstream interface is unique per border router, while all border
+     * routers might share the same address on the upstream link */
+    if (gnrc_netapi_get(gnrc_wireless_interface, NETOPT_IPV6_IID, 0, &iid,
+                        sizeof(eui64_t)) < 0) {
+        return -1;
+    }
+    memcpy(client_id, iid.uint8, UHCP_CLIENT_ID_LEN);
+    return 0;
+}
 
 void uhcp_handle_prefix(uint8_t *prefix, uint8_t prefix_len, uint16_t lifetime, uint8_t *src, uhcp_iface_t iface)
 {
-    (void)prefix_len;
-    (void)lifetime;
     (void)src;
 
     eui64_t iid;
+    ipv6_addr_t *addr;
+
     if (!gnrc_wireless_interface) {
         LOG_WARNING("gnrc_uhcpc: uhcp_handle_prefix(): received prefix, but don't know any wireless interface\n");
         return;
@@ -76,6 +125,11 @@ void uhcp_handle_prefix(uint8_t *prefix, uint8_t prefix_len, uint16_t lifetime,
         return;
     }
 
+    if (prefix_len > 64) {
+        LOG_WARNING("gnrc_uhcpc: uhcp_handle_prefix(): prefix too long for address autoconfiguration\n");
+        return;
+    }
+
     if (gnrc_netapi_get(gnrc_wireless_interface, NETOPT_IPV6_IID, 0, &iid,
                         sizeof(eui64_t)) >= 0) {
         ipv6_addr_set_aiid((ipv6_addr_t*)prefix, iid.uint8);
@@ -85,28 +139,43 @@ void uhcp_handle_prefix(uint8_t *prefix, uint8_t prefix_len, uint16_t lifetime,
         return;
     }
 
-    if (ipv6_addr_equal(&_prefix, (ipv6_addr_t*)prefix)) {
-        LOG_WARNING("gnrc_uhcpc: uhcp_handle_prefix(): got same prefix again\n");
+    if (lifetime == 0) {
+        if (ipv6_addr_equal(&_prefix, (ipv6_addr_t*)prefix)) {
+            _remove_prefix();
+        }
+        return;
+    }
+
+    if (ipv6_addr_equal(&_prefix, (ipv6_addr_t*)prefix) &&
+        (prefix_len == _prefix_len) &&
+        ((addr = gnrc_ipv6_netif_find_addr(gnrc_wireless_interface,
+                                           &_prefix)) != NULL)) {
+        /* lease refreshed, only the lifetime might have changed */
+        _set_lifetime(addr, lifetime);
         return;
     }
 
-    gnrc_ipv6_netif_add_addr(gnrc_wireless_interface, (ipv6_addr_t*)prefix, 64,
-                             GNRC_IPV6_NETIF_ADDR_FLAGS_UNICAST |
-                             GNRC_IPV6_NETIF_ADDR_FLAGS_NDP_AUTO);
+    addr = gnrc_ipv6_netif_add_addr(gnrc_wireless_interface,
+                                    (ipv6_addr_t*)prefix, prefix_len,
+                                    GNRC_IPV6_NETIF_ADDR_FLAGS_UNICAST |
+                                    GNRC_IPV6_NETIF_ADDR_FLAGS_NDP_AUTO);
+    if (addr == NULL) {
+        LOG_WARNING("gnrc_uhcpc: uhcp_handle_prefix(): cannot add prefix\n");
+        return;
+    }
+    _set_lifetime(addr, lifetime);
 
-    gnrc_ipv6_netif_remove_addr(gnrc_wireless_interface, &_prefix);
     print_str("gnrc_uhcpc: uhcp_handle_prefix(): configured new prefix ");
     ipv6_addr_print((ipv6_addr_t*)prefix);
-    puts("/64");
+    printf("/%u\n", (unsigned)prefix_len);
 
-    if (!ipv6_addr_is_unspecified(&_prefix)) {
-        gnrc_ipv6_netif_remove_addr(gnrc_wireless_interface, &_prefix);
-        print_str("gnrc_uhcpc: uhcp_handle_prefix(): removed old prefix ");
-        ipv6_addr_print(&_prefix);
-        puts("/64");
+    if (!ipv6_addr_is_unspecified(&_prefix) &&
+        !ipv6_addr_equal(&_prefix, (ipv6_addr_t*)prefix)) {
+        _remove_prefix();
     }
 
     memcpy(&_prefix, prefix, 16);
+    _prefix_len = prefix_len;
 }
 
 extern void uhcp_client(uhcp_iface_t iface);
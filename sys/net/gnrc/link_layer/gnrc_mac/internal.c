@@ -28,6 +28,16 @@
 #include "debug.h"
 
 #if ((GNRC_MAC_TX_QUEUE_SIZE != 0) || (GNRC_MAC_RX_QUEUE_SIZE != 0))
+static inline bool _is_free_pktqueue_node(gnrc_priority_pktqueue_node_t *node)
+{
+#ifdef MODULE_GNRC_PRIORITY_PKTQUEUE_HEAP
+    /* queued heap nodes always hold a packet */
+    return (node->pkt == NULL);
+#else
+    return (node->pkt == NULL) && (node->next == NULL);
+#endif
+}
+
 gnrc_priority_pktqueue_node_t *_alloc_pktqueue_node(gnrc_priority_pktqueue_node_t *nodes,
                                                     uint32_t size)
 {
@@ -36,8 +46,7 @@ gnrc_priority_pktqueue_node_t *_alloc_pktqueue_node(gnrc_priority_pktqueue_node_
 
     /* search for free packet_queue_node */
     for (size_t i = 0; i < size; i++) {
-        if ((nodes[i].pkt == NULL) &&
-            (nodes[i].next == NULL)) {
+        if (_is_free_pktqueue_node(&nodes[i])) {
             return &nodes[i];
         }
     }
@@ -125,6 +134,10 @@ bool gnrc_mac_queue_tx_packet(gnrc_mac_tx_t *tx, uint32_t priority, gnrc_pktsnip
     assert(tx != NULL);
     assert(pkt != NULL);
 
+#ifdef MODULE_GNRC_PRIORITY_PKTQUEUE_DRR
+    priority = gnrc_priority_pktqueue_classify(pkt, priority);
+#endif
+
 #if GNRC_MAC_NEIGHBOR_COUNT == 0
 
     gnrc_priority_pktqueue_node_t *node;
@@ -132,7 +145,11 @@ bool gnrc_mac_queue_tx_packet(gnrc_mac_tx_t *tx, uint32_t priority, gnrc_pktsnip
 
     if (node) {
         gnrc_priority_pktqueue_node_init(node, priority, pkt);
-        gnrc_priority_pktqueue_push(&tx->queue, node);
+        if (gnrc_priority_pktqueue_push(&tx->queue, node) < 0) {
+            DEBUG("[gnrc_mac-int] Can't push to TX queue, class is full\n");
+            gnrc_priority_pktqueue_node_init(node, 0, NULL);
+            return false;
+        }
         return true;
     }
 
@@ -201,7 +218,12 @@ bool gnrc_mac_queue_tx_packet(gnrc_mac_tx_t *tx, uint32_t priority, gnrc_pktsnip
     node = _alloc_pktqueue_node(tx->_queue_nodes, GNRC_MAC_TX_QUEUE_SIZE);
     if (node) {
         gnrc_priority_pktqueue_node_init(node, priority, pkt);
-        gnrc_priority_pktqueue_push(&neighbor->queue, node);
+        if (gnrc_priority_pktqueue_push(&neighbor->queue, node) < 0) {
+            DEBUG("[gnrc_mac-int] Can't push to neighbor #%d's queue, class "
+                  "is full\n", neighbor_id);
+            gnrc_priority_pktqueue_node_init(node, 0, NULL);
+            return false;
+        }
         DEBUG("[gnrc_mac-int] Queuing pkt to neighbor #%d\n", neighbor_id);
         return true;
     }
@@ -220,12 +242,20 @@ bool gnrc_mac_queue_rx_packet(gnrc_mac_rx_t *rx, uint32_t priority, gnrc_pktsnip
     assert(rx != NULL);
     assert(pkt != NULL);
 
+#ifdef MODULE_GNRC_PRIORITY_PKTQUEUE_DRR
+    priority = gnrc_priority_pktqueue_classify(pkt, priority);
+#endif
+
     gnrc_priority_pktqueue_node_t *node;
     node = _alloc_pktqueue_node(rx->_queue_nodes, GNRC_MAC_RX_QUEUE_SIZE);
 
     if (node) {
         gnrc_priority_pktqueue_node_init(node, priority, pkt);
-        gnrc_priority_pktqueue_push(&rx->queue, node);
+        if (gnrc_priority_pktqueue_push(&rx->queue, node) < 0) {
+            DEBUG("[gnrc_mac-int] Can't push to RX queue, class is full\n");
+            gnrc_priority_pktqueue_node_init(node, 0, NULL);
+            return false;
+        }
         return true;
     }
 
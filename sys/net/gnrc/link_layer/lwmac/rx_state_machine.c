@@ -253,7 +253,10 @@ static uint8_t _packet_process_in_wait_for_data(gnrc_netdev_t *gnrc_netdev)
             gnrc_lwmac_clear_timeout(gnrc_netdev, GNRC_LWMAC_TIMEOUT_DATA);
             rx_info |= GNRC_LWMAC_RX_FOUND_WR;
             /* Push WR back to rx queue */
-            gnrc_mac_queue_rx_packet(&gnrc_netdev->rx, 0, pkt);
+            if (!gnrc_mac_queue_rx_packet(&gnrc_netdev->rx, 0, pkt)) {
+                LOG_WARNING("WARNING: [LWMAC-rx] RX queue full, drop WR\n");
+                gnrc_pktbuf_release(pkt);
+            }
             break;
         }
 
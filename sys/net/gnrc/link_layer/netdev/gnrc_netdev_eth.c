@@ -18,11 +18,15 @@
 
 #include "net/gnrc.h"
 #include "net/gnrc/netdev.h"
+#include "net/gnrc/pktfilter.h"
 #include "net/ethernet/hdr.h"
 
 #ifdef MODULE_GNRC_IPV6
 #include "net/ipv6/hdr.h"
 #endif
+#ifdef MODULE_GNRC_IPV4
+#include "net/ipv4/hdr.h"
+#endif
 
 #include "od.h"
 
@@ -78,6 +82,13 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev_t *gnrc_netdev)
             goto safe_out;
         }
 #endif
+#ifdef MODULE_GNRC_PKTFILTER
+        if (!gnrc_pktfilter_l2(hdr->src, ETHERNET_ADDR_LEN,
+                               hdr->dst, ETHERNET_ADDR_LEN)) {
+            DEBUG("gnrc_netdev_eth: incoming packet filtered by pktfilter\n");
+            goto safe_out;
+        }
+#endif
 
         /* set payload type from ethertype */
         pkt->type = gnrc_nettype_from_ethertype(byteorder_ntohs(hdr->type));
@@ -135,6 +146,18 @@ static inline void _addr_set_multicast(uint8_t *dst, gnrc_pktsnip_t *payload)
             ipv6_hdr_t *ipv6 = payload->data;
             memcpy(dst + 2, ipv6->dst.u8 + 12, 4);
             break;
+#endif
+#ifdef MODULE_GNRC_IPV4
+        case GNRC_NETTYPE_IPV4:
+            /* https://tools.ietf.org/html/rfc1112#section-6.4 */
+            dst[0] = 0x01;
+            dst[1] = 0x00;
+            dst[2] = 0x5e;
+            ipv4_hdr_t *ipv4 = payload->data;
+            dst[3] = ipv4->dst.u8[1] & 0x7f;
+            dst[4] = ipv4->dst.u8[2];
+            dst[5] = ipv4->dst.u8[3];
+            break;
 #endif
         default:
             _addr_set_broadcast(dst);
@@ -17,6 +17,7 @@
 
 #include "od.h"
 #include "net/l2filter.h"
+#include "net/gnrc/pktfilter.h"
 #include "net/gnrc.h"
 #include "net/ieee802154.h"
 
@@ -43,27 +44,19 @@ int gnrc_netdev_ieee802154_init(gnrc_netdev_t *gnrc_netdev,
     return 0;
 }
 
-static gnrc_pktsnip_t *_make_netif_hdr(uint8_t *mhr)
+static gnrc_pktsnip_t *_make_netif_hdr(ieee802154_mhr_t *mhr)
 {
     gnrc_pktsnip_t *snip;
-    uint8_t src[IEEE802154_LONG_ADDRESS_LEN], dst[IEEE802154_LONG_ADDRESS_LEN];
-    int src_len, dst_len;
-    le_uint16_t _pan_tmp;   /* TODO: hand-up PAN IDs to GNRC? */
 
-    dst_len = ieee802154_get_dst(mhr, dst, &_pan_tmp);
-    src_len = ieee802154_get_src(mhr, src, &_pan_tmp);
-    if ((dst_len < 0) || (src_len < 0)) {
-        DEBUG("_make_netif_hdr: unable to get addresses\n");
-        return NULL;
-    }
+    /* TODO: hand-up PAN IDs to GNRC? */
     /* allocate space for header */
-    snip = gnrc_netif_hdr_build(src, (size_t)src_len, dst, (size_t)dst_len);
+    snip = gnrc_netif_hdr_build(mhr->src, mhr->src_len, mhr->dst, mhr->dst_len);
     if (snip == NULL) {
         DEBUG("_make_netif_hdr: no space left in packet buffer\n");
         return NULL;
     }
     /* set broadcast flag for broadcast destination */
-    if ((dst_len == 2) && (dst[0] == 0xff) && (dst[1] == 0xff)) {
+    if ((mhr->dst_len == 2) && (mhr->dst[0] == 0xff) && (mhr->dst[1] == 0xff)) {
         gnrc_netif_hdr_t *hdr = snip->data;
         hdr->flags |= GNRC_NETIF_HDR_FLAGS_BROADCAST;
     }
@@ -97,9 +90,10 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev_t *gnrc_netdev)
 #if ENABLE_DEBUG
             char src_str[GNRC_NETIF_HDR_L2ADDR_PRINT_LEN];
 #endif
-            size_t mhr_len = ieee802154_get_frame_hdr_len(pkt->data);
+            ieee802154_mhr_t mhr;
+            int mhr_len = ieee802154_parse_mhr(pkt->data, nread, &mhr);
 
-            if (mhr_len == 0) {
+            if (mhr_len < 0) {
                 DEBUG("_recv_ieee802154: illegally formatted frame received\n");
                 gnrc_pktbuf_release(pkt);
                 return NULL;
@@ -112,7 +106,7 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev_t *gnrc_netdev)
                 gnrc_pktbuf_release(pkt);
                 return NULL;
             }
-            netif_hdr = _make_netif_hdr(ieee802154_hdr->data);
+            netif_hdr = _make_netif_hdr(&mhr);
             if (netif_hdr == NULL) {
                 DEBUG("_recv_ieee802154: no space left in packet buffer\n");
                 gnrc_pktbuf_release(pkt);
@@ -130,6 +124,17 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev_t *gnrc_netdev)
                 return NULL;
             }
 #endif
+#ifdef MODULE_GNRC_PKTFILTER
+            if (!gnrc_pktfilter_l2(gnrc_netif_hdr_get_src_addr(hdr),
+                                   hdr->src_l2addr_len,
+                                   gnrc_netif_hdr_get_dst_addr(hdr),
+                                   hdr->dst_l2addr_len)) {
+                gnrc_pktbuf_release(pkt);
+                gnrc_pktbuf_release(netif_hdr);
+                DEBUG("_recv_ieee802154: packet dropped by pktfilter\n");
+                return NULL;
+            }
+#endif
 
             hdr->lqi = rx_info.lqi;
             hdr->rssi = rx_info.rssi;
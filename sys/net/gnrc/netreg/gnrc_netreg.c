@@ -21,6 +21,7 @@
 #include "net/gnrc/nettype.h"
 #include "net/gnrc/pkt.h"
 #include "net/gnrc/icmpv6.h"
+#include "net/gnrc/ipv4/icmp.h"
 #include "net/gnrc/ipv6.h"
 #include "net/gnrc/udp.h"
 #include "net/gnrc/tcp.h"
@@ -131,6 +132,10 @@ int gnrc_netreg_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr)
         case GNRC_NETTYPE_ICMPV6:
             return gnrc_icmpv6_calc_csum(hdr, pseudo_hdr);
 #endif
+#ifdef MODULE_GNRC_IPV4
+        case GNRC_NETTYPE_ICMP:
+            return gnrc_ipv4_icmp_calc_csum(hdr, pseudo_hdr);
+#endif
 #ifdef MODULE_GNRC_TCP
         case GNRC_NETTYPE_TCP:
             return gnrc_tcp_calc_csum(hdr, pseudo_hdr);
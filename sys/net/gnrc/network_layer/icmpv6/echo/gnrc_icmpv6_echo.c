@@ -18,6 +18,7 @@
 #include "net/gnrc/icmpv6.h"
 #include "net/gnrc/icmpv6/echo.h"
 #include "net/gnrc/ipv6/hdr.h"
+#include "net/protnum.h"
 #include "utlist.h"
 
 #define ENABLE_DEBUG    (0)
@@ -109,4 +110,100 @@ void gnrc_icmpv6_echo_req_handle(kernel_pid_t iface, ipv6_hdr_t *ipv6_hdr,
     }
 }
 
+void gnrc_icmpv6_echo_req_reply(kernel_pid_t iface, gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *icmpv6, *ipv6, *netif, *tmp;
+    ipv6_hdr_t *ipv6_hdr;
+    icmpv6_echo_t *echo;
+    ipv6_addr_t dst;
+
+    assert((pkt != NULL) && (pkt->type == GNRC_NETTYPE_ICMPV6));
+
+    if (pkt->size < sizeof(icmpv6_echo_t)) {
+        DEBUG("icmpv6_echo: echo request too short\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+
+    /* every snip gets relinked, so write protect all of them */
+    if ((icmpv6 = gnrc_pktbuf_start_write(pkt)) == NULL) {
+        DEBUG("icmpv6_echo: no space left in packet buffer\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    for (tmp = icmpv6; tmp->next != NULL; tmp = tmp->next) {
+        gnrc_pktsnip_t *next = gnrc_pktbuf_start_write(tmp->next);
+
+        if (next == NULL) {
+            DEBUG("icmpv6_echo: no space left in packet buffer\n");
+            gnrc_pktbuf_release(icmpv6);
+            return;
+        }
+        tmp->next = next;
+    }
+    ipv6 = gnrc_pktsnip_search_type(icmpv6, GNRC_NETTYPE_IPV6);
+    netif = gnrc_pktsnip_search_type(icmpv6, GNRC_NETTYPE_NETIF);
+    assert(ipv6 != NULL);
+
+    /* unlink all headers, the reply carries no extension headers */
+    tmp = icmpv6->next;
+    icmpv6->next = NULL;
+    while (tmp != NULL) {
+        gnrc_pktsnip_t *next = tmp->next;
+
+        tmp->next = NULL;
+        if ((tmp != ipv6) && (tmp != netif)) {
+            gnrc_pktbuf_release(tmp);
+        }
+        tmp = next;
+    }
+
+    echo = icmpv6->data;
+    echo->type = ICMPV6_ECHO_REP;
+    echo->code = 0;
+    echo->csum.u16 = 0;     /* calculated by IPv6 */
+
+    /* same header as gnrc_ipv6_hdr_build() would create */
+    ipv6_hdr = ipv6->data;
+    dst = ipv6_hdr->src;
+    if (ipv6_addr_is_multicast(&ipv6_hdr->dst)) {
+        ipv6_addr_set_unspecified(&ipv6_hdr->src);
+    }
+    else {
+        ipv6_hdr->src = ipv6_hdr->dst;
+    }
+    ipv6_hdr->dst = dst;
+    ipv6_hdr_set_version(ipv6_hdr);
+    ipv6_hdr_set_tc(ipv6_hdr, 0);
+    ipv6_hdr_set_fl(ipv6_hdr, 0);
+    ipv6_hdr->nh = PROTNUM_RESERVED;
+    ipv6_hdr->hl = 0;
+    ipv6->next = icmpv6;
+    pkt = ipv6;
+
+    if ((netif != NULL) &&
+        (gnrc_pktbuf_realloc_data(netif, sizeof(gnrc_netif_hdr_t)) != 0)) {
+        gnrc_pktbuf_release(netif);
+        netif = NULL;
+    }
+    if (netif == NULL) {
+        if ((netif = gnrc_netif_hdr_build(NULL, 0, NULL, 0)) == NULL) {
+            DEBUG("icmpv6_echo: no space left in packet buffer\n");
+            gnrc_pktbuf_release(pkt);
+            return;
+        }
+    }
+    else {
+        gnrc_netif_hdr_init(netif->data, 0, 0);
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = iface;
+    LL_PREPEND(pkt, netif);
+
+    if (!gnrc_netapi_dispatch_send(GNRC_NETTYPE_IPV6, GNRC_NETREG_DEMUX_CTX_ALL,
+                                   pkt)) {
+        DEBUG("icmpv6_echo: no receivers for IPv6 packets\n");
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
 /** @} */
@@ -89,6 +89,13 @@ void gnrc_icmpv6_demux(kernel_pid_t iface, gnrc_pktsnip_t *pkt)
 #ifdef MODULE_GNRC_ICMPV6_ECHO
         case ICMPV6_ECHO_REQ:
             DEBUG("icmpv6: handle echo request.\n");
+            if ((pkt == icmpv6) &&
+                (gnrc_netreg_num(GNRC_NETTYPE_ICMPV6, ICMPV6_ECHO_REQ) == 0)) {
+                /* nobody else is interested in the request, so reuse it for
+                 * the reply */
+                gnrc_icmpv6_echo_req_reply(iface, pkt);
+                return;
+            }
             gnrc_icmpv6_echo_req_handle(iface, (ipv6_hdr_t *)ipv6->data,
                                         (icmpv6_echo_t *)hdr, icmpv6->size);
             break;
@@ -0,0 +1,310 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "net/ethertype.h"
+#include "net/netopt.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv4.h"
+#include "utlist.h"
+
+#include "net/gnrc/ipv4/arp.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#if ENABLE_DEBUG
+static char addr_str[IPV4_ADDR_MAX_STR_LEN];
+#endif
+
+static gnrc_ipv4_arp_t _cache[GNRC_IPV4_ARP_CACHE_SIZE];
+
+static gnrc_ipv4_arp_t *_find(const ipv4_addr_t *addr)
+{
+    for (unsigned i = 0; i < GNRC_IPV4_ARP_CACHE_SIZE; i++) {
+        if ((_cache[i].state != GNRC_IPV4_ARP_STATE_EMPTY) &&
+            (_cache[i].addr.u32.u32 == addr->u32.u32)) {
+            return &_cache[i];
+        }
+    }
+    return NULL;
+}
+
+static void _clear(gnrc_ipv4_arp_t *entry)
+{
+    xtimer_remove(&entry->timer);
+    if (entry->pending != NULL) {
+        gnrc_pktbuf_release(entry->pending);
+    }
+    memset(entry, 0, sizeof(gnrc_ipv4_arp_t));
+}
+
+/* returns a free entry or replaces the resolved entry expiring first */
+static gnrc_ipv4_arp_t *_alloc(void)
+{
+    gnrc_ipv4_arp_t *res = NULL;
+    uint32_t now = xtimer_now_usec();
+
+    for (unsigned i = 0; i < GNRC_IPV4_ARP_CACHE_SIZE; i++) {
+        gnrc_ipv4_arp_t *entry = &_cache[i];
+
+        if (entry->state == GNRC_IPV4_ARP_STATE_EMPTY) {
+            return entry;
+        }
+        if ((entry->state == GNRC_IPV4_ARP_STATE_REACHABLE) &&
+            ((res == NULL) ||
+             ((int32_t)(entry->expires - now) < (int32_t)(res->expires - now)))) {
+            res = entry;
+        }
+    }
+    if (res != NULL) {
+        _clear(res);
+    }
+    return res;
+}
+
+static int _send_arp(kernel_pid_t iface, uint16_t op, const ipv4_addr_t *tpa,
+                     const uint8_t *tha)
+{
+    gnrc_ipv4_netif_t *netif = gnrc_ipv4_netif_get(iface);
+    gnrc_pktsnip_t *pkt, *hdr;
+    arp_hdr_t *arp;
+
+    if (netif == NULL) {
+        return -ENOENT;
+    }
+    pkt = gnrc_pktbuf_add(NULL, NULL, sizeof(arp_hdr_t), GNRC_NETTYPE_ARP);
+    if (pkt == NULL) {
+        return -ENOMEM;
+    }
+    arp = pkt->data;
+    arp->htype = byteorder_htons(ARP_HTYPE_ETHERNET);
+    arp->ptype = byteorder_htons(ETHERTYPE_IPV4);
+    arp->hlen = ETHERNET_ADDR_LEN;
+    arp->plen = sizeof(ipv4_addr_t);
+    arp->op = byteorder_htons(op);
+    if (gnrc_netapi_get(iface, NETOPT_ADDRESS, 0, arp->sha,
+                        sizeof(arp->sha)) != sizeof(arp->sha)) {
+        DEBUG("arp: unable to get link layer address of %" PRIkernel_pid "\n",
+              iface);
+        gnrc_pktbuf_release(pkt);
+        return -ENOENT;
+    }
+    arp->spa = netif->addr;
+    if (tha != NULL) {
+        memcpy(arp->tha, tha, sizeof(arp->tha));
+    }
+    else {
+        memset(arp->tha, 0, sizeof(arp->tha));
+    }
+    arp->tpa = *tpa;
+
+    hdr = gnrc_netif_hdr_build(NULL, 0, (uint8_t *)tha,
+                               (tha != NULL) ? ETHERNET_ADDR_LEN : 0);
+    if (hdr == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return -ENOMEM;
+    }
+    ((gnrc_netif_hdr_t *)hdr->data)->if_pid = iface;
+    if (tha == NULL) {
+        ((gnrc_netif_hdr_t *)hdr->data)->flags = GNRC_NETIF_HDR_FLAGS_BROADCAST;
+    }
+    LL_PREPEND(pkt, hdr);
+    if (gnrc_netapi_send(iface, pkt) < 1) {
+        DEBUG("arp: unable to send packet\n");
+        gnrc_pktbuf_release(pkt);
+        return -EIO;
+    }
+    return 0;
+}
+
+static void _set_reachable(gnrc_ipv4_arp_t *entry, const uint8_t *l2addr)
+{
+    gnrc_pktsnip_t *pkt = entry->pending;
+
+    xtimer_remove(&entry->timer);
+    memcpy(entry->l2addr, l2addr, ETHERNET_ADDR_LEN);
+    if (entry->state != GNRC_IPV4_ARP_STATE_STATIC) {
+        entry->state = GNRC_IPV4_ARP_STATE_REACHABLE;
+        entry->expires = xtimer_now_usec() + GNRC_IPV4_ARP_REACHABLE_TIME;
+    }
+    entry->pending = NULL;
+    if (pkt != NULL) {
+        DEBUG("arp: send pending packet\n");
+        gnrc_netif_hdr_set_dst_addr(pkt->data, entry->l2addr, ETHERNET_ADDR_LEN);
+        if (gnrc_netapi_send(entry->iface, pkt) < 1) {
+            DEBUG("arp: unable to send pending packet\n");
+            gnrc_pktbuf_release(pkt);
+        }
+    }
+}
+
+int gnrc_ipv4_arp_resolve(kernel_pid_t iface, const ipv4_addr_t *addr,
+                          gnrc_pktsnip_t *pkt)
+{
+    gnrc_ipv4_arp_t *entry = _find(addr);
+
+    assert((pkt != NULL) && (pkt->type == GNRC_NETTYPE_NETIF) &&
+           (((gnrc_netif_hdr_t *)pkt->data)->dst_l2addr_len == ETHERNET_ADDR_LEN));
+
+    if ((entry != NULL) && (entry->iface == iface)) {
+        switch (entry->state) {
+            case GNRC_IPV4_ARP_STATE_STATIC:
+                break;
+            case GNRC_IPV4_ARP_STATE_REACHABLE:
+                if ((int32_t)(entry->expires - xtimer_now_usec()) > 0) {
+                    break;
+                }
+                /* entry expired, resolve again */
+                entry->state = GNRC_IPV4_ARP_STATE_INCOMPLETE;
+                entry->retrans = GNRC_IPV4_ARP_MAX_RETRANS;
+                gnrc_ipv4_arp_retrans(entry);
+                /* fall through */
+            default:
+                if (entry->pending != NULL) {
+                    DEBUG("arp: drop packet waiting for resolution\n");
+                    gnrc_pktbuf_release(entry->pending);
+                }
+                entry->pending = pkt;
+                return 0;
+        }
+        gnrc_netif_hdr_set_dst_addr(pkt->data, entry->l2addr, ETHERNET_ADDR_LEN);
+        return 1;
+    }
+    if (entry != NULL) {
+        /* address moved to another interface */
+        _clear(entry);
+    }
+    if ((entry = _alloc()) == NULL) {
+        DEBUG("arp: cache full\n");
+        return -ENOMEM;
+    }
+    DEBUG("arp: resolve %s\n", ipv4_addr_to_str(addr_str, addr, sizeof(addr_str)));
+    entry->addr = *addr;
+    entry->iface = iface;
+    entry->state = GNRC_IPV4_ARP_STATE_INCOMPLETE;
+    entry->retrans = GNRC_IPV4_ARP_MAX_RETRANS;
+    entry->pending = pkt;
+    gnrc_ipv4_arp_retrans(entry);
+    return 0;
+}
+
+void gnrc_ipv4_arp_receive(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *netif = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_NETIF);
+    arp_hdr_t *arp = pkt->data;
+    gnrc_ipv4_netif_t *ipv4_netif;
+    gnrc_ipv4_arp_t *entry;
+    kernel_pid_t iface;
+
+    if ((netif == NULL) || (pkt->size < sizeof(arp_hdr_t)) ||
+        (byteorder_ntohs(arp->htype) != ARP_HTYPE_ETHERNET) ||
+        (byteorder_ntohs(arp->ptype) != ETHERTYPE_IPV4) ||
+        (arp->hlen != ETHERNET_ADDR_LEN) ||
+        (arp->plen != sizeof(ipv4_addr_t))) {
+        DEBUG("arp: unsupported packet, dropping it\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    iface = ((gnrc_netif_hdr_t *)netif->data)->if_pid;
+    if ((ipv4_netif = gnrc_ipv4_netif_get(iface)) == NULL) {
+        DEBUG("arp: interface not configured for IPv4\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    DEBUG("arp: received op %u from %s\n", byteorder_ntohs(arp->op),
+          ipv4_addr_to_str(addr_str, &arp->spa, sizeof(addr_str)));
+
+    /* RFC 826, "Packet reception": update the sender if known, add it if the
+     * packet is meant for us */
+    entry = _find(&arp->spa);
+    if ((entry != NULL) && (entry->iface == iface)) {
+        _set_reachable(entry, arp->sha);
+    }
+    if (arp->tpa.u32.u32 != ipv4_netif->addr.u32.u32) {
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    if ((entry == NULL) && ((entry = _alloc()) != NULL)) {
+        entry->addr = arp->spa;
+        entry->iface = iface;
+        _set_reachable(entry, arp->sha);
+    }
+    if (byteorder_ntohs(arp->op) == ARP_OP_REQUEST) {
+        DEBUG("arp: answer request\n");
+        _send_arp(iface, ARP_OP_REPLY, &arp->spa, arp->sha);
+    }
+    gnrc_pktbuf_release(pkt);
+}
+
+void gnrc_ipv4_arp_retrans(gnrc_ipv4_arp_t *entry)
+{
+    if (entry->state != GNRC_IPV4_ARP_STATE_INCOMPLETE) {
+        return;
+    }
+    if (entry->retrans == 0) {
+        DEBUG("arp: resolution of %s failed\n",
+              ipv4_addr_to_str(addr_str, &entry->addr, sizeof(addr_str)));
+        _clear(entry);
+        return;
+    }
+    entry->retrans--;
+    _send_arp(entry->iface, ARP_OP_REQUEST, &entry->addr, NULL);
+    entry->msg.type = GNRC_IPV4_ARP_MSG_RETRANS;
+    entry->msg.content.ptr = entry;
+    xtimer_set_msg(&entry->timer, GNRC_IPV4_ARP_RETRANS_TIMER, &entry->msg,
+                   gnrc_ipv4_pid);
+}
+
+int gnrc_ipv4_arp_add(kernel_pid_t iface, const ipv4_addr_t *addr,
+                      const uint8_t *l2addr)
+{
+    gnrc_ipv4_arp_t *entry = _find(addr);
+
+    if ((entry == NULL) && ((entry = _alloc()) == NULL)) {
+        return -ENOMEM;
+    }
+    entry->addr = *addr;
+    entry->iface = iface;
+    entry->state = GNRC_IPV4_ARP_STATE_STATIC;
+    _set_reachable(entry, l2addr);
+    return 0;
+}
+
+void gnrc_ipv4_arp_remove(const ipv4_addr_t *addr)
+{
+    gnrc_ipv4_arp_t *entry = _find(addr);
+
+    if (entry != NULL) {
+        _clear(entry);
+    }
+}
+
+const gnrc_ipv4_arp_t *gnrc_ipv4_arp_get(unsigned idx)
+{
+    assert(idx < GNRC_IPV4_ARP_CACHE_SIZE);
+    return &_cache[idx];
+}
+
+void gnrc_ipv4_arp_reset(void)
+{
+    for (unsigned i = 0; i < GNRC_IPV4_ARP_CACHE_SIZE; i++) {
+        _clear(&_cache[i]);
+    }
+}
+
+/** @} */
@@ -0,0 +1,491 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "net/ethernet/hdr.h"
+#include "net/fib.h"
+#include "net/fib/table.h"
+#include "net/inet_csum.h"
+#include "net/netopt.h"
+#include "net/protnum.h"
+#include "thread.h"
+#include "utlist.h"
+
+#include "net/gnrc/ipv4.h"
+#include "net/gnrc/ipv4/arp.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/* minimum size of a datagram every host must be able to receive
+ * (RFC 791, section 3.1) */
+#define _MIN_MTU        (576U)
+
+#if ENABLE_DEBUG
+static char _stack[GNRC_IPV4_STACK_SIZE + THREAD_EXTRA_STACKSIZE_PRINTF];
+static char addr_str[IPV4_ADDR_MAX_STR_LEN];
+#else
+static char _stack[GNRC_IPV4_STACK_SIZE];
+#endif
+
+static fib_entry_t _fib_entries[GNRC_IPV4_FIB_TABLE_SIZE];
+
+/**
+ * @brief the IPv4 forwarding table
+ */
+fib_table_t gnrc_ipv4_fib_table;
+
+kernel_pid_t gnrc_ipv4_pid = KERNEL_PID_UNDEF;
+
+static uint16_t _id;
+
+/* handles GNRC_NETAPI_MSG_TYPE_RCV commands */
+static void _receive(gnrc_pktsnip_t *pkt);
+/* handles GNRC_NETAPI_MSG_TYPE_SND commands */
+static void _send(gnrc_pktsnip_t *pkt);
+/* Main event loop for IPv4 */
+static void *_event_loop(void *args);
+
+kernel_pid_t gnrc_ipv4_init(void)
+{
+    if (gnrc_ipv4_pid == KERNEL_PID_UNDEF) {
+        gnrc_ipv4_fib_table.data.entries = _fib_entries;
+        gnrc_ipv4_fib_table.table_type = FIB_TABLE_TYPE_SH;
+        gnrc_ipv4_fib_table.size = GNRC_IPV4_FIB_TABLE_SIZE;
+        fib_init(&gnrc_ipv4_fib_table);
+
+        gnrc_ipv4_pid = thread_create(_stack, sizeof(_stack), GNRC_IPV4_PRIO,
+                                      THREAD_CREATE_STACKTEST,
+                                      _event_loop, NULL, "ipv4");
+    }
+
+    return gnrc_ipv4_pid;
+}
+
+ipv4_hdr_t *gnrc_ipv4_get_header(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *tmp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_IPV4);
+
+    if ((tmp == NULL) || (tmp->size < sizeof(ipv4_hdr_t))) {
+        return NULL;
+    }
+    return tmp->data;
+}
+
+static void *_event_loop(void *args)
+{
+    msg_t msg, reply, msg_q[GNRC_IPV4_MSG_QUEUE_SIZE];
+    gnrc_netreg_entry_t me_reg = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                            sched_active_pid);
+    gnrc_netreg_entry_t arp_reg = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                             sched_active_pid);
+
+    (void)args;
+    msg_init_queue(msg_q, GNRC_IPV4_MSG_QUEUE_SIZE);
+
+    /* register interest in all IPv4 and ARP packets */
+    gnrc_netreg_register(GNRC_NETTYPE_IPV4, &me_reg);
+    gnrc_netreg_register(GNRC_NETTYPE_ARP, &arp_reg);
+
+    /* preinitialize ACK */
+    reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+
+    /* start event loop */
+    while (1) {
+        DEBUG("ipv4: waiting for incoming message.\n");
+        msg_receive(&msg);
+
+        switch (msg.type) {
+            case GNRC_NETAPI_MSG_TYPE_RCV:
+                DEBUG("ipv4: GNRC_NETAPI_MSG_TYPE_RCV received\n");
+                if (((gnrc_pktsnip_t *)msg.content.ptr)->type == GNRC_NETTYPE_ARP) {
+                    gnrc_ipv4_arp_receive(msg.content.ptr);
+                }
+                else {
+                    _receive(msg.content.ptr);
+                }
+                break;
+
+            case GNRC_NETAPI_MSG_TYPE_SND:
+                DEBUG("ipv4: GNRC_NETAPI_MSG_TYPE_SND received\n");
+                _send(msg.content.ptr);
+                break;
+
+            case GNRC_NETAPI_MSG_TYPE_GET:
+            case GNRC_NETAPI_MSG_TYPE_SET:
+                DEBUG("ipv4: reply to unsupported get/set\n");
+                reply.content.value = -ENOTSUP;
+                msg_reply(&msg, &reply);
+                break;
+
+            case GNRC_IPV4_ARP_MSG_RETRANS:
+                DEBUG("ipv4: ARP retransmission timer event received\n");
+                gnrc_ipv4_arp_retrans(msg.content.ptr);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return NULL;
+}
+
+/* functions for sending */
+static int _fill_ipv4_hdr(const gnrc_ipv4_netif_t *netif, gnrc_pktsnip_t *ipv4,
+                          gnrc_pktsnip_t *payload)
+{
+    ipv4_hdr_t *hdr = ipv4->data;
+    int res;
+
+    hdr->tl = byteorder_htons(gnrc_pkt_len(ipv4));
+    hdr->id = byteorder_htons(_id++);
+
+    if (hdr->protocol == PROTNUM_RESERVED) {
+        hdr->protocol = gnrc_nettype_to_protnum(payload->type);
+    }
+    if (hdr->ttl == 0) {
+        hdr->ttl = GNRC_IPV4_DEFAULT_TTL;
+    }
+    if (hdr->src.u32.u32 == 0) {
+        if (netif != NULL) {
+            hdr->src = netif->addr;
+        }
+        else {
+            /* loopback */
+            hdr->src = hdr->dst;
+        }
+    }
+
+    DEBUG("ipv4: calculate checksum for upper header.\n");
+    if ((res = gnrc_netreg_calc_csum(payload, ipv4)) < 0) {
+        if (res != -ENOENT) {   /* if there is no checksum we are okay */
+            DEBUG("ipv4: checksum calculation failed.\n");
+            return res;
+        }
+    }
+
+    hdr->csum.u16 = 0;
+    hdr->csum = byteorder_htons(~inet_csum(0, ipv4->data, ipv4->size));
+
+    return 0;
+}
+
+static void _send_loopback(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *rcv_pkt;
+    uint8_t *rcv_data;
+
+    rcv_pkt = gnrc_pktbuf_add(NULL, NULL, gnrc_pkt_len(pkt), GNRC_NETTYPE_IPV4);
+    if (rcv_pkt == NULL) {
+        DEBUG("ipv4: error on generating loopback packet\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+
+    /* "reverse" packet (by making it one snip as if received from NIC) */
+    rcv_data = rcv_pkt->data;
+    for (gnrc_pktsnip_t *ptr = pkt; ptr != NULL; ptr = ptr->next) {
+        memcpy(rcv_data, ptr->data, ptr->size);
+        rcv_data += ptr->size;
+    }
+    gnrc_pktbuf_release(pkt);
+
+    DEBUG("ipv4: packet is addressed to myself => loopback\n");
+    if (gnrc_netapi_receive(gnrc_ipv4_pid, rcv_pkt) < 1) {
+        DEBUG("ipv4: unable to deliver packet\n");
+        gnrc_pktbuf_release(rcv_pkt);
+    }
+}
+
+static gnrc_ipv4_netif_t *_next_hop(ipv4_addr_t *next_hop, kernel_pid_t iface,
+                                    const ipv4_addr_t *dst)
+{
+    gnrc_ipv4_netif_t *netif = gnrc_ipv4_netif_find_by_prefix(dst);
+    size_t next_hop_size = sizeof(ipv4_addr_t);
+    uint32_t next_hop_flags = 0;
+    kernel_pid_t fib_iface;
+
+    if ((netif != NULL) &&
+        ((iface == KERNEL_PID_UNDEF) || (netif->pid == iface))) {
+        /* destination is on-link */
+        *next_hop = *dst;
+        return netif;
+    }
+    if (fib_get_next_hop(&gnrc_ipv4_fib_table, &fib_iface, next_hop->u8,
+                         &next_hop_size, &next_hop_flags, (uint8_t *)dst->u8,
+                         sizeof(ipv4_addr_t), 0) < 0) {
+        DEBUG("ipv4: no route to %s\n",
+              ipv4_addr_to_str(addr_str, dst, sizeof(addr_str)));
+        return NULL;
+    }
+    if ((iface != KERNEL_PID_UNDEF) && (fib_iface != iface)) {
+        DEBUG("ipv4: route does not use requested interface\n");
+        return NULL;
+    }
+    return gnrc_ipv4_netif_get(fib_iface);
+}
+
+static void _send(gnrc_pktsnip_t *pkt)
+{
+    kernel_pid_t iface = KERNEL_PID_UNDEF;
+    gnrc_ipv4_netif_t *netif = NULL;
+    gnrc_pktsnip_t *ipv4, *netif_snip;
+    gnrc_netif_hdr_t *netif_hdr;
+    ipv4_addr_t next_hop;
+    ipv4_hdr_t *hdr;
+    uint8_t flags = 0;
+
+    if (pkt->type == GNRC_NETTYPE_NETIF) {
+        /* a higher layer preset the sending interface and maybe flags */
+        if ((netif_snip = gnrc_pktbuf_start_write(pkt)) == NULL) {
+            DEBUG("ipv4: unable to get write access to netif header, dropping packet\n");
+            gnrc_pktbuf_release(pkt);
+            return;
+        }
+        pkt = netif_snip;
+        netif_hdr = pkt->data;
+        iface = netif_hdr->if_pid;
+        flags = netif_hdr->flags & ~(GNRC_NETIF_HDR_FLAGS_BROADCAST |
+                                     GNRC_NETIF_HDR_FLAGS_MULTICAST);
+        pkt = gnrc_pktbuf_remove_snip(pkt, pkt);
+    }
+    if ((pkt == NULL) || (pkt->type != GNRC_NETTYPE_IPV4) ||
+        (pkt->size < sizeof(ipv4_hdr_t))) {
+        DEBUG("ipv4: packet does not start with an IPv4 header\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    /* write protect IPv4 header, the payload is only read */
+    if ((ipv4 = gnrc_pktbuf_start_write(pkt)) == NULL) {
+        DEBUG("ipv4: unable to get write access to IPv4 header, dropping packet\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    pkt = ipv4;
+    hdr = ipv4->data;
+
+    /* addresses of this node loop back whatever interface was requested */
+    if ((hdr->dst.u8[0] == 127) || (gnrc_ipv4_netif_find_by_addr(&hdr->dst) != NULL)) {
+        if (_fill_ipv4_hdr(NULL, ipv4, ipv4->next) < 0) {
+            gnrc_pktbuf_release(pkt);
+            return;
+        }
+        _send_loopback(pkt);
+        return;
+    }
+    if ((hdr->dst.u32.u32 == 0xffffffff) || ((hdr->dst.u8[0] & 0xf0) == 0xe0)) {
+        /* limited broadcast and multicast stay on the given interface or
+         * take the first one */
+        netif = (iface == KERNEL_PID_UNDEF) ? gnrc_ipv4_netif_get_next(NULL)
+                                            : gnrc_ipv4_netif_get(iface);
+        flags |= (hdr->dst.u32.u32 == 0xffffffff) ? GNRC_NETIF_HDR_FLAGS_BROADCAST
+                                                  : GNRC_NETIF_HDR_FLAGS_MULTICAST;
+    }
+    else if (((netif = _next_hop(&next_hop, iface, &hdr->dst)) != NULL) &&
+             gnrc_ipv4_netif_is_bcast(netif, &hdr->dst)) {
+        flags |= GNRC_NETIF_HDR_FLAGS_BROADCAST;
+    }
+    if (netif == NULL) {
+        DEBUG("ipv4: no interface to send to, dropping packet\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    if (_fill_ipv4_hdr(netif, ipv4, ipv4->next) < 0) {
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    if (netif->mtu == 0) {
+        uint16_t mtu;
+
+        if ((gnrc_netapi_get(netif->pid, NETOPT_MAX_PACKET_SIZE, 0, &mtu,
+                             sizeof(mtu)) != sizeof(mtu)) || (mtu < _MIN_MTU)) {
+            mtu = _MIN_MTU;
+        }
+        netif->mtu = mtu;
+    }
+    if (gnrc_pkt_len(pkt) > netif->mtu) {
+        DEBUG("ipv4: packet too big, dropping packet\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+
+    netif_snip = gnrc_netif_hdr_build(NULL, 0, NULL,
+                                      (flags & (GNRC_NETIF_HDR_FLAGS_BROADCAST |
+                                                GNRC_NETIF_HDR_FLAGS_MULTICAST)) ?
+                                      0 : ETHERNET_ADDR_LEN);
+    if (netif_snip == NULL) {
+        DEBUG("ipv4: error on interface header allocation, dropping packet\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    netif_hdr = netif_snip->data;
+    netif_hdr->if_pid = netif->pid;
+    netif_hdr->flags = flags;
+    LL_PREPEND(pkt, netif_snip);
+
+    if (netif_hdr->dst_l2addr_len > 0) {
+        int res = gnrc_ipv4_arp_resolve(netif->pid, &next_hop, pkt);
+
+        if (res == 0) {
+            DEBUG("ipv4: packet queued until next hop is resolved\n");
+            return;
+        }
+        else if (res < 0) {
+            DEBUG("ipv4: unable to resolve next hop, dropping packet\n");
+            gnrc_pktbuf_release(pkt);
+            return;
+        }
+    }
+
+    DEBUG("ipv4: send to interface %" PRIkernel_pid "\n", netif->pid);
+    if (gnrc_netapi_send(netif->pid, pkt) < 1) {
+        DEBUG("ipv4: unable to send packet\n");
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
+/* functions for receiving */
+static bool _pkt_for_me(kernel_pid_t iface, const ipv4_addr_t *dst)
+{
+    gnrc_ipv4_netif_t *netif;
+
+    if (iface == KERNEL_PID_UNDEF) {
+        /* looped back */
+        return (dst->u8[0] == 127) || (gnrc_ipv4_netif_find_by_addr(dst) != NULL);
+    }
+    if ((netif = gnrc_ipv4_netif_get(iface)) == NULL) {
+        /* interface is not configured for IPv4 yet, only take broadcasts
+         * (e.g. for address configuration) */
+        return (dst->u32.u32 == 0xffffffff);
+    }
+    return (dst->u32.u32 == netif->addr.u32.u32) ||
+           gnrc_ipv4_netif_is_bcast(netif, dst) ||
+           /* all systems multicast group */
+           (dst->u32.u32 == byteorder_htonl(0xe0000001).u32);
+}
+
+static void _demux(kernel_pid_t iface, gnrc_pktsnip_t *pkt, uint8_t protocol)
+{
+    bool interested = (protocol == PROTNUM_ICMP);
+    unsigned type_num, proto_num, users;
+
+    pkt->type = gnrc_nettype_from_protnum(protocol);
+    type_num = (pkt->type == GNRC_NETTYPE_UNDEF) ? 0 :
+               gnrc_netreg_num(pkt->type, GNRC_NETREG_DEMUX_CTX_ALL);
+    proto_num = gnrc_netreg_num(GNRC_NETTYPE_IPV4, protocol);
+    users = (type_num > 0) + (proto_num > 0) + interested;
+
+    DEBUG("ipv4: forward protocol %u to other threads\n", protocol);
+    if (users == 0) {
+        DEBUG("ipv4: no one is interested in protocol %u\n", protocol);
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    /* one reference per dispatch */
+    gnrc_pktbuf_hold(pkt, users - 1);
+    if ((type_num > 0) &&
+        (gnrc_netapi_dispatch_receive(pkt->type, GNRC_NETREG_DEMUX_CTX_ALL,
+                                      pkt) == 0)) {
+        gnrc_pktbuf_release(pkt);
+    }
+    if ((proto_num > 0) &&
+        (gnrc_netapi_dispatch_receive(GNRC_NETTYPE_IPV4, protocol, pkt) == 0)) {
+        gnrc_pktbuf_release(pkt);
+    }
+    if (interested) {
+        DEBUG("ipv4: handle ICMP packet\n");
+        gnrc_ipv4_icmp_demux(iface, pkt);
+    }
+}
+
+static void _receive(gnrc_pktsnip_t *pkt)
+{
+    kernel_pid_t iface = KERNEL_PID_UNDEF;
+    gnrc_pktsnip_t *ipv4, *netif;
+    ipv4_hdr_t *hdr;
+    uint16_t ihl, tl;
+
+    assert(pkt != NULL);
+
+    netif = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_NETIF);
+    if (netif != NULL) {
+        iface = ((gnrc_netif_hdr_t *)netif->data)->if_pid;
+    }
+
+    hdr = pkt->data;
+    if ((pkt->size < sizeof(ipv4_hdr_t)) || (ipv4_hdr_get_version(hdr) != 4)) {
+        DEBUG("ipv4: Received packet was not IPv4, dropping packet\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    ihl = ipv4_hdr_get_ihl(hdr);
+    tl = byteorder_ntohs(hdr->tl);
+    if ((ihl < sizeof(ipv4_hdr_t)) || (tl < ihl) || (tl > pkt->size)) {
+        DEBUG("ipv4: invalid header or total length, dropping packet\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    if (inet_csum(0, pkt->data, ihl) != 0xffff) {
+        DEBUG("ipv4: invalid header checksum, dropping packet\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    if ((ipv4_hdr_get_flags(hdr) & IPV4_HDR_FLAG_MF) ||
+        (ipv4_hdr_get_fo(hdr) != 0)) {
+        DEBUG("ipv4: fragments are not supported, dropping packet\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+
+    DEBUG("ipv4: Received (src = %s, ",
+          ipv4_addr_to_str(addr_str, &hdr->src, sizeof(addr_str)));
+    DEBUG("dst = %s, protocol = %u, length = %u)\n",
+          ipv4_addr_to_str(addr_str, &hdr->dst, sizeof(addr_str)),
+          hdr->protocol, tl);
+
+    if (!_pkt_for_me(iface, &hdr->dst)) {
+        /* no forwarding between interfaces */
+        DEBUG("ipv4: packet destination not this host, dropping packet\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+
+    /* seize ipv4 as a temporary variable */
+    if ((ipv4 = gnrc_pktbuf_start_write(pkt)) == NULL) {
+        DEBUG("ipv4: unable to get write access to packet, drop it\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    pkt = ipv4;
+
+    /* remove any padding that was added by lower layers to fulfill their
+     * minimum size requirements (e.g. ethernet) */
+    if (tl < pkt->size) {
+        gnrc_pktbuf_realloc_data(pkt, tl);
+    }
+    if ((ipv4 = gnrc_pktbuf_mark(pkt, ihl, GNRC_NETTYPE_IPV4)) == NULL) {
+        DEBUG("ipv4: error marking IPv4 header, dropping packet\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+
+    _demux(iface, pkt, ((ipv4_hdr_t *)ipv4->data)->protocol);
+}
+
+/** @} */
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <string.h>
+
+#include "net/protnum.h"
+#include "net/gnrc/pktbuf.h"
+
+#include "net/gnrc/ipv4/hdr.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+gnrc_pktsnip_t *gnrc_ipv4_hdr_build(gnrc_pktsnip_t *payload, const ipv4_addr_t *src,
+                                    const ipv4_addr_t *dst)
+{
+    gnrc_pktsnip_t *ipv4;
+    ipv4_hdr_t *hdr;
+
+    ipv4 = gnrc_pktbuf_add(payload, NULL, sizeof(ipv4_hdr_t), GNRC_NETTYPE_IPV4);
+    if (ipv4 == NULL) {
+        DEBUG("ipv4_hdr: no space left in packet buffer\n");
+        return NULL;
+    }
+
+    hdr = ipv4->data;
+    memset(hdr, 0, sizeof(ipv4_hdr_t));
+    ipv4_hdr_set_version(hdr);
+    ipv4_hdr_set_ihl(hdr, sizeof(ipv4_hdr_t));
+    ipv4_hdr_set_flags(hdr, IPV4_HDR_FLAG_DF);
+    hdr->protocol = PROTNUM_RESERVED;
+    if (src != NULL) {
+        hdr->src = *src;
+    }
+    if (dst != NULL) {
+        hdr->dst = *dst;
+    }
+
+    return ipv4;
+}
+
+/** @} */
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "net/inet_csum.h"
+#include "net/gnrc.h"
+#include "utlist.h"
+
+#include "net/gnrc/ipv4.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static uint16_t _calc_csum(gnrc_pktsnip_t *hdr)
+{
+    uint16_t csum = 0;
+    uint16_t len = (uint16_t)hdr->size;
+
+    for (gnrc_pktsnip_t *payload = hdr->next;
+         (payload != NULL) && (payload->type != GNRC_NETTYPE_IPV4);
+         payload = payload->next) {
+        csum = inet_csum_slice(csum, payload->data, payload->size, len);
+        len += (uint16_t)payload->size;
+    }
+    return inet_csum(csum, hdr->data, hdr->size);
+}
+
+static void _echo_req_handle(kernel_pid_t iface, gnrc_pktsnip_t *pkt,
+                             gnrc_pktsnip_t *ipv4)
+{
+    icmp_echo_t *echo = pkt->data;
+    ipv4_hdr_t *ipv4_hdr = ipv4->data;
+    gnrc_pktsnip_t *hdr, *reply;
+
+    if (pkt->size < sizeof(icmp_echo_t)) {
+        DEBUG("icmp: echo request too short\n");
+        return;
+    }
+    if ((ipv4_hdr->dst.u8[0] != 127) &&
+        (gnrc_ipv4_netif_find_by_addr(&ipv4_hdr->dst) == NULL)) {
+        /* RFC 1122, section 3.2.2.6 allows to discard those */
+        DEBUG("icmp: ignore echo request to broadcast or multicast address\n");
+        return;
+    }
+    reply = gnrc_ipv4_icmp_echo_build(ICMP_ECHO_REP, byteorder_ntohs(echo->id),
+                                      byteorder_ntohs(echo->sn),
+                                      (uint8_t *)(echo + 1),
+                                      pkt->size - sizeof(icmp_echo_t));
+    if (reply == NULL) {
+        DEBUG("icmp: no space left in packet buffer\n");
+        return;
+    }
+    hdr = gnrc_ipv4_hdr_build(reply, &ipv4_hdr->dst, &ipv4_hdr->src);
+    if (hdr == NULL) {
+        DEBUG("icmp: no space left in packet buffer\n");
+        gnrc_pktbuf_release(reply);
+        return;
+    }
+    reply = hdr;
+    if (iface != KERNEL_PID_UNDEF) {
+        if ((hdr = gnrc_netif_hdr_build(NULL, 0, NULL, 0)) == NULL) {
+            DEBUG("icmp: no space left in packet buffer\n");
+            gnrc_pktbuf_release(reply);
+            return;
+        }
+        ((gnrc_netif_hdr_t *)hdr->data)->if_pid = iface;
+        LL_PREPEND(reply, hdr);
+    }
+    if (!gnrc_netapi_dispatch_send(GNRC_NETTYPE_IPV4, GNRC_NETREG_DEMUX_CTX_ALL,
+                                   reply)) {
+        DEBUG("icmp: no receivers for IPv4 packets\n");
+        gnrc_pktbuf_release(reply);
+    }
+}
+
+void gnrc_ipv4_icmp_demux(kernel_pid_t iface, gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *ipv4 = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_IPV4);
+    icmp_hdr_t *hdr = pkt->data;
+
+    assert(ipv4 != NULL);
+
+    if (pkt->size < sizeof(icmp_hdr_t)) {
+        DEBUG("icmp: packet too short.\n");
+    }
+    else if (_calc_csum(pkt) != 0xffff) {
+        DEBUG("icmp: wrong checksum.\n");
+    }
+    else if (hdr->type == ICMP_ECHO_REQ) {
+        DEBUG("icmp: handle echo request.\n");
+        _echo_req_handle(iface, pkt, ipv4);
+    }
+    gnrc_pktbuf_release(pkt);
+}
+
+gnrc_pktsnip_t *gnrc_ipv4_icmp_echo_build(uint8_t type, uint16_t id,
+                                          uint16_t seq, uint8_t *data,
+                                          size_t data_len)
+{
+    gnrc_pktsnip_t *pkt;
+    icmp_echo_t *echo;
+
+    pkt = gnrc_pktbuf_add(NULL, NULL, sizeof(icmp_echo_t) + data_len,
+                          GNRC_NETTYPE_ICMP);
+    if (pkt == NULL) {
+        return NULL;
+    }
+    echo = pkt->data;
+    echo->type = type;
+    echo->code = 0;
+    echo->csum.u16 = 0;
+    echo->id = byteorder_htons(id);
+    echo->sn = byteorder_htons(seq);
+    if (data != NULL) {
+        memcpy(echo + 1, data, data_len);
+    }
+    return pkt;
+}
+
+int gnrc_ipv4_icmp_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr)
+{
+    icmp_hdr_t *icmp;
+
+    (void)pseudo_hdr;
+    if (hdr == NULL) {
+        return -EFAULT;
+    }
+    if ((hdr->type != GNRC_NETTYPE_ICMP) || (hdr->size < sizeof(icmp_hdr_t))) {
+        return -EINVAL;
+    }
+    icmp = hdr->data;
+    icmp->csum.u16 = 0;
+    icmp->csum = byteorder_htons(~_calc_csum(hdr));
+    return 0;
+}
+
+/** @} */
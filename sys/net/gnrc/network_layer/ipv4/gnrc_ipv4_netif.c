@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <errno.h>
+
+#include "byteorder.h"
+
+#include "net/gnrc/ipv4/netif.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static gnrc_ipv4_netif_t _netifs[GNRC_IPV4_NETIF_NUMOF];
+
+static inline uint32_t _mask(uint8_t prefix_len)
+{
+    return (prefix_len == 0) ? 0 : (0xffffffff << (32 - prefix_len));
+}
+
+static inline bool _on_link(const gnrc_ipv4_netif_t *netif,
+                            const ipv4_addr_t *addr)
+{
+    uint32_t mask = _mask(netif->prefix_len);
+
+    return ((byteorder_ntohl(netif->addr.u32) & mask) ==
+            (byteorder_ntohl(addr->u32) & mask));
+}
+
+int gnrc_ipv4_netif_add_addr(kernel_pid_t pid, const ipv4_addr_t *addr,
+                             uint8_t prefix_len)
+{
+    gnrc_ipv4_netif_t *netif = gnrc_ipv4_netif_get(pid);
+
+    if ((prefix_len == 0) || (prefix_len > 32)) {
+        return -EINVAL;
+    }
+    for (unsigned i = 0; (netif == NULL) && (i < GNRC_IPV4_NETIF_NUMOF); i++) {
+        if (_netifs[i].pid == KERNEL_PID_UNDEF) {
+            netif = &_netifs[i];
+        }
+    }
+    if (netif == NULL) {
+        DEBUG("ipv4 netif: no free entry for interface %" PRIkernel_pid "\n",
+              pid);
+        return -ENOMEM;
+    }
+    netif->pid = pid;
+    netif->addr = *addr;
+    netif->prefix_len = prefix_len;
+    netif->bcast.u32 = byteorder_htonl(byteorder_ntohl(addr->u32) |
+                                       ~_mask(prefix_len));
+    netif->mtu = 0;     /* queried by the IPv4 thread on first use */
+    return 0;
+}
+
+void gnrc_ipv4_netif_remove_addr(kernel_pid_t pid)
+{
+    gnrc_ipv4_netif_t *netif = gnrc_ipv4_netif_get(pid);
+
+    if (netif != NULL) {
+        netif->pid = KERNEL_PID_UNDEF;
+    }
+}
+
+gnrc_ipv4_netif_t *gnrc_ipv4_netif_get(kernel_pid_t pid)
+{
+    if (pid == KERNEL_PID_UNDEF) {
+        return NULL;
+    }
+    for (unsigned i = 0; i < GNRC_IPV4_NETIF_NUMOF; i++) {
+        if (_netifs[i].pid == pid) {
+            return &_netifs[i];
+        }
+    }
+    return NULL;
+}
+
+gnrc_ipv4_netif_t *gnrc_ipv4_netif_get_next(const gnrc_ipv4_netif_t *prev)
+{
+    unsigned i = (prev == NULL) ? 0 : (prev - _netifs) + 1;
+
+    for (; i < GNRC_IPV4_NETIF_NUMOF; i++) {
+        if (_netifs[i].pid != KERNEL_PID_UNDEF) {
+            return &_netifs[i];
+        }
+    }
+    return NULL;
+}
+
+gnrc_ipv4_netif_t *gnrc_ipv4_netif_find_by_addr(const ipv4_addr_t *addr)
+{
+    for (unsigned i = 0; i < GNRC_IPV4_NETIF_NUMOF; i++) {
+        if ((_netifs[i].pid != KERNEL_PID_UNDEF) &&
+            (_netifs[i].addr.u32.u32 == addr->u32.u32)) {
+            return &_netifs[i];
+        }
+    }
+    return NULL;
+}
+
+gnrc_ipv4_netif_t *gnrc_ipv4_netif_find_by_prefix(const ipv4_addr_t *addr)
+{
+    gnrc_ipv4_netif_t *res = NULL;
+
+    for (unsigned i = 0; i < GNRC_IPV4_NETIF_NUMOF; i++) {
+        if ((_netifs[i].pid != KERNEL_PID_UNDEF) &&
+            _on_link(&_netifs[i], addr) &&
+            ((res == NULL) || (_netifs[i].prefix_len > res->prefix_len))) {
+            res = &_netifs[i];
+        }
+    }
+    return res;
+}
+
+void gnrc_ipv4_netif_reset(void)
+{
+    for (unsigned i = 0; i < GNRC_IPV4_NETIF_NUMOF; i++) {
+        _netifs[i].pid = KERNEL_PID_UNDEF;
+    }
+}
+
+/** @} */
@@ -0,0 +1,504 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_ipv6_ext_frag
+ * @{
+ *
+ * @file
+ * @brief       IPv6 fragmentation and reassembly
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "msg.h"
+#include "net/ipv6/ext.h"
+#include "net/ipv6/hdr.h"
+#include "net/gnrc/ipv6/ext/frag.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/protnum.h"
+#include "random.h"
+#include "thread.h"
+#include "utlist.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/**
+ * @brief   Byte range of a received fragment
+ */
+typedef struct _limits {
+    struct _limits *next;   /**< next fragment of the datagram */
+    uint16_t start;         /**< first byte of the fragment */
+    uint16_t end;           /**< first byte after the fragment */
+} _limits_t;
+
+/**
+ * @brief   Reassembly buffer entry
+ *
+ * A datagram is identified by source, destination and identification
+ * (RFC 8200, section 4.5).
+ */
+typedef struct {
+    gnrc_pktsnip_t *pkt;    /**< fragmentable part received so far, NULL if
+                             *   the entry is free */
+    _limits_t *limits;      /**< received fragments */
+    ipv6_hdr_t ipv6;        /**< IPv6 header of the first received fragment */
+    uint32_t id;            /**< identification */
+    uint32_t arrival;       /**< arrival of the first fragment in us */
+    uint16_t pkt_len;       /**< length of the datagram, 0 until the last
+                             *   fragment was received */
+    uint16_t rcvd;          /**< number of bytes received */
+    uint8_t nh;             /**< next header from the first fragment */
+} _rbuf_t;
+
+static _rbuf_t _rbuf[GNRC_IPV6_EXT_FRAG_RBUF_SIZE];
+static _limits_t _limits_pool[GNRC_IPV6_EXT_FRAG_LIMITS_POOL_SIZE];
+static _limits_t *_free_limits;
+static bool _limits_pool_filled;
+static xtimer_t _gc_timer;
+static msg_t _gc_msg = { .type = GNRC_IPV6_EXT_FRAG_RBUF_GC };
+static kernel_pid_t _gc_pid;
+
+/*
+ * ------------------------------------
+ * sending
+ * ------------------------------------
+ */
+
+/**
+ * @brief   Copies @p len bytes starting at @p offset of a snip list
+ *
+ * @return  number of bytes copied
+ */
+static size_t _copy(uint8_t *dst, const gnrc_pktsnip_t *pkt, size_t offset,
+                    size_t len)
+{
+    size_t copied = 0;
+
+    while ((pkt != NULL) && (copied < len)) {
+        if (offset >= pkt->size) {
+            offset -= pkt->size;
+        }
+        else {
+            size_t n = pkt->size - offset;
+
+            if (n > (len - copied)) {
+                n = len - copied;
+            }
+            memcpy(dst + copied, ((uint8_t *)pkt->data) + offset, n);
+            copied += n;
+            offset = 0;
+        }
+        pkt = pkt->next;
+    }
+    return copied;
+}
+
+int gnrc_ipv6_ext_frag_init(gnrc_ipv6_ext_frag_send_t *state,
+                            gnrc_pktsnip_t *pkt, uint16_t mtu)
+{
+    gnrc_pktsnip_t *ipv6 = pkt->next;
+    ipv6_hdr_t hdr;
+    size_t len = gnrc_pkt_len(ipv6);
+    uint16_t off = sizeof(ipv6_hdr_t);
+
+    assert((pkt->type == GNRC_NETTYPE_NETIF) && (ipv6 != NULL));
+    if (_copy((uint8_t *)&hdr, ipv6, 0, sizeof(hdr)) < sizeof(hdr)) {
+        gnrc_pktbuf_release(pkt);
+        return -EMSGSIZE;
+    }
+    state->nh_pos = offsetof(ipv6_hdr_t, nh);
+    state->nh = hdr.nh;
+    /* hop-by-hop options, routing headers, and destination options in front of
+     * a routing header are unfragmentable (RFC 8200, section 4.5) */
+    while ((state->nh == PROTNUM_IPV6_EXT_HOPOPT) ||
+           (state->nh == PROTNUM_IPV6_EXT_RH) ||
+           (state->nh == PROTNUM_IPV6_EXT_DST)) {
+        ipv6_ext_t ext;
+
+        if (_copy((uint8_t *)&ext, ipv6, off, sizeof(ext)) < sizeof(ext)) {
+            break;
+        }
+        if ((state->nh == PROTNUM_IPV6_EXT_DST) &&
+            (ext.nh != PROTNUM_IPV6_EXT_RH)) {
+            break;
+        }
+        state->nh_pos = off;
+        state->nh = ext.nh;
+        off += (ext.len * IPV6_EXT_LEN_UNIT) + IPV6_EXT_LEN_UNIT;
+    }
+    /* at least 8 bytes of payload per fragment */
+    if ((off > len) || ((off + sizeof(ipv6_ext_frag_t) + 8U) > mtu)) {
+        DEBUG("ipv6_ext_frag: unfragmentable part too long\n");
+        gnrc_pktbuf_release(pkt);
+        return -EMSGSIZE;
+    }
+    state->pkt = pkt;
+    /* unpredictable identification (RFC 7739) */
+    state->id = random_uint32();
+    state->mtu = mtu;
+    state->offset = 0;
+    state->unfrag_len = off;
+    state->frag_len = len - off;
+    DEBUG("ipv6_ext_frag: fragmenting %u bytes (unfragmentable: %u) into %u "
+          "byte fragments\n", (unsigned)len, (unsigned)off, (unsigned)mtu);
+    return 0;
+}
+
+static gnrc_pktsnip_t *_frag_fail(gnrc_ipv6_ext_frag_send_t *state,
+                                  gnrc_pktsnip_t *frag)
+{
+    DEBUG("ipv6_ext_frag: unable to allocate fragment\n");
+    gnrc_pktbuf_release(frag);
+    gnrc_pktbuf_release(state->pkt);
+    state->pkt = NULL;
+    return NULL;
+}
+
+gnrc_pktsnip_t *gnrc_ipv6_ext_frag_next(gnrc_ipv6_ext_frag_send_t *state)
+{
+    gnrc_pktsnip_t *frag, *ext, *ipv6;
+    ipv6_ext_frag_t *fh;
+    size_t ext_len = state->unfrag_len - sizeof(ipv6_hdr_t);
+    size_t len = state->frag_len - state->offset;
+    size_t max = (state->mtu - state->unfrag_len - sizeof(ipv6_ext_frag_t)) &
+                 IPV6_EXT_FRAG_OFFSET_MASK;
+    bool last = (len <= max);
+
+    if (state->pkt == NULL) {
+        return NULL;
+    }
+    ipv6 = state->pkt->next;
+    if (!last) {
+        len = max;
+    }
+    frag = gnrc_pktbuf_add(NULL, NULL, len, GNRC_NETTYPE_UNDEF);
+    if (frag == NULL) {
+        return _frag_fail(state, NULL);
+    }
+    _copy(frag->data, ipv6, state->unfrag_len + state->offset, len);
+    /* unfragmentable extension headers and the fragment header */
+    ext = gnrc_pktbuf_add(frag, NULL, ext_len + sizeof(ipv6_ext_frag_t),
+                          GNRC_NETTYPE_IPV6_EXT);
+    if (ext == NULL) {
+        return _frag_fail(state, frag);
+    }
+    frag = ext;
+    _copy(ext->data, ipv6, sizeof(ipv6_hdr_t), ext_len);
+    fh = (ipv6_ext_frag_t *)(((uint8_t *)ext->data) + ext_len);
+    fh->nh = state->nh;
+    fh->resv = 0;
+    ipv6_ext_frag_set_offset(fh, state->offset);
+    if (!last) {
+        ipv6_ext_frag_set_more(fh);
+    }
+    fh->id = byteorder_htonl(state->id);
+    /* IPv6 header */
+    ipv6 = gnrc_pktbuf_add(frag, NULL, sizeof(ipv6_hdr_t), GNRC_NETTYPE_IPV6);
+    if (ipv6 == NULL) {
+        return _frag_fail(state, frag);
+    }
+    frag = ipv6;
+    _copy(ipv6->data, state->pkt->next, 0, sizeof(ipv6_hdr_t));
+    ((ipv6_hdr_t *)ipv6->data)->len = byteorder_htons(ext->size + len);
+    if (state->nh_pos < sizeof(ipv6_hdr_t)) {
+        ((ipv6_hdr_t *)ipv6->data)->nh = PROTNUM_IPV6_EXT_FRAG;
+    }
+    else {
+        ((uint8_t *)ext->data)[state->nh_pos - sizeof(ipv6_hdr_t)] =
+            PROTNUM_IPV6_EXT_FRAG;
+    }
+    /* netif header */
+    frag = gnrc_pktbuf_add(frag, state->pkt->data, state->pkt->size,
+                           GNRC_NETTYPE_NETIF);
+    if (frag == NULL) {
+        return _frag_fail(state, ipv6);
+    }
+    DEBUG("ipv6_ext_frag: fragment (%u, %u) of %u\n",
+          (unsigned)state->offset, (unsigned)len, (unsigned)state->frag_len);
+
+    state->offset += len;
+    if (last) {
+        gnrc_pktbuf_release(state->pkt);
+        state->pkt = NULL;
+    }
+    return frag;
+}
+
+/*
+ * ------------------------------------
+ * reassembly
+ * ------------------------------------
+ */
+
+static void _rbuf_rem(_rbuf_t *entry)
+{
+    while (entry->limits != NULL) {
+        _limits_t *next = entry->limits->next;
+
+        LL_PREPEND(_free_limits, entry->limits);
+        entry->limits = next;
+    }
+    if (entry->pkt != NULL) {
+        gnrc_pktbuf_release(entry->pkt);
+        entry->pkt = NULL;
+    }
+}
+
+static void _rbuf_gc(uint32_t now)
+{
+    for (unsigned i = 0; i < GNRC_IPV6_EXT_FRAG_RBUF_SIZE; i++) {
+        if ((_rbuf[i].pkt != NULL) &&
+            ((now - _rbuf[i].arrival) > GNRC_IPV6_EXT_FRAG_RBUF_TIMEOUT)) {
+            DEBUG("ipv6_ext_frag: datagram %08" PRIx32 " timed out\n",
+                  _rbuf[i].id);
+            _rbuf_rem(&_rbuf[i]);
+        }
+    }
+}
+
+/**
+ * @brief   Arms the garbage collection timer for the oldest datagram
+ *
+ * Expects timed out datagrams to be removed already.
+ */
+static void _gc_arm(uint32_t now)
+{
+    _rbuf_t *oldest = NULL;
+
+    for (unsigned i = 0; i < GNRC_IPV6_EXT_FRAG_RBUF_SIZE; i++) {
+        if ((_rbuf[i].pkt != NULL) &&
+            ((oldest == NULL) ||
+             ((now - _rbuf[i].arrival) > (now - oldest->arrival)))) {
+            oldest = &_rbuf[i];
+        }
+    }
+    if (oldest == NULL) {
+        xtimer_remove(&_gc_timer);
+        return;
+    }
+    xtimer_set_msg(&_gc_timer,
+                   GNRC_IPV6_EXT_FRAG_RBUF_TIMEOUT - (now - oldest->arrival) + 1,
+                   &_gc_msg, _gc_pid);
+}
+
+static _rbuf_t *_rbuf_get(const ipv6_hdr_t *hdr, uint32_t id, size_t size,
+                          uint32_t now)
+{
+    _rbuf_t *res = NULL, *oldest = NULL;
+
+    for (unsigned i = 0; i < GNRC_IPV6_EXT_FRAG_RBUF_SIZE; i++) {
+        _rbuf_t *entry = &_rbuf[i];
+
+        if (entry->pkt == NULL) {
+            if (res == NULL) {
+                res = entry;
+            }
+            continue;
+        }
+        if ((entry->id == id) &&
+            ipv6_addr_equal(&entry->ipv6.src, &hdr->src) &&
+            ipv6_addr_equal(&entry->ipv6.dst, &hdr->dst)) {
+            return entry;
+        }
+        if ((oldest == NULL) ||
+            ((now - entry->arrival) > (now - oldest->arrival))) {
+            oldest = entry;
+        }
+    }
+    if (res == NULL) {
+        DEBUG("ipv6_ext_frag: reassembly buffer full, drop oldest datagram\n");
+        _rbuf_rem(oldest);
+        res = oldest;
+    }
+    /* grows with the fragments */
+    res->pkt = gnrc_pktbuf_add(NULL, NULL, size, GNRC_NETTYPE_UNDEF);
+    if (res->pkt == NULL) {
+        DEBUG("ipv6_ext_frag: unable to allocate reassembly buffer\n");
+        return NULL;
+    }
+    res->ipv6 = *hdr;
+    res->id = id;
+    res->arrival = now;
+    res->pkt_len = 0;
+    res->rcvd = 0;
+    res->nh = PROTNUM_RESERVED;
+    _gc_arm(now);
+    return res;
+}
+
+/**
+ * @brief   Checks a new fragment against the ones already received
+ *
+ * @return  1, if the fragment is new
+ * @return  0, if the fragment is an exact duplicate
+ * @return  -1, if the fragment overlaps a received one
+ */
+static int _check_overlap(const _rbuf_t *entry, uint16_t start, uint16_t end)
+{
+    for (const _limits_t *l = entry->limits; l != NULL; l = l->next) {
+        if ((start < l->end) && (l->start < end)) {
+            return ((start == l->start) && (end == l->end)) ? 0 : -1;
+        }
+    }
+    return 1;
+}
+
+gnrc_pktsnip_t *gnrc_ipv6_ext_frag_reass(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *ipv6 = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_IPV6);
+    gnrc_pktsnip_t *netif = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_NETIF);
+    ipv6_ext_frag_t *fh = pkt->data;
+    _rbuf_t *entry;
+    _limits_t *limits;
+    uint32_t now = xtimer_now_usec();
+    size_t start, end;
+    int res;
+
+    if (!_limits_pool_filled) {
+        /* first fragment ever: fill the pool */
+        for (unsigned i = 0; i < GNRC_IPV6_EXT_FRAG_LIMITS_POOL_SIZE; i++) {
+            LL_PREPEND(_free_limits, &_limits_pool[i]);
+        }
+        _limits_pool_filled = true;
+    }
+    if ((ipv6 == NULL) || (pkt->size < sizeof(ipv6_ext_frag_t))) {
+        DEBUG("ipv6_ext_frag: invalid fragment\n");
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    start = ipv6_ext_frag_get_offset(fh);
+    end = start + pkt->size - sizeof(ipv6_ext_frag_t);
+    /* all but the last fragment must be a multiple of 8 bytes long */
+    if ((end == start) || (ipv6_ext_frag_more(fh) && (end & 0x7)) ||
+        (end > GNRC_IPV6_EXT_FRAG_MAX_SIZE)) {
+        DEBUG("ipv6_ext_frag: invalid fragment (%u, %u)\n", (unsigned)start,
+              (unsigned)end);
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+
+    /* reassembly runs in the IPv6 thread, it does the garbage collection */
+    _gc_pid = sched_active_pid;
+    _rbuf_gc(now);
+    entry = _rbuf_get(ipv6->data, byteorder_ntohl(fh->id), end, now);
+    if (entry == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    DEBUG("ipv6_ext_frag: fragment (%u, %u) of datagram %08" PRIx32 "\n",
+          (unsigned)start, (unsigned)end, entry->id);
+
+    res = _check_overlap(entry, start, end);
+    if (res == 0) {
+        DEBUG("ipv6_ext_frag: duplicate fragment\n");
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    if ((res < 0) ||
+        /* beyond the end of the datagram */
+        ((entry->pkt_len != 0) && (end > entry->pkt_len)) ||
+        /* a second, different last fragment or fragments beyond it */
+        (!ipv6_ext_frag_more(fh) &&
+         (((entry->pkt_len != 0) && (end != entry->pkt_len)) ||
+          (entry->pkt->size > end))) ||
+        /* no space left to keep track of the fragment */
+        (_free_limits == NULL)) {
+        DEBUG("ipv6_ext_frag: inconsistent fragment, drop datagram\n");
+        _rbuf_rem(entry);
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    if ((end > entry->pkt->size) &&
+        (gnrc_pktbuf_realloc_data(entry->pkt, end) != 0)) {
+        DEBUG("ipv6_ext_frag: packet buffer full, drop datagram\n");
+        _rbuf_rem(entry);
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+
+    limits = _free_limits;
+    _free_limits = limits->next;
+    limits->start = start;
+    limits->end = end;
+    LL_PREPEND(entry->limits, limits);
+    memcpy(((uint8_t *)entry->pkt->data) + start, fh + 1, end - start);
+    entry->rcvd += end - start;
+    if (start == 0) {
+        entry->nh = fh->nh;
+    }
+    if (!ipv6_ext_frag_more(fh)) {
+        entry->pkt_len = end;
+    }
+
+    if ((entry->pkt_len == 0) || (entry->rcvd < entry->pkt_len)) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+
+    /* complete: fragments don't overlap, so the first one must be there */
+    gnrc_pktsnip_t *reass = entry->pkt;
+    ipv6_hdr_t *hdr;
+
+    DEBUG("ipv6_ext_frag: datagram %08" PRIx32 " complete (%u bytes)\n",
+          entry->id, (unsigned)entry->pkt_len);
+    ipv6 = gnrc_pktbuf_add(NULL, &entry->ipv6, sizeof(ipv6_hdr_t),
+                           GNRC_NETTYPE_IPV6);
+    if (ipv6 == NULL) {
+        _rbuf_rem(entry);
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    /* the unfragmentable extension headers were handled with the fragment */
+    hdr = ipv6->data;
+    hdr->nh = entry->nh;
+    hdr->len = byteorder_htons(entry->pkt_len);
+    LL_APPEND(reass, ipv6);
+    if (netif != NULL) {
+        netif = gnrc_pktbuf_add(NULL, netif->data, netif->size,
+                                GNRC_NETTYPE_NETIF);
+        if (netif == NULL) {
+            _rbuf_rem(entry);
+            gnrc_pktbuf_release(pkt);
+            return NULL;
+        }
+        LL_APPEND(reass, netif);
+    }
+    entry->pkt = NULL;
+    _rbuf_rem(entry);
+    gnrc_pktbuf_release(pkt);
+    return reass;
+}
+
+void gnrc_ipv6_ext_frag_rbuf_reset(void)
+{
+    for (unsigned i = 0; i < GNRC_IPV6_EXT_FRAG_RBUF_SIZE; i++) {
+        _rbuf_rem(&_rbuf[i]);
+    }
+    xtimer_remove(&_gc_timer);
+}
+
+void gnrc_ipv6_ext_frag_rbuf_gc(void)
+{
+    uint32_t now = xtimer_now_usec();
+
+    _rbuf_gc(now);
+    _gc_arm(now);
+}
+
+/** @} */
@@ -17,8 +17,10 @@
 #include "utlist.h"
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/ipv6.h"
+#include "net/gnrc/netreg.h"
 
 #include "net/gnrc/ipv6/ext.h"
+#include "net/gnrc/ipv6/ext/frag.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -164,6 +166,48 @@ static inline bool _has_valid_size(gnrc_pktsnip_t *pkt, uint8_t nh)
     }
 }
 
+/**
+ * @brief   Checks if anyone registered for the headers following the walked
+ *          ones, who expects a separate snip for each header
+ */
+static bool _split_requested(const gnrc_ipv6_ext_walk_t *walk)
+{
+    for (unsigned i = 1; i < walk->numof; i++) {
+        if (gnrc_netreg_num(GNRC_NETTYPE_IPV6, walk->type[i]) != 0) {
+            return true;
+        }
+    }
+    return (walk->numof > 0) &&
+           (gnrc_netreg_num(GNRC_NETTYPE_IPV6, walk->nh) != 0);
+}
+
+/**
+ * @brief   Marks all walked headers as a single snip
+ *
+ * @return  The packet, starting after the walked headers.
+ * @return  NULL on error, @p pkt is released then.
+ */
+static gnrc_pktsnip_t *_mark_walked(gnrc_pktsnip_t *pkt,
+                                    const gnrc_ipv6_ext_walk_t *walk)
+{
+    gnrc_pktsnip_t *tmp;
+
+    if (walk->len == 0) {
+        return pkt;
+    }
+    if ((tmp = gnrc_pktbuf_start_write(pkt)) == NULL) {
+        DEBUG("ipv6: could not get a copy of pkt\n");
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    pkt = tmp;
+    if (gnrc_pktbuf_mark(pkt, walk->len, GNRC_NETTYPE_IPV6_EXT) == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    return pkt;
+}
+
 /*
  *         current                 pkt
  *         |                       |
@@ -231,6 +275,46 @@ void gnrc_ipv6_ext_demux(kernel_pid_t iface,
                     return;
                 }
 
+#ifdef MODULE_GNRC_IPV6_EXT_FRAG
+                /* atomic fragments (RFC 6946) are handled like any other
+                 * extension header */
+                if ((nh == PROTNUM_IPV6_EXT_FRAG) && (current == pkt) &&
+                    ((ipv6_ext_frag_get_offset(current->data) != 0) ||
+                     ipv6_ext_frag_more(current->data))) {
+                    /* a reassembled datagram continues at its payload */
+                    if ((pkt = gnrc_ipv6_ext_frag_reass(pkt)) != NULL) {
+                        gnrc_ipv6_demux(iface, pkt, pkt,
+                                        ((ipv6_hdr_t *)pkt->next->data)->nh);
+                    }
+                    return;
+                }
+#endif
+
+                if (current == pkt) {
+                    gnrc_ipv6_ext_walk_t walk;
+                    int res;
+
+                    if ((res = gnrc_ipv6_ext_walk(&walk, pkt, nh)) < 0) {
+                        DEBUG("ipv6_ext: invalid extension header (%d)\n", res);
+                        gnrc_pktbuf_release(pkt);
+                        return;
+                    }
+                    if (!_split_requested(&walk)) {
+                        /* mark all walked headers at once */
+                        if ((pkt = _mark_walked(pkt, &walk)) == NULL) {
+                            return;
+                        }
+                        current = pkt;
+                        nh = walk.nh;
+                        if (gnrc_nettype_from_protnum(nh) != GNRC_NETTYPE_IPV6_EXT) {
+                            gnrc_ipv6_demux(iface, current, pkt, nh);
+                            return;
+                        }
+                        /* routing or fragment header to handle */
+                        break;
+                    }
+                }
+
                 nh = ext->nh;
                 DEBUG("ipv6_ext: next header = %" PRIu8 "\n", nh);
 
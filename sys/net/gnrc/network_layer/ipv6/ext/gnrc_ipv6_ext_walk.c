@@ -0,0 +1,266 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief   Single pass walker over IPv6 extension headers
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "utlist.h"
+#include "net/protnum.h"
+#include "net/icmpv6.h"
+#include "net/ipv6/ext/frag.h"
+#include "net/ipv6/ext/rh.h"
+#include "net/ipv6/hdr.h"
+#include "net/gnrc/icmpv6.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/ext.h"
+#include "net/gnrc/ipv6/hdr.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/pktbuf.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define _OPTS           (0x01U)     /**< header contains options */
+#define _FIRST          (0x02U)     /**< header must follow the IPv6 header */
+#define _AH_LEN         (0x04U)     /**< length in 4 byte units (RFC 4302) */
+#define _FIXED_LEN      (0x08U)     /**< header is always 8 bytes long */
+
+typedef struct {
+    uint8_t nh;
+    uint8_t flags;
+} _ext_type_t;
+
+/* headers not in this table end the walk, ESP is rejected explicitly */
+static const _ext_type_t _ext_types[] = {
+    { PROTNUM_IPV6_EXT_HOPOPT, _OPTS | _FIRST },
+    { PROTNUM_IPV6_EXT_RH, 0 },
+    { PROTNUM_IPV6_EXT_FRAG, _FIXED_LEN },
+    { PROTNUM_IPV6_EXT_AH, _AH_LEN },
+    { PROTNUM_IPV6_EXT_DST, _OPTS },
+    { PROTNUM_IPV6_EXT_MOB, 0 },
+};
+
+static gnrc_ipv6_ext_opt_handler_t *_handlers;
+
+static const _ext_type_t *_get_type(uint8_t nh)
+{
+    for (unsigned i = 0; i < (sizeof(_ext_types) / sizeof(_ext_types[0])); i++) {
+        if (_ext_types[i].nh == nh) {
+            return &_ext_types[i];
+        }
+    }
+    return NULL;
+}
+
+#if GNRC_IPV6_EXT_OPT_DISCARD_UNKNOWN && defined(MODULE_GNRC_ICMPV6)
+/**
+ * @brief   Sends a parameter problem message for an unrecognized option
+ *
+ * Unlike gnrc_icmpv6_error_param_prob_send(), this quotes the received
+ * packet from its IPv6 header on and leaves @p pkt to the caller.
+ */
+static void _param_prob(gnrc_pktsnip_t *pkt, const ipv6_ext_opt_t *opt)
+{
+    gnrc_pktsnip_t *ipv6 = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_IPV6);
+    gnrc_pktsnip_t *err, *hdr;
+    const ipv6_hdr_t *ipv6_hdr;
+    icmpv6_error_param_prob_t *pp;
+    size_t len = 0, offset = 0;
+    uint32_t ptr;
+
+    if (ipv6 == NULL) {
+        return;
+    }
+    ipv6_hdr = ipv6->data;
+    /* no errors for multicast destinations with action 11 (RFC 8200,
+     * section 4.2) and for invalid sources (RFC 4443, section 2.4) */
+    if ((((opt->type & IPV6_EXT_OPT_ACTION_MASK) ==
+          IPV6_EXT_OPT_ACTION_DISCARD_ERR_UCAST) &&
+         ipv6_addr_is_multicast(&ipv6_hdr->dst)) ||
+        ipv6_addr_is_unspecified(&ipv6_hdr->src) ||
+        ipv6_addr_is_multicast(&ipv6_hdr->src)) {
+        return;
+    }
+    for (gnrc_pktsnip_t *snip = pkt; snip != ipv6->next; snip = snip->next) {
+        len += snip->size;
+    }
+    ptr = len - pkt->size + ((const uint8_t *)opt - (uint8_t *)pkt->data);
+    if (len > (IPV6_MIN_MTU - sizeof(ipv6_hdr_t) - sizeof(*pp))) {
+        len = IPV6_MIN_MTU - sizeof(ipv6_hdr_t) - sizeof(*pp);
+    }
+    err = gnrc_icmpv6_build(NULL, ICMPV6_PARAM_PROB,
+                            ICMPV6_ERROR_PARAM_PROB_OPT, sizeof(*pp) + len);
+    if (err == NULL) {
+        return;
+    }
+    pp = err->data;
+    pp->ptr = byteorder_htonl(ptr);
+    /* received snips are in reverse order, copy from the IPv6 header on */
+    for (gnrc_pktsnip_t *end = ipv6->next; (end != pkt) && (offset < len);) {
+        gnrc_pktsnip_t *snip = pkt;
+        size_t n;
+
+        while (snip->next != end) {
+            snip = snip->next;
+        }
+        n = ((len - offset) < snip->size) ? (len - offset) : snip->size;
+        memcpy(((uint8_t *)(pp + 1)) + offset, snip->data, n);
+        offset += n;
+        end = snip;
+    }
+    hdr = gnrc_ipv6_hdr_build(err, NULL, &ipv6_hdr->src);
+    if (hdr == NULL) {
+        gnrc_pktbuf_release(err);
+        return;
+    }
+    DEBUG("ipv6_ext: sending parameter problem\n");
+    if (gnrc_netapi_send(gnrc_ipv6_pid, hdr) < 1) {
+        DEBUG("ipv6_ext: unable to send parameter problem\n");
+        gnrc_pktbuf_release(hdr);
+    }
+}
+#endif
+
+static int _walk_opts(gnrc_pktsnip_t *pkt, uint8_t ext, const uint8_t *opts,
+                      size_t len)
+{
+    size_t pos = 0;
+
+    while (pos < len) {
+        const ipv6_ext_opt_t *opt = (const ipv6_ext_opt_t *)&opts[pos];
+        gnrc_ipv6_ext_opt_handler_t *handler;
+
+        if (opt->type == IPV6_EXT_OPT_PAD1) {
+            pos++;
+            continue;
+        }
+        if (((pos + sizeof(ipv6_ext_opt_t)) > len) ||
+            ((pos + sizeof(ipv6_ext_opt_t) + opt->len) > len)) {
+            DEBUG("ipv6_ext: option %u exceeds header\n", opt->type);
+            return -EBADMSG;
+        }
+        pos += sizeof(ipv6_ext_opt_t) + opt->len;
+        if (opt->type == IPV6_EXT_OPT_PADN) {
+            continue;
+        }
+        LL_SEARCH_SCALAR(_handlers, handler, type, opt->type);
+        if (handler != NULL) {
+            int res = handler->cb(pkt, ext, opt);
+
+            if (res < 0) {
+                DEBUG("ipv6_ext: option %u rejected packet\n", opt->type);
+                return res;
+            }
+        }
+#if GNRC_IPV6_EXT_OPT_DISCARD_UNKNOWN
+        else if ((opt->type & IPV6_EXT_OPT_ACTION_MASK) !=
+                 IPV6_EXT_OPT_ACTION_SKIP) {
+            DEBUG("ipv6_ext: unrecognized option %u\n", opt->type);
+#ifdef MODULE_GNRC_ICMPV6
+            if ((opt->type & IPV6_EXT_OPT_ACTION_MASK) !=
+                IPV6_EXT_OPT_ACTION_DISCARD) {
+                _param_prob(pkt, opt);
+            }
+#endif
+            return -EBADMSG;
+        }
+#endif
+    }
+    return 0;
+}
+
+int gnrc_ipv6_ext_walk(gnrc_ipv6_ext_walk_t *walk, gnrc_pktsnip_t *pkt,
+                       uint8_t nh)
+{
+    const uint8_t *data = pkt->data;
+    const _ext_type_t *type;
+    size_t pos = 0;
+
+    walk->numof = 0;
+    while ((walk->numof < GNRC_IPV6_EXT_WALK_NUMOF) &&
+           ((type = _get_type(nh)) != NULL)) {
+        const ipv6_ext_t *ext = (const ipv6_ext_t *)&data[pos];
+        size_t len;
+
+        if ((pos + sizeof(ipv6_ext_t)) > pkt->size) {
+            DEBUG("ipv6_ext: header exceeds packet\n");
+            return -EBADMSG;
+        }
+        if (type->flags & _FIXED_LEN) {
+            len = IPV6_EXT_LEN_UNIT;
+        }
+        else if (type->flags & _AH_LEN) {
+            len = (ext->len + 2) * 4;
+        }
+        else {
+            len = (ext->len * IPV6_EXT_LEN_UNIT) + IPV6_EXT_LEN_UNIT;
+        }
+        if ((pos + len) > pkt->size) {
+            DEBUG("ipv6_ext: header exceeds packet\n");
+            return -EBADMSG;
+        }
+        if ((type->flags & _FIRST) && (walk->numof > 0)) {
+            DEBUG("ipv6_ext: hop-by-hop options not first\n");
+            return -EBADMSG;
+        }
+        /* stop at headers the stack has to act on */
+#ifdef MODULE_GNRC_IPV6_EXT_FRAG
+        if ((nh == PROTNUM_IPV6_EXT_FRAG) &&
+            ((ipv6_ext_frag_get_offset((ipv6_ext_frag_t *)ext) != 0) ||
+             ipv6_ext_frag_more((ipv6_ext_frag_t *)ext))) {
+            break;
+        }
+#endif
+#ifdef MODULE_GNRC_RPL_SRH
+        if ((nh == PROTNUM_IPV6_EXT_RH) &&
+            (((ipv6_ext_rh_t *)ext)->seg_left != 0)) {
+            break;
+        }
+#endif
+        if (type->flags & _OPTS) {
+            int res = _walk_opts(pkt, nh, &data[pos + sizeof(ipv6_ext_t)],
+                                 len - sizeof(ipv6_ext_t));
+
+            if (res < 0) {
+                return res;
+            }
+        }
+        walk->offset[walk->numof] = pos;
+        walk->type[walk->numof++] = nh;
+        nh = ext->nh;
+        pos += len;
+    }
+    if (nh == PROTNUM_IPV6_EXT_ESP) {
+        DEBUG("ipv6_ext: encapsulating security payload not supported\n");
+        return -ENOTSUP;
+    }
+    walk->len = pos;
+    walk->nh = nh;
+    return 0;
+}
+
+void gnrc_ipv6_ext_opt_register(gnrc_ipv6_ext_opt_handler_t *handler)
+{
+    LL_APPEND(_handlers, handler);
+}
+
+void gnrc_ipv6_ext_opt_unregister(gnrc_ipv6_ext_opt_handler_t *handler)
+{
+    if (_handlers != NULL) {
+        LL_DELETE(_handlers, handler);
+    }
+}
+
+/** @} */
@@ -33,6 +33,8 @@
 #include "net/gnrc/ipv6/netif.h"
 #include "net/gnrc/ipv6/whitelist.h"
 #include "net/gnrc/ipv6/blacklist.h"
+#include "net/gnrc/ipv6/ext/frag.h"
+#include "net/gnrc/pktfilter.h"
 
 #include "net/gnrc/ipv6.h"
 
@@ -360,6 +362,12 @@ static void *_event_loop(void *args)
                 gnrc_ndp_internal_send_rtr_adv(nc_entry->iface, NULL,
                                                &(nc_entry->ipv6_addr), false);
                 break;
+#endif
+#ifdef MODULE_GNRC_IPV6_EXT_FRAG
+            case GNRC_IPV6_EXT_FRAG_RBUF_GC:
+                DEBUG("ipv6: reassembly buffer garbage collection\n");
+                gnrc_ipv6_ext_frag_rbuf_gc();
+                break;
 #endif
             default:
                 break;
@@ -376,8 +384,20 @@ static void _send_to_iface(kernel_pid_t iface, gnrc_pktsnip_t *pkt)
 
     assert(if_entry != NULL);
     if (gnrc_pkt_len(pkt->next) > if_entry->mtu) {
+#ifdef MODULE_GNRC_IPV6_EXT_FRAG
+        gnrc_ipv6_ext_frag_send_t frag_state;
+        gnrc_pktsnip_t *frag;
+
+        DEBUG("ipv6: packet too big, fragmenting\n");
+        if (gnrc_ipv6_ext_frag_init(&frag_state, pkt, if_entry->mtu) == 0) {
+            while ((frag = gnrc_ipv6_ext_frag_next(&frag_state)) != NULL) {
+                _send_to_iface(iface, frag);
+            }
+        }
+#else
         DEBUG("ipv6: packet too big\n");
         gnrc_pktbuf_release(pkt);
+#endif
         return;
     }
 #ifdef MODULE_NETSTATS_IPV6
@@ -838,6 +858,13 @@ static void _receive(gnrc_pktsnip_t *pkt)
             gnrc_pktbuf_release(pkt);
             return;
         }
+#endif
+#ifdef MODULE_GNRC_PKTFILTER
+        if (!gnrc_pktfilter_ipv6(pkt->data, pkt->size)) {
+            DEBUG("ipv6: Packet filtered by pktfilter, dropping packet\n");
+            gnrc_pktbuf_release(pkt);
+            return;
+        }
 #endif
         /* seize ipv6 as a temporary variable */
         ipv6 = gnrc_pktbuf_start_write(pkt);
@@ -877,6 +904,14 @@ static void _receive(gnrc_pktsnip_t *pkt)
         return;
     }
 #endif
+#ifdef MODULE_GNRC_PKTFILTER
+    else if (!gnrc_pktfilter_ipv6(ipv6->data, ipv6->size)) {
+        /* if ipv6 header already marked, the port is not known */
+        DEBUG("ipv6: Packet filtered by pktfilter, dropping packet\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+#endif
 
     /* extract header */
     hdr = (ipv6_hdr_t *)ipv6->data;
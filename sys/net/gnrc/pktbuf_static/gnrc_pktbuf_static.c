@@ -48,6 +48,9 @@ static _unused_t *_first_unused;
 #ifdef DEVELHELP
 /* maximum number of bytes allocated */
 static uint16_t max_byte_count = 0;
+/* number of bytes currently allocated and its high-water mark */
+static size_t used_count = 0;
+static size_t max_used_count = 0;
 #endif
 
 /* internal gnrc_pktbuf functions */
@@ -86,6 +89,10 @@ void gnrc_pktbuf_init(void)
     _first_unused = (_unused_t *)_pktbuf;
     _first_unused->next = NULL;
     _first_unused->size = sizeof(_pktbuf);
+#ifdef DEVELHELP
+    used_count = 0;
+    max_used_count = 0;
+#endif
     mutex_unlock(&_mutex);
 }
 
@@ -330,6 +337,8 @@ void gnrc_pktbuf_stats(void)
     printf("packet buffer: first byte: %p, last byte: %p (size: %u)\n",
            (void *)&_pktbuf[0], (void *)&_pktbuf[GNRC_PKTBUF_SIZE], GNRC_PKTBUF_SIZE);
     printf("  position of last byte used: %" PRIu16 "\n", max_byte_count);
+    printf("  bytes used: %u (max: %u)\n", (unsigned)used_count,
+           (unsigned)max_used_count);
     if (ptr == NULL) {  /* packet buffer is completely full */
         _print_chunk(chunk, GNRC_PKTBUF_SIZE, count++);
     }
@@ -360,6 +369,26 @@ void gnrc_pktbuf_stats(void)
     DEBUG("pktbuf: needs od module\n");
 #endif
 }
+
+size_t gnrc_pktbuf_get_used(size_t *max_used)
+{
+    size_t res;
+
+    mutex_lock(&_mutex);
+    res = used_count;
+    if (max_used != NULL) {
+        *max_used = max_used_count;
+    }
+    mutex_unlock(&_mutex);
+    return res;
+}
+
+void gnrc_pktbuf_reset_max_used(void)
+{
+    mutex_lock(&_mutex);
+    max_used_count = used_count;
+    mutex_unlock(&_mutex);
+}
 #endif
 
 #ifdef TEST_SUITES
@@ -469,6 +498,10 @@ static void *_pktbuf_alloc(size_t size)
     if (last_byte > max_byte_count) {
         max_byte_count = last_byte;
     }
+    used_count += size;
+    if (used_count > max_used_count) {
+        max_used_count = used_count;
+    }
 #endif
     return (void *)ptr;
 }
@@ -501,6 +534,9 @@ static void _pktbuf_free(void *data, size_t size)
     }
     new->next = ptr;
     new->size = (size < sizeof(_unused_t)) ? _align(sizeof(_unused_t)) : _align(size);
+#ifdef DEVELHELP
+    used_count -= new->size;
+#endif
     /* calculate number of bytes between new _unused_t chunk and end of packet
      * buffer */
     bytes_at_end = ((&_pktbuf[0] + GNRC_PKTBUF_SIZE) - (((uint8_t *)new) + new->size));
@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_pktfilter
+ * @{
+ *
+ * @file
+ * @brief       GNRC packet filter implementation
+ *
+ * @}
+ */
+
+#include "net/protnum.h"
+#include "net/gnrc/pktfilter.h"
+
+static pktfilter_rule_t _rules[GNRC_PKTFILTER_RULES];
+static uint16_t _table[GNRC_PKTFILTER_TABLE_SIZE];
+
+pktfilter_t gnrc_pktfilter = PKTFILTER_INIT(_rules, _table);
+
+bool gnrc_pktfilter_ipv6(const ipv6_hdr_t *hdr, size_t len)
+{
+    pktfilter_pkt_t pkt = {
+        .ipv6_src = hdr->src.u8, .ipv6_dst = hdr->dst.u8,
+        .proto = hdr->nh, .port = PKTFILTER_PORT_ANY,
+    };
+
+    /* UDP and TCP both start with source and destination port */
+    if (((hdr->nh == PROTNUM_UDP) || (hdr->nh == PROTNUM_TCP)) &&
+        (len >= sizeof(ipv6_hdr_t) + 4)) {
+        const uint8_t *payload = (const uint8_t *)(hdr + 1);
+        pkt.port = (payload[2] << 8) | payload[3];
+    }
+    return pktfilter_pass(&gnrc_pktfilter, &pkt);
+}
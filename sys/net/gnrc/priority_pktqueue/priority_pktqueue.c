@@ -19,6 +19,9 @@
  * @}
  */
 
+#if !defined(MODULE_GNRC_PRIORITY_PKTQUEUE_HEAP) && \
+    !defined(MODULE_GNRC_PRIORITY_PKTQUEUE_DRR)
+
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/priority_pktqueue.h"
 
@@ -55,8 +58,8 @@ gnrc_pktsnip_t *gnrc_priority_pktqueue_head(gnrc_priority_pktqueue_t *queue)
 }
 /******************************************************************************/
 
-void gnrc_priority_pktqueue_push(gnrc_priority_pktqueue_t *queue,
-                                 gnrc_priority_pktqueue_node_t *node)
+int gnrc_priority_pktqueue_push(gnrc_priority_pktqueue_t *queue,
+                                gnrc_priority_pktqueue_node_t *node)
 {
     assert(queue != NULL);
     assert(node != NULL);
@@ -64,6 +67,7 @@ void gnrc_priority_pktqueue_push(gnrc_priority_pktqueue_t *queue,
     assert(sizeof(unsigned int) == sizeof(gnrc_pktsnip_t *));
 
     priority_queue_add(queue, (priority_queue_node_t *)node);
+    return 0;
 }
 
 /******************************************************************************/
@@ -100,3 +104,5 @@ uint32_t gnrc_priority_pktqueue_length(gnrc_priority_pktqueue_t *queue)
     }
     return length;
 }
+
+#endif /* !MODULE_GNRC_PRIORITY_PKTQUEUE_HEAP && !MODULE_GNRC_PRIORITY_PKTQUEUE_DRR */
@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_priority_pktqueue
+ * @{
+ *
+ * @file
+ * @brief       gnrc priority packet queue implementation with traffic classes
+ *              served by deficit round robin
+ *
+ * Alternative to the sorted list in priority_pktqueue.c, enabled with the
+ * `gnrc_priority_pktqueue_drr` module.
+ *
+ * @}
+ */
+
+#ifdef MODULE_GNRC_PRIORITY_PKTQUEUE_DRR
+
+#include <errno.h>
+
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/priority_pktqueue.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#if GNRC_PRIORITY_PKTQUEUE_CLASSES < 2
+#error "gnrc_priority_pktqueue_drr needs at least two classes"
+#endif
+
+static gnrc_priority_pktqueue_class_conf_t _conf[GNRC_PRIORITY_PKTQUEUE_CLASSES];
+
+static inline unsigned _class(const gnrc_priority_pktqueue_node_t *node)
+{
+    return (node->priority < GNRC_PRIORITY_PKTQUEUE_CLASSES) ?
+           node->priority : (GNRC_PRIORITY_PKTQUEUE_CLASSES - 1);
+}
+
+static inline uint32_t _quantum(unsigned cls)
+{
+    if (_conf[cls].quantum != 0) {
+        return _conf[cls].quantum;
+    }
+    return GNRC_PRIORITY_PKTQUEUE_QUANTUM << (GNRC_PRIORITY_PKTQUEUE_CLASSES - 1 - cls);
+}
+
+static inline void _free_node(gnrc_priority_pktqueue_node_t *node)
+{
+    assert(node != NULL);
+
+    gnrc_priority_pktqueue_node_init(node, 0, NULL);
+}
+
+/* Returns the class whose oldest packet is sent next. Calling it again
+ * without popping returns the same class, so peeking at the head does not
+ * change the order. */
+static gnrc_priority_pktqueue_class_t *_select(gnrc_priority_pktqueue_t *queue)
+{
+    /* control traffic bypasses the round, it is kept short by its limits */
+    if (queue->classes[GNRC_PRIORITY_PKTQUEUE_CLASS_CONTROL].first != NULL) {
+        return &queue->classes[GNRC_PRIORITY_PKTQUEUE_CLASS_CONTROL];
+    }
+    if (queue->current == GNRC_PRIORITY_PKTQUEUE_CLASS_CONTROL) {
+        queue->current++;
+    }
+    while (1) {
+        gnrc_priority_pktqueue_class_t *cls = &queue->classes[queue->current];
+
+        if (cls->first == NULL) {
+            /* idle classes don't save up credit */
+            cls->deficit = 0;
+        }
+        else if (gnrc_pkt_len(cls->first->pkt) <= cls->deficit) {
+            return cls;
+        }
+        else if (!queue->granted) {
+            cls->deficit += _quantum(queue->current);
+            queue->granted = 1;
+            continue;
+        }
+        /* next class, skipping the control class */
+        queue->current = (queue->current % (GNRC_PRIORITY_PKTQUEUE_CLASSES - 1)) + 1;
+        queue->granted = 0;
+    }
+}
+
+void gnrc_priority_pktqueue_set_class(unsigned cls,
+                                      const gnrc_priority_pktqueue_class_conf_t *conf)
+{
+    assert(cls < GNRC_PRIORITY_PKTQUEUE_CLASSES);
+    assert(conf != NULL);
+
+    _conf[cls] = *conf;
+}
+
+uint32_t gnrc_priority_pktqueue_classify(gnrc_pktsnip_t *pkt, uint32_t priority)
+{
+    assert(pkt != NULL);
+
+#ifdef MODULE_GNRC_ICMPV6
+    if (gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_ICMPV6) != NULL) {
+        return GNRC_PRIORITY_PKTQUEUE_CLASS_CONTROL;
+    }
+#endif
+#ifdef MODULE_GNRC_IPV4
+    if (gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_ICMP) != NULL) {
+        return GNRC_PRIORITY_PKTQUEUE_CLASS_CONTROL;
+    }
+#endif
+#ifdef MODULE_GNRC_IPV4_ARP
+    if (gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_ARP) != NULL) {
+        return GNRC_PRIORITY_PKTQUEUE_CLASS_CONTROL;
+    }
+#endif
+    (void)pkt;
+    if (priority >= (GNRC_PRIORITY_PKTQUEUE_CLASSES - 1)) {
+        return GNRC_PRIORITY_PKTQUEUE_CLASSES - 1;
+    }
+    return priority + 1;
+}
+
+gnrc_pktsnip_t *gnrc_priority_pktqueue_pop(gnrc_priority_pktqueue_t *queue)
+{
+    if (!queue || (gnrc_priority_pktqueue_length(queue) == 0)) {
+        return NULL;
+    }
+    gnrc_priority_pktqueue_class_t *cls = _select(queue);
+    gnrc_priority_pktqueue_node_t *head = cls->first;
+    gnrc_pktsnip_t *pkt = head->pkt;
+    size_t len = gnrc_pkt_len(pkt);
+
+    cls->first = head->next;
+    if (cls->first == NULL) {
+        cls->last = NULL;
+    }
+    if (cls != &queue->classes[GNRC_PRIORITY_PKTQUEUE_CLASS_CONTROL]) {
+        cls->deficit -= len;
+    }
+    cls->bytes -= len;
+    cls->pkts--;
+    _free_node(head);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_priority_pktqueue_head(gnrc_priority_pktqueue_t *queue)
+{
+    if (!queue || (gnrc_priority_pktqueue_length(queue) == 0)) {
+        return NULL;
+    }
+    return _select(queue)->first->pkt;
+}
+
+int gnrc_priority_pktqueue_push(gnrc_priority_pktqueue_t *queue,
+                                gnrc_priority_pktqueue_node_t *node)
+{
+    assert(queue != NULL);
+    assert(node != NULL);
+    assert(node->pkt != NULL);
+
+    unsigned idx = _class(node);
+    gnrc_priority_pktqueue_class_t *cls = &queue->classes[idx];
+    size_t len = gnrc_pkt_len(node->pkt);
+
+    if (((_conf[idx].max_pkts != 0) && (cls->pkts >= _conf[idx].max_pkts)) ||
+        ((_conf[idx].max_bytes != 0) &&
+         ((cls->bytes + len) > _conf[idx].max_bytes)) ||
+        ((cls->bytes + len) > UINT16_MAX)) {
+        DEBUG("priority_pktqueue: class %u full\n", idx);
+        return -ENOBUFS;
+    }
+    node->next = NULL;
+    if (cls->last == NULL) {
+        cls->first = node;
+    }
+    else {
+        cls->last->next = node;
+    }
+    cls->last = node;
+    cls->bytes += len;
+    cls->pkts++;
+    return 0;
+}
+
+void gnrc_priority_pktqueue_flush(gnrc_priority_pktqueue_t *queue)
+{
+    assert(queue != NULL);
+
+    for (unsigned i = 0; i < GNRC_PRIORITY_PKTQUEUE_CLASSES; i++) {
+        gnrc_priority_pktqueue_node_t *node = queue->classes[i].first;
+
+        while (node != NULL) {
+            gnrc_priority_pktqueue_node_t *next = node->next;
+
+            gnrc_pktbuf_release(node->pkt);
+            _free_node(node);
+            node = next;
+        }
+    }
+    gnrc_priority_pktqueue_init(queue);
+}
+
+uint32_t gnrc_priority_pktqueue_length(gnrc_priority_pktqueue_t *queue)
+{
+    assert(queue != NULL);
+
+    uint32_t length = 0;
+    for (unsigned i = 0; i < GNRC_PRIORITY_PKTQUEUE_CLASSES; i++) {
+        length += queue->classes[i].pkts;
+    }
+    return length;
+}
+
+#endif /* MODULE_GNRC_PRIORITY_PKTQUEUE_DRR */
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_priority_pktqueue
+ * @{
+ *
+ * @file
+ * @brief       gnrc priority packet queue implementation based on a binary heap
+ *
+ * Alternative to the sorted list in priority_pktqueue.c, enabled with the
+ * `gnrc_priority_pktqueue_heap` module.
+ *
+ * @}
+ */
+
+#ifdef MODULE_GNRC_PRIORITY_PKTQUEUE_HEAP
+
+#include "kernel_defines.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/priority_pktqueue.h"
+
+static inline gnrc_priority_pktqueue_node_t *_node(priority_heap_node_t *node)
+{
+    return container_of(node, gnrc_priority_pktqueue_node_t, node);
+}
+
+static inline void _free_node(gnrc_priority_pktqueue_node_t *node)
+{
+    assert(node != NULL);
+
+    gnrc_priority_pktqueue_node_init(node, 0, NULL);
+}
+
+gnrc_pktsnip_t *gnrc_priority_pktqueue_pop(gnrc_priority_pktqueue_t *queue)
+{
+    if (!queue || (priority_heap_size(queue) == 0)) {
+        return NULL;
+    }
+    gnrc_priority_pktqueue_node_t *head = _node(priority_heap_remove_head(queue));
+    gnrc_pktsnip_t *pkt = head->pkt;
+    _free_node(head);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_priority_pktqueue_head(gnrc_priority_pktqueue_t *queue)
+{
+    if (!queue || (priority_heap_size(queue) == 0)) {
+        return NULL;
+    }
+    return _node(priority_heap_peek(queue))->pkt;
+}
+
+int gnrc_priority_pktqueue_push(gnrc_priority_pktqueue_t *queue,
+                                gnrc_priority_pktqueue_node_t *node)
+{
+    assert(queue != NULL);
+    assert(node != NULL);
+    assert(node->pkt != NULL);
+
+    priority_heap_add(queue, &node->node);
+    return 0;
+}
+
+void gnrc_priority_pktqueue_flush(gnrc_priority_pktqueue_t *queue)
+{
+    assert(queue != NULL);
+
+    priority_heap_node_t *node;
+    while ((node = priority_heap_remove_head(queue))) {
+        gnrc_pktbuf_release(_node(node)->pkt);
+        _free_node(_node(node));
+    }
+}
+
+uint32_t gnrc_priority_pktqueue_length(gnrc_priority_pktqueue_t *queue)
+{
+    assert(queue != NULL);
+
+    return priority_heap_size(queue);
+}
+
+#endif /* MODULE_GNRC_PRIORITY_PKTQUEUE_HEAP */
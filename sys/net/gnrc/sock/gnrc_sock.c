@@ -16,7 +16,11 @@
 #include <errno.h>
 
 #include "net/af.h"
+#include "net/ipv4/hdr.h"
 #include "net/ipv6/hdr.h"
+#ifdef MODULE_GNRC_IPV4
+#include "net/gnrc/ipv4/hdr.h"
+#endif
 #include "net/gnrc/ipv6/hdr.h"
 #include "net/gnrc/ipv6/netif.h"
 #include "net/gnrc/netreg.h"
@@ -90,14 +94,25 @@ ssize_t gnrc_sock_recv(gnrc_sock_reg_t *reg, gnrc_pktsnip_t **pkt_out,
         default:
             return -EINTR;
     }
-    /* TODO: discern NETTYPE from remote->family (set in caller), when IPv4
-     * was implemented */
-    ipv6_hdr_t *ipv6_hdr;
-    ip = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_IPV6);
-    assert((ip != NULL) && (ip->size >= 40));
-    ipv6_hdr = ip->data;
-    memcpy(&remote->addr, &ipv6_hdr->src, sizeof(ipv6_addr_t));
-    remote->family = AF_INET6;
+#ifdef SOCK_HAS_IPV6
+    if ((ip = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_IPV6)) != NULL) {
+        ipv6_hdr_t *ipv6_hdr = ip->data;
+
+        assert(ip->size >= sizeof(ipv6_hdr_t));
+        memcpy(&remote->addr, &ipv6_hdr->src, sizeof(ipv6_addr_t));
+        remote->family = AF_INET6;
+    }
+#endif
+#ifdef SOCK_HAS_IPV4
+    if ((ip = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_IPV4)) != NULL) {
+        ipv4_hdr_t *ipv4_hdr = ip->data;
+
+        assert(ip->size >= sizeof(ipv4_hdr_t));
+        memcpy(&remote->addr, &ipv4_hdr->src, sizeof(ipv4_addr_t));
+        remote->family = AF_INET;
+    }
+#endif
+    assert((remote->family == AF_INET) || (remote->family == AF_INET6));
     netif = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_NETIF);
     if (netif == NULL) {
         remote->netif = SOCK_ADDR_ANY_NETIF;
@@ -143,6 +158,26 @@ ssize_t gnrc_sock_send(gnrc_pktsnip_t *payload, sock_ip_ep_t *local,
             hdr->nh = nh;
             break;
         }
+#endif
+#ifdef SOCK_HAS_IPV4
+        case AF_INET: {
+            ipv4_hdr_t *hdr;
+            pkt = gnrc_ipv4_hdr_build(payload, (ipv4_addr_t *)&local->addr.ipv4,
+                                      (ipv4_addr_t *)&remote->addr.ipv4);
+            if (pkt == NULL) {
+                return -ENOMEM;
+            }
+            if (payload->type == GNRC_NETTYPE_UNDEF) {
+                payload->type = GNRC_NETTYPE_IPV4;
+                type = GNRC_NETTYPE_IPV4;
+            }
+            else {
+                type = payload->type;
+            }
+            hdr = pkt->data;
+            hdr->protocol = nh;
+            break;
+        }
 #endif
         default:
             (void)nh;
@@ -76,8 +76,17 @@ extern "C" {
  */
 static inline bool gnrc_af_not_supported(int af)
 {
-    /* TODO: add AF_INET support */
-    return (af != AF_INET6);
+    switch (af) {
+#ifdef SOCK_HAS_IPV4
+        case AF_INET:
+#endif
+#ifdef SOCK_HAS_IPV6
+        case AF_INET6:
+#endif
+            return false;
+        default:
+            return true;
+    }
 }
 
 /**
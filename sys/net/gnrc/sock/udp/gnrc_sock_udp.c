@@ -20,6 +20,7 @@
 #include "byteorder.h"
 #include "net/af.h"
 #include "net/protnum.h"
+#include "net/ipv4/addr.h"
 #include "net/gnrc/ipv6.h"
 #include "net/gnrc/udp.h"
 #include "net/sock/udp.h"
@@ -83,6 +84,36 @@ static uint16_t _get_dyn_port(sock_udp_t *sock)
     return GNRC_SOCK_DYN_PORTRANGE_ERR;
 }
 
+/**
+ * @brief   Returns the length of an address of the given family
+ */
+static inline size_t _addr_len(int family)
+{
+#ifdef SOCK_HAS_IPV4
+    if (family == AF_INET) {
+        return sizeof(ipv4_addr_t);
+    }
+#else
+    (void)family;
+#endif
+    return sizeof(ipv6_addr_t);
+}
+
+/**
+ * @brief   Checks if the address of an end point is unspecified
+ */
+static bool _addr_unspecified(const sock_udp_ep_t *ep)
+{
+    const uint8_t *p = (uint8_t *)&ep->addr;
+
+    for (unsigned i = 0; i < _addr_len(ep->family); i++) {
+        if (p[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
 int sock_udp_create(sock_udp_t *sock, const sock_udp_ep_t *local,
                     const sock_udp_ep_t *remote, uint16_t flags)
 {
@@ -189,21 +220,23 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
     udp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_UDP);
     assert(udp);
     hdr = udp->data;
-    if (remote != NULL) {
-        /* return remote to possibly block if wrong remote */
-        memcpy(remote, &tmp, sizeof(tmp));
-        remote->port = byteorder_ntohs(hdr->src_port);
+    if (tmp.family != sock->local.family) {
+        /* the port is shared between IPv4 and IPv6 */
+        gnrc_pktbuf_release(pkt);
+        return -EPROTO;
     }
     if ((sock->remote.family != AF_UNSPEC) &&  /* check remote end-point if set */
         ((sock->remote.port != byteorder_ntohs(hdr->src_port)) ||
-        /* We only have IPv6 for now, so just comparing the whole end point
-         * should suffice */
-        ((memcmp(&sock->remote.addr, &ipv6_addr_unspecified,
-                 sizeof(ipv6_addr_t)) != 0) &&
-         (memcmp(&sock->remote.addr, &tmp.addr, sizeof(ipv6_addr_t)) != 0)))) {
+        (!_addr_unspecified(&sock->remote) &&
+         (memcmp(&sock->remote.addr, &tmp.addr,
+                 _addr_len(sock->remote.family)) != 0)))) {
         gnrc_pktbuf_release(pkt);
         return -EPROTO;
     }
+    if (remote != NULL) {
+        memcpy(remote, &tmp, sizeof(tmp));
+        remote->port = byteorder_ntohs(hdr->src_port);
+    }
     memcpy(data, pkt->data, pkt->size);
     gnrc_pktbuf_release(pkt);
     return (int)pkt->size;
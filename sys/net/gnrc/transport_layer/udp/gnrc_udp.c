@@ -17,6 +17,7 @@
  * @}
  */
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <errno.h>
 
@@ -24,6 +25,7 @@
 #include "msg.h"
 #include "thread.h"
 #include "utlist.h"
+#include "net/ipv4/hdr.h"
 #include "net/ipv6/hdr.h"
 #include "net/gnrc/udp.h"
 #include "net/gnrc.h"
@@ -80,6 +82,11 @@ static uint16_t _calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr,
         case GNRC_NETTYPE_IPV6:
             csum = ipv6_hdr_inet_csum(csum, pseudo_hdr->data, PROTNUM_UDP, len);
             break;
+#endif
+#ifdef MODULE_GNRC_IPV4
+        case GNRC_NETTYPE_IPV4:
+            csum = ipv4_hdr_inet_csum(csum, pseudo_hdr->data, PROTNUM_UDP, len);
+            break;
 #endif
         default:
             (void)len;
@@ -98,9 +105,25 @@ static uint16_t _calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr,
     }
 }
 
+/**
+ * @brief   Checks if a received packet may omit the checksum
+ *
+ * RFC 768: "An all zero transmitted checksum value means that the transmitter
+ * generated no checksum", which is only allowed over IPv4.
+ */
+static inline bool _zero_csum_allowed(gnrc_pktsnip_t *ip)
+{
+#ifdef MODULE_GNRC_IPV4
+    return (ip->type == GNRC_NETTYPE_IPV4);
+#else
+    (void)ip;
+    return false;
+#endif
+}
+
 static void _receive(gnrc_pktsnip_t *pkt)
 {
-    gnrc_pktsnip_t *udp, *ipv6;
+    gnrc_pktsnip_t *udp, *ip;
     udp_hdr_t *hdr;
     uint32_t port;
 
@@ -113,9 +136,14 @@ static void _receive(gnrc_pktsnip_t *pkt)
     }
     pkt = udp;
 
-    ipv6 = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_IPV6);
+    ip = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_IPV6);
+#ifdef MODULE_GNRC_IPV4
+    if (ip == NULL) {
+        ip = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_IPV4);
+    }
+#endif
 
-    assert(ipv6 != NULL);
+    assert(ip != NULL);
 
     if ((pkt->next != NULL) && (pkt->next->type == GNRC_NETTYPE_UDP) &&
         (pkt->next->size == sizeof(udp_hdr_t))) {
@@ -137,15 +165,17 @@ static void _receive(gnrc_pktsnip_t *pkt)
 
     /* validate checksum */
     if (byteorder_ntohs(hdr->checksum) == 0) {
-        /* RFC 2460 Section 8.1
-         * "IPv6 receivers must discard UDP packets containing a zero checksum,
-         * and should log the error."
-         */
-        DEBUG("udp: received packet with zero checksum, dropping it\n");
-        gnrc_pktbuf_release(pkt);
-        return;
+        if (!_zero_csum_allowed(ip)) {
+            /* RFC 2460 Section 8.1
+             * "IPv6 receivers must discard UDP packets containing a zero checksum,
+             * and should log the error."
+             */
+            DEBUG("udp: received packet with zero checksum, dropping it\n");
+            gnrc_pktbuf_release(pkt);
+            return;
+        }
     }
-    if (_calc_csum(udp, ipv6, pkt) != 0xFFFF) {
+    else if (_calc_csum(udp, ip, pkt) != 0xFFFF) {
         DEBUG("udp: received packet with invalid checksum, dropping it\n");
         gnrc_pktbuf_release(pkt);
         return;
@@ -15,6 +15,7 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <stdbool.h>
 #include <string.h>
 
 #include "net/ieee802154.h"
@@ -241,4 +242,176 @@ int ieee802154_get_dst(const uint8_t *mhr, uint8_t *dst, le_uint16_t *dst_pan)
     return 0;
 }
 
+#define PAN_DST         (0x1)   /**< destination PAN ID present */
+#define PAN_SRC         (0x2)   /**< source PAN ID present */
+#define PAN_INVALID     (0xf)   /**< illegal addressing mode combination */
+
+/**
+ * @brief   Presence of the PAN IDs
+ *
+ * Indexed by 2015 frame, PAN ID compression and destination and source
+ * addressing modes (in that order, 4 bit), so the addressing fields of any
+ * frame version are decoded without branching on the modes.
+ *
+ * @see IEEE Std 802.15.4-2015, Table 7-2
+ */
+static const uint8_t _pan_presence[2][2][16] = {
+    {   /* 2003 and 2006 frames */
+        { 0x0, 0xf, 0x2, 0x2, 0xf, 0xf, 0xf, 0xf,
+          0x1, 0xf, 0x3, 0x3, 0x1, 0xf, 0x3, 0x3 },
+        /* PAN compression, but no destination address => illegal state */
+        { 0xf, 0xf, 0xf, 0xf, 0xf, 0xf, 0xf, 0xf,
+          0x1, 0xf, 0x1, 0x1, 0x1, 0xf, 0x1, 0x1 },
+    },
+    {   /* 2015 frames */
+        { 0x0, 0xf, 0x2, 0x2, 0xf, 0xf, 0xf, 0xf,
+          0x1, 0xf, 0x3, 0x3, 0x1, 0xf, 0x3, 0x1 },
+        { 0x1, 0xf, 0x0, 0x0, 0xf, 0xf, 0xf, 0xf,
+          0x0, 0xf, 0x1, 0x1, 0x0, 0xf, 0x1, 0x0 },
+    },
+};
+
+/**
+ * @brief   Address length by addressing mode
+ */
+static const uint8_t _addr_len[] = {
+    0, 0, IEEE802154_SHORT_ADDRESS_LEN, IEEE802154_LONG_ADDRESS_LEN
+};
+
+static inline void _copy_addr_reverse(uint8_t *dst, const uint8_t *src,
+                                      uint8_t len)
+{
+    for (unsigned i = 0; i < len; i++) {
+        dst[len - 1 - i] = src[i];
+    }
+}
+
+int ieee802154_parse_mhr(const uint8_t *buf, size_t len, ieee802154_mhr_t *mhr)
+{
+    static const uint8_t key_id_len[] = { 0, 1, 5, 9 };
+    size_t pos = IEEE802154_FCF_LEN;
+
+    assert((buf != NULL) && (mhr != NULL));
+    if (len < IEEE802154_FCF_LEN) {
+        return -EINVAL;
+    }
+    /* only reset what is not necessarily written below, addresses beyond
+     * their length are left untouched */
+    mhr->flags = 0;
+    mhr->seq = 0;
+    mhr->sec_ctrl = 0;
+    mhr->frame_cnt = 0;
+    mhr->sec_offset = 0;
+    mhr->ie_offset = 0;
+    mhr->ie_len = 0;
+    mhr->dst_pan.u16 = 0;
+    mhr->fcf[0] = buf[0];
+    mhr->fcf[1] = buf[1];
+    bool v2 = ((buf[1] & IEEE802154_FCF_VERS_MASK) == IEEE802154_FCF_VERS_V2);
+
+    if (!v2 || !(buf[1] & IEEE802154_FCF_SEQ_SUPPR)) {
+        if (pos >= len) {
+            return -EINVAL;
+        }
+        mhr->seq = buf[pos++];
+        mhr->flags |= IEEE802154_MHR_SEQ;
+    }
+
+    /* addressing fields */
+    uint8_t dst_mode = (buf[1] & IEEE802154_FCF_DST_ADDR_MASK) >> 2;
+    uint8_t src_mode = (buf[1] & IEEE802154_FCF_SRC_ADDR_MASK) >> 6;
+    uint8_t pans = _pan_presence[v2][!!(buf[0] & IEEE802154_FCF_PAN_COMP)]
+                                [(dst_mode << 2) | src_mode];
+
+    if (pans == PAN_INVALID) {
+        return -EINVAL;
+    }
+    mhr->dst_len = _addr_len[dst_mode];
+    mhr->src_len = _addr_len[src_mode];
+    if ((pos + ((pans & PAN_DST) ? 2 : 0) + ((pans & PAN_SRC) ? 2 : 0) +
+         mhr->dst_len + mhr->src_len) > len) {
+        return -EINVAL;
+    }
+    if (pans & PAN_DST) {
+        mhr->dst_pan.u8[0] = buf[pos++];
+        mhr->dst_pan.u8[1] = buf[pos++];
+    }
+    /* read addresses in little endian */
+    _copy_addr_reverse(mhr->dst, &buf[pos], mhr->dst_len);
+    pos += mhr->dst_len;
+    if (pans & PAN_SRC) {
+        mhr->src_pan.u8[0] = buf[pos++];
+        mhr->src_pan.u8[1] = buf[pos++];
+    }
+    else {
+        mhr->src_pan = mhr->dst_pan;
+    }
+    _copy_addr_reverse(mhr->src, &buf[pos], mhr->src_len);
+    pos += mhr->src_len;
+
+    /* auxiliary security header */
+    if (buf[0] & IEEE802154_FCF_SECURITY_EN) {
+        if (pos >= len) {
+            return -EINVAL;
+        }
+        mhr->flags |= IEEE802154_MHR_SECURITY;
+        mhr->sec_offset = pos;
+        mhr->sec_ctrl = buf[pos++];
+        if (!v2 || !(mhr->sec_ctrl & IEEE802154_SCF_FC_SUPPR)) {
+            if ((pos + sizeof(uint32_t)) > len) {
+                return -EINVAL;
+            }
+            mhr->frame_cnt = ((uint32_t)buf[pos]) |
+                             ((uint32_t)buf[pos + 1] << 8) |
+                             ((uint32_t)buf[pos + 2] << 16) |
+                             ((uint32_t)buf[pos + 3] << 24);
+            pos += sizeof(uint32_t);
+        }
+        pos += key_id_len[(mhr->sec_ctrl & IEEE802154_SCF_KEYMODE_MASK) >>
+                          IEEE802154_SCF_KEYMODE_SHIFT];
+        if (pos > len) {
+            return -EINVAL;
+        }
+    }
+
+    /* header information elements */
+    if (v2 && (buf[1] & IEEE802154_FCF_IE_PRESENT)) {
+        mhr->flags |= IEEE802154_MHR_HDR_IE;
+        mhr->ie_offset = pos;
+        while (1) {
+            if ((pos + 2) > len) {
+                /* IE list may end with the frame if there is no payload */
+                break;
+            }
+            uint16_t desc = buf[pos] | (buf[pos + 1] << 8);
+            uint8_t ie_len = desc & 0x7f;
+            uint8_t ie_id = (desc >> 7) & 0xff;
+
+            if (desc & 0x8000) {
+                /* payload IE without header termination => illegal state */
+                return -EINVAL;
+            }
+            if ((ie_id == IEEE802154_IE_HT1) || (ie_id == IEEE802154_IE_HT2)) {
+                mhr->ie_len = pos - mhr->ie_offset;
+                if (ie_id == IEEE802154_IE_HT1) {
+                    mhr->flags |= IEEE802154_MHR_PAYLOAD_IE;
+                }
+                pos += 2;
+                break;
+            }
+            pos += 2 + ie_len;
+            if (pos > len) {
+                return -EINVAL;
+            }
+            mhr->ie_len = pos - mhr->ie_offset;
+        }
+    }
+
+    if (pos > UINT8_MAX) {
+        return -EINVAL;
+    }
+    mhr->hdr_len = pos;
+    return pos;
+}
+
 /** @} */
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_lora
+ * @{
+ *
+ * @file
+ * @brief       LoRa time on air and duty cycle accounting implementation
+ *
+ * @}
+ */
+
+#include "assert.h"
+#include "net/lora.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/* the preamble is 4.25 symbols longer than programmed */
+#define PREAMBLE_EXTRA_QUARTERS     (17U)
+#define HEADER_SYMBOLS              (8U)
+
+const lora_duty_band_t lora_duty_bands_eu868[LORA_DUTY_BANDS_EU868_NUMOF] = {
+    { .min_freq = 863000000, .max_freq = 864999999, .duty = 1 },
+    { .min_freq = 865000000, .max_freq = 867999999, .duty = 10 },
+    { .min_freq = 868000000, .max_freq = 868600000, .duty = 10 },
+    { .min_freq = 868700000, .max_freq = 869200000, .duty = 1 },
+    { .min_freq = 869400000, .max_freq = 869650000, .duty = 100 },
+    { .min_freq = 869700000, .max_freq = 870000000, .duty = 10 },
+};
+
+static int _find_band(const lora_duty_t *duty, uint32_t freq)
+{
+    for (unsigned i = 0; i < duty->numof; i++) {
+        if ((freq >= duty->bands[i].min_freq) &&
+            (freq <= duty->bands[i].max_freq)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+uint32_t lora_symbol_time(const lora_modulation_t *mod)
+{
+    assert((mod->bandwidth == 125) || (mod->bandwidth == 250) ||
+           (mod->bandwidth == 500));
+    assert((mod->sf >= 6) && (mod->sf <= 12));
+
+    /* 2^SF / BW, exact for all valid bandwidths */
+    return (1000UL << mod->sf) / mod->bandwidth;
+}
+
+uint32_t lora_time_on_air(const lora_modulation_t *mod, uint8_t payload_len)
+{
+    assert((mod->cr >= 1) && (mod->cr <= 4));
+
+    uint32_t t_sym = lora_symbol_time(mod);
+    uint32_t symbols = HEADER_SYMBOLS;
+    int32_t num = (8 * (int32_t)payload_len) - (4 * mod->sf) + 28;
+    int32_t den = 4 * mod->sf;
+
+    if (mod->flags & LORA_FLAG_CRC) {
+        num += 16;
+    }
+    if (mod->flags & LORA_FLAG_IMPLICIT_HEADER) {
+        num -= 20;
+    }
+    if (mod->flags & LORA_FLAG_LOW_DATARATE_OPT) {
+        den -= 8;
+    }
+    if (num > 0) {
+        symbols += ((num + den - 1) / den) * (mod->cr + 4);
+    }
+
+    DEBUG("lora: %u symbols payload at %u us per symbol\n",
+          (unsigned)symbols, (unsigned)t_sym);
+
+    return ((((uint32_t)mod->preamble_len * 4) + PREAMBLE_EXTRA_QUARTERS) *
+            t_sym) / 4 + (symbols * t_sym);
+}
+
+void lora_duty_init(lora_duty_t *duty, const lora_duty_band_t *bands,
+                    unsigned numof)
+{
+    assert(numof <= LORA_DUTY_BANDS_MAX);
+
+    duty->bands = bands;
+    duty->numof = numof;
+    for (unsigned i = 0; i < numof; i++) {
+        duty->ready[i] = 0;
+    }
+}
+
+uint64_t lora_duty_wait(const lora_duty_t *duty, uint32_t freq, uint64_t now)
+{
+    int band = _find_band(duty, freq);
+
+    if ((band < 0) || (duty->ready[band] <= now)) {
+        return 0;
+    }
+    return duty->ready[band] - now;
+}
+
+void lora_duty_account(lora_duty_t *duty, uint32_t freq, uint64_t now,
+                       uint32_t time_on_air)
+{
+    int band = _find_band(duty, freq);
+
+    if (band < 0) {
+        return;
+    }
+    /* the sub-band stays closed for time_on_air / duty, rounded up */
+    uint16_t d = duty->bands[band].duty;
+    duty->ready[band] = now + ((((uint64_t)time_on_air * 1000) + d - 1) / d);
+    DEBUG("lora: band %i closed for %lu us\n", band,
+          (unsigned long)(duty->ready[band] - now));
+}
@@ -18,10 +18,16 @@
  * @}
  */
 
+#include <string.h>
+
 #include "irq.h"
 #include "periph/pm.h"
 #include "pm_layered.h"
 
+#ifdef MODULE_PM_TICKLESS
+#include "xtimer.h"
+#endif
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -46,6 +52,23 @@ typedef union {
  */
 volatile pm_blocker_t pm_blocker = PM_BLOCKER_INITIAL;
 
+#ifdef MODULE_PM_TICKLESS
+#ifndef PM_TICKLESS_MODES
+/* without any parameters, every unblocked mode is considered to pay off */
+#define PM_TICKLESS_MODES { { 0, 0 } }
+#endif
+
+/**
+ * @brief Exit latency and break-even time of each power mode
+ */
+static const pm_tickless_mode_t _modes[PM_NUM_MODES] = PM_TICKLESS_MODES;
+
+/**
+ * @brief Residency statistics, including the implicit idle mode
+ */
+static pm_tickless_stats_t _stats[PM_NUM_MODES + 1];
+#endif
+
 void pm_set_lowest(void)
 {
     pm_blocker_t blocker = (pm_blocker_t) pm_blocker;
@@ -60,8 +83,17 @@ void pm_set_lowest(void)
     /* set lowest mode if blocker is still the same */
     unsigned state = irq_disable();
     if (blocker.val_u32 == pm_blocker.val_u32) {
+#ifdef MODULE_PM_TICKLESS
+        /* the next deadline can only move while interrupts are enabled */
+        uint32_t left = xtimer_usec_from_ticks(xtimer_left_until_next());
+        mode = pm_tickless_select(_modes, PM_NUM_MODES, mode, left);
+        uint32_t start = xtimer_now_usec();
+#endif
         DEBUG("pm: setting mode %u\n", mode);
         pm_set(mode);
+#ifdef MODULE_PM_TICKLESS
+        pm_tickless_record(&_stats[mode], xtimer_now_usec() - start);
+#endif
     }
     else {
         DEBUG("pm: mode block changed\n");
@@ -87,6 +119,20 @@ void pm_unblock(unsigned mode)
     irq_restore(state);
 }
 
+#ifdef MODULE_PM_TICKLESS
+const pm_tickless_stats_t *pm_layered_stats(void)
+{
+    return _stats;
+}
+
+void pm_layered_stats_reset(void)
+{
+    unsigned state = irq_disable();
+    memset(_stats, 0, sizeof(_stats));
+    irq_restore(state);
+}
+#endif
+
 void __attribute__((weak)) pm_off(void)
 {
     pm_blocker.val_u32 = 0;
@@ -0,0 +1,38 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_pm_tickless
+ * @{
+ *
+ * @file
+ * @brief       Tickless idle policy implementation
+ *
+ * @}
+ */
+
+#include "pm_tickless.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+unsigned pm_tickless_select(const pm_tickless_mode_t *modes, unsigned numof,
+                            unsigned lowest, uint32_t time_left)
+{
+    for (unsigned mode = lowest; mode < numof; mode++) {
+        if ((modes[mode].exit_latency <= time_left) &&
+            (modes[mode].break_even <= time_left)) {
+            DEBUG("pm_tickless: %u us left, selecting mode %u\n",
+                  (unsigned)time_left, mode);
+            return mode;
+        }
+    }
+
+    DEBUG("pm_tickless: %u us left, staying idle\n", (unsigned)time_left);
+    return numof;
+}
@@ -22,6 +22,25 @@
 extern "C" {
 #endif
 
+#if defined(MODULE_PTHREAD_TLS_STATIC) || defined(DOXYGEN)
+#ifndef PTHREAD_KEYS_MAX
+/**
+ * @brief   Maximum number of keys, with the `pthread_tls_static` module
+ *
+ * Every pthread reserves one pointer per key.
+ */
+#define PTHREAD_KEYS_MAX                (8)
+#endif
+
+#ifndef PTHREAD_DESTRUCTOR_ITERATIONS
+/**
+ * @brief   Maximum number of destructor rounds on thread exit, with the
+ *          `pthread_tls_static` module
+ */
+#define PTHREAD_DESTRUCTOR_ITERATIONS   (4)
+#endif
+#endif
+
 /**
  * @brief   Internal representation of a thread-specific key.
  * @internal
@@ -77,11 +96,21 @@ int pthread_key_delete(pthread_key_t key);
  */
 void __pthread_keys_exit(int self_id);
 
+#ifdef MODULE_PTHREAD_TLS_STATIC
+/**
+ * @brief Returns the thread-specific data slots of a pthread.
+ * @param[in] pid kernel PID of the thread
+ * @return the slots, `NULL` if the thread is no pthread
+ * @internal
+ */
+void **__pthread_get_tls_slots(kernel_pid_t pid);
+#else
 /**
  * @brief Returns the pointer to the head of the list of thread-specific data.
  * @internal
  */
 struct __pthread_tls_datum **__pthread_get_tls_head(int self_id) PURE;
+#endif
 
 #ifdef __cplusplus
 }
@@ -68,12 +68,20 @@ typedef struct {
 
     char *stack;
 
+#ifdef MODULE_PTHREAD_TLS_STATIC
+    void *tls[PTHREAD_KEYS_MAX];
+#else
     struct __pthread_tls_datum *tls_head;
+#endif
 
     __pthread_cleanup_datum_t *cleanup_top;
 } pthread_thread_t;
 
 static pthread_thread_t *volatile pthread_sched_threads[MAXTHREADS];
+#ifdef MODULE_PTHREAD_TLS_STATIC
+/* allows finding the calling pthread without searching pthread_sched_threads */
+static pthread_thread_t *volatile pthread_by_pid[KERNEL_PID_LAST + 1];
+#endif
 static mutex_t pthread_mutex;
 
 static volatile kernel_pid_t pthread_reaper_pid = KERNEL_PID_UNDEF;
@@ -83,6 +91,10 @@ static char pthread_reaper_stack[PTHREAD_REAPER_STACKSIZE];
 static void *pthread_start_routine(void *pt_)
 {
     pthread_thread_t *pt = pt_;
+#ifdef MODULE_PTHREAD_TLS_STATIC
+    /* set here, thread_create() might not have returned the pid yet */
+    pthread_by_pid[sched_active_pid] = pt;
+#endif
     void *retval = pt->start_routine(pt->arg);
     pthread_exit(retval);
 }
@@ -168,7 +180,6 @@ int pthread_create(pthread_t *newthread, const pthread_attr_t *attr, void *(*sta
         pthread_sched_threads[pthread_pid-1] = NULL;
         return -1;
     }
-
     sched_switch(THREAD_PRIORITY_MAIN);
 
     return 0;
@@ -196,6 +207,9 @@ void pthread_exit(void *retval)
         if (__pthread_keys_exit) {
             __pthread_keys_exit(self_id);
         }
+#ifdef MODULE_PTHREAD_TLS_STATIC
+        pthread_by_pid[sched_active_pid] = NULL;
+#endif
 
         self->thread_pid = KERNEL_PID_UNDEF;
         DEBUG("pthread_exit(%p), self == %p\n", retval, (void *) self);
@@ -367,8 +381,16 @@ void __pthread_cleanup_pop(__pthread_cleanup_datum_t *datum, int execute)
     }
 }
 
+#ifdef MODULE_PTHREAD_TLS_STATIC
+void **__pthread_get_tls_slots(kernel_pid_t pid)
+{
+    pthread_thread_t *pt = pthread_by_pid[pid];
+    return pt ? pt->tls : NULL;
+}
+#else
 struct __pthread_tls_datum **__pthread_get_tls_head(int self_id)
 {
     pthread_thread_t *self = pthread_sched_threads[self_id-1];
     return self ? &self->tls_head : NULL;
 }
+#endif
@@ -16,6 +16,8 @@
  * @}
  */
 
+#ifndef MODULE_PTHREAD_TLS_STATIC
+
 #include "pthread.h"
 
 #ifdef HAVE_MALLOC_H
@@ -198,3 +200,5 @@ void __pthread_keys_exit(int self_id)
     }
     mutex_unlock(&tls_mutex);
 }
+
+#endif /* MODULE_PTHREAD_TLS_STATIC */
@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup pthread
+ * @{
+ * @file
+ * @brief       RIOT POSIX thread local storage without dynamic allocation
+ *
+ * Alternative to pthread_tls.c, enabled with the `pthread_tls_static` module.
+ * Keys are taken from a static array of PTHREAD_KEYS_MAX entries and every
+ * pthread has one value slot per key, so pthread_getspecific() and
+ * pthread_setspecific() are a simple array access.
+ * @}
+ */
+
+#ifdef MODULE_PTHREAD_TLS_STATIC
+
+#include "pthread.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+struct __pthread_tls_key {
+    void (*destructor)(void *);
+    bool used;
+};
+
+static struct __pthread_tls_key tls_keys[PTHREAD_KEYS_MAX];
+
+/**
+ * @brief   Used while creating or deleting keys.
+ */
+static mutex_t tls_mutex;
+
+static inline bool is_valid(pthread_key_t key)
+{
+    return (key >= tls_keys) && (key < &tls_keys[PTHREAD_KEYS_MAX]) &&
+           key->used;
+}
+
+int pthread_key_create(pthread_key_t *key, void (*destructor)(void *))
+{
+    int res = EAGAIN;
+
+    mutex_lock(&tls_mutex);
+    for (unsigned i = 0; i < PTHREAD_KEYS_MAX; i++) {
+        if (!tls_keys[i].used) {
+            tls_keys[i].destructor = destructor;
+            tls_keys[i].used = true;
+            *key = &tls_keys[i];
+            res = 0;
+            break;
+        }
+    }
+    mutex_unlock(&tls_mutex);
+
+    return res;
+}
+
+int pthread_key_delete(pthread_key_t key)
+{
+    if (!is_valid(key)) {
+        return EINVAL;
+    }
+
+    unsigned idx = key - tls_keys;
+
+    mutex_lock(&tls_mutex);
+    /* clear the values, so a key reusing the slot starts with NULL */
+    for (kernel_pid_t pid = KERNEL_PID_FIRST; pid <= KERNEL_PID_LAST; pid++) {
+        void **tls = __pthread_get_tls_slots(pid);
+        if (tls) {
+            tls[idx] = NULL;
+        }
+    }
+    key->used = false;
+    mutex_unlock(&tls_mutex);
+
+    return 0;
+}
+
+void *pthread_getspecific(pthread_key_t key)
+{
+    void **tls = __pthread_get_tls_slots(sched_active_pid);
+
+    if (!tls || !is_valid(key)) {
+        return NULL;
+    }
+
+    return tls[key - tls_keys];
+}
+
+int pthread_setspecific(pthread_key_t key, const void *value)
+{
+    void **tls = __pthread_get_tls_slots(sched_active_pid);
+
+    if (!is_valid(key)) {
+        return EINVAL;
+    }
+    if (!tls) {
+        DEBUG("ERROR called pthread_setspecific() from a non-pthread!\n");
+        return ENOMEM;
+    }
+
+    tls[key - tls_keys] = (void *) value;
+    return 0;
+}
+
+void __pthread_keys_exit(int self_id)
+{
+    (void) self_id;
+    void **tls = __pthread_get_tls_slots(sched_active_pid);
+
+    if (!tls) {
+        return;
+    }
+
+    /* destructors may set values again, so repeat as long as there are values
+     * with destructors left, at most PTHREAD_DESTRUCTOR_ITERATIONS times */
+    for (unsigned round = 0; round < PTHREAD_DESTRUCTOR_ITERATIONS; round++) {
+        bool called = false;
+
+        for (unsigned i = 0; i < PTHREAD_KEYS_MAX; i++) {
+            void *value = tls[i];
+            void (*destructor)(void *) = tls_keys[i].destructor;
+
+            if (value && tls_keys[i].used && destructor) {
+                tls[i] = NULL;
+                destructor(value);
+                called = true;
+            }
+        }
+
+        if (!called) {
+            break;
+        }
+    }
+}
+
+#endif /* MODULE_PTHREAD_TLS_STATIC */
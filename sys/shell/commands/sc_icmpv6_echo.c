@@ -15,12 +15,16 @@
  * @author      Martine Lenders <mlenders@inf.fu-berlin.de>
  */
 
+#include <errno.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <inttypes.h>
 
 #ifdef MODULE_GNRC_ICMPV6
 
+#include "bitarithm.h"
 #include "byteorder.h"
 #include "net/gnrc/icmpv6.h"
 #include "net/ipv6/addr.h"
@@ -31,15 +35,65 @@
 #include "utlist.h"
 #include "xtimer.h"
 
+/**
+ * @brief   Maximum number of outstanding echo requests
+ */
+#ifndef SC_PING6_WINDOW_SIZE
+#define SC_PING6_WINDOW_SIZE    (16U)
+#endif
+
+/**
+ * @brief   Number of bits below the most significant one used to bin round
+ *          trip times for the percentiles
+ *
+ * Each power of two is split into `1 << SC_PING6_HIST_SUB_BITS` bins, so
+ * percentiles are accurate to `1 / (1 << SC_PING6_HIST_SUB_BITS)`.
+ */
+#ifndef SC_PING6_HIST_SUB_BITS
+#define SC_PING6_HIST_SUB_BITS  (2U)
+#endif
+
+#define _TIMEOUT        (1U * US_PER_SEC)
+#define _HIST_NUMOF     ((32U - SC_PING6_HIST_SUB_BITS + 1) << SC_PING6_HIST_SUB_BITS)
+
+enum {
+    _REQ_FREE = 0,      /**< never sent or timed out */
+    _REQ_PENDING,       /**< waiting for the reply */
+    _REQ_RECEIVED,      /**< reply received, kept to detect duplicates */
+};
+
+typedef struct {
+    uint32_t sent;      /**< transmission time stamp in us */
+    uint16_t seq;       /**< sequence number */
+    uint8_t state;      /**< state of the request */
+} _req_t;
+
+typedef struct {
+    uint64_t sum_rtt;
+    uint32_t min_rtt;
+    uint32_t max_rtt;
+    uint32_t last_rtt;
+    uint32_t jitter;    /**< RFC 3550, section 6.4.1 estimator, times 16 */
+    unsigned sent;
+    unsigned received;
+    unsigned dups;
+    unsigned reordered;
+    unsigned lost;
+    uint16_t max_seq;   /**< highest sequence number received */
+    uint32_t hist[_HIST_NUMOF];
+} _stats_t;
+
 static uint16_t id = 0x53;
-static uint16_t min_seq_expected = 0;
-static uint16_t max_seq_expected = 0;
 static char ipv6_str[IPV6_ADDR_MAX_STR_LEN];
+static _req_t _reqs[SC_PING6_WINDOW_SIZE];
+static _stats_t _stats;
 
 static void usage(char **argv)
 {
-    printf("%s [<count>] <ipv6 addr>[%%<interface>] [<payload_len>] [<delay in ms>] [<stats interval>]\n", argv[0]);
+    printf("%s [-f] [-w <window>] [<count>] <ipv6 addr>[%%<interface>] [<payload_len>] [<delay in ms>] [<stats interval>]\n", argv[0]);
     puts("defaults:");
+    puts("    -f = flood: send without delay, print statistics only");
+    printf("    window = %u outstanding requests\n", SC_PING6_WINDOW_SIZE);
     puts("    count = 3");
     puts("    interface = first interface if only one present, only needed for link-local addresses");
     puts("    payload_len = 4");
@@ -68,126 +122,269 @@ void _set_payload(icmpv6_echo_t *hdr, size_t payload_len)
     }
 }
 
-static inline bool _expected_seq(uint16_t seq)
+static unsigned _hist_idx(uint32_t rtt)
 {
-    /* take integer overflows in account */
-    if (min_seq_expected > max_seq_expected) {
-        return (seq >= min_seq_expected) || (seq <= max_seq_expected);
+    unsigned msb;
+
+    if (rtt < (1U << SC_PING6_HIST_SUB_BITS)) {
+        return rtt;
     }
-    else {
-        return (seq >= min_seq_expected) && (seq <= max_seq_expected);
+    /* bitarithm_msb() takes an unsigned, which may be only 16 bit wide */
+    msb = (rtt > 0xffff) ? (bitarithm_msb(rtt >> 16) + 16) : bitarithm_msb(rtt);
+    return ((msb - SC_PING6_HIST_SUB_BITS + 1) << SC_PING6_HIST_SUB_BITS) |
+           ((rtt >> (msb - SC_PING6_HIST_SUB_BITS)) &
+            ((1U << SC_PING6_HIST_SUB_BITS) - 1));
+}
+
+/* largest round trip time in bin idx */
+static uint32_t _hist_max(unsigned idx)
+{
+    unsigned msb, shift;
+
+    if (idx < (1U << SC_PING6_HIST_SUB_BITS)) {
+        return idx;
     }
+    msb = (idx >> SC_PING6_HIST_SUB_BITS) + SC_PING6_HIST_SUB_BITS - 1;
+    shift = msb - SC_PING6_HIST_SUB_BITS;
+    return ((1UL << msb) |
+            ((uint32_t)(idx & ((1U << SC_PING6_HIST_SUB_BITS) - 1)) << shift)) +
+           ((1UL << shift) - 1);
 }
 
-int _handle_reply(gnrc_pktsnip_t *pkt, uint32_t time)
+static uint32_t _percentile(unsigned p)
+{
+    uint32_t target = ((_stats.received * p) + 99) / 100;
+    uint32_t sum = 0;
+
+    for (unsigned i = 0; i < _HIST_NUMOF; i++) {
+        sum += _stats.hist[i];
+        if (sum >= target) {
+            uint32_t res = _hist_max(i);
+            return (res > _stats.max_rtt) ? _stats.max_rtt : res;
+        }
+    }
+    return _stats.max_rtt;
+}
+
+static void _add_rtt(uint32_t rtt)
+{
+    if (_stats.received > 0) {
+        uint32_t d = (rtt > _stats.last_rtt) ? (rtt - _stats.last_rtt) :
+                                               (_stats.last_rtt - rtt);
+        _stats.jitter += d - ((_stats.jitter + 8) >> 4);
+    }
+    _stats.last_rtt = rtt;
+    if (rtt > _stats.max_rtt) {
+        _stats.max_rtt = rtt;
+    }
+    if (rtt < _stats.min_rtt) {
+        _stats.min_rtt = rtt;
+    }
+    _stats.sum_rtt += rtt;
+    _stats.hist[_hist_idx(rtt)]++;
+    _stats.received++;
+}
+
+static void _handle_reply(gnrc_pktsnip_t *pkt, uint32_t now, bool quiet)
 {
     gnrc_pktsnip_t *ipv6, *icmpv6;
     ipv6_hdr_t *ipv6_hdr;
     icmpv6_echo_t *icmpv6_hdr;
+    _req_t *req;
+    uint32_t rtt;
     uint16_t seq;
 
     ipv6 = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_IPV6);
     icmpv6 = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_ICMPV6);
 
-    if ((ipv6 == NULL) || (icmpv6 == NULL)) {
+    if ((ipv6 == NULL) || (icmpv6 == NULL) ||
+        (icmpv6->size < sizeof(icmpv6_echo_t))) {
         puts("error: IPv6 header or ICMPv6 header not found in reply");
-        return 0;
+        return;
     }
 
     ipv6_hdr = ipv6->data;
     icmpv6_hdr = icmpv6->data;
     seq = byteorder_ntohs(icmpv6_hdr->seq);
+    req = &_reqs[seq % SC_PING6_WINDOW_SIZE];
 
-    if ((byteorder_ntohs(icmpv6_hdr->id) == id) && _expected_seq(seq)) {
-        if (seq <= min_seq_expected) {
-            min_seq_expected++;
+    if ((byteorder_ntohs(icmpv6_hdr->id) != id) || (req->seq != seq) ||
+        (req->state == _REQ_FREE)) {
+        /* reply to another ping or after the request timed out */
+        return;
+    }
+    if (req->state == _REQ_RECEIVED) {
+        _stats.dups++;
+        if (!quiet) {
+            printf("%u bytes from %s: id=%" PRIu16 " seq=%" PRIu16 " (DUP!)\n",
+                   (unsigned)icmpv6->size,
+                   ipv6_addr_to_str(ipv6_str, &ipv6_hdr->src, sizeof(ipv6_str)),
+                   id, seq);
         }
-
+        return;
+    }
+    rtt = now - req->sent;
+    req->state = _REQ_RECEIVED;
+    if ((_stats.received > 0) && ((int16_t)(seq - _stats.max_seq) < 0)) {
+        _stats.reordered++;
+    }
+    else {
+        _stats.max_seq = seq;
+    }
+    _add_rtt(rtt);
+    if (!quiet) {
         printf("%u bytes from %s: id=%" PRIu16 " seq=%" PRIu16 " hop limit=%u time = %"
                PRIu32 ".%03" PRIu32 " ms\n", (unsigned) icmpv6->size,
                ipv6_addr_to_str(ipv6_str, &(ipv6_hdr->src), sizeof(ipv6_str)),
-               byteorder_ntohs(icmpv6_hdr->id), seq, (unsigned)ipv6_hdr->hl,
-               time / US_PER_MS, time % US_PER_MS);
+               id, seq, (unsigned)ipv6_hdr->hl, rtt / US_PER_MS, rtt % US_PER_MS);
+    }
 #ifdef MODULE_GNRC_IPV6_NC
-        gnrc_ipv6_nc_still_reachable(&ipv6_hdr->src);
+    gnrc_ipv6_nc_still_reachable(&ipv6_hdr->src);
 #endif
-    }
-    else {
-        puts("error: unexpected parameters");
-        return 0;
-    }
+}
 
-    return 1;
+static inline void _print_ms(const char *sep, uint32_t usec)
+{
+    printf("%" PRIu32 ".%03" PRIu32 "%s", usec / US_PER_MS, usec % US_PER_MS, sep);
 }
 
-static void _print_stats(char *addr_str, int success, int count, uint64_t total_time,
-                         uint64_t sum_rtt, uint32_t min_rtt, uint32_t max_rtt)
+static void _print_stats(char *addr_str, uint64_t total_time)
 {
     printf("--- %s ping statistics ---\n", addr_str);
+    printf("%u packets transmitted, %u received, %u duplicates, %u reordered, "
+           "%u%% packet loss, time %" PRIu32 ".%06" PRIu32 " s\n",
+           _stats.sent, _stats.received, _stats.dups, _stats.reordered,
+           (_stats.sent > 0) ? ((_stats.lost * 100) / _stats.sent) : 0,
+           (uint32_t)(total_time / US_PER_SEC), (uint32_t)(total_time % US_PER_SEC));
+    if (_stats.received > 0) {
+        printf("rtt min/avg/max/jitter = ");
+        _print_ms("/", _stats.min_rtt);
+        _print_ms("/", (uint32_t)(_stats.sum_rtt / _stats.received));
+        _print_ms("/", _stats.max_rtt);
+        _print_ms(" ms\n", _stats.jitter >> 4);
+        printf("rtt p50/p90/p99 = ");
+        _print_ms("/", _percentile(50));
+        _print_ms("/", _percentile(90));
+        _print_ms(" ms\n", _percentile(99));
+    }
+}
+
+static int _send_req(ipv6_addr_t *addr, kernel_pid_t src_iface,
+                     uint16_t seq, size_t payload_len)
+{
+    gnrc_pktsnip_t *pkt, *tmp;
 
-    if (success > 0) {
-        uint32_t avg_rtt = (uint32_t)(sum_rtt / count); /* get average */
-        printf("%d packets transmitted, %d received, %d%% packet loss, time %"
-               PRIu32 ".06%" PRIu32 " s\n", count, success,
-               (100 - ((success * 100) / count)),
-               (uint32_t)total_time / US_PER_SEC, (uint32_t)total_time % US_PER_SEC);
-        printf("rtt min/avg/max = "
-               "%" PRIu32 ".%03" PRIu32 "/"
-               "%" PRIu32 ".%03" PRIu32 "/"
-               "%" PRIu32 ".%03" PRIu32 " ms\n",
-               min_rtt / US_PER_MS, min_rtt % US_PER_MS,
-               avg_rtt / US_PER_MS, avg_rtt % US_PER_MS,
-               max_rtt / US_PER_MS, max_rtt % US_PER_MS);
+    pkt = gnrc_icmpv6_echo_build(ICMPV6_ECHO_REQ, id, seq, NULL, payload_len);
+    if (pkt == NULL) {
+        return -ENOBUFS;
     }
-    else {
-        printf("%d packets transmitted, 0 received, 100%% packet loss\n", count);
+    _set_payload(pkt->data, payload_len);
+    if ((tmp = gnrc_ipv6_hdr_build(pkt, NULL, addr)) == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return -ENOBUFS;
+    }
+    pkt = tmp;
+    if (src_iface != KERNEL_PID_UNDEF) {
+        if ((tmp = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_netif_hdr_t),
+                                   GNRC_NETTYPE_NETIF)) == NULL) {
+            gnrc_pktbuf_release(pkt);
+            return -ENOBUFS;
+        }
+        pkt = tmp;
+        gnrc_netif_hdr_init(((gnrc_netif_hdr_t *)pkt->data), 0, 0);
+        ((gnrc_netif_hdr_t *)pkt->data)->if_pid = src_iface;
+    }
+    if (!gnrc_netapi_dispatch_send(GNRC_NETTYPE_IPV6, GNRC_NETREG_DEMUX_CTX_ALL, pkt)) {
+        gnrc_pktbuf_release(pkt);
+        return -ENOTCONN;
     }
+    return 0;
+}
+
+/* returns the time until the oldest outstanding request times out */
+static uint32_t _expire_reqs(uint32_t now, unsigned *outstanding, bool quiet)
+{
+    uint32_t next = _TIMEOUT;
+
+    for (unsigned i = 0; i < SC_PING6_WINDOW_SIZE; i++) {
+        _req_t *req = &_reqs[i];
+
+        if (req->state != _REQ_PENDING) {
+            continue;
+        }
+        if ((now - req->sent) >= _TIMEOUT) {
+            req->state = _REQ_FREE;
+            (*outstanding)--;
+            _stats.lost++;
+            if (!quiet) {
+                printf("ping timeout (seq=%" PRIu16 ")\n", req->seq);
+            }
+        }
+        else if ((_TIMEOUT - (now - req->sent)) < next) {
+            next = _TIMEOUT - (now - req->sent);
+        }
+    }
+    return next;
 }
 
 int _icmpv6_ping(int argc, char **argv)
 {
-    int count = 3, success = 0, remaining, stat_interval = 0, stat_counter = 0;
+    int count = 3, stat_interval = 0, arg = 1;
+    unsigned window = SC_PING6_WINDOW_SIZE, outstanding = 0;
+    unsigned done, stats_printed = 0;
     size_t payload_len = 4;
-    uint32_t delay = 1 * MS_PER_SEC;
+    uint32_t delay = 1 * MS_PER_SEC, next_send;
     char *addr_str;
     ipv6_addr_t addr;
     kernel_pid_t src_iface;
     msg_t msg;
     gnrc_netreg_entry_t my_entry = GNRC_NETREG_ENTRY_INIT_PID(ICMPV6_ECHO_REP,
                                                               sched_active_pid);
-    uint32_t min_rtt = UINT32_MAX, max_rtt = 0;
-    uint64_t sum_rtt = 0;
     uint64_t ping_start;
-    int param_offset = 0;
+    uint16_t seq = 0;
+    bool flood = false;
 
-    if (argc < 2) {
+    while ((arg < argc) && (argv[arg][0] == '-')) {
+        if (strcmp(argv[arg], "-f") == 0) {
+            flood = true;
+        }
+        else if ((strcmp(argv[arg], "-w") == 0) && ((arg + 1) < argc)) {
+            window = atoi(argv[++arg]);
+        }
+        else {
+            usage(argv);
+            return 1;
+        }
+        arg++;
+    }
+    if ((argc - arg) < 1) {
         usage(argv);
         return 1;
     }
-    else if ((argc > 2) &&  ((count = atoi(argv[1])) > 0)) {
-        param_offset = 1;
+    else if (((argc - arg) > 1) && ((count = atoi(argv[arg])) > 0)) {
+        arg++;
     }
     else {
         count = 3;
     }
 
-    stat_interval = count;
-
-    addr_str = argv[1 + param_offset];
-    if (argc > (2 + param_offset)) {
-        payload_len = atoi(argv[2 + param_offset]);
-    }
-    if (argc > (3 + param_offset)) {
-        delay = atoi(argv[3 + param_offset]);
+    addr_str = argv[arg++];
+    if (arg < argc) {
+        payload_len = atoi(argv[arg++]);
     }
-    if (argc > (4 + param_offset)) {
-        stat_interval = atoi(argv[4 + param_offset]);
+    if (arg < argc) {
+        delay = atoi(argv[arg++]);
     }
+    stat_interval = (arg < argc) ? atoi(argv[arg]) : count;
 
-    if ((int)payload_len < 0) {
+    if (((int)payload_len < 0) || (window == 0) ||
+        (window > SC_PING6_WINDOW_SIZE)) {
         usage(argv);
         return 1;
     }
+    if (flood) {
+        delay = 0;
+    }
 
     src_iface = ipv6_addr_split_iface(addr_str);
     if (src_iface == -1) {
@@ -231,105 +428,64 @@ int _icmpv6_ping(int argc, char **argv)
         return 1;
     }
 
-    remaining = count;
+    memset(_reqs, 0, sizeof(_reqs));
+    memset(&_stats, 0, sizeof(_stats));
+    _stats.min_rtt = UINT32_MAX;
 
     ping_start = xtimer_now_usec64();
-
-    while ((remaining--) > 0) {
-        gnrc_pktsnip_t *pkt;
-        uint32_t start, timeout = 1 * US_PER_SEC;
-
-        pkt = gnrc_icmpv6_echo_build(ICMPV6_ECHO_REQ, id, ++max_seq_expected,
-                                     NULL, payload_len);
-
-        if (pkt == NULL) {
-            puts("error: packet buffer full");
-            continue;
-        }
-
-        _set_payload(pkt->data, payload_len);
-
-        pkt = gnrc_ipv6_hdr_build(pkt, NULL, &addr);
-
-        if (pkt == NULL) {
-            puts("error: packet buffer full");
-            continue;
-        }
-
-        if (src_iface != KERNEL_PID_UNDEF) {
-            pkt = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_netif_hdr_t),
-                                  GNRC_NETTYPE_NETIF);
-
-            if (pkt == NULL) {
-                puts("error: packet buffer full");
+    next_send = (uint32_t)ping_start;
+
+    while ((_stats.sent < (unsigned)count) || (outstanding > 0)) {
+        uint32_t now = xtimer_now_usec();
+        uint32_t timeout = _expire_reqs(now, &outstanding, flood);
+        _req_t *req = &_reqs[(uint16_t)(seq + 1) % SC_PING6_WINDOW_SIZE];
+        bool can_send = (_stats.sent < (unsigned)count) && (outstanding < window) &&
+                        (req->state != _REQ_PENDING);
+
+        if (can_send && ((int32_t)(now - next_send) >= 0)) {
+            int res = _send_req(&addr, src_iface, seq + 1, payload_len);
+
+            if (res == 0) {
+                req->seq = ++seq;
+                req->sent = now;
+                req->state = _REQ_PENDING;
+                outstanding++;
+                _stats.sent++;
+                next_send = now + (delay * US_PER_MS);
                 continue;
             }
-
-            gnrc_netif_hdr_init(((gnrc_netif_hdr_t *)pkt->data), 0, 0);
-            ((gnrc_netif_hdr_t *)pkt->data)->if_pid = src_iface;
-        }
-
-        start = xtimer_now_usec();
-        if (!gnrc_netapi_dispatch_send(GNRC_NETTYPE_IPV6, GNRC_NETREG_DEMUX_CTX_ALL, pkt)) {
-            puts("error: unable to send ICMPv6 echo request\n");
-            gnrc_pktbuf_release(pkt);
-            continue;
-        }
-
-        /* TODO: replace when #4219 was fixed */
-        if (xtimer_msg_receive_timeout64(&msg, (uint64_t)timeout) >= 0) {
-            uint32_t stop;
-            switch (msg.type) {
-                case GNRC_NETAPI_MSG_TYPE_RCV:
-                    stop = xtimer_now_usec() - start;
-
-                    gnrc_pktsnip_t *pkt = msg.content.ptr;
-                    success += _handle_reply(pkt, stop);
-                    gnrc_pktbuf_release(pkt);
-
-                    if (stop > max_rtt) {
-                        max_rtt = stop;
-                    }
-
-                    if (stop < min_rtt) {
-                        min_rtt = stop;
-                    }
-
-                    sum_rtt += stop;
-
-                    break;
-
-                default:
-                    /* requeue wrong packets */
-                    msg_send(&msg, thread_getpid());
-                    break;
+            if ((res != -ENOBUFS) || (outstanding == 0)) {
+                puts((res == -ENOBUFS) ? "error: packet buffer full" :
+                                         "error: unable to send ICMPv6 echo request");
+                break;
             }
+            /* retry once a reply freed some space in the packet buffer */
+            can_send = false;
         }
-        else {
-            puts("ping timeout");
+        if (can_send && ((next_send - now) < timeout)) {
+            timeout = next_send - now;
         }
-
-        while (msg_try_receive(&msg) > 0) {
+        if (xtimer_msg_receive_timeout(&msg, timeout) >= 0) {
             if (msg.type == GNRC_NETAPI_MSG_TYPE_RCV) {
-                printf("dropping additional response packet (probably caused by duplicates)\n");
-                gnrc_pktsnip_t *pkt = msg.content.ptr;
-                gnrc_pktbuf_release(pkt);
-            }
-        }
+                unsigned received = _stats.received;
 
-        if (remaining > 0) {
-            xtimer_usleep64(delay * US_PER_MS);
+                _handle_reply(msg.content.ptr, xtimer_now_usec(), flood);
+                gnrc_pktbuf_release(msg.content.ptr);
+                if (_stats.received > received) {
+                    outstanding--;
+                }
+            }
         }
-        if ((++stat_counter == stat_interval) || (remaining == 0)) {
-            uint64_t total_time = xtimer_now_usec64() - ping_start;
-            _print_stats(addr_str, success, (count - remaining), total_time, sum_rtt, min_rtt,
-                         max_rtt);
-            stat_counter = 0;
+        /* print statistics every stat_interval answered or lost requests */
+        done = _stats.received + _stats.lost;
+        if ((stat_interval > 0) && ((done - stats_printed) >= (unsigned)stat_interval) &&
+            (done < (unsigned)count)) {
+            _print_stats(addr_str, xtimer_now_usec64() - ping_start);
+            stats_printed = done;
         }
-
     }
+    _print_stats(addr_str, xtimer_now_usec64() - ping_start);
 
-    max_seq_expected = 0;
     id++;
 
     gnrc_netreg_unregister(GNRC_NETTYPE_ICMPV6, &my_entry);
@@ -341,7 +497,7 @@ int _icmpv6_ping(int argc, char **argv)
         }
     }
 
-    return success ? 0 : 1;
+    return (_stats.received > 0) ? 0 : 1;
 }
 
 #endif
@@ -21,12 +21,67 @@
 #define ENABLE_DEBUG        (0)
 #include "debug.h"
 
+static void _mgr_set_timer(trickle_mgr_t *mgr)
+{
+    if (mgr->queue) {
+        uint64_t now = xtimer_now_usec64();
+        uint64_t deadline = mgr->queue->deadline;
+
+        xtimer_set_msg64(&mgr->timer, (deadline > now) ? (deadline - now) : 0,
+                         &mgr->msg, mgr->pid);
+    }
+    else {
+        xtimer_remove(&mgr->timer);
+    }
+}
+
+static void _mgr_remove(trickle_mgr_t *mgr, trickle_t *trickle)
+{
+    trickle_t **list = &mgr->queue;
+
+    while (*list) {
+        if (*list == trickle) {
+            *list = trickle->next;
+            trickle->next = NULL;
+            break;
+        }
+        list = &(*list)->next;
+    }
+}
+
+static void _mgr_schedule(trickle_mgr_t *mgr, trickle_t *trickle)
+{
+    /* when called for the timer that is handled right now, continue from its
+     * scheduled time, so firing early within the slack does not drift */
+    uint64_t base = (mgr->firing == trickle) ? trickle->deadline
+                                             : xtimer_now_usec64();
+    trickle_t **list = &mgr->queue;
+
+    _mgr_remove(mgr, trickle);
+    trickle->deadline = base + trickle->msg_time;
+
+    while (*list && ((*list)->deadline <= trickle->deadline)) {
+        list = &(*list)->next;
+    }
+    trickle->next = *list;
+    *list = trickle;
+
+    /* trickle_mgr_handle() sets the timer when done */
+    if (!mgr->firing && (mgr->queue == trickle)) {
+        _mgr_set_timer(mgr);
+    }
+}
+
 void trickle_callback(trickle_t *trickle)
 {
     /* Handle k=0 like k=infinity (according to RFC6206, section 6.5) */
     if ((trickle->c < trickle->k) || (trickle->k == 0)) {
+        trickle->tx_count++;
         (*trickle->callback.func)(trickle->callback.args);
     }
+    else {
+        trickle->suppress_count++;
+    }
 
     trickle_interval(trickle);
 }
@@ -52,8 +107,13 @@ void trickle_interval(trickle_t *trickle)
     trickle->t = random_uint32_range(old_interval, trickle->I);
 
     trickle->msg_time = (trickle->t + diff) * MS_PER_SEC;
-    xtimer_set_msg64(&trickle->msg_timer, trickle->msg_time, &trickle->msg,
-                     trickle->pid);
+    if (trickle->mgr) {
+        _mgr_schedule(trickle->mgr, trickle);
+    }
+    else {
+        xtimer_set_msg64(&trickle->msg_timer, trickle->msg_time, &trickle->msg,
+                         trickle->pid);
+    }
 }
 
 void trickle_reset_timer(trickle_t *trickle)
@@ -65,20 +125,26 @@ void trickle_reset_timer(trickle_t *trickle)
     trickle_interval(trickle);
 }
 
-void trickle_start(kernel_pid_t pid, trickle_t *trickle, uint16_t msg_type,
-                   uint32_t Imin, uint8_t Imax, uint8_t k)
+static void _init(trickle_t *trickle, uint32_t Imin, uint8_t Imax, uint8_t k)
 {
     assert(Imin > 0);
     assert((Imin << Imax) < (UINT32_MAX / 2));
 
-    trickle->pid = pid;
-
     trickle->c = 0;
     trickle->k = k;
     trickle->Imin = Imin;
     trickle->Imax = Imax;
     trickle->I = trickle->t = random_uint32_range(trickle->Imin,
                                                   4 * trickle->Imin);
+    trickle->tx_count = 0;
+    trickle->suppress_count = 0;
+}
+
+void trickle_start(kernel_pid_t pid, trickle_t *trickle, uint16_t msg_type,
+                   uint32_t Imin, uint8_t Imax, uint8_t k)
+{
+    _init(trickle, Imin, Imax, k);
+    trickle->mgr = NULL;
     trickle->pid = pid;
     trickle->msg.content.ptr = trickle;
     trickle->msg.type = msg_type;
@@ -88,10 +154,64 @@ void trickle_start(kernel_pid_t pid, trickle_t *trickle, uint16_t msg_type,
 
 void trickle_stop(trickle_t *trickle)
 {
-    xtimer_remove(&trickle->msg_timer);
+    if (trickle->mgr) {
+        trickle_mgr_t *mgr = trickle->mgr;
+        bool was_head = (mgr->queue == trickle);
+
+        _mgr_remove(mgr, trickle);
+        if (was_head && !mgr->firing) {
+            _mgr_set_timer(mgr);
+        }
+    }
+    else {
+        xtimer_remove(&trickle->msg_timer);
+    }
 }
 
 void trickle_increment_counter(trickle_t *trickle)
 {
     trickle->c++;
 }
+
+void trickle_mgr_init(trickle_mgr_t *mgr, kernel_pid_t pid, uint16_t msg_type,
+                      uint32_t slack)
+{
+    mgr->queue = NULL;
+    mgr->firing = NULL;
+    mgr->slack = slack;
+    mgr->wakeups = 0;
+    mgr->pid = pid;
+    mgr->msg.content.ptr = mgr;
+    mgr->msg.type = msg_type;
+}
+
+void trickle_mgr_start(trickle_mgr_t *mgr, trickle_t *trickle, uint32_t Imin,
+                       uint8_t Imax, uint8_t k)
+{
+    _init(trickle, Imin, Imax, k);
+    trickle->mgr = mgr;
+    trickle->pid = mgr->pid;
+    trickle->next = NULL;
+
+    trickle_interval(trickle);
+}
+
+void trickle_mgr_handle(trickle_mgr_t *mgr)
+{
+    uint64_t limit = xtimer_now_usec64() + ((uint64_t)mgr->slack * US_PER_MS);
+
+    mgr->wakeups++;
+    while (mgr->queue && (mgr->queue->deadline <= limit)) {
+        trickle_t *trickle = mgr->queue;
+
+        DEBUG("trickle: handling %p of manager %p\n", (void *)trickle,
+              (void *)mgr);
+        mgr->queue = trickle->next;
+        trickle->next = NULL;
+        mgr->firing = trickle;
+        trickle_callback(trickle);
+    }
+    mgr->firing = NULL;
+
+    _mgr_set_timer(mgr);
+}
@@ -17,6 +17,8 @@
  * @}
  */
 
+#include <string.h>
+
 #include "tsrb.h"
 
 static void _push(tsrb_t *rb, char c)
@@ -41,12 +43,42 @@ int tsrb_get_one(tsrb_t *rb)
 
 int tsrb_get(tsrb_t *rb, char *dst, size_t n)
 {
-    size_t tmp = n;
-    while (tmp && !tsrb_empty(rb)) {
-        *dst++ = _pop(rb);
-        tmp--;
+    size_t avail = tsrb_avail(rb);
+    size_t done = 0;
+
+    if (n > avail) {
+        n = avail;
     }
-    return (n - tmp);
+
+    /* at most two segments: up to the end of the buffer, then from its start */
+    while (done < n) {
+        char *src;
+        size_t len = tsrb_read_contiguous(rb, &src);
+
+        if (len > (n - done)) {
+            len = n - done;
+        }
+        memcpy(dst + done, src, len);
+        tsrb_read_commit(rb, len);
+        done += len;
+    }
+
+    return n;
+}
+
+unsigned tsrb_read_contiguous(const tsrb_t *rb, char **ptr)
+{
+    unsigned pos = rb->reads & (rb->size - 1);
+    unsigned avail = tsrb_avail(rb);
+
+    *ptr = &rb->buf[pos];
+    return (avail < (rb->size - pos)) ? avail : (rb->size - pos);
+}
+
+void tsrb_read_commit(tsrb_t *rb, unsigned n)
+{
+    assert(n <= tsrb_avail(rb));
+    rb->reads += n;
 }
 
 int tsrb_add_one(tsrb_t *rb, char c)
@@ -62,10 +94,40 @@ int tsrb_add_one(tsrb_t *rb, char c)
 
 int tsrb_add(tsrb_t *rb, const char *src, size_t n)
 {
-    size_t tmp = n;
-    while (tmp && !tsrb_full(rb)) {
-        _push(rb, *src++);
-        tmp--;
+    size_t space = tsrb_free(rb);
+    size_t done = 0;
+
+    if (n > space) {
+        n = space;
+    }
+
+    /* at most two segments: up to the end of the buffer, then from its start */
+    while (done < n) {
+        char *dst;
+        size_t len = tsrb_write_contiguous(rb, &dst);
+
+        if (len > (n - done)) {
+            len = n - done;
+        }
+        memcpy(dst, src + done, len);
+        tsrb_write_commit(rb, len);
+        done += len;
     }
-    return (n - tmp);
+
+    return n;
+}
+
+unsigned tsrb_write_contiguous(const tsrb_t *rb, char **ptr)
+{
+    unsigned pos = rb->writes & (rb->size - 1);
+    unsigned space = tsrb_free(rb);
+
+    *ptr = &rb->buf[pos];
+    return (space < (rb->size - pos)) ? space : (rb->size - pos);
+}
+
+void tsrb_write_commit(tsrb_t *rb, unsigned n)
+{
+    assert(n <= tsrb_free(rb));
+    rb->writes += n;
 }
@@ -37,6 +37,13 @@
 #include "periph/uart.h"
 #include "isrpipe.h"
 
+#ifdef MODULE_UART_STDIO_TX_BUF
+#include "irq.h"
+#include "mutex.h"
+#include "thread.h"
+#include "tsrb.h"
+#endif
+
 #ifdef USE_ETHOS_FOR_STDIO
 #include "ethos.h"
 extern ethos_t ethos;
@@ -52,6 +59,17 @@ extern ethos_t ethos;
 static char _rx_buf_mem[UART_STDIO_RX_BUFSIZE];
 isrpipe_t uart_stdio_isrpipe = ISRPIPE_INIT(_rx_buf_mem);
 
+#ifdef MODULE_UART_STDIO_TX_BUF
+static char _tx_buf_mem[UART_STDIO_TX_BUFSIZE];
+static tsrb_t _tx_rb = TSRB_INIT(_tx_buf_mem);
+static mutex_t _tx_wake = MUTEX_INIT_LOCKED;
+static mutex_t _tx_space = MUTEX_INIT_LOCKED;
+static unsigned _tx_dropped;
+static kernel_pid_t _tx_pid = KERNEL_PID_UNDEF;
+static char _tx_stack[UART_STDIO_TX_STACKSIZE];
+static char _tx_chunk[UART_STDIO_TX_CHUNK];
+#endif
+
 #if MODULE_VFS
 static ssize_t uart_stdio_vfs_read(vfs_file_t *filp, void *dest, size_t nbytes);
 static ssize_t uart_stdio_vfs_write(vfs_file_t *filp, const void *src, size_t nbytes);
@@ -112,12 +130,138 @@ int uart_stdio_read(char* buffer, int count)
     return isrpipe_read(&uart_stdio_isrpipe, buffer, count);
 }
 
-int uart_stdio_write(const char* buffer, int len)
+static void _write(const char* buffer, int len)
 {
 #ifndef USE_ETHOS_FOR_STDIO
     uart_write(UART_STDIO_DEV, (const uint8_t *)buffer, (size_t)len);
 #else
     ethos_send_frame(&ethos, (const uint8_t *)buffer, len, ETHOS_FRAME_TYPE_TEXT);
 #endif
+}
+
+#ifdef MODULE_UART_STDIO_TX_BUF
+static void *_tx_thread(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        /* the data is taken out of the buffer before it is written, so
+         * writers dropping the oldest data can't overwrite it meanwhile */
+        unsigned state = irq_disable();
+        int len = tsrb_get(&_tx_rb, _tx_chunk, sizeof(_tx_chunk));
+        irq_restore(state);
+
+        if (!len) {
+            mutex_lock(&_tx_wake);
+            continue;
+        }
+
+        mutex_unlock(&_tx_space);
+        _write(_tx_chunk, len);
+    }
+
+    return NULL;
+}
+
+static void _tx_start(void)
+{
+    unsigned state = irq_disable();
+
+    if (_tx_pid == KERNEL_PID_UNDEF) {
+        _tx_pid = thread_create(_tx_stack, sizeof(_tx_stack),
+                                UART_STDIO_TX_PRIO,
+                                THREAD_CREATE_WOUT_YIELD | THREAD_CREATE_STACKTEST,
+                                _tx_thread, NULL, "stdio_tx");
+    }
+    irq_restore(state);
+}
+
+int uart_stdio_write(const char* buffer, int len)
+{
+    int done = 0;
+
+    /* the drain thread can only be started once the scheduler runs, write
+     * synchronously before */
+    if (_tx_pid == KERNEL_PID_UNDEF) {
+        if (!sched_active_thread || irq_is_in()) {
+            _write(buffer, len);
+            return len;
+        }
+        _tx_start();
+    }
+
+    while (done < len) {
+        unsigned state = irq_disable();
+
+        done += tsrb_add(&_tx_rb, buffer + done, len - done);
+#if UART_STDIO_TX_POLICY == UART_STDIO_TX_DROP_OLDEST
+        if (done < len) {
+            unsigned missing = len - done;
+            unsigned drop;
+
+            /* only the tail of data larger than the buffer can be kept */
+            if (missing > _tx_rb.size) {
+                _tx_dropped += missing - _tx_rb.size;
+                done += missing - _tx_rb.size;
+                missing = _tx_rb.size;
+            }
+            drop = tsrb_avail(&_tx_rb);
+            if (drop > missing) {
+                drop = missing;
+            }
+            tsrb_read_commit(&_tx_rb, drop);
+            _tx_dropped += drop;
+            done += tsrb_add(&_tx_rb, buffer + done, len - done);
+        }
+#else
+        /* blocking is impossible in interrupt context */
+        if ((done < len) &&
+            ((UART_STDIO_TX_POLICY == UART_STDIO_TX_DROP) || irq_is_in())) {
+            _tx_dropped += len - done;
+            done = len;
+        }
+#endif
+        irq_restore(state);
+
+        mutex_unlock(&_tx_wake);
+        if (done < len) {
+            mutex_lock(&_tx_space);
+        }
+    }
+
+    return len;
+}
+
+void uart_stdio_flush(void)
+{
+    char *ptr;
+    unsigned len;
+    unsigned state = irq_disable();
+
+    while ((len = tsrb_read_contiguous(&_tx_rb, &ptr)) > 0) {
+        _write(ptr, len);
+        tsrb_read_commit(&_tx_rb, len);
+    }
+    irq_restore(state);
+}
+
+unsigned uart_stdio_tx_dropped(void)
+{
+    return _tx_dropped;
+}
+#else
+int uart_stdio_write(const char* buffer, int len)
+{
+    _write(buffer, len);
     return len;
 }
+
+void uart_stdio_flush(void)
+{
+}
+
+unsigned uart_stdio_tx_dropped(void)
+{
+    return 0;
+}
+#endif
@@ -34,6 +34,18 @@ static volatile uint32_t _long_cnt = 0;
 #if XTIMER_MASK
 volatile uint32_t _xtimer_high_cnt = 0;
 #endif
+volatile uint32_t _xtimer_coarse_now = 0;
+
+/**
+ * @brief   Time of the start of the current low-level timer period
+ *
+ * This is (_long_cnt << 32) | _xtimer_high_cnt, kept as latched copies so it
+ * can be read lock-free: readers use _epoch[_epoch_seq & 1] and retry if
+ * _epoch_seq changed meanwhile, while the writer always updates the copy that
+ * is currently not in use (see _update_epoch()).
+ */
+static volatile uint32_t _epoch_seq = 0;
+static volatile uint64_t _epoch[2] = { 0, 0 };
 
 static inline void xtimer_spin_until(uint32_t value);
 
@@ -52,6 +64,7 @@ static void _timer_callback(void);
 static void _periph_timer_callback(void *arg, int chan);
 
 static inline int _this_high_period(uint32_t target);
+static inline void _update_epoch(void);
 
 static inline int _is_set(xtimer_t *timer)
 {
@@ -77,26 +90,28 @@ void xtimer_init(void)
 
 static void _xtimer_now_internal(uint32_t *short_term, uint32_t *long_term)
 {
-    uint32_t before, after, long_value;
+    uint64_t now = _xtimer_now64();
 
-    /* loop to cope with possible overflow of _xtimer_now() */
-    do {
-        before = _xtimer_now();
-        long_value = _long_cnt;
-        after = _xtimer_now();
-
-    } while(before > after);
-
-    *short_term = after;
-    *long_term = long_value;
+    *short_term = (uint32_t)now;
+    *long_term = (uint32_t)(now >> 32);
 }
 
 uint64_t _xtimer_now64(void)
 {
-    uint32_t short_term, long_term;
-    _xtimer_now_internal(&short_term, &long_term);
+    uint32_t seq, now;
+    uint64_t epoch;
+
+    /* The epoch only changes once per low-level timer period, so this loops
+     * at most once more, unless the read takes longer than a whole period.
+     * As the reader never waits for the writer, it is safe to call from any
+     * interrupt, even one preempting the epoch update. */
+    do {
+        seq = _epoch_seq;
+        epoch = _epoch[seq & 1];
+        now = _xtimer_lltimer_now();
+    } while (seq != _epoch_seq);
 
-    return ((uint64_t)long_term<<32) + short_term;
+    return epoch + now;
 }
 
 void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
@@ -286,6 +301,29 @@ void xtimer_remove(xtimer_t *timer)
     irq_restore(state);
 }
 
+xtimer_ticks32_t xtimer_left_until_next(void)
+{
+    xtimer_ticks32_t left = { .ticks32 = 0 };
+    uint32_t next;
+
+    unsigned state = irq_disable();
+    uint32_t now = _xtimer_lltimer_now();
+    if (timer_list_head) {
+        next = _xtimer_lltimer_mask(timer_list_head->target - XTIMER_OVERHEAD);
+    }
+    else {
+        /* there is always a wakeup at the end of the timer period */
+        next = _xtimer_lltimer_mask(0xFFFFFFFF);
+    }
+    irq_restore(state);
+
+    if (next > now) {
+        left.ticks32 = next - now;
+    }
+
+    return left;
+}
+
 static uint32_t _time_left(uint32_t target, uint32_t reference)
 {
     uint32_t now = _xtimer_lltimer_now();
@@ -401,6 +439,25 @@ static void _select_long_timers(void)
     }
 }
 
+/**
+ * @brief publish the start of the current timer period to _xtimer_now64()
+ */
+static inline void _update_epoch(void)
+{
+#if XTIMER_MASK
+    uint64_t epoch = ((uint64_t)_long_cnt << 32) | _xtimer_high_cnt;
+#else
+    uint64_t epoch = (uint64_t)_long_cnt << 32;
+#endif
+
+    /* let readers use the old value in _epoch[1] while updating _epoch[0],
+     * then switch them over to _epoch[0] */
+    _epoch_seq++;
+    _epoch[0] = epoch;
+    _epoch_seq++;
+    _epoch[1] = epoch;
+}
+
 /**
  * @brief handle low-level timer overflow, advance to next short timer period
  */
@@ -418,6 +475,8 @@ static void _next_period(void)
     _long_cnt++;
 #endif
 
+    _update_epoch();
+
     /* swap overflow list to current timer list */
     timer_list_head = overflow_list_head;
     overflow_list_head = NULL;
@@ -529,6 +588,8 @@ overflow:
 
     _in_handler = 0;
 
+    _xtimer_coarse_now = _xtimer_now();
+
     /* set low level timer */
     _lltimer_set(next_target);
 }
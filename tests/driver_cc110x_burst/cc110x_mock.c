@@ -0,0 +1,362 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       SPI bus with an emulated CC110x device
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "mutex.h"
+#include "periph/spi.h"
+
+#include "cc110x-defines.h"
+#include "cc110x_mock.h"
+
+#define FIFO_SIZE           (64U)
+#define CONF_NUMOF          (0x2f)
+#define PATABLE_LEN         (8U)
+#define HDR_READ            (0x80)
+#define HDR_BURST           (0x40)
+#define HDR_ADDR_MASK       (0x3f)
+#define STATUS_LAST         (CC110X_SNOP)
+/* thresholds for FIFOTHR = 0x07 */
+#define RX_THRESHOLD        (32U)
+#define TX_THRESHOLD        (33U)
+/* GDO2 signals configured by the driver */
+#define GDO2_RX_THRESHOLD   (0x01)
+#define GDO2_TX_THRESHOLD   (0x02)
+#define GDO2_SYNC_WORD      (0x06)
+/* MARCSTATE values */
+#define MARC_IDLE           (0x01)
+#define MARC_RX             (0x0d)
+#define MARC_TX             (0x13)
+
+typedef struct {
+    uint8_t data[FIFO_SIZE];
+    unsigned head;
+    unsigned count;
+    bool flow;              /**< overflow or underflow */
+} fifo_t;
+
+unsigned cc110x_mock_accesses;
+unsigned cc110x_mock_transfers;
+unsigned cc110x_mock_errors;
+uint8_t cc110x_mock_tx[256];
+size_t cc110x_mock_tx_len;
+
+static mutex_t _bus = MUTEX_INIT;
+static uint8_t _conf[CONF_NUMOF];
+static uint8_t _patable[PATABLE_LEN];
+static unsigned _patable_pos;
+static fifo_t _rx;
+static fifo_t _tx;
+static uint8_t _marc;
+/* packet on the air, followed by the status bytes */
+static uint8_t _air[256 + 2];
+static size_t _air_len;
+static size_t _air_pos;
+/* current access */
+static uint8_t _hdr;
+static uint8_t _addr;
+static bool _hdr_next;
+
+static void _push(fifo_t *fifo, uint8_t val)
+{
+    fifo->data[(fifo->head + fifo->count++) % FIFO_SIZE] = val;
+}
+
+static uint8_t _pop(fifo_t *fifo)
+{
+    uint8_t val = fifo->data[fifo->head];
+
+    fifo->head = (fifo->head + 1) % FIFO_SIZE;
+    fifo->count--;
+    return val;
+}
+
+static void _flush(fifo_t *fifo)
+{
+    memset(fifo, 0, sizeof(*fifo));
+}
+
+static void _strobe(uint8_t cmd)
+{
+    switch (cmd) {
+        case CC110X_SRES:
+            memset(_conf, 0, sizeof(_conf));
+            _flush(&_rx);
+            _flush(&_tx);
+            _marc = MARC_IDLE;
+            break;
+        case CC110X_SIDLE:
+        case CC110X_SPWD:
+            /* aborts the reception of a packet on the air */
+            _air_pos = _air_len;
+            _marc = MARC_IDLE;
+            break;
+        case CC110X_SRX:
+            _marc = MARC_RX;
+            break;
+        case CC110X_STX:
+            cc110x_mock_tx_len = 0;
+            _marc = MARC_TX;
+            break;
+        case CC110X_SFRX:
+            _flush(&_rx);
+            break;
+        case CC110X_SFTX:
+            _flush(&_tx);
+            break;
+        default:
+            break;
+    }
+}
+
+static uint8_t _status(uint8_t addr)
+{
+    switch (addr) {
+        case CC110X_MARCSTATE:
+            return _marc;
+        case CC110X_TXBYTES:
+            return (_tx.flow ? TXFIFO_UNDERFLOW : 0) | _tx.count;
+        case CC110X_RXBYTES:
+            return (_rx.flow ? RXFIFO_OVERFLOW : 0) | _rx.count;
+        default:
+            return 0;
+    }
+}
+
+static void _header(uint8_t hdr)
+{
+    _hdr = hdr;
+    _addr = hdr & HDR_ADDR_MASK;
+    _hdr_next = false;
+    _patable_pos = 0;
+    if ((_addr >= CC110X_PARTNUM) && (_addr <= STATUS_LAST) &&
+        !(hdr & HDR_BURST)) {
+        _strobe(_addr);
+        _hdr_next = true;
+    }
+}
+
+static uint8_t _data(uint8_t out)
+{
+    bool read = _hdr & HDR_READ;
+    uint8_t in = 0;
+
+    if ((_addr == CC110X_RXFIFO) && read) {
+        if (_rx.count == 0) {
+            cc110x_mock_errors++;
+        }
+        else {
+            in = _pop(&_rx);
+            /* the last byte must stay in the FIFO during reception */
+            if ((_rx.count == 0) && (_air_pos < _air_len)) {
+                cc110x_mock_errors++;
+            }
+        }
+    }
+    else if (_addr == CC110X_TXFIFO) {
+        if (_tx.count == FIFO_SIZE) {
+            cc110x_mock_errors++;
+        }
+        else {
+            _push(&_tx, out);
+        }
+    }
+    else if (_addr == CC110X_PATABLE) {
+        if (read) {
+            in = _patable[_patable_pos];
+        }
+        else {
+            _patable[_patable_pos] = out;
+        }
+        _patable_pos = (_patable_pos + 1) % PATABLE_LEN;
+    }
+    else if (_addr >= CC110X_PARTNUM) {
+        in = _status(_addr);
+    }
+    else if (_addr < CONF_NUMOF) {
+        if (read) {
+            in = _conf[_addr];
+        }
+        else {
+            _conf[_addr] = out;
+        }
+        if (_hdr & HDR_BURST) {
+            _addr++;
+        }
+    }
+    /* single accesses and status registers take one data byte */
+    _hdr_next = !(_hdr & HDR_BURST) ||
+                ((_addr >= CC110X_PARTNUM) && (_addr <= STATUS_LAST));
+    return in;
+}
+
+static unsigned _receive(void)
+{
+    unsigned moved = 0;
+
+    while ((_air_pos < _air_len) && (_rx.count < RX_THRESHOLD)) {
+        if (_rx.count == FIFO_SIZE) {
+            _rx.flow = true;
+            break;
+        }
+        _push(&_rx, _air[_air_pos++]);
+        moved++;
+    }
+    if (_air_pos == _air_len) {
+        /* RXOFF_MODE: IDLE after the packet */
+        _marc = MARC_IDLE;
+    }
+    return moved;
+}
+
+static unsigned _transmit(unsigned limit)
+{
+    unsigned moved = 0;
+
+    while (_tx.count > limit) {
+        cc110x_mock_tx[cc110x_mock_tx_len++] = _pop(&_tx);
+        moved++;
+        if (cc110x_mock_tx_len == (size_t)cc110x_mock_tx[0] + 1) {
+            /* TXOFF_MODE: RX after the packet */
+            _marc = MARC_RX;
+            return moved;
+        }
+    }
+    if (_tx.count == 0) {
+        _tx.flow = true;
+    }
+    return moved;
+}
+
+void cc110x_mock_init(void)
+{
+    _strobe(CC110X_SRES);
+    memset(_patable, 0, sizeof(_patable));
+    _air_len = 0;
+    _air_pos = 0;
+    cc110x_mock_tx_len = 0;
+    cc110x_mock_clear();
+}
+
+void cc110x_mock_clear(void)
+{
+    cc110x_mock_accesses = 0;
+    cc110x_mock_transfers = 0;
+    cc110x_mock_errors = 0;
+}
+
+void cc110x_mock_rx(const void *pkt, size_t len, bool crc_ok)
+{
+    memcpy(_air, pkt, len);
+    _air[len] = CC110X_MOCK_RSSI;
+    _air[len + 1] = CC110X_MOCK_LQI | (crc_ok ? CRC_OK : 0);
+    _air_len = len + 2;
+    _air_pos = 0;
+}
+
+unsigned cc110x_mock_run(void)
+{
+    uint8_t gdo2 = _conf[CC110X_IOCFG2] & HDR_ADDR_MASK;
+
+    if ((_marc == MARC_RX) && (gdo2 == GDO2_RX_THRESHOLD)) {
+        return _receive();
+    }
+    if ((_marc == MARC_TX) && (gdo2 == GDO2_TX_THRESHOLD)) {
+        return _transmit(TX_THRESHOLD - 1);
+    }
+    if ((_marc == MARC_TX) && (gdo2 == GDO2_SYNC_WORD)) {
+        return _transmit(0);
+    }
+    return 0;
+}
+
+uint8_t cc110x_mock_reg(uint8_t addr)
+{
+    return _conf[addr];
+}
+
+int spi_init_cs(spi_t bus, spi_cs_t cs)
+{
+    (void)bus;
+    (void)cs;
+    return SPI_OK;
+}
+
+void spi_init_pins(spi_t bus)
+{
+    (void)bus;
+}
+
+int spi_acquire(spi_t bus, spi_cs_t cs, spi_mode_t mode, spi_clk_t clk)
+{
+    (void)bus;
+    (void)cs;
+    (void)mode;
+    (void)clk;
+    mutex_lock(&_bus);
+    cc110x_mock_accesses++;
+    _hdr_next = true;
+    return SPI_OK;
+}
+
+void spi_release(spi_t bus)
+{
+    (void)bus;
+    mutex_unlock(&_bus);
+}
+
+uint8_t spi_transfer_byte(spi_t bus, spi_cs_t cs, bool cont, uint8_t out)
+{
+    (void)bus;
+    (void)cs;
+    (void)cont;
+    cc110x_mock_transfers++;
+    if (_hdr_next) {
+        _header(out);
+        return 0;
+    }
+    return _data(out);
+}
+
+uint8_t spi_transfer_reg(spi_t bus, spi_cs_t cs, uint8_t reg, uint8_t out)
+{
+    uint8_t in = 0;
+
+    spi_transfer_regs(bus, cs, reg, &out, &in, 1);
+    return in;
+}
+
+void spi_transfer_regs(spi_t bus, spi_cs_t cs, uint8_t reg,
+                       const void *out, void *in, size_t len)
+{
+    const uint8_t *o = out;
+    uint8_t *i = in;
+
+    (void)bus;
+    (void)cs;
+    cc110x_mock_transfers++;
+    _header(reg);
+    for (size_t n = 0; n < len; n++) {
+        uint8_t val = _data((o != NULL) ? o[n] : 0);
+
+        if (i != NULL) {
+            i[n] = val;
+        }
+    }
+    _hdr_next = true;
+}
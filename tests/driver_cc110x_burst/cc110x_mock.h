@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       SPI bus with an emulated CC110x device
+ *
+ * Implements the SPI functions used by the CC110x driver. Every SPI access is
+ * decoded into the configuration registers, status registers, command strobes
+ * and FIFOs of the emulated device. Packets pass the air only when the test
+ * lets the radio run.
+ */
+
+#ifndef CC110X_MOCK_H
+#define CC110X_MOCK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   RSSI value appended to every received packet
+ */
+#define CC110X_MOCK_RSSI            (0x42)
+
+/**
+ * @brief   LQI value appended to every received packet
+ */
+#define CC110X_MOCK_LQI             (0x17)
+
+/**
+ * @brief   Number of SPI accesses (chip select cycles) since
+ *          cc110x_mock_clear()
+ */
+extern unsigned cc110x_mock_accesses;
+
+/**
+ * @brief   Number of calls to SPI transfer functions since
+ *          cc110x_mock_clear()
+ */
+extern unsigned cc110x_mock_transfers;
+
+/**
+ * @brief   Number of FIFO misuses (reading an empty RX FIFO, the last byte
+ *          of the RX FIFO during reception or writing a full TX FIFO) since
+ *          cc110x_mock_clear()
+ */
+extern unsigned cc110x_mock_errors;
+
+/**
+ * @brief   Bytes sent by the device since the last STX strobe
+ */
+extern uint8_t cc110x_mock_tx[256];
+
+/**
+ * @brief   Number of bytes in @ref cc110x_mock_tx
+ */
+extern size_t cc110x_mock_tx_len;
+
+/**
+ * @brief   Powers up the emulated device
+ */
+void cc110x_mock_init(void);
+
+/**
+ * @brief   Clears the counters
+ */
+void cc110x_mock_clear(void);
+
+/**
+ * @brief   Lets a packet arrive at the device
+ *
+ * The packet is received in the following calls to cc110x_mock_run(),
+ * followed by the status bytes.
+ *
+ * @param[in] pkt       packet starting with the length byte
+ * @param[in] len       length of @p pkt
+ * @param[in] crc_ok    false to mark the packet as received with a CRC error
+ */
+void cc110x_mock_rx(const void *pkt, size_t len, bool crc_ok);
+
+/**
+ * @brief   Lets the radio run until GDO2 signals the next interrupt, as
+ *          configured in IOCFG2
+ *
+ * @return  number of bytes received or sent over the air
+ */
+unsigned cc110x_mock_run(void);
+
+/**
+ * @brief   Returns the value of a configuration register
+ */
+uint8_t cc110x_mock_reg(uint8_t addr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CC110X_MOCK_H */
+/** @} */
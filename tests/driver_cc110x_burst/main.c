@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the burst FIFO access of the CC110x driver
+ *
+ * Streams packets through an emulated CC110x on a mock SPI bus.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "cc110x.h"
+#include "cc110x-defines.h"
+#include "cc110x-interface.h"
+#include "cc110x-spi.h"
+#include "cc110x_mock.h"
+
+/* upper bound for the interrupts needed for one packet */
+#define IRQ_MAX             (32U)
+
+static const cc110x_params_t params = {
+    .spi = SPI_DEV(0),
+    .cs = GPIO_UNDEF,
+    .gdo0 = GPIO_UNDEF,
+    .gdo1 = GPIO_UNDEF,
+    .gdo2 = GPIO_UNDEF,
+};
+
+/* packet lengths (without the length byte) to test with */
+static const uint8_t lengths[] = { 10, 61, 120, 254 };
+
+static cc110x_t dev;
+static uint8_t pkt[256];
+static unsigned received;
+static bool ok_all = true;
+
+static void _result(const char *name, bool ok)
+{
+    printf("%-40s %s\n", name, ok ? "OK" : "FAILED");
+    ok_all = ok_all && ok;
+}
+
+static void _rx_cb(void *arg)
+{
+    (void)arg;
+    received++;
+}
+
+static void _build(uint8_t length, uint8_t seq)
+{
+    pkt[0] = length;
+    pkt[1] = dev.radio_address;
+    pkt[2] = 0x23;
+    pkt[3] = 0;
+    for (unsigned i = 4; i <= length; i++) {
+        pkt[i] = (uint8_t)(seq + i);
+    }
+}
+
+/* returns the number of packets passed to the callback */
+static unsigned _receive(uint8_t length, bool crc_ok)
+{
+    unsigned prev = received;
+
+    cc110x_mock_rx(pkt, length + 1, crc_ok);
+    cc110x_mock_clear();
+
+    /* the sync word can't be signalled through the GPIO of native, so this
+     * does what the driver does on the GDO2 interrupt in RADIO_RX */
+    dev.radio_state = RADIO_RX_BUSY;
+    dev.pkt_buf.pos = 0;
+    cc110x_write_reg(&dev, CC110X_IOCFG2, 0x01);
+
+    for (unsigned i = 0; (i < IRQ_MAX) && (dev.radio_state == RADIO_RX_BUSY);
+         i++) {
+        cc110x_mock_run();
+        cc110x_isr_handler(&dev, _rx_cb, NULL);
+    }
+    if ((dev.radio_state != RADIO_RX) || (cc110x_mock_errors != 0)) {
+        return ~0U;
+    }
+    return received - prev;
+}
+
+static bool _send(uint8_t length)
+{
+    _build(length, length);
+    cc110x_mock_clear();
+    if (cc110x_send(&dev, (cc110x_pkt_t *)pkt) != length + 1) {
+        return false;
+    }
+    for (unsigned i = 0; (i < IRQ_MAX) && (dev.radio_state == RADIO_TX_BUSY);
+         i++) {
+        cc110x_mock_run();
+        cc110x_isr_handler(&dev, _rx_cb, NULL);
+    }
+    return (dev.radio_state == RADIO_RX) && (cc110x_mock_errors == 0) &&
+           (cc110x_mock_tx_len == (size_t)length + 1) &&
+           (memcmp(cc110x_mock_tx, pkt, length + 1) == 0);
+}
+
+static void test_init(void)
+{
+    bool ok;
+
+    cc110x_mock_init();
+    ok = (cc110x_setup(&dev, &params) == 0) &&
+         (cc110x_mock_reg(CC110X_PKTLEN) == 0xff);
+    cc110x_setup_rx_mode(&dev);
+    ok = ok && (dev.radio_state == RADIO_RX) && (cc110x_mock_errors == 0);
+    _result("init", ok);
+}
+
+static void test_rx(void)
+{
+    char name[48];
+    bool ok;
+
+    for (unsigned i = 0; i < sizeof(lengths); i++) {
+        _build(lengths[i], i);
+        ok = (_receive(lengths[i], true) == 1) &&
+             (memcmp(&dev.pkt_buf.packet, pkt, lengths[i] + 1) == 0) &&
+             (dev.pkt_buf.rssi == CC110X_MOCK_RSSI) &&
+             (dev.pkt_buf.lqi == CC110X_MOCK_LQI);
+        printf("RX %3u byte packet: %2u SPI accesses, %3u transfers\n",
+               lengths[i], cc110x_mock_accesses, cc110x_mock_transfers);
+        snprintf(name, sizeof(name), "RX %u byte packet", lengths[i]);
+        _result(name, ok);
+    }
+
+    _build(100, 0x55);
+    ok = (_receive(100, false) == 0) &&
+         (dev.cc110x_statistic.packets_in_crc_fail == 1);
+    _result("RX packet with CRC error dropped", ok);
+
+    /* one byte longer than the packet buffer */
+    _build(255, 0x66);
+    ok = (_receive(255, true) == 0);
+    _result("RX oversized packet dropped", ok);
+}
+
+static void test_tx(void)
+{
+    char name[48];
+    bool ok;
+
+    for (unsigned i = 0; i < sizeof(lengths); i++) {
+        ok = _send(lengths[i]);
+        printf("TX %3u byte packet: %2u SPI accesses, %3u transfers\n",
+               lengths[i], cc110x_mock_accesses, cc110x_mock_transfers);
+        snprintf(name, sizeof(name), "TX %u byte packet", lengths[i]);
+        _result(name, ok);
+    }
+}
+
+int main(void)
+{
+    puts("CC110x burst FIFO access test");
+
+    test_init();
+    test_rx();
+    test_tx();
+
+    puts(ok_all ? "SUCCESS" : "FAILURE");
+    return 0;
+}
@@ -0,0 +1,325 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       SPI bus with an emulated ENC28J60 device
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "mutex.h"
+#include "periph/spi.h"
+
+#include "enc28j60_regs.h"
+#include "enc28j60_mock.h"
+
+#define REG_MASK            (0x1f)
+#define REG_COMMON          (REG_EIE)
+#define OPCODE_MASK         (0xe0)
+#define CRC_LEN             (4U)
+#define RSV_CRCERR          (0x10)
+
+unsigned enc28j60_mock_cmds;
+unsigned enc28j60_mock_acquired;
+unsigned enc28j60_mock_dma_runs;
+uint8_t enc28j60_mock_tx[ENC28J60_MOCK_MEM_SIZE];
+size_t enc28j60_mock_tx_len;
+
+static mutex_t _bus = MUTEX_INIT;
+static uint8_t _mem[ENC28J60_MOCK_MEM_SIZE];
+static uint8_t _regs[4][REG_MASK + 1];
+static uint8_t _pktcnt;
+
+static uint8_t *_reg(uint8_t reg)
+{
+    reg &= REG_MASK;
+    if (reg >= REG_COMMON) {
+        return &_regs[0][reg];
+    }
+    return &_regs[_regs[0][REG_ECON1] & ECON1_BSEL_MASK][reg];
+}
+
+static uint16_t _ptr(uint8_t addr)
+{
+    return (_regs[0][addr + 1] << 8) | _regs[0][addr];
+}
+
+static void _set_ptr(uint8_t addr, uint16_t val)
+{
+    _regs[0][addr] = (uint8_t)(val & 0xff);
+    _regs[0][addr + 1] = (uint8_t)(val >> 8);
+}
+
+/* pointers into the receive buffer wrap around at its end */
+static uint16_t _rx_inc(uint16_t ptr)
+{
+    if (ptr == _ptr(ADDR_RX_END)) {
+        return _ptr(ADDR_RX_START);
+    }
+    return (ptr + 1) & (ENC28J60_MOCK_MEM_SIZE - 1);
+}
+
+static uint16_t _rx_free(void)
+{
+    uint16_t size = _ptr(ADDR_RX_END) - _ptr(ADDR_RX_START) + 1;
+    uint16_t rd = _ptr(ADDR_RX_READ);
+    uint16_t wr = _ptr(ADDR_RX_WRITE);
+
+    if (_pktcnt == 0) {
+        return size - 1;
+    }
+    return (rd > wr) ? (rd - wr - 1) : (size - (wr - rd) - 1);
+}
+
+static void _update_eir(void)
+{
+    if (_pktcnt > 0) {
+        _regs[0][REG_EIR] |= EIR_PKTIF;
+    }
+    else {
+        _regs[0][REG_EIR] &= ~EIR_PKTIF;
+    }
+}
+
+static void _transmit(void)
+{
+    uint16_t start = _ptr(ADDR_TX_START);
+    uint16_t end = _ptr(ADDR_TX_END);
+
+    /* the first byte is the per packet control byte */
+    enc28j60_mock_tx_len = end - start;
+    memcpy(enc28j60_mock_tx, &_mem[start + 1], enc28j60_mock_tx_len);
+    _regs[0][REG_ECON1] &= ~ECON1_TXRTS;
+    _regs[0][REG_EIR] |= EIR_TXIF;
+}
+
+static void _dma_csum(void)
+{
+    uint16_t ptr = _ptr(REG_B0_EDMASTL);
+    uint16_t end = _ptr(REG_B0_EDMANDL);
+    uint32_t sum = 0;
+    bool high = true;
+
+    while (1) {
+        sum += high ? (_mem[ptr] << 8) : _mem[ptr];
+        high = !high;
+        if (ptr == end) {
+            break;
+        }
+        ptr = _rx_inc(ptr);
+    }
+    while (sum >> 16) {
+        sum = (sum & 0xffff) + (sum >> 16);
+    }
+    sum = ~sum & 0xffff;
+    _regs[0][REG_B0_EDMACSH] = (uint8_t)(sum >> 8);
+    _regs[0][REG_B0_EDMACSL] = (uint8_t)(sum & 0xff);
+    _regs[0][REG_ECON1] &= ~ECON1_DMAST;
+    _regs[0][REG_EIR] |= EIR_DMAIF;
+    enc28j60_mock_dma_runs++;
+}
+
+static uint8_t _rcr(uint8_t reg)
+{
+    if ((reg & REG_MASK) == REG_ESTAT) {
+        return ESTAT_CLKRDY;
+    }
+    if (((_regs[0][REG_ECON1] & ECON1_BSEL_MASK) == 1) &&
+        ((reg & REG_MASK) == REG_B1_EPKTCNT)) {
+        return _pktcnt;
+    }
+    return *_reg(reg);
+}
+
+static void _wcr(uint8_t reg, uint8_t val)
+{
+    *_reg(reg) = val;
+    /* writing the receive buffer start resets the receive write pointer */
+    if (((_regs[0][REG_ECON1] & ECON1_BSEL_MASK) == 0) &&
+        (((reg & REG_MASK) == REG_B0_ERXSTL) ||
+         ((reg & REG_MASK) == REG_B0_ERXSTH))) {
+        _set_ptr(ADDR_RX_WRITE, _ptr(ADDR_RX_START));
+    }
+}
+
+static void _bfs(uint8_t reg, uint8_t mask)
+{
+    reg &= REG_MASK;
+    if ((reg == REG_ECON2) && (mask & ECON2_PKTDEC)) {
+        if (_pktcnt > 0) {
+            _pktcnt--;
+        }
+        _update_eir();
+        mask &= ~ECON2_PKTDEC;
+    }
+    *_reg(reg) |= mask;
+    if ((reg == REG_ECON1) && (mask & ECON1_TXRTS)) {
+        _transmit();
+    }
+    if ((reg == REG_ECON1) && (mask & ECON1_DMAST) &&
+        (_regs[0][REG_ECON1] & ECON1_CSUMEN)) {
+        _dma_csum();
+    }
+}
+
+static void _rbm(uint8_t *in, size_t len)
+{
+    uint16_t ptr = _ptr(ADDR_READ_PTR);
+
+    for (size_t i = 0; i < len; i++) {
+        if (in != NULL) {
+            in[i] = _mem[ptr];
+        }
+        ptr = _rx_inc(ptr);
+    }
+    _set_ptr(ADDR_READ_PTR, ptr);
+}
+
+static void _wbm(const uint8_t *out, size_t len)
+{
+    uint16_t ptr = _ptr(ADDR_WRITE_PTR);
+
+    for (size_t i = 0; i < len; i++) {
+        _mem[ptr] = out[i];
+        ptr = (ptr + 1) & (ENC28J60_MOCK_MEM_SIZE - 1);
+    }
+    _set_ptr(ADDR_WRITE_PTR, ptr);
+}
+
+void enc28j60_mock_init(void)
+{
+    memset(_mem, 0, sizeof(_mem));
+    memset(_regs, 0, sizeof(_regs));
+    _pktcnt = 0;
+    enc28j60_mock_clear();
+}
+
+void enc28j60_mock_clear(void)
+{
+    enc28j60_mock_cmds = 0;
+    enc28j60_mock_acquired = 0;
+    enc28j60_mock_dma_runs = 0;
+}
+
+int enc28j60_mock_rx(const void *frame, size_t len, bool ok)
+{
+    uint16_t wr = _ptr(ADDR_RX_WRITE);
+    uint16_t count = len + CRC_LEN;
+    uint16_t total = RSV_LEN + count + ((RSV_LEN + count) & 1);
+    uint16_t next = wr;
+    uint8_t head[RSV_LEN];
+
+    if (!(_regs[0][REG_ECON1] & ECON1_RXEN) || (_pktcnt == 0xff) ||
+        (total > _rx_free())) {
+        _regs[0][REG_EIR] |= EIR_RXERIF;
+        return -1;
+    }
+    /* frames start at even addresses */
+    for (unsigned i = 0; i < total; i++) {
+        next = _rx_inc(next);
+    }
+    head[0] = (uint8_t)(next & 0xff);
+    head[1] = (uint8_t)(next >> 8);
+    head[2] = (uint8_t)(count & 0xff);
+    head[3] = (uint8_t)(count >> 8);
+    head[4] = ok ? RSV_RXOK : RSV_CRCERR;
+    head[5] = 0;
+    for (unsigned i = 0; i < total; i++) {
+        if (i < RSV_LEN) {
+            _mem[wr] = head[i];
+        }
+        else if (i < (RSV_LEN + len)) {
+            _mem[wr] = ((const uint8_t *)frame)[i - RSV_LEN];
+        }
+        else {
+            _mem[wr] = 0xa5;
+        }
+        wr = _rx_inc(wr);
+    }
+    _set_ptr(ADDR_RX_WRITE, next);
+    _pktcnt++;
+    _update_eir();
+    return 0;
+}
+
+uint8_t enc28j60_mock_pending(void)
+{
+    return _pktcnt;
+}
+
+int spi_init_cs(spi_t bus, spi_cs_t cs)
+{
+    (void)bus;
+    (void)cs;
+    return SPI_OK;
+}
+
+int spi_acquire(spi_t bus, spi_cs_t cs, spi_mode_t mode, spi_clk_t clk)
+{
+    (void)bus;
+    (void)cs;
+    (void)mode;
+    (void)clk;
+    mutex_lock(&_bus);
+    enc28j60_mock_acquired++;
+    return SPI_OK;
+}
+
+void spi_release(spi_t bus)
+{
+    (void)bus;
+    mutex_unlock(&_bus);
+}
+
+uint8_t spi_transfer_reg(spi_t bus, spi_cs_t cs, uint8_t reg, uint8_t out)
+{
+    uint8_t in = 0;
+
+    spi_transfer_regs(bus, cs, reg, &out, &in, 1);
+    return in;
+}
+
+void spi_transfer_regs(spi_t bus, spi_cs_t cs, uint8_t reg,
+                       const void *out, void *in, size_t len)
+{
+    const uint8_t *o = out;
+    uint8_t *i = in;
+
+    (void)bus;
+    (void)cs;
+    enc28j60_mock_cmds++;
+
+    if (reg == CMD_RBM) {
+        _rbm(i, len);
+    }
+    else if (reg == CMD_WBM) {
+        _wbm(o, len);
+    }
+    else if ((reg & OPCODE_MASK) == CMD_RCR) {
+        /* MAC and MII registers are preceded by a dummy byte */
+        if (i != NULL) {
+            memset(i, 0, len);
+            i[len - 1] = _rcr(reg);
+        }
+    }
+    else if ((reg & OPCODE_MASK) == CMD_WCR) {
+        _wcr(reg, o[0]);
+    }
+    else if ((reg & OPCODE_MASK) == CMD_BFS) {
+        _bfs(reg, o[0]);
+    }
+    else if ((reg & OPCODE_MASK) == CMD_BFC) {
+        *_reg(reg) &= ~o[0];
+    }
+}
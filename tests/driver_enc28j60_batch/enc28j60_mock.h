@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       SPI bus with an emulated ENC28J60 device
+ *
+ * Implements the SPI functions used by the ENC28J60 driver. Every SPI command
+ * is applied to the emulated control registers and buffer memory. Frames are
+ * sent and the DMA checksum is computed at once.
+ */
+
+#ifndef ENC28J60_MOCK_H
+#define ENC28J60_MOCK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Size of the buffer memory of the device
+ */
+#define ENC28J60_MOCK_MEM_SIZE      (0x2000)
+
+/**
+ * @brief   Number of SPI commands (chip select cycles) since
+ *          enc28j60_mock_clear()
+ */
+extern unsigned enc28j60_mock_cmds;
+
+/**
+ * @brief   Number of SPI bus acquisitions since enc28j60_mock_clear()
+ */
+extern unsigned enc28j60_mock_acquired;
+
+/**
+ * @brief   Number of DMA checksum calculations since enc28j60_mock_clear()
+ */
+extern unsigned enc28j60_mock_dma_runs;
+
+/**
+ * @brief   Last frame sent by the device
+ */
+extern uint8_t enc28j60_mock_tx[ENC28J60_MOCK_MEM_SIZE];
+
+/**
+ * @brief   Length of the last frame sent
+ */
+extern size_t enc28j60_mock_tx_len;
+
+/**
+ * @brief   Powers up the emulated device
+ */
+void enc28j60_mock_init(void);
+
+/**
+ * @brief   Clears the counters
+ */
+void enc28j60_mock_clear(void);
+
+/**
+ * @brief   Lets the device receive a frame
+ *
+ * @param[in] frame     frame without CRC
+ * @param[in] len       length of @p frame
+ * @param[in] ok        false to mark the frame as received with a CRC error
+ *
+ * @return  0 on success
+ * @return  -1 if the receive buffer is full
+ */
+int enc28j60_mock_rx(const void *frame, size_t len, bool ok);
+
+/**
+ * @brief   Returns the number of frames in the receive buffer
+ */
+uint8_t enc28j60_mock_pending(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ENC28J60_MOCK_H */
+/** @} */
@@ -0,0 +1,308 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the ENC28J60 receive path and checksum
+ *              offload
+ *
+ * Runs the driver against an emulated ENC28J60 on a mock SPI bus.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/ethernet.h"
+#include "net/ethertype.h"
+#include "net/inet_csum.h"
+#include "net/ipv6/hdr.h"
+#include "net/protnum.h"
+#include "net/udp.h"
+
+#include "enc28j60.h"
+#include "enc28j60_mock.h"
+
+#define IPV6_OFFSET         (sizeof(ethernet_hdr_t))
+#define UDP_OFFSET          (IPV6_OFFSET + sizeof(ipv6_hdr_t))
+#define PAYLOAD_OFFSET      (UDP_OFFSET + sizeof(udp_hdr_t))
+#define CSUM_POS            (UDP_OFFSET + 6)
+#define BATCH               (8U)
+#define ROUNDS              (16U)
+
+typedef struct {
+    uint16_t len;
+    uint8_t seq;
+} frame_t;
+
+static const enc28j60_params_t params = {
+    .spi = SPI_DEV(0),
+    .cs_pin = GPIO_UNDEF,
+    .int_pin = GPIO_UNDEF,
+    .reset_pin = GPIO_UNDEF,
+};
+
+static enc28j60_t dev;
+static uint8_t frame[ETHERNET_FRAME_LEN];
+static uint8_t buf[ETHERNET_FRAME_LEN];
+
+/* frames injected and not received yet */
+static frame_t expect[BATCH * 2];
+static unsigned expect_len;
+static unsigned received;
+static unsigned errors;
+static unsigned rx_errors;
+static unsigned drop;
+static bool ok_all = true;
+
+static void _result(const char *name, bool ok)
+{
+    printf("%-40s %s\n", name, ok ? "OK" : "FAILED");
+    ok_all = ok_all && ok;
+}
+
+static uint16_t _udp_csum(const uint8_t *f, uint16_t len)
+{
+    uint8_t pseudo[] = { len >> 8, len & 0xff, 0, PROTNUM_UDP };
+    uint16_t sum;
+
+    sum = inet_csum(0, &f[IPV6_OFFSET + 8], 2 * sizeof(ipv6_addr_t));
+    sum = inet_csum(sum, pseudo, sizeof(pseudo));
+    return inet_csum(sum, &f[UDP_OFFSET], len);
+}
+
+/* builds an Ethernet frame with an IPv6/UDP datagram with valid checksum */
+static size_t _build(uint8_t *f, uint16_t payload_len, uint8_t seq)
+{
+    uint16_t len = sizeof(udp_hdr_t) + payload_len;
+    uint16_t csum;
+
+    memset(f, 0, PAYLOAD_OFFSET);
+    memset(f, 0xff, ETHERNET_ADDR_LEN);
+    f[11] = 0x01;
+    f[12] = ETHERTYPE_IPV6 >> 8;
+    f[13] = ETHERTYPE_IPV6 & 0xff;
+    f[IPV6_OFFSET] = 0x60;
+    f[IPV6_OFFSET + 4] = len >> 8;
+    f[IPV6_OFFSET + 5] = len & 0xff;
+    f[IPV6_OFFSET + 6] = PROTNUM_UDP;
+    f[IPV6_OFFSET + 7] = 64;
+    f[IPV6_OFFSET + 8] = 0xfe;
+    f[IPV6_OFFSET + 9] = 0x80;
+    f[IPV6_OFFSET + 23] = 0x01;
+    f[IPV6_OFFSET + 24] = 0xfe;
+    f[IPV6_OFFSET + 25] = 0x80;
+    f[IPV6_OFFSET + 39] = 0x02;
+    f[UDP_OFFSET] = 0x16;
+    f[UDP_OFFSET + 1] = 0x33;
+    f[UDP_OFFSET + 2] = 0x16;
+    f[UDP_OFFSET + 3] = 0x33;
+    f[UDP_OFFSET + 4] = len >> 8;
+    f[UDP_OFFSET + 5] = len & 0xff;
+    for (unsigned i = 0; i < payload_len; i++) {
+        f[PAYLOAD_OFFSET + i] = (uint8_t)(seq + i);
+    }
+    csum = ~_udp_csum(f, len);
+    f[CSUM_POS] = csum >> 8;
+    f[CSUM_POS + 1] = csum & 0xff;
+    return PAYLOAD_OFFSET + payload_len;
+}
+
+static void _inject(uint16_t payload_len, uint8_t seq, bool ok)
+{
+    size_t len = _build(frame, payload_len, seq);
+
+    if (enc28j60_mock_rx(frame, len, ok) < 0) {
+        /* receive buffer full */
+        errors++;
+    }
+    else if (ok) {
+        expect[expect_len].len = len;
+        expect[expect_len++].seq = seq;
+    }
+}
+
+/* receives like the GNRC Ethernet glue code */
+static void _event_cb(netdev_t *netdev, netdev_event_t event)
+{
+    int size, nread;
+
+    if (event != NETDEV_EVENT_RX_COMPLETE) {
+        return;
+    }
+    size = netdev->driver->recv(netdev, NULL, 0, NULL);
+    if (size <= 0) {
+        return;
+    }
+    if (drop > 0) {
+        /* packet buffer full */
+        drop--;
+        netdev->driver->recv(netdev, NULL, size, NULL);
+        received++;
+        return;
+    }
+    nread = netdev->driver->recv(netdev, buf, size, NULL);
+    if (nread < 0) {
+        rx_errors++;
+        return;
+    }
+    if (received >= expect_len) {
+        errors++;
+        return;
+    }
+    frame_t *exp = &expect[received++];
+    _build(frame, exp->len - PAYLOAD_OFFSET, exp->seq);
+    if ((nread != exp->len) || (memcmp(buf, frame, nread) != 0)) {
+        errors++;
+    }
+}
+
+static bool _rx_done(void)
+{
+    bool ok = (received == expect_len) && (errors == 0) &&
+              (enc28j60_mock_pending() == 0);
+
+    expect_len = 0;
+    received = 0;
+    errors = 0;
+    return ok;
+}
+
+static void test_batch(void)
+{
+    for (unsigned i = 0; i < BATCH; i++) {
+        _inject(17 + (i * 97), i, true);
+    }
+    enc28j60_mock_clear();
+    dev.netdev.driver->isr(&dev.netdev);
+    printf("%u frames: %u SPI commands, %u bus acquisitions\n", BATCH,
+           enc28j60_mock_cmds, enc28j60_mock_acquired);
+    _result("RX batch", _rx_done());
+}
+
+static void test_errors(void)
+{
+    _inject(100, 1, true);
+    _inject(100, 2, false);
+    _inject(100, 3, true);
+    dev.netdev.driver->isr(&dev.netdev);
+    _result("RX frames with CRC errors skipped", _rx_done());
+
+    drop = 1;
+    _inject(200, 4, true);
+    _inject(200, 5, true);
+    dev.netdev.driver->isr(&dev.netdev);
+    _result("RX drop", _rx_done() && (drop == 0));
+}
+
+static void test_option(void)
+{
+    netopt_enable_t en = NETOPT_ENABLE;
+    bool ok;
+
+    ok = (dev.netdev.driver->get(&dev.netdev, NETOPT_CHECKSUM_OFFLOAD, &en,
+                                 sizeof(en)) == sizeof(en)) &&
+         (en == NETOPT_DISABLE);
+    en = NETOPT_ENABLE;
+    ok = ok && (dev.netdev.driver->set(&dev.netdev, NETOPT_CHECKSUM_OFFLOAD,
+                                       &en, sizeof(en)) == sizeof(en));
+    en = NETOPT_DISABLE;
+    ok = ok && (dev.netdev.driver->get(&dev.netdev, NETOPT_CHECKSUM_OFFLOAD,
+                                       &en, sizeof(en)) == sizeof(en)) &&
+         (en == NETOPT_ENABLE);
+    _result("checksum offload option", ok);
+}
+
+static bool _send(size_t payload_len, bool clear_csum)
+{
+    size_t len = _build(frame, payload_len, 0x42);
+    struct iovec vec[] = {
+        { .iov_base = frame, .iov_len = IPV6_OFFSET },
+        { .iov_base = &frame[IPV6_OFFSET], .iov_len = UDP_OFFSET - IPV6_OFFSET },
+        { .iov_base = &frame[UDP_OFFSET], .iov_len = 5 },
+        { .iov_base = &frame[UDP_OFFSET + 5], .iov_len = len - UDP_OFFSET - 5 },
+    };
+
+    if (clear_csum) {
+        frame[CSUM_POS] = 0;
+        frame[CSUM_POS + 1] = 0;
+    }
+    enc28j60_mock_clear();
+    return dev.netdev.driver->send(&dev.netdev, vec, 4) == (int)len;
+}
+
+static void test_tx_csum(void)
+{
+    uint16_t len;
+    bool ok;
+
+    /* an odd length makes the DMA pad the last byte */
+    ok = _send(333, true) && (enc28j60_mock_dma_runs == 1);
+    len = sizeof(udp_hdr_t) + 333;
+    ok = ok && (_udp_csum(enc28j60_mock_tx, len) == 0xffff);
+    _result("TX checksum filled in", ok);
+
+    /* a checksum given by the network stack is kept */
+    ok = _send(64, false) && (enc28j60_mock_dma_runs == 0) &&
+         (memcmp(enc28j60_mock_tx, frame, PAYLOAD_OFFSET + 64) == 0);
+    _result("TX checksum kept", ok);
+}
+
+static void test_rx_csum(void)
+{
+    _inject(300, 1, true);
+    _build(frame, 300, 2);
+    frame[PAYLOAD_OFFSET + 100] ^= 0x01;
+    enc28j60_mock_rx(frame, PAYLOAD_OFFSET + 300, true);
+    _inject(300, 3, true);
+    enc28j60_mock_clear();
+    dev.netdev.driver->isr(&dev.netdev);
+    _result("RX checksum verified", _rx_done() && (rx_errors == 1) &&
+            (enc28j60_mock_dma_runs == 3));
+    rx_errors = 0;
+}
+
+static void test_wrap(void)
+{
+    bool ok = true;
+
+    /* frames of odd sizes run around the receive buffer a couple of times */
+    for (unsigned r = 0; r < ROUNDS; r++) {
+        for (unsigned i = 0; i < BATCH; i++) {
+            _inject(101 + (r * 23) + (i * 37), r + i, true);
+        }
+        dev.netdev.driver->isr(&dev.netdev);
+        ok = ok && _rx_done() && (rx_errors == 0);
+    }
+    _result("RX buffer wrap around with checksums", ok);
+}
+
+int main(void)
+{
+    puts("ENC28J60 batched receive and checksum offload test");
+
+    enc28j60_mock_init();
+    enc28j60_setup(&dev, &params);
+    dev.netdev.event_callback = _event_cb;
+    _result("init", dev.netdev.driver->init(&dev.netdev) == 0);
+
+    test_batch();
+    test_errors();
+    test_option();
+    test_tx_csum();
+    test_rx_csum();
+    test_wrap();
+
+    puts(ok_all ? "SUCCESS" : "FAILURE");
+    return 0;
+}
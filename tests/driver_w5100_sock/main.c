@@ -0,0 +1,426 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the W5100 hardware socket backend
+ *
+ * Runs the sock API against an emulated W5100 on a mock SPI bus and checks
+ * the socket register accesses.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/sock/tcp.h"
+#include "net/sock/udp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#include "w5100.h"
+#include "w5100_regs.h"
+#include "w5100_sock_internal.h"
+#include "w5100_mock.h"
+
+#define UDP_PORT            (4711U)
+#define PEER_PORT           (5683U)
+#define TCP_PORT            (80U)
+#define PAYLOAD_LEN         (64U)
+#define ETH_IPV4_UDP_HDRS   (14U + 20U + 8U)
+#define INJECT_DELAY        (20U * 1000U)
+
+/* expected write to a socket register */
+#define W(sn, off, val)     { SN_BASE(sn) + (off), (val) }
+
+static const w5100_params_t params = {
+    .spi = SPI_DEV(0),
+    .clk = SPI_CLK_5MHZ,
+    .cs  = GPIO_UNDEF,
+    .evt = GPIO_UNDEF,
+};
+
+static const w5100_ipconf_t ipconf = {
+    .addr = { 192, 168, 0, 1 },
+    .mask = { 255, 255, 255, 0 },
+    .gw   = { 192, 168, 0, 254 },
+};
+
+static const uint8_t peer[] = { 192, 168, 0, 2 };
+
+static w5100_t dev;
+static uint8_t payload[PAYLOAD_LEN];
+static uint8_t buf[256];
+static xtimer_t timer;
+static bool ok_all = true;
+static char reader_stack[THREAD_STACKSIZE_DEFAULT];
+static mutex_t reader_done = MUTEX_INIT_LOCKED;
+static ssize_t reader_res;
+
+static void _result(const char *name, bool ok)
+{
+    printf("%-40s %s\n", name, ok ? "OK" : "FAILED");
+    ok_all = ok_all && ok;
+}
+
+static bool _log(const w5100_mock_write_t *exp, unsigned len)
+{
+    if (w5100_mock_log_len != len) {
+        printf("  %u register writes, expected %u\n", w5100_mock_log_len, len);
+        return false;
+    }
+    for (unsigned i = 0; i < len; i++) {
+        if ((w5100_mock_log[i].reg != exp[i].reg) ||
+            (w5100_mock_log[i].val != exp[i].val)) {
+            printf("  write %u: 0x%04x=0x%02x, expected 0x%04x=0x%02x\n", i,
+                   w5100_mock_log[i].reg, w5100_mock_log[i].val,
+                   exp[i].reg, exp[i].val);
+            return false;
+        }
+    }
+    return true;
+}
+
+static void _peer_ep(struct _sock_tl_ep *ep, uint16_t port)
+{
+    memset(ep, 0, sizeof(*ep));
+    ep->family = AF_INET;
+    memcpy(ep->addr.ipv4, peer, sizeof(peer));
+    ep->port = port;
+}
+
+static bool _is_peer(const struct _sock_tl_ep *ep, uint16_t port)
+{
+    return (ep->family == AF_INET) &&
+           (memcmp(ep->addr.ipv4, peer, sizeof(peer)) == 0) &&
+           (ep->port == port);
+}
+
+static void _inject_udp(void *arg)
+{
+    (void)arg;
+    w5100_mock_rx_udp(0, peer, PEER_PORT, payload, PAYLOAD_LEN);
+}
+
+static void _inject_accept(void *arg)
+{
+    (void)arg;
+    w5100_mock_accept(0, peer, PEER_PORT);
+}
+
+static void _inject_reset(void *arg)
+{
+    (void)arg;
+    w5100_mock_remote_reset(0);
+}
+
+static void *_reader(void *arg)
+{
+    reader_res = sock_tcp_read(arg, buf, sizeof(buf), SOCK_NO_TIMEOUT);
+    mutex_unlock(&reader_done);
+    return NULL;
+}
+
+static unsigned test_macraw(void)
+{
+    uint8_t hdrs[ETH_IPV4_UDP_HDRS] = { 0 };
+    const struct iovec vec[] = {
+        { .iov_base = hdrs, .iov_len = sizeof(hdrs) },
+        { .iov_base = payload, .iov_len = sizeof(payload) },
+    };
+
+    /* the same datagram sent through netdev, headers built by a host stack */
+    dev.nd.driver->init(&dev.nd);
+    w5100_mock_clear();
+    dev.nd.driver->send(&dev.nd, vec, 2);
+    _result("MACRAW send", (w5100_mock_sent.cmd == CR_SEND_MAC));
+    return w5100_mock_frames;
+}
+
+static bool test_init(void)
+{
+    static const uint8_t exp[] = { 192, 168, 0, 254, 255, 255, 255, 0 };
+
+    /* power cycle, the SPI check expects the memory size reset values */
+    w5100_mock_init(&dev);
+    bool ok = (w5100_sock_init(&dev, &ipconf) == 0) &&
+              (memcmp(&w5100_mock_mem[REG_GAR0], exp, sizeof(exp)) == 0) &&
+              (memcmp(&w5100_mock_mem[REG_SIPR0], ipconf.addr, 4) == 0) &&
+              (w5100_mock_mem[REG_RMSR] == MSR_2KB_EACH) &&
+              (w5100_mock_mem[REG_TMSR] == MSR_2KB_EACH) &&
+              (w5100_mock_mem[REG_IMR] == 0);
+    _result("init", ok);
+    return ok;
+}
+
+static void test_udp(sock_udp_t *sock, unsigned macraw)
+{
+    static const w5100_mock_write_t exp_open[] = {
+        W(0, SN_MR, MR_UDP), W(0, SN_PORT0, UDP_PORT >> 8),
+        W(0, SN_PORT1, UDP_PORT & 0xff), W(0, SN_CR, CR_OPEN),
+        W(0, SN_IR, 0xff),
+    };
+    static const w5100_mock_write_t exp_send[] = {
+        W(0, SN_DIPR0, 192), W(0, SN_DIPR0 + 1, 168), W(0, SN_DIPR0 + 2, 0),
+        W(0, SN_DIPR0 + 3, 2), W(0, SN_DPORT0, PEER_PORT >> 8),
+        W(0, SN_DPORT1, PEER_PORT & 0xff), W(0, SN_TX_WR0, 0),
+        W(0, SN_TX_WR1, PAYLOAD_LEN), W(0, SN_CR, CR_SEND),
+        W(0, SN_IR, IR_SEND_OK),
+    };
+    static const w5100_mock_write_t exp_recv[] = {
+        W(0, SN_RX_RD0, 0), W(0, SN_RX_RD1, PAYLOAD_LEN + 8),
+        W(0, SN_CR, CR_RECV),
+    };
+    sock_udp_ep_t local = SOCK_IPV4_EP_ANY;
+    sock_udp_ep_t remote;
+    uint32_t timeout = 0;
+    bool ok;
+
+    local.port = UDP_PORT;
+    w5100_mock_clear();
+    ok = (sock_udp_create(sock, &local, NULL, 0) == 0) &&
+         (sock_udp_get_local(sock, &local) == 0) &&
+         (local.port == UDP_PORT) &&
+         (memcmp(local.addr.ipv4, ipconf.addr, 4) == 0);
+    _result("UDP bind", ok && _log(exp_open, sizeof(exp_open) / sizeof(exp_open[0])));
+
+    _peer_ep(&remote, PEER_PORT);
+    w5100_mock_clear();
+    ok = (sock_udp_send(sock, payload, sizeof(payload), &remote) ==
+          sizeof(payload)) &&
+         (w5100_mock_sent.sn == 0) && (w5100_mock_sent.cmd == CR_SEND) &&
+         (memcmp(w5100_mock_sent.dst, peer, sizeof(peer)) == 0) &&
+         (w5100_mock_sent.port == PEER_PORT) &&
+         (w5100_mock_sent.len == sizeof(payload)) &&
+         (memcmp(w5100_mock_sent.data, payload, sizeof(payload)) == 0);
+    _result("UDP send", ok && _log(exp_send, sizeof(exp_send) / sizeof(exp_send[0])));
+    printf("SPI frames for %u byte UDP payload: %u (MACRAW: %u)\n",
+           (unsigned)PAYLOAD_LEN, w5100_mock_frames, macraw);
+
+    w5100_mock_rx_udp(0, peer, PEER_PORT, payload, PAYLOAD_LEN);
+    w5100_mock_clear();
+    memset(&remote, 0, sizeof(remote));
+    ok = (sock_udp_recv(sock, buf, sizeof(buf), 0, &remote) == PAYLOAD_LEN) &&
+         (memcmp(buf, payload, PAYLOAD_LEN) == 0) &&
+         _is_peer(&remote, PEER_PORT);
+    _result("UDP receive", ok && _log(exp_recv, sizeof(exp_recv) / sizeof(exp_recv[0])));
+
+    ok = (sock_udp_recv(sock, buf, sizeof(buf), 0, NULL) == -EAGAIN) &&
+         (sock_udp_recv(sock, buf, sizeof(buf), 10000, NULL) == -ETIMEDOUT) &&
+         (w5100_mock_mem[REG_IMR] == 0);
+    _result("UDP receive timeout", ok);
+
+    /* a receiving thread must not take the flag a sending one waits for */
+    w5100_mock_mem[SN_BASE(0) + SN_IR] = IR_SEND_OK;
+    ok = (sock_udp_recv(sock, buf, sizeof(buf), 0, NULL) == -EAGAIN) &&
+         (w5100_mock_mem[SN_BASE(0) + SN_IR] == 0) &&
+         (w5100_sock_wait(0, IR_SEND_OK, &timeout) == IR_SEND_OK) &&
+         (w5100_sock_wait(0, IR_SEND_OK, &timeout) == -EAGAIN);
+    _result("UDP receive leaves send flag", ok);
+
+    /* the datagram arrives while the thread waits for the interrupt */
+    timer.callback = _inject_udp;
+    xtimer_set(&timer, INJECT_DELAY);
+    ok = (sock_udp_recv(sock, buf, sizeof(buf), SOCK_NO_TIMEOUT, NULL) ==
+          PAYLOAD_LEN) && (w5100_mock_mem[REG_IMR] == 0);
+    _result("UDP receive wakes on interrupt", ok);
+}
+
+static void test_udp_errors(sock_udp_t *sock)
+{
+    sock_udp_t socks[W5100_SOCK_NUMOF];
+    sock_udp_ep_t local = SOCK_IPV4_EP_ANY;
+    sock_udp_ep_t remote;
+    unsigned n = 0;
+    bool ok;
+
+    w5100_mock_rx_udp(0, peer, PEER_PORT, payload, PAYLOAD_LEN);
+    ok = (sock_udp_recv(sock, buf, 16, 0, NULL) == -ENOBUFS) &&
+         (sock_udp_recv(sock, buf, sizeof(buf), 0, NULL) == -EAGAIN);
+    _result("UDP datagram too large is dropped", ok);
+
+    /* a connected sock only takes datagrams from its remote end point */
+    _peer_ep(&remote, PEER_PORT + 1);
+    local.port = UDP_PORT;
+    ok = (sock_udp_create(&socks[0], &local, &remote, 0) == -EADDRINUSE) &&
+         (sock_udp_create(&socks[0], &local, &remote,
+                          SOCK_FLAGS_REUSE_EP) == 0) &&
+         (socks[0].sn == 1);
+    w5100_mock_rx_udp(1, peer, PEER_PORT, payload, PAYLOAD_LEN);
+    ok = ok && (sock_udp_recv(&socks[0], buf, sizeof(buf), 0, NULL) == -EPROTO);
+    _result("UDP port reuse and remote filter", ok);
+
+    local.port = 0;
+    for (n = 1; n < W5100_SOCK_NUMOF; n++) {
+        if (sock_udp_create(&socks[n], &local, NULL, 0) < 0) {
+            break;
+        }
+    }
+    ok = (n == W5100_SOCK_NUMOF - 1) &&
+         (sock_udp_create(&socks[n], &local, NULL, 0) == -ENOMEM);
+    _result("UDP out of hardware sockets", ok);
+    while (n-- > 0) {
+        sock_udp_close(&socks[n]);
+    }
+
+    _peer_ep(&remote, PEER_PORT);
+    w5100_mock_send_fails = true;
+    ok = (sock_udp_send(sock, payload, sizeof(payload), &remote) ==
+          -EHOSTUNREACH);
+    w5100_mock_send_fails = false;
+    remote.family = AF_INET6;
+    ok = ok && (sock_udp_send(sock, payload, sizeof(payload), &remote) ==
+                -EAFNOSUPPORT);
+    _result("UDP send errors", ok);
+    sock_udp_close(sock);
+}
+
+static void test_tcp_connect(void)
+{
+    static const w5100_mock_write_t exp_close[] = {
+        W(0, SN_CR, CR_DISCON), W(0, SN_CR, CR_CLOSE), W(0, SN_IR, 0xff),
+    };
+    sock_tcp_t sock;
+    sock_tcp_ep_t remote, local;
+    bool ok;
+
+    _peer_ep(&remote, TCP_PORT);
+    w5100_mock_clear();
+    ok = (sock_tcp_connect(&sock, &remote, 0, 0) == 0) &&
+         (sock_tcp_get_local(&sock, &local) == 0);
+
+    const w5100_mock_write_t exp_conn[] = {
+        W(0, SN_MR, MR_TCP), W(0, SN_PORT0, local.port >> 8),
+        W(0, SN_PORT1, local.port & 0xff), W(0, SN_CR, CR_OPEN),
+        W(0, SN_IR, 0xff), W(0, SN_DIPR0, 192), W(0, SN_DIPR0 + 1, 168),
+        W(0, SN_DIPR0 + 2, 0), W(0, SN_DIPR0 + 3, 2),
+        W(0, SN_DPORT0, TCP_PORT >> 8), W(0, SN_DPORT1, TCP_PORT & 0xff),
+        W(0, SN_CR, CR_CONNECT),
+    };
+    _result("TCP connect", ok && (local.port >= 49152U) &&
+            _log(exp_conn, sizeof(exp_conn) / sizeof(exp_conn[0])));
+
+    /* the write pointer continues where the last user of the socket left it */
+    const uint16_t wr = ((w5100_mock_mem[SN_BASE(0) + SN_TX_WR0] << 8) |
+                         w5100_mock_mem[SN_BASE(0) + SN_TX_WR1]) + PAYLOAD_LEN;
+    const w5100_mock_write_t exp_send[] = {
+        W(0, SN_TX_WR0, wr >> 8), W(0, SN_TX_WR1, wr & 0xff),
+        W(0, SN_CR, CR_SEND), W(0, SN_IR, IR_CON | IR_SEND_OK),
+    };
+    w5100_mock_clear();
+    ok = (sock_tcp_write(&sock, payload, sizeof(payload)) == sizeof(payload)) &&
+         (w5100_mock_sent.len == sizeof(payload));
+    _result("TCP write", ok && _log(exp_send, sizeof(exp_send) / sizeof(exp_send[0])));
+
+    w5100_mock_rx_tcp(0, payload, 48);
+    w5100_mock_rx_tcp(0, &payload[48], 16);
+    ok = (sock_tcp_read(&sock, buf, 40, 0) == 40) &&
+         (sock_tcp_read(&sock, &buf[40], sizeof(buf), 0) == 24) &&
+         (memcmp(buf, payload, PAYLOAD_LEN) == 0) &&
+         (sock_tcp_read(&sock, buf, sizeof(buf), 0) == -EAGAIN);
+    _result("TCP read", ok);
+
+    w5100_mock_remote_close(0);
+    ok = (sock_tcp_read(&sock, buf, sizeof(buf), 0) == 0);
+    w5100_mock_clear();
+    sock_tcp_disconnect(&sock);
+    _result("TCP remote close and disconnect", ok &&
+            _log(exp_close, sizeof(exp_close) / sizeof(exp_close[0])));
+
+    /* a reset wakes both a reader and a writer waiting for the device */
+    ok = (sock_tcp_connect(&sock, &remote, 0, 0) == 0);
+    thread_create(reader_stack, sizeof(reader_stack),
+                  THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                  _reader, &sock, "reader");
+    w5100_mock_send_held = true;
+    timer.callback = _inject_reset;
+    xtimer_set(&timer, INJECT_DELAY);
+    ok = ok && (sock_tcp_write(&sock, payload, sizeof(payload)) == -ECONNRESET);
+    mutex_lock(&reader_done);
+    w5100_mock_send_held = false;
+    sock_tcp_disconnect(&sock);
+    _result("TCP reset with reader and writer", ok &&
+            (reader_res == -ECONNRESET));
+
+    w5100_mock_refuse = true;
+    ok = (sock_tcp_connect(&sock, &remote, 0, 0) == -ECONNREFUSED) &&
+         (w5100_mock_mem[SN_BASE(0) + SN_SR] == SR_CLOSED);
+    w5100_mock_refuse = false;
+    _result("TCP connection refused", ok);
+}
+
+static void test_tcp_listen(void)
+{
+    static const w5100_mock_write_t exp_listen[] = {
+        W(0, SN_MR, MR_TCP), W(0, SN_PORT0, 0), W(0, SN_PORT1, TCP_PORT),
+        W(0, SN_CR, CR_OPEN), W(0, SN_IR, 0xff), W(0, SN_CR, CR_LISTEN),
+    };
+    sock_tcp_queue_t queue;
+    sock_tcp_t queue_array[2];
+    sock_tcp_t *sock = NULL;
+    sock_tcp_ep_t local = SOCK_IPV4_EP_ANY;
+    sock_tcp_ep_t remote;
+    bool ok;
+
+    local.port = TCP_PORT;
+    w5100_mock_clear();
+    ok = (sock_tcp_listen(&queue, &local, queue_array, 2, 0) == 0) &&
+         (w5100_mock_mem[SN_BASE(0) + SN_SR] == SR_LISTEN);
+    _result("TCP listen", ok && _log(exp_listen, sizeof(exp_listen) / sizeof(exp_listen[0])));
+
+    timer.callback = _inject_accept;
+    xtimer_set(&timer, INJECT_DELAY);
+    ok = (sock_tcp_accept(&queue, &sock, 0) == -EAGAIN) &&
+         (sock_tcp_accept(&queue, &sock, SOCK_NO_TIMEOUT) == 0) &&
+         (sock == &queue_array[0]) && (sock->sn == 0) &&
+         (sock_tcp_get_remote(sock, &remote) == 0) &&
+         _is_peer(&remote, PEER_PORT) &&
+         /* the next connection is taken by another hardware socket */
+         (w5100_mock_mem[SN_BASE(1) + SN_SR] == SR_LISTEN) &&
+         (w5100_mock_mem[SN_BASE(1) + SN_PORT1] == TCP_PORT);
+    _result("TCP accept", ok);
+
+    w5100_mock_rx_tcp(0, payload, PAYLOAD_LEN);
+    ok = (sock_tcp_read(sock, buf, sizeof(buf), 0) == PAYLOAD_LEN) &&
+         (memcmp(buf, payload, PAYLOAD_LEN) == 0);
+    sock_tcp_stop_listen(&queue);
+    for (unsigned sn = 0; sn < W5100_SOCK_NUMOF; sn++) {
+        ok = ok && (w5100_mock_mem[SN_BASE(sn) + SN_SR] == SR_CLOSED);
+    }
+    _result("TCP read and stop listening", ok);
+}
+
+int main(void)
+{
+    sock_udp_t udp;
+    unsigned macraw;
+
+    puts("W5100 hardware socket test");
+
+    for (unsigned i = 0; i < sizeof(payload); i++) {
+        payload[i] = (uint8_t)i;
+    }
+    w5100_setup(&dev, &params);
+    w5100_mock_init(&dev);
+
+    macraw = test_macraw();
+    if (test_init()) {
+        test_udp(&udp, macraw);
+        test_udp_errors(&udp);
+        test_tcp_connect();
+        test_tcp_listen();
+    }
+
+    puts(ok_all ? "SUCCESS" : "FAILURE");
+    return 0;
+}
@@ -0,0 +1,390 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       SPI bus with an emulated W5100 device
+ *
+ * @}
+ */
+
+#include <string.h>
+
+#include "irq.h"
+#include "mutex.h"
+#include "periph/spi.h"
+
+#include "w5100_regs.h"
+#include "w5100_mock.h"
+
+#define SOCK_NUMOF          (4U)
+#define SOCK_REGS           (0x0400)
+#define SOCK_REGS_END       (0x0800)
+#define TX_MEM              (0x4000)
+#define RX_MEM              (0x6000)
+#define MR_MACRAW_STATE     (0x42)
+#define SN_TX_RD0           (0x22)
+
+uint8_t w5100_mock_mem[0x8000];
+w5100_mock_write_t w5100_mock_log[W5100_MOCK_LOG_SIZE];
+unsigned w5100_mock_log_len;
+unsigned w5100_mock_frames;
+w5100_mock_pkt_t w5100_mock_sent;
+bool w5100_mock_send_fails;
+bool w5100_mock_refuse;
+bool w5100_mock_send_held;
+
+static w5100_t *_dev;
+static mutex_t _bus = MUTEX_INIT;
+static uint8_t _frame[4];
+static unsigned _pos;
+static uint16_t _prev_rd[SOCK_NUMOF];
+static bool _level;
+static bool _edge;
+
+static inline uint8_t *_sreg(uint8_t sn, uint8_t off)
+{
+    return &w5100_mock_mem[SN_BASE(sn) + off];
+}
+
+static inline uint16_t _get16(uint8_t sn, uint8_t off)
+{
+    return (_sreg(sn, off)[0] << 8) | _sreg(sn, off)[1];
+}
+
+static inline void _set16(uint8_t sn, uint8_t off, uint16_t val)
+{
+    _sreg(sn, off)[0] = (uint8_t)(val >> 8);
+    _sreg(sn, off)[1] = (uint8_t)(val & 0xff);
+}
+
+/* memory of a socket as configured in RMSR or TMSR */
+static uint16_t _buf(uint8_t msr, uint8_t sn, uint16_t *size)
+{
+    uint16_t base = 0;
+
+    for (unsigned i = 0; i <= sn; i++) {
+        *size = 1024 << ((msr >> (2 * i)) & 0x03);
+        if (i < sn) {
+            base += *size;
+        }
+    }
+    return base;
+}
+
+static uint8_t *_tx(uint8_t sn, uint16_t ptr)
+{
+    uint16_t size;
+    uint16_t base = _buf(w5100_mock_mem[REG_TMSR], sn, &size);
+
+    return &w5100_mock_mem[TX_MEM + base + (ptr & (size - 1))];
+}
+
+static uint8_t *_rx(uint8_t sn, uint16_t ptr)
+{
+    uint16_t size;
+    uint16_t base = _buf(w5100_mock_mem[REG_RMSR], sn, &size);
+
+    return &w5100_mock_mem[RX_MEM + base + (ptr & (size - 1))];
+}
+
+static void _update_int(void)
+{
+    uint8_t ir = 0;
+
+    for (unsigned sn = 0; sn < SOCK_NUMOF; sn++) {
+        if (*_sreg(sn, SN_IR)) {
+            ir |= (1 << sn);
+        }
+    }
+    w5100_mock_mem[REG_IR] = ir;
+    bool level = (ir & w5100_mock_mem[REG_IMR]) != 0;
+    if (level && !_level) {
+        _edge = true;
+    }
+    _level = level;
+}
+
+/* signals the falling edge of the interrupt line outside the mock's critical
+ * sections */
+static void _signal(void)
+{
+    if (_edge) {
+        _edge = false;
+        if ((_dev != NULL) && (_dev->nd.event_callback != NULL)) {
+            _dev->nd.event_callback(&_dev->nd, NETDEV_EVENT_ISR);
+        }
+    }
+}
+
+static void _reset(void)
+{
+    memset(w5100_mock_mem, 0, sizeof(w5100_mock_mem));
+    memset(_prev_rd, 0, sizeof(_prev_rd));
+    w5100_mock_mem[REG_RMSR] = 0x55;
+    w5100_mock_mem[REG_TMSR] = 0x55;
+    _level = false;
+}
+
+static void _cmd(uint8_t sn, uint8_t cmd)
+{
+    uint8_t *sr = _sreg(sn, SN_SR);
+    uint8_t *ir = _sreg(sn, SN_IR);
+    uint16_t size;
+
+    switch (cmd) {
+        case CR_OPEN:
+            switch (*_sreg(sn, SN_MR) & 0x0f) {
+                case MR_UDP:
+                    *sr = SR_UDP;
+                    break;
+                case MR_TCP:
+                    *sr = SR_INIT;
+                    break;
+                case MR_MACRAW:
+                    *sr = MR_MACRAW_STATE;
+                    break;
+            }
+            _buf(w5100_mock_mem[REG_TMSR], sn, &size);
+            _set16(sn, SN_TX_FSR0, size);
+            _set16(sn, SN_RX_RSR0, 0);
+            _prev_rd[sn] = _get16(sn, SN_RX_RD0);
+            break;
+        case CR_LISTEN:
+            if (*sr == SR_INIT) {
+                *sr = SR_LISTEN;
+            }
+            break;
+        case CR_CONNECT:
+            if (w5100_mock_refuse) {
+                *sr = SR_CLOSED;
+                *ir |= IR_DISCON;
+            }
+            else {
+                *sr = SR_ESTABLISHED;
+                *ir |= IR_CON;
+            }
+            break;
+        case CR_DISCON:
+            *sr = SR_CLOSED;
+            *ir |= IR_DISCON;
+            break;
+        case CR_CLOSE:
+            *sr = SR_CLOSED;
+            break;
+        case CR_SEND:
+        case CR_SEND_MAC: {
+            uint16_t rd = _get16(sn, SN_TX_RD0);
+            uint16_t wr = _get16(sn, SN_TX_WR0);
+
+            w5100_mock_sent.sn = sn;
+            w5100_mock_sent.cmd = cmd;
+            memcpy(w5100_mock_sent.dst, _sreg(sn, SN_DIPR0), 4);
+            w5100_mock_sent.port = _get16(sn, SN_DPORT0);
+            w5100_mock_sent.len = wr - rd;
+            for (uint16_t i = 0; (i < w5100_mock_sent.len) &&
+                 (i < sizeof(w5100_mock_sent.data)); i++) {
+                w5100_mock_sent.data[i] = *_tx(sn, rd + i);
+            }
+            _set16(sn, SN_TX_RD0, wr);
+            if (w5100_mock_send_fails) {
+                *ir |= IR_TIMEOUT;
+                if (*sr == SR_ESTABLISHED) {
+                    *sr = SR_CLOSED;
+                }
+            }
+            else if (!w5100_mock_send_held) {
+                *ir |= IR_SEND_OK;
+            }
+            break;
+        }
+        case CR_RECV: {
+            uint16_t rd = _get16(sn, SN_RX_RD0);
+
+            _set16(sn, SN_RX_RSR0,
+                   _get16(sn, SN_RX_RSR0) - (uint16_t)(rd - _prev_rd[sn]));
+            _prev_rd[sn] = rd;
+            if (_get16(sn, SN_RX_RSR0) > 0) {
+                *ir |= IR_RECV;
+            }
+            break;
+        }
+    }
+    _update_int();
+}
+
+static void _write(uint16_t addr, uint8_t val)
+{
+    if ((addr >= SOCK_REGS) && (addr < SOCK_REGS_END)) {
+        uint8_t sn = (addr - SOCK_REGS) >> 8;
+        uint8_t off = addr & 0xff;
+
+        if (w5100_mock_log_len < W5100_MOCK_LOG_SIZE) {
+            w5100_mock_log[w5100_mock_log_len].reg = addr;
+            w5100_mock_log[w5100_mock_log_len++].val = val;
+        }
+        if (off == SN_IR) {
+            w5100_mock_mem[addr] &= ~val;
+            _update_int();
+        }
+        else if (off == SN_CR) {
+            _cmd(sn, val);
+        }
+        else {
+            w5100_mock_mem[addr] = val;
+        }
+    }
+    else if ((addr == REG_MODE) && (val & MODE_RESET)) {
+        _reset();
+    }
+    else if (addr < sizeof(w5100_mock_mem)) {
+        w5100_mock_mem[addr] = val;
+        if (addr == REG_IMR) {
+            _update_int();
+        }
+    }
+}
+
+void w5100_mock_init(w5100_t *dev)
+{
+    _dev = dev;
+    _reset();
+}
+
+void w5100_mock_clear(void)
+{
+    w5100_mock_log_len = 0;
+    w5100_mock_frames = 0;
+}
+
+void w5100_mock_rx_udp(uint8_t sn, const uint8_t *src, uint16_t port,
+                       const void *data, uint16_t len)
+{
+    unsigned state = irq_disable();
+    uint16_t pos = _get16(sn, SN_RX_RD0) + _get16(sn, SN_RX_RSR0);
+    const uint8_t hdr[] = { src[0], src[1], src[2], src[3],
+                            (uint8_t)(port >> 8), (uint8_t)port,
+                            (uint8_t)(len >> 8), (uint8_t)len };
+
+    for (unsigned i = 0; i < sizeof(hdr); i++) {
+        *_rx(sn, pos++) = hdr[i];
+    }
+    for (unsigned i = 0; i < len; i++) {
+        *_rx(sn, pos++) = ((const uint8_t *)data)[i];
+    }
+    _set16(sn, SN_RX_RSR0, _get16(sn, SN_RX_RSR0) + sizeof(hdr) + len);
+    *_sreg(sn, SN_IR) |= IR_RECV;
+    _update_int();
+    irq_restore(state);
+    _signal();
+}
+
+void w5100_mock_rx_tcp(uint8_t sn, const void *data, uint16_t len)
+{
+    unsigned state = irq_disable();
+    uint16_t pos = _get16(sn, SN_RX_RD0) + _get16(sn, SN_RX_RSR0);
+
+    for (unsigned i = 0; i < len; i++) {
+        *_rx(sn, pos++) = ((const uint8_t *)data)[i];
+    }
+    _set16(sn, SN_RX_RSR0, _get16(sn, SN_RX_RSR0) + len);
+    *_sreg(sn, SN_IR) |= IR_RECV;
+    _update_int();
+    irq_restore(state);
+    _signal();
+}
+
+void w5100_mock_accept(uint8_t sn, const uint8_t *src, uint16_t port)
+{
+    unsigned state = irq_disable();
+
+    memcpy(_sreg(sn, SN_DIPR0), src, 4);
+    _set16(sn, SN_DPORT0, port);
+    *_sreg(sn, SN_SR) = SR_ESTABLISHED;
+    *_sreg(sn, SN_IR) |= IR_CON;
+    _update_int();
+    irq_restore(state);
+    _signal();
+}
+
+void w5100_mock_remote_close(uint8_t sn)
+{
+    unsigned state = irq_disable();
+
+    *_sreg(sn, SN_SR) = SR_CLOSE_WAIT;
+    *_sreg(sn, SN_IR) |= IR_DISCON;
+    _update_int();
+    irq_restore(state);
+    _signal();
+}
+
+void w5100_mock_remote_reset(uint8_t sn)
+{
+    unsigned state = irq_disable();
+
+    *_sreg(sn, SN_SR) = SR_CLOSED;
+    *_sreg(sn, SN_IR) |= IR_DISCON;
+    _update_int();
+    irq_restore(state);
+    _signal();
+}
+
+int spi_init_cs(spi_t bus, spi_cs_t cs)
+{
+    (void)bus;
+    (void)cs;
+    return SPI_OK;
+}
+
+int spi_acquire(spi_t bus, spi_cs_t cs, spi_mode_t mode, spi_clk_t clk)
+{
+    (void)bus;
+    (void)cs;
+    (void)mode;
+    (void)clk;
+    mutex_lock(&_bus);
+    return SPI_OK;
+}
+
+void spi_release(spi_t bus)
+{
+    (void)bus;
+    mutex_unlock(&_bus);
+}
+
+uint8_t spi_transfer_byte(spi_t bus, spi_cs_t cs, bool cont, uint8_t out)
+{
+    unsigned state = irq_disable();
+    uint8_t in = 0;
+
+    (void)bus;
+    (void)cs;
+    if (_pos < sizeof(_frame)) {
+        _frame[_pos++] = out;
+    }
+    /* the device takes one frame of four bytes per chip select cycle:
+     * command, address (high byte first) and data */
+    if (!cont) {
+        uint16_t addr = (_frame[1] << 8) | _frame[2];
+
+        if ((_pos == sizeof(_frame)) && (_frame[0] == CMD_READ)) {
+            in = w5100_mock_mem[addr & (sizeof(w5100_mock_mem) - 1)];
+        }
+        else if ((_pos == sizeof(_frame)) && (_frame[0] == CMD_WRITE)) {
+            _write(addr, _frame[3]);
+        }
+        w5100_mock_frames++;
+        _pos = 0;
+    }
+    irq_restore(state);
+    _signal();
+    return in;
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       SPI bus with an emulated W5100 device
+ *
+ * Implements the SPI functions used by the W5100 driver. Every SPI frame is
+ * decoded and applied to the emulated register and buffer memory. Socket
+ * commands are executed at once.
+ */
+
+#ifndef W5100_MOCK_H
+#define W5100_MOCK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "w5100.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of register writes kept in the log
+ */
+#define W5100_MOCK_LOG_SIZE     (64U)
+
+/**
+ * @brief   Register write to the socket register block
+ */
+typedef struct {
+    uint16_t reg;           /**< register address */
+    uint8_t val;            /**< written value */
+} w5100_mock_write_t;
+
+/**
+ * @brief   Last packet sent by the emulated device
+ */
+typedef struct {
+    uint8_t sn;             /**< socket */
+    uint8_t cmd;            /**< CR_SEND or CR_SEND_MAC */
+    uint8_t dst[4];         /**< destination address */
+    uint16_t port;          /**< destination port */
+    uint16_t len;           /**< length of data */
+    uint8_t data[2048];     /**< payload */
+} w5100_mock_pkt_t;
+
+/**
+ * @brief   Emulated memory of the device
+ */
+extern uint8_t w5100_mock_mem[0x8000];
+
+/**
+ * @brief   Writes to the socket registers since w5100_mock_clear()
+ */
+extern w5100_mock_write_t w5100_mock_log[W5100_MOCK_LOG_SIZE];
+
+/**
+ * @brief   Number of entries in w5100_mock_log
+ */
+extern unsigned w5100_mock_log_len;
+
+/**
+ * @brief   Number of SPI frames since w5100_mock_clear()
+ */
+extern unsigned w5100_mock_frames;
+
+/**
+ * @brief   Last packet sent
+ */
+extern w5100_mock_pkt_t w5100_mock_sent;
+
+/**
+ * @brief   If set, sending fails with a timeout (e.g. ARP not answered)
+ */
+extern bool w5100_mock_send_fails;
+
+/**
+ * @brief   If set, TCP connection attempts are refused
+ */
+extern bool w5100_mock_refuse;
+
+/**
+ * @brief   If set, sent data is never acknowledged (no IR_SEND_OK)
+ */
+extern bool w5100_mock_send_held;
+
+/**
+ * @brief   Connects the emulated device to a device descriptor
+ *
+ * The interrupts of the device are signaled to the event callback of @p dev.
+ */
+void w5100_mock_init(w5100_t *dev);
+
+/**
+ * @brief   Clears the register write log and the frame counter
+ */
+void w5100_mock_clear(void);
+
+/**
+ * @brief   Lets a socket receive an UDP datagram
+ */
+void w5100_mock_rx_udp(uint8_t sn, const uint8_t *src, uint16_t port,
+                       const void *data, uint16_t len);
+
+/**
+ * @brief   Lets a socket receive TCP data
+ */
+void w5100_mock_rx_tcp(uint8_t sn, const void *data, uint16_t len);
+
+/**
+ * @brief   Connects a peer to a listening socket
+ */
+void w5100_mock_accept(uint8_t sn, const uint8_t *src, uint16_t port);
+
+/**
+ * @brief   Lets the peer of a socket close the connection
+ */
+void w5100_mock_remote_close(uint8_t sn);
+
+/**
+ * @brief   Lets the peer of a socket reset the connection
+ */
+void w5100_mock_remote_reset(uint8_t sn);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* W5100_MOCK_H */
+/** @} */
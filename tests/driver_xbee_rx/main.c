@@ -0,0 +1,269 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the receive path of the XBee driver
+ *
+ * Replays a byte stream as an XBee S1 in API mode sends it over the UART and
+ * checks the packets the driver hands out.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "xbee.h"
+#include "xtimer.h"
+
+#ifndef TEST_FRAMES
+#define TEST_FRAMES         (128U)
+#endif
+
+/**
+ * @brief   Frame with a broken checksum, must not be handed out
+ */
+#define CORRUPT_SEQ         (42U)
+
+#define MSG_TYPE_ISR        (0x5842)
+#define MSG_QUEUE_SIZE      (8U)
+#define TICK_US             (1000U)
+#define IDLE_TIMEOUT_US     (100U * 1000U)
+#define STREAM_SIZE         (TEST_FRAMES * (XBEE_MAX_PKT_LENGTH + 4) + 64)
+
+static const xbee_params_t params = {
+    .uart = UART_DEV(0),
+    .br = 115200U,
+    .pin_sleep = GPIO_UNDEF,
+    .pin_reset = GPIO_UNDEF,
+};
+
+/* what an XBee sends after a hardware reset: modem status frame */
+static const uint8_t modem_status[] = { 0x7e, 0x00, 0x02, 0x8a, 0x00, 0x75 };
+/* noise on the line before the modem is in API mode */
+static const uint8_t noise[] = { 'O', 'K', '\r' };
+
+static xbee_t dev;
+static msg_t msg_queue[MSG_QUEUE_SIZE];
+static kernel_pid_t main_pid;
+
+static uint8_t stream[STREAM_SIZE];
+static size_t stream_len;
+static volatile size_t stream_pos;
+static size_t bytes_per_tick;
+static xtimer_t feed_timer;
+
+static unsigned received, errors;
+static int last_seq;
+
+static unsigned _payload_len(unsigned seq)
+{
+    return 1 + ((seq * 7) % XBEE_MAX_PAYLOAD_LENGTH);
+}
+
+static void _add(const uint8_t *data, size_t len)
+{
+    memcpy(&stream[stream_len], data, len);
+    stream_len += len;
+}
+
+static void _add_frame(uint8_t type, const uint8_t *data, size_t len, bool corrupt)
+{
+    uint8_t *frame = &stream[stream_len];
+    uint8_t cksum = 0xff - type;
+
+    frame[0] = 0x7e;
+    frame[1] = (uint8_t)((len + 1) >> 8);
+    frame[2] = (uint8_t)(len + 1);
+    frame[3] = type;
+    for (size_t i = 0; i < len; i++) {
+        frame[4 + i] = data[i];
+        cksum -= data[i];
+    }
+    frame[4 + len] = corrupt ? (cksum ^ 0x55) : cksum;
+    stream_len += len + 5;
+}
+
+static void _build_stream(void)
+{
+    static const uint8_t at_resp[] = { 0x01, 'C', 'H', 0x00, 0x1a };
+    uint8_t data[XBEE_MAX_PKT_LENGTH];
+
+    stream_len = 0;
+    _add(noise, sizeof(noise));
+    _add(modem_status, sizeof(modem_status));
+    for (unsigned seq = 0; seq < TEST_FRAMES; seq++) {
+        /* alternate between 16-bit (0x81) and 64-bit (0x80) source address */
+        uint8_t type = (seq & 1) ? 0x80 : 0x81;
+        size_t alen = (seq & 1) ? 8 : 2;
+        size_t len = _payload_len(seq);
+
+        memset(data, 0x11, alen);               /* source address */
+        data[alen] = 0x28;                      /* RSSI */
+        data[alen + 1] = 0x00;                  /* options */
+        for (size_t i = 0; i < len; i++) {
+            /* contains start delimiters, the frames are not escaped */
+            data[alen + 2 + i] = (uint8_t)(seq + i);
+        }
+        _add_frame(type, data, alen + 2 + len, seq == CORRUPT_SEQ);
+        if ((seq % 16) == 15) {
+            _add_frame(0x88, at_resp, sizeof(at_resp), false);
+        }
+    }
+}
+
+static void _feed(void *arg)
+{
+    (void)arg;
+    size_t end = stream_pos + bytes_per_tick;
+
+    if (end > stream_len) {
+        end = stream_len;
+    }
+    while (stream_pos < end) {
+        xbee_rx_cb(&dev, stream[stream_pos++]);
+    }
+    if (stream_pos < stream_len) {
+        xtimer_set(&feed_timer, TICK_US);
+    }
+}
+
+static void _recv(void)
+{
+    uint8_t buf[XBEE_MAX_PKT_LENGTH];
+    xbee_l2hdr_t l2hdr;
+    int len = xbee_driver.recv((netdev_t *)&dev, NULL, 0, NULL);
+    int hdr;
+
+    if ((len <= 0) || (xbee_driver.recv((netdev_t *)&dev, buf, sizeof(buf),
+                                         NULL) != len)) {
+        errors++;
+        return;
+    }
+    if ((hdr = xbee_parse_hdr(&dev, buf, &l2hdr)) < 0) {
+        errors++;
+        return;
+    }
+
+    uint8_t *payload = &buf[hdr];
+    unsigned seq = payload[0];
+    size_t plen = len - hdr;
+
+    /* sequence numbers wrap at 256, TEST_FRAMES is smaller */
+    if (((int)seq <= last_seq) || (plen != _payload_len(seq)) ||
+        (seq == CORRUPT_SEQ) || (l2hdr.addr_len != ((seq & 1) ? 8 : 2))) {
+        errors++;
+    }
+    for (size_t i = 0; i < plen; i++) {
+        if (payload[i] != (uint8_t)(seq + i)) {
+            errors++;
+            break;
+        }
+    }
+    last_seq = seq;
+    received++;
+}
+
+static void _event_cb(netdev_t *netdev, netdev_event_t event)
+{
+    (void)netdev;
+
+    if (event == NETDEV_EVENT_ISR) {
+        msg_t msg = { .type = MSG_TYPE_ISR };
+
+        if (msg_send(&msg, main_pid) <= 0) {
+            puts("lost ISR event");
+        }
+    }
+    else if (event == NETDEV_EVENT_RX_COMPLETE) {
+        _recv();
+    }
+}
+
+static bool _run(const char *name, size_t per_tick, bool strict)
+{
+    msg_t msg;
+    uint32_t start, stop;
+
+    xbee_setup(&dev, &params);
+    dev.event_callback = _event_cb;
+    received = 0;
+    errors = 0;
+    last_seq = -1;
+    stream_pos = 0;
+    bytes_per_tick = per_tick;
+
+    start = xtimer_now_usec();
+    stop = start;
+    _feed(NULL);
+    while (1) {
+        if (xtimer_msg_receive_timeout(&msg, IDLE_TIMEOUT_US) < 0) {
+            if (stream_pos == stream_len) {
+                break;
+            }
+            continue;
+        }
+        if (msg.type == MSG_TYPE_ISR) {
+            xbee_driver.isr((netdev_t *)&dev);
+            stop = xtimer_now_usec();
+        }
+    }
+
+    printf("%s: %u of %u packets in %lu ms, %u errors\n", name, received,
+           (unsigned)(TEST_FRAMES - 1), (unsigned long)((stop - start) / 1000),
+           errors);
+    printf("  driver: frames %lu dropped %lu cksum %lu overrun %lu\n",
+           (unsigned long)dev.rx_stats.frames,
+           (unsigned long)dev.rx_stats.dropped,
+           (unsigned long)dev.rx_stats.cksum,
+           (unsigned long)dev.rx_stats.overrun);
+
+    if (errors != 0) {
+        return false;
+    }
+    if (strict) {
+        /* every packet but the corrupted one, including the AT responses'
+         * checksum, nothing lost */
+        return (received == (TEST_FRAMES - 1)) &&
+               (dev.rx_stats.frames == (TEST_FRAMES - 1)) &&
+               (dev.rx_stats.cksum == 1) && (dev.rx_stats.dropped == 0) &&
+               (dev.rx_stats.overrun == 0);
+    }
+    /* bytes are lost, but whatever is handed out must be intact */
+    return (received == dev.rx_stats.frames) && (received > 0);
+}
+
+int main(void)
+{
+    bool ok = true;
+
+    msg_init_queue(msg_queue, MSG_QUEUE_SIZE);
+    main_pid = thread_getpid();
+    feed_timer.callback = _feed;
+
+    puts("XBee receive path test");
+    _build_stream();
+    printf("replaying %u byte, %u frames\n", (unsigned)stream_len,
+           (unsigned)TEST_FRAMES);
+
+    /* one tick of UART data at 115200 baud */
+    ok = _run("115200 baud", params.br / 10 / (US_PER_SEC / TICK_US), true) && ok;
+    /* a ring buffer full of data at once */
+    ok = _run("burst", XBEE_RX_BUF_SIZE, true) && ok;
+    /* the whole stream at once, the ring buffer overflows */
+    ok = _run("overrun", stream_len, false) && ok;
+
+    puts(ok ? "SUCCESS" : "FAILURE");
+    return 0;
+}
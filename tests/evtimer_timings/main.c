@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the cost of evtimer operations
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "evtimer.h"
+#include "mutex.h"
+#include "xtimer.h"
+
+#ifndef EVENTS_MAX
+#define EVENTS_MAX      (100U)
+#endif
+
+#define FIRE_OFFSET     (100U)      /* in ms */
+
+static evtimer_t evtimer;
+static evtimer_event_t events[EVENTS_MAX];
+static mutex_t fired_all = MUTEX_INIT_LOCKED;
+static unsigned fire_count;
+static unsigned fire_numof;
+static uint32_t fire_first;
+static uint32_t fire_last;
+
+static void _cb(evtimer_event_t *event)
+{
+    (void)event;
+    uint32_t now = xtimer_now_usec();
+
+    if (fire_count++ == 0) {
+        fire_first = now;
+    }
+    if (fire_count == fire_numof) {
+        fire_last = now;
+        mutex_unlock(&fired_all);
+    }
+}
+
+static uint32_t _rand(void)
+{
+    static uint32_t state = 42;
+
+    /* xorshift32, good enough to shuffle offsets */
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static void _print(const char *op, unsigned numof, uint32_t elapsed)
+{
+    printf("%6u events: %-4s %8lu ns/event\n", numof, op,
+           (unsigned long)(((uint64_t)elapsed * 1000) / numof));
+}
+
+static void _run(unsigned numof)
+{
+    uint32_t start;
+
+    /* add events far in the future */
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < numof; i++) {
+        events[i].offset = 1000000 + (_rand() % 1000000);
+        evtimer_add(&evtimer, &events[i]);
+    }
+    _print("add", numof, xtimer_now_usec() - start);
+
+    /* delete them in a different order, 7919 is prime */
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < numof; i++) {
+        evtimer_del(&evtimer, &events[(i * 7919U) % numof]);
+    }
+    _print("del", numof, xtimer_now_usec() - start);
+
+    /* let all events fire at once */
+    fire_count = 0;
+    fire_numof = numof;
+    for (unsigned i = 0; i < numof; i++) {
+        events[i].offset = FIRE_OFFSET;
+        evtimer_add(&evtimer, &events[i]);
+    }
+    mutex_lock(&fired_all);
+    _print("fire", numof, fire_last - fire_first);
+}
+
+int main(void)
+{
+#ifdef MODULE_EVTIMER_HEAP
+    puts("evtimer timings test (heap)");
+#else
+    puts("evtimer timings test (list)");
+#endif
+
+    evtimer_init(&evtimer, _cb);
+
+    for (unsigned numof = 10; numof <= EVENTS_MAX; numof *= 10) {
+        _run(numof);
+    }
+
+    puts("Done.");
+    return 0;
+}
@@ -0,0 +1,226 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Functional and throughput test for the GNRC IPv4 layer
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "msg.h"
+#include "shell.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv4.h"
+#include "net/icmp.h"
+#include "xtimer.h"
+
+#define MAIN_QUEUE_SIZE     (8)
+#define PING_TIMEOUT        (1U * US_PER_SEC)
+#define PING_ID             (0x4711)
+
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+
+extern int udp_cmd(int argc, char **argv);
+
+static char *_parse_prefix(char *str, uint8_t *prefix_len)
+{
+    char *slash = strchr(str, '/');
+
+    if (slash == NULL) {
+        return NULL;
+    }
+    *slash = '\0';
+    *prefix_len = atoi(slash + 1);
+    return str;
+}
+
+static void _print_netifs(void)
+{
+    char addr_str[IPV4_ADDR_MAX_STR_LEN];
+
+    for (gnrc_ipv4_netif_t *netif = gnrc_ipv4_netif_get_next(NULL);
+         netif != NULL; netif = gnrc_ipv4_netif_get_next(netif)) {
+        printf("Iface %" PRIkernel_pid ": %s/%u", netif->pid,
+               ipv4_addr_to_str(addr_str, &netif->addr, sizeof(addr_str)),
+               netif->prefix_len);
+        printf(" bcast %s\n",
+               ipv4_addr_to_str(addr_str, &netif->bcast, sizeof(addr_str)));
+    }
+}
+
+static void _print_arp(void)
+{
+    static const char *states[] = { "", "INCOMPLETE", "REACHABLE", "STATIC" };
+    char addr_str[IPV4_ADDR_MAX_STR_LEN];
+
+    for (unsigned i = 0; i < GNRC_IPV4_ARP_CACHE_SIZE; i++) {
+        const gnrc_ipv4_arp_t *entry = gnrc_ipv4_arp_get(i);
+
+        if (entry->state == GNRC_IPV4_ARP_STATE_EMPTY) {
+            continue;
+        }
+        printf("%s dev #%" PRIkernel_pid " lladdr "
+               "%02x:%02x:%02x:%02x:%02x:%02x %s\n",
+               ipv4_addr_to_str(addr_str, &entry->addr, sizeof(addr_str)),
+               entry->iface, entry->l2addr[0], entry->l2addr[1],
+               entry->l2addr[2], entry->l2addr[3], entry->l2addr[4],
+               entry->l2addr[5], states[entry->state]);
+    }
+}
+
+static int _ip_cmd(int argc, char **argv)
+{
+    ipv4_addr_t addr, next_hop;
+    uint8_t prefix_len;
+
+    if (argc < 2) {
+        _print_netifs();
+        return 0;
+    }
+    if ((strcmp(argv[1], "addr") == 0) && (argc > 3)) {
+        int res;
+
+        if ((_parse_prefix(argv[3], &prefix_len) == NULL) ||
+            (ipv4_addr_from_str(&addr, argv[3]) == NULL)) {
+            puts("error: unable to parse address");
+            return 1;
+        }
+        res = gnrc_ipv4_netif_add_addr(atoi(argv[2]), &addr, prefix_len);
+        if (res < 0) {
+            printf("error: unable to add address (%d)\n", res);
+            return 1;
+        }
+        puts("success: added address");
+    }
+    else if ((strcmp(argv[1], "route") == 0) && (argc > 4)) {
+        /* 0.0.0.0/0 is the default route */
+        if ((_parse_prefix(argv[2], &prefix_len) == NULL) ||
+            (ipv4_addr_from_str(&addr, argv[2]) == NULL) ||
+            (ipv4_addr_from_str(&next_hop, argv[3]) == NULL)) {
+            puts("error: unable to parse address");
+            return 1;
+        }
+        if (fib_add_entry(&gnrc_ipv4_fib_table, atoi(argv[4]), addr.u8,
+                          sizeof(addr),
+                          ((uint32_t)prefix_len << FIB_FLAG_NET_PREFIX_SHIFT),
+                          next_hop.u8, sizeof(next_hop), 0,
+                          (uint32_t)FIB_LIFETIME_NO_EXPIRE) < 0) {
+            puts("error: unable to add route");
+            return 1;
+        }
+        puts("success: added route");
+    }
+    else if (strcmp(argv[1], "routes") == 0) {
+        fib_print_routes(&gnrc_ipv4_fib_table);
+    }
+    else if (strcmp(argv[1], "arp") == 0) {
+        _print_arp();
+    }
+    else {
+        printf("usage: %s [addr <iface> <addr>/<len>|"
+               "route <prefix>/<len> <next hop> <iface>|routes|arp]\n", argv[0]);
+        return 1;
+    }
+    return 0;
+}
+
+static int _ping_cmd(int argc, char **argv)
+{
+    gnrc_netreg_entry_t entry = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                           sched_active_pid);
+    ipv4_addr_t dst;
+    unsigned count = 3, received = 0;
+    size_t data_len = 56;
+
+    if ((argc < 2) || (ipv4_addr_from_str(&dst, argv[1]) == NULL)) {
+        printf("usage: %s <addr> [<count> [<bytes>]]\n", argv[0]);
+        return 1;
+    }
+    if (argc > 2) {
+        count = atoi(argv[2]);
+    }
+    if (argc > 3) {
+        data_len = atoi(argv[3]);
+    }
+    gnrc_netreg_register(GNRC_NETTYPE_ICMP, &entry);
+    for (unsigned seq = 0; seq < count; seq++) {
+        gnrc_pktsnip_t *pkt, *ip;
+        uint32_t start = xtimer_now_usec();
+        msg_t msg;
+
+        pkt = gnrc_ipv4_icmp_echo_build(ICMP_ECHO_REQ, PING_ID, seq, NULL,
+                                        data_len);
+        if (pkt == NULL) {
+            puts("error: packet buffer full");
+            break;
+        }
+        memset(((icmp_echo_t *)pkt->data) + 1, seq, data_len);
+        if ((ip = gnrc_ipv4_hdr_build(pkt, NULL, &dst)) == NULL) {
+            puts("error: packet buffer full");
+            gnrc_pktbuf_release(pkt);
+            break;
+        }
+        if (!gnrc_netapi_dispatch_send(GNRC_NETTYPE_IPV4,
+                                       GNRC_NETREG_DEMUX_CTX_ALL, ip)) {
+            puts("error: IPv4 thread not running");
+            gnrc_pktbuf_release(ip);
+            break;
+        }
+        while (xtimer_msg_receive_timeout(&msg, PING_TIMEOUT) >= 0) {
+            gnrc_pktsnip_t *reply = msg.content.ptr;
+            icmp_echo_t *echo;
+
+            if (msg.type != GNRC_NETAPI_MSG_TYPE_RCV) {
+                continue;
+            }
+            echo = reply->data;
+            if ((reply->size >= sizeof(icmp_echo_t)) &&
+                (echo->type == ICMP_ECHO_REP) &&
+                (byteorder_ntohs(echo->id) == PING_ID) &&
+                (byteorder_ntohs(echo->sn) == seq)) {
+                printf("%u bytes from %s: icmp_seq=%u time=%" PRIu32 " us\n",
+                       (unsigned)(reply->size - sizeof(icmp_echo_t)), argv[1],
+                       seq, xtimer_now_usec() - start);
+                received++;
+                gnrc_pktbuf_release(reply);
+                break;
+            }
+            gnrc_pktbuf_release(reply);
+        }
+    }
+    gnrc_netreg_unregister(GNRC_NETTYPE_ICMP, &entry);
+    printf("%u packets transmitted, %u received\n", count, received);
+    return (received == count) ? 0 : 1;
+}
+
+static const shell_command_t shell_commands[] = {
+    { "ip4", "configure IPv4 addresses and routes", _ip_cmd },
+    { "ping4", "send ICMP echo requests", _ping_cmd },
+    { "udp", "send UDP datagrams and measure received throughput", udp_cmd },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+    shell_run(shell_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+
+    /* should be never reached */
+    return 0;
+}
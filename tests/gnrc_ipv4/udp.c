@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "net/ipv4/addr.h"
+#include "net/sock/udp.h"
+#include "thread.h"
+#include "timex.h"
+#include "xtimer.h"
+
+#define SERVER_PRIO             (THREAD_PRIORITY_MAIN - 1)
+#define SERVER_STACKSIZE        (THREAD_STACKSIZE_MAIN)
+#define SERVER_BUFFER_SIZE      (1472U)
+
+static char server_stack[SERVER_STACKSIZE];
+static uint8_t server_buffer[SERVER_BUFFER_SIZE];
+static uint8_t send_buffer[SERVER_BUFFER_SIZE];
+static sock_udp_t server_sock;
+static kernel_pid_t server_pid = KERNEL_PID_UNDEF;
+
+/* written by the server thread only, read by the shell for statistics */
+static volatile uint32_t rcv_count, rcv_bytes, rcv_first, rcv_last;
+
+static void _print_rate(const char *what, uint32_t count, uint32_t bytes,
+                        uint32_t usec)
+{
+    uint32_t kbps = (usec > 0) ? (uint32_t)(((uint64_t)bytes * 8000) / usec) : 0;
+
+    printf("%s %" PRIu32 " datagrams (%" PRIu32 " bytes) in %" PRIu32
+           " us: %" PRIu32 " kbit/s\n", what, count, bytes, usec, kbps);
+}
+
+static void *_eventloop(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        ssize_t res = sock_udp_recv(&server_sock, server_buffer,
+                                    sizeof(server_buffer), SOCK_NO_TIMEOUT,
+                                    NULL);
+
+        if (res < 0) {
+            continue;
+        }
+        rcv_last = xtimer_now_usec();
+        if (rcv_count++ == 0) {
+            rcv_first = rcv_last;
+        }
+        rcv_bytes += res;
+    }
+
+    /* never reached */
+    return NULL;
+}
+
+static void send(char *addr_str, char *port_str, char *data_len_str,
+                 unsigned int num, unsigned int delay)
+{
+    sock_udp_ep_t remote = SOCK_IPV4_EP_ANY;
+    size_t data_len;
+    uint32_t start, sent = 0;
+
+    /* parse destination address */
+    if (ipv4_addr_from_str((ipv4_addr_t *)&remote.addr.ipv4, addr_str) == NULL) {
+        puts("Error: unable to parse destination address");
+        return;
+    }
+    /* parse port */
+    remote.port = atoi(port_str);
+    if (remote.port == 0) {
+        puts("Error: unable to parse destination port");
+        return;
+    }
+
+    data_len = atoi(data_len_str);
+    if ((data_len == 0) || (data_len > sizeof(send_buffer))) {
+        printf("Error: data_len must be between 1 and %u\n",
+               (unsigned)sizeof(send_buffer));
+        return;
+    }
+
+    start = xtimer_now_usec();
+    for (unsigned int i = 0; i < num; i++) {
+        ssize_t res;
+
+        memset(send_buffer, i, data_len);
+        if ((res = sock_udp_send(NULL, send_buffer, data_len, &remote)) < 0) {
+            printf("Error: unable to send datagram (%d)\n", (int)res);
+            break;
+        }
+        sent++;
+        if (delay > 0) {
+            xtimer_usleep(delay);
+        }
+    }
+    _print_rate("Sent", sent, sent * data_len, xtimer_now_usec() - start);
+}
+
+static void start_server(char *port_str)
+{
+    sock_udp_ep_t local = SOCK_IPV4_EP_ANY;
+
+    /* check if server is already running */
+    if (server_pid != KERNEL_PID_UNDEF) {
+        printf("Error: server already running on port %" PRIu16 "\n",
+               server_sock.local.port);
+        return;
+    }
+    /* parse port */
+    local.port = atoi(port_str);
+    if (local.port == 0) {
+        puts("Error: invalid port specified");
+        return;
+    }
+    if (sock_udp_create(&server_sock, &local, NULL, 0) < 0) {
+        puts("Error: unable to create sock");
+        return;
+    }
+    server_pid = thread_create(server_stack, sizeof(server_stack), SERVER_PRIO,
+                               THREAD_CREATE_STACKTEST, _eventloop, NULL,
+                               "UDP server");
+    if (server_pid <= KERNEL_PID_UNDEF) {
+        puts("Error: can not start server thread");
+        sock_udp_close(&server_sock);
+        server_pid = KERNEL_PID_UNDEF;
+        return;
+    }
+    printf("Success: started UDP server on port %" PRIu16 "\n", local.port);
+}
+
+int udp_cmd(int argc, char **argv)
+{
+    if (argc < 2) {
+        printf("usage: %s [send|server|stats|reset]\n", argv[0]);
+        return 1;
+    }
+
+    if (strcmp(argv[1], "send") == 0) {
+        uint32_t num = 1;
+        uint32_t delay = 0;
+        if (argc < 5) {
+            printf("usage: %s send <addr> <port> <bytes> [<num> [<delay in us>]]\n",
+                   argv[0]);
+            return 1;
+        }
+        if (argc > 5) {
+            num = atoi(argv[5]);
+        }
+        if (argc > 6) {
+            delay = atoi(argv[6]);
+        }
+        send(argv[2], argv[3], argv[4], num, delay);
+    }
+    else if (strcmp(argv[1], "server") == 0) {
+        if (argc < 3) {
+            printf("usage: %s server <port>\n", argv[0]);
+            return 1;
+        }
+        start_server(argv[2]);
+    }
+    else if (strcmp(argv[1], "stats") == 0) {
+        _print_rate("Received", rcv_count, rcv_bytes,
+                    (rcv_count > 1) ? (rcv_last - rcv_first) : 0);
+    }
+    else if (strcmp(argv[1], "reset") == 0) {
+        rcv_count = 0;
+        rcv_bytes = 0;
+    }
+    else {
+        puts("error: invalid command");
+    }
+    return 0;
+}
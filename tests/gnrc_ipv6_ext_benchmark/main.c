@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Per packet cost of IPv6 extension header processing
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "board.h"
+#include "periph_conf.h"
+#include "net/gnrc/ipv6/ext.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/protnum.h"
+#include "xtimer.h"
+
+#ifndef TEST_PACKETS
+#define TEST_PACKETS        (10000U)
+#endif
+
+static uint8_t payload[] = {
+    /* Hop-by-Hop Options Header with RPL option */
+    PROTNUM_IPV6_EXT_DST, 0x00,
+    0x63, 0x04, 0x80, 0x00, 0x80, 0x00,
+    /* Destination Options Header with PadN */
+    PROTNUM_UDP, 0x00,
+    0x01, 0x04, 0x00, 0x00, 0x00, 0x00,
+    /* UDP and data */
+    0x1f, 0x90, 0x1f, 0x90, 0x00, 0x10, 0xff, 0xff,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+};
+
+static void _print(const char *name, uint32_t usec)
+{
+    uint64_t ns = ((uint64_t)usec * 1000) / TEST_PACKETS;
+
+#ifdef CLOCK_CORECLOCK
+    printf("%s %6lu ns/packet, %6lu cycles/packet\n", name, (unsigned long)ns,
+           (unsigned long)((ns * (CLOCK_CORECLOCK / 1000)) / 1000000));
+#else
+    printf("%s %6lu ns/packet\n", name, (unsigned long)ns);
+#endif
+}
+
+static gnrc_pktsnip_t *_pkt(void)
+{
+    gnrc_pktsnip_t *ipv6 = gnrc_pktbuf_add(NULL, NULL, sizeof(ipv6_hdr_t),
+                                           GNRC_NETTYPE_IPV6);
+
+    if (ipv6 == NULL) {
+        return NULL;
+    }
+    return gnrc_pktbuf_add(ipv6, payload, sizeof(payload), GNRC_NETTYPE_UNDEF);
+}
+
+/* what gnrc_ipv6_ext_demux() used to do for every extension header */
+static gnrc_pktsnip_t *_per_header(gnrc_pktsnip_t *pkt, uint8_t *nh)
+{
+    while ((*nh == PROTNUM_IPV6_EXT_HOPOPT) || (*nh == PROTNUM_IPV6_EXT_DST)) {
+        ipv6_ext_t *ext = pkt->data;
+
+        if ((pkt = gnrc_pktbuf_start_write(pkt)) == NULL) {
+            return NULL;
+        }
+        *nh = ext->nh;
+        if (gnrc_pktbuf_mark(pkt, (ext->len * IPV6_EXT_LEN_UNIT) +
+                             IPV6_EXT_LEN_UNIT, GNRC_NETTYPE_IPV6_EXT) == NULL) {
+            gnrc_pktbuf_release(pkt);
+            return NULL;
+        }
+        /* reference taken and given back by the dispatch */
+        gnrc_pktbuf_hold(pkt, 1);
+        gnrc_pktbuf_release(pkt);
+    }
+    return pkt;
+}
+
+static gnrc_pktsnip_t *_walk(gnrc_pktsnip_t *pkt, uint8_t *nh)
+{
+    gnrc_ipv6_ext_walk_t walk;
+
+    if ((gnrc_ipv6_ext_walk(&walk, pkt, *nh) < 0) ||
+        ((pkt = gnrc_pktbuf_start_write(pkt)) == NULL)) {
+        return NULL;
+    }
+    if (gnrc_pktbuf_mark(pkt, walk.len, GNRC_NETTYPE_IPV6_EXT) == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    *nh = walk.nh;
+    return pkt;
+}
+
+static uint32_t _run(gnrc_pktsnip_t *(*process)(gnrc_pktsnip_t *, uint8_t *))
+{
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned i = 0; i < TEST_PACKETS; i++) {
+        gnrc_pktsnip_t *pkt = _pkt();
+        uint8_t nh = PROTNUM_IPV6_EXT_HOPOPT;
+
+        if ((pkt == NULL) || ((pkt = process(pkt, &nh)) == NULL) ||
+            (nh != PROTNUM_UDP)) {
+            puts("error processing packet");
+            return 0;
+        }
+        gnrc_pktbuf_release(pkt);
+    }
+    return xtimer_now_usec() - start;
+}
+
+int main(void)
+{
+    puts("IPv6 extension header processing benchmark");
+    printf("%u packets\n", TEST_PACKETS);
+
+    _print("snip per header:", _run(_per_header));
+    _print("walk:           ", _run(_walk));
+    puts("done");
+
+    return 0;
+}
@@ -0,0 +1,546 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Receive path benchmark of GNRC using netdev_test devices
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "board.h"
+#include "periph_conf.h"
+#include "msg.h"
+#include "net/ethernet.h"
+#include "net/ethertype.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6/netif.h"
+#include "net/gnrc/netdev/eth.h"
+#include "net/gnrc/netdev/ieee802154.h"
+#include "net/ieee802154.h"
+#include "net/inet_csum.h"
+#include "net/ipv6/hdr.h"
+#include "net/netdev_test.h"
+#include "net/protnum.h"
+#include "net/sixlowpan.h"
+#include "net/udp.h"
+#include "shell.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define BENCH_MAC_STACKSIZE (THREAD_STACKSIZE_DEFAULT)
+#define BENCH_MAC_PRIO      (THREAD_PRIORITY_MAIN - 4)
+
+/**
+ * @brief   Maximum number of packets in flight, the sink's queue holds all
+ *          of them
+ */
+#define BENCH_WINDOW_MAX    (32U)
+#define MAIN_QUEUE_SIZE     (BENCH_WINDOW_MAX)
+
+#ifndef BENCH_COUNT
+#define BENCH_COUNT         (1000U)
+#endif
+
+/**
+ * @brief   Time after which all packets in flight are considered lost
+ */
+#define BENCH_TIMEOUT       (100U * US_PER_MS)
+
+#define BENCH_PORT          (4711U)
+#define BENCH_PAN           (0x23U)
+#define BENCH_HL            (64U)
+#define BENCH_ETHERTYPE     (0x88b5U)   /**< IEEE 802 local experimental */
+#define BENCH_PROTNUM       (253U)      /**< RFC 3692 experimental */
+
+/**
+ * @brief   Layer the sink registers at
+ */
+enum {
+    BENCH_STAGE_L2 = 0,
+    BENCH_STAGE_IPV6,
+    BENCH_STAGE_UDP,
+    BENCH_STAGE_NUMOF,
+};
+
+typedef struct _link _link_t;
+
+struct _link {
+    const char *name;
+    /**
+     * @brief   Writes the link layer header for @p stage to the frame
+     *
+     * @return  offset of the IPv6 header in the frame
+     */
+    size_t (*build_hdr)(_link_t *link, unsigned stage);
+    size_t payload_offset;      /**< offset of the IPv6 header in the L2 payload */
+    size_t max_len;             /**< maximum frame length */
+    size_t l3_offset;           /**< offset of the IPv6 header in the frame */
+    size_t frame_len;
+    uint32_t seq;               /**< sequence number of the next frame */
+    netdev_test_t dev;
+    gnrc_netdev_t gnrc_netdev;
+    kernel_pid_t pid;
+    uint8_t frame[ETHERNET_FRAME_LEN];
+    char stack[BENCH_MAC_STACKSIZE];
+};
+
+typedef struct {
+    uint32_t sent;
+    uint32_t received;
+    uint32_t lost;
+    uint32_t duration;          /**< in us */
+    uint64_t lat_sum;           /**< in us */
+    uint32_t lat_min;           /**< in us */
+    uint32_t lat_max;           /**< in us */
+    size_t pktbuf_max;          /**< high-water mark in bytes */
+} _result_t;
+
+static size_t _eth_hdr(_link_t *link, unsigned stage);
+static size_t _ieee802154_hdr(_link_t *link, unsigned stage);
+
+static const char *_stage_names[] = { "l2", "ipv6", "udp" };
+static const gnrc_nettype_t _stage_types[] = {
+    GNRC_NETTYPE_UNDEF, GNRC_NETTYPE_IPV6, GNRC_NETTYPE_UDP,
+};
+static const uint32_t _stage_demux_ctx[] = {
+    GNRC_NETREG_DEMUX_CTX_ALL, BENCH_PROTNUM, BENCH_PORT,
+};
+static const size_t _sizes[] = { 16, 64, 512 };
+
+static const uint8_t _eth_src[] = { 0x6c, 0x5d, 0xff, 0x73, 0x84, 0x6f };
+static const uint8_t _eth_dst[] = { 0x33, 0x33, 0x00, 0x00, 0x00, 0x01 };
+static const uint8_t _ieee802154_src[] = { 0x00, 0x01 };
+static const uint8_t _ieee802154_dst[] = { 0xff, 0xff };
+static const ipv6_addr_t _src_addr = { {
+        0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01
+    } };
+
+static _link_t _links[] = {
+    { .name = "eth", .build_hdr = _eth_hdr, .payload_offset = 0,
+      .max_len = ETHERNET_FRAME_LEN },
+    { .name = "802154", .build_hdr = _ieee802154_hdr,
+      .payload_offset = 1,  /* 6LoWPAN dispatch */
+      .max_len = IEEE802154_FRAME_LEN_MAX - IEEE802154_FCS_LEN },
+};
+
+#define LINK_NUMOF  (sizeof(_links) / sizeof(_links[0]))
+
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+
+static size_t _eth_hdr(_link_t *link, unsigned stage)
+{
+    ethernet_hdr_t *hdr = (ethernet_hdr_t *)link->frame;
+
+    memcpy(hdr->dst, _eth_dst, sizeof(hdr->dst));
+    memcpy(hdr->src, _eth_src, sizeof(hdr->src));
+    /* unknown ethertypes are handed to GNRC_NETTYPE_UNDEF */
+    hdr->type = byteorder_htons((stage == BENCH_STAGE_L2) ? BENCH_ETHERTYPE
+                                                          : ETHERTYPE_IPV6);
+    return sizeof(ethernet_hdr_t);
+}
+
+static size_t _ieee802154_hdr(_link_t *link, unsigned stage)
+{
+    netdev_ieee802154_t *dev = (netdev_ieee802154_t *)&link->dev;
+    le_uint16_t pan = byteorder_btols(byteorder_htons(BENCH_PAN));
+    size_t len;
+
+    len = ieee802154_set_frame_hdr(link->frame, _ieee802154_src,
+                                   sizeof(_ieee802154_src), _ieee802154_dst,
+                                   sizeof(_ieee802154_dst), pan, pan,
+                                   IEEE802154_FCF_TYPE_DATA |
+                                   IEEE802154_FCF_PAN_COMP, 0);
+    /* bypass 6LoWPAN to end at the link layer */
+    dev->proto = (stage == BENCH_STAGE_L2) ? GNRC_NETTYPE_UNDEF
+                                           : GNRC_NETTYPE_SIXLOWPAN;
+    link->frame[len] = SIXLOWPAN_UNCOMP;
+    return len + 1;
+}
+
+static int _build_frame(_link_t *link, unsigned stage, size_t size)
+{
+    size_t l3_offset = link->build_hdr(link, stage);
+    uint8_t *udp_data = &link->frame[l3_offset + sizeof(ipv6_hdr_t)];
+    uint16_t udp_len = sizeof(udp_hdr_t) + size;
+    ipv6_hdr_t ipv6;
+    udp_hdr_t udp;
+    uint16_t csum;
+
+    if ((size > link->max_len) ||
+        ((l3_offset + sizeof(ipv6_hdr_t) + udp_len) > link->max_len)) {
+        return -EMSGSIZE;
+    }
+    memset(&ipv6, 0, sizeof(ipv6));
+    ipv6_hdr_set_version(&ipv6);
+    ipv6.len = byteorder_htons(udp_len);
+    ipv6.nh = (stage == BENCH_STAGE_IPV6) ? BENCH_PROTNUM : PROTNUM_UDP;
+    ipv6.hl = BENCH_HL;
+    ipv6.src = _src_addr;
+    ipv6.dst = ipv6_addr_all_nodes_link_local;
+    udp.src_port = byteorder_htons(BENCH_PORT);
+    udp.dst_port = byteorder_htons(BENCH_PORT);
+    udp.length = byteorder_htons(udp_len);
+    udp.checksum.u16 = 0;
+    memcpy(udp_data, &udp, sizeof(udp));
+    for (size_t i = 0; i < size; i++) {
+        udp_data[sizeof(udp) + i] = (uint8_t)i;
+    }
+    /* the flow label carrying the sequence number is not part of the
+     * pseudo header, so the checksum stays valid for all frames */
+    csum = ipv6_hdr_inet_csum(0, &ipv6, PROTNUM_UDP, udp_len);
+    csum = inet_csum(csum, udp_data, udp_len);
+    udp.checksum = byteorder_htons((csum == 0xffff) ? csum : ~csum);
+    memcpy(udp_data, &udp, sizeof(udp));
+    memcpy(&link->frame[l3_offset], &ipv6, sizeof(ipv6));
+    link->l3_offset = l3_offset;
+    link->frame_len = l3_offset + sizeof(ipv6_hdr_t) + udp_len;
+    return 0;
+}
+
+static uint32_t _get_seq(gnrc_pktsnip_t *pkt, size_t payload_offset)
+{
+    gnrc_pktsnip_t *ipv6 = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_IPV6);
+    uint8_t *hdr = (ipv6 != NULL) ? ipv6->data
+                                  : ((uint8_t *)pkt->data) + payload_offset;
+
+    return ((uint32_t)(hdr[1] & 0x0f) << 16) | ((uint32_t)hdr[2] << 8) | hdr[3];
+}
+
+/* runs in the thread of the link, once per injected interrupt */
+static void _dev_isr(netdev_t *dev)
+{
+    _link_t *link = ((netdev_test_t *)dev)->state;
+    uint8_t *hdr = &link->frame[link->l3_offset];
+
+    /* byte-wise, the IPv6 header is not aligned within the frame */
+    hdr[1] = (hdr[1] & 0xf0) | ((link->seq >> 16) & 0x0f);
+    hdr[2] = (uint8_t)(link->seq >> 8);
+    hdr[3] = (uint8_t)link->seq;
+    link->seq++;
+    dev->event_callback(dev, NETDEV_EVENT_RX_COMPLETE);
+}
+
+static int _dev_recv(netdev_t *dev, char *buf, int len, void *info)
+{
+    _link_t *link = ((netdev_test_t *)dev)->state;
+
+    /* size request or drop */
+    if (buf == NULL) {
+        return link->frame_len;
+    }
+    if (len < (int)link->frame_len) {
+        return -ENOBUFS;
+    }
+    memcpy(buf, link->frame, link->frame_len);
+    /* only the IEEE 802.15.4 adaption asks for reception info */
+    if (info != NULL) {
+        netdev_ieee802154_rx_info_t *rx_info = info;
+
+        rx_info->lqi = 0xff;
+        rx_info->rssi = 0;
+    }
+    return link->frame_len;
+}
+
+static void _inject(_link_t *link)
+{
+    netdev_t *dev = (netdev_t *)&link->dev;
+
+    dev->event_callback(dev, NETDEV_EVENT_ISR);
+}
+
+static void _flush(void)
+{
+    msg_t msg;
+
+    while (msg_try_receive(&msg) == 1) {
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_RCV) {
+            gnrc_pktbuf_release(msg.content.ptr);
+        }
+    }
+}
+
+static int _run(_link_t *link, unsigned stage, unsigned count, size_t size,
+                unsigned window, uint32_t rate, _result_t *res)
+{
+    gnrc_netreg_entry_t sink;
+    uint32_t tx_time[BENCH_WINDOW_MAX];
+    uint32_t start, next_seq = 0;
+    int error;
+
+    if ((error = _build_frame(link, stage, size)) < 0) {
+        return error;
+    }
+    memset(res, 0, sizeof(_result_t));
+    res->lat_min = UINT32_MAX;
+    link->seq = 0;
+    gnrc_netreg_entry_init_pid(&sink, _stage_demux_ctx[stage], sched_active_pid);
+    gnrc_netreg_register(_stage_types[stage], &sink);
+#ifdef DEVELHELP
+    gnrc_pktbuf_reset_max_used();
+#endif
+    start = xtimer_now_usec();
+    while ((res->sent < count) || (next_seq < res->sent)) {
+        uint32_t now = xtimer_now_usec(), timeout = BENCH_TIMEOUT, seq;
+        bool waiting = true;
+        gnrc_pktsnip_t *pkt;
+        msg_t msg;
+
+        if ((res->sent < count) && ((res->sent - next_seq) < window)) {
+            uint32_t due = start;
+
+            if (rate > 0) {
+                due += (uint32_t)(((uint64_t)res->sent * US_PER_SEC) / rate);
+            }
+            if ((int32_t)(due - now) <= 0) {
+                tx_time[res->sent % BENCH_WINDOW_MAX] = now;
+                res->sent++;
+                _inject(link);
+                continue;
+            }
+            timeout = due - now;
+            waiting = false;
+        }
+        if (xtimer_msg_receive_timeout(&msg, timeout) < 0) {
+            if (waiting) {
+                /* everything still in flight was dropped on the way */
+                res->lost += res->sent - next_seq;
+                next_seq = res->sent;
+            }
+            continue;
+        }
+        if (msg.type != GNRC_NETAPI_MSG_TYPE_RCV) {
+            continue;
+        }
+        now = xtimer_now_usec();
+        pkt = msg.content.ptr;
+        /* the flow label holds the lower 20 bits of the sequence number */
+        seq = next_seq + ((_get_seq(pkt, link->payload_offset) - next_seq) & 0xfffff);
+        gnrc_pktbuf_release(pkt);
+        if (seq >= res->sent) {
+            /* arrived after it was considered lost */
+            continue;
+        }
+        /* the pipeline keeps the order, so frames before seq were dropped */
+        res->lost += seq - next_seq;
+        next_seq = seq + 1;
+        now -= tx_time[seq % BENCH_WINDOW_MAX];
+        res->lat_sum += now;
+        if (now < res->lat_min) {
+            res->lat_min = now;
+        }
+        if (now > res->lat_max) {
+            res->lat_max = now;
+        }
+        res->received++;
+    }
+    res->duration = xtimer_now_usec() - start;
+    gnrc_netreg_unregister(_stage_types[stage], &sink);
+    _flush();
+#ifdef DEVELHELP
+    gnrc_pktbuf_get_used(&res->pktbuf_max);
+#endif
+    if (res->received == 0) {
+        res->lat_min = 0;
+    }
+    return 0;
+}
+
+static uint32_t _avg_ns(const _result_t *res)
+{
+    return (res->received > 0) ? (uint32_t)((res->lat_sum * 1000) / res->received)
+                               : 0;
+}
+
+static void _print_result(const _link_t *link, unsigned stage, size_t size,
+                          unsigned window, const _result_t *res)
+{
+    uint32_t pps = 0;
+
+    if (res->duration > 0) {
+        pps = (uint32_t)(((uint64_t)res->received * US_PER_SEC) / res->duration);
+    }
+    printf("%-6s %-4s %4u B window %2u: %" PRIu32 "/%" PRIu32 " received, "
+           "%" PRIu32 " lost, %" PRIu32 " pkt/s, latency avg %" PRIu32
+           " ns min %" PRIu32 " us max %" PRIu32 " us, pktbuf max %u B\n",
+           link->name, _stage_names[stage], (unsigned)size, window,
+           res->received, res->sent, res->lost, pps, _avg_ns(res),
+           res->lat_min, res->lat_max, (unsigned)res->pktbuf_max);
+}
+
+static void _print_cost(const char *name, uint32_t ns)
+{
+#ifdef CLOCK_CORECLOCK
+    printf("  %-5s %6lu ns/packet, %6lu cycles/packet\n", name,
+           (unsigned long)ns,
+           (unsigned long)(((uint64_t)ns * (CLOCK_CORECLOCK / 1000)) / 1000000));
+#else
+    printf("  %-5s %6lu ns/packet\n", name, (unsigned long)ns);
+#endif
+}
+
+/* one packet at a time, the difference between the stages is the cost of
+ * the layer in between */
+static int _layers(_link_t *link, unsigned count, size_t size)
+{
+    static const char *layers[] = { "l2", "l3", "l4" };
+    uint32_t prev = 0;
+
+    for (unsigned stage = 0; stage < BENCH_STAGE_NUMOF; stage++) {
+        _result_t res;
+        uint32_t ns;
+        int error;
+
+        if ((error = _run(link, stage, count, size, 1, 0, &res)) < 0) {
+            return error;
+        }
+        _print_result(link, stage, size, 1, &res);
+        ns = _avg_ns(&res);
+        _print_cost(layers[stage], (ns > prev) ? (ns - prev) : 0);
+        prev = ns;
+    }
+    return 0;
+}
+
+static _link_t *_find_link(const char *name)
+{
+    for (unsigned i = 0; i < LINK_NUMOF; i++) {
+        if (strcmp(_links[i].name, name) == 0) {
+            return &_links[i];
+        }
+    }
+    return NULL;
+}
+
+static int _bench_cmd(int argc, char **argv)
+{
+    _link_t *link;
+    unsigned stage, count = BENCH_COUNT, window = 1;
+    uint32_t rate = 0;
+    size_t size = 64;
+    int res;
+
+    if ((argc < 3) || ((link = _find_link(argv[1])) == NULL)) {
+        printf("usage: %s <eth|802154> <l2|ipv6|udp|all> "
+               "[<count> [<bytes> [<window> [<pkt/s>]]]]\n", argv[0]);
+        return 1;
+    }
+    for (stage = 0; stage < BENCH_STAGE_NUMOF; stage++) {
+        if (strcmp(argv[2], _stage_names[stage]) == 0) {
+            break;
+        }
+    }
+    if ((stage == BENCH_STAGE_NUMOF) && (strcmp(argv[2], "all") != 0)) {
+        printf("error: unknown stage %s\n", argv[2]);
+        return 1;
+    }
+    if (argc > 3) {
+        count = atoi(argv[3]);
+    }
+    if (argc > 4) {
+        size = atoi(argv[4]);
+    }
+    if (argc > 5) {
+        window = atoi(argv[5]);
+    }
+    if (argc > 6) {
+        rate = atoi(argv[6]);
+    }
+    if ((window == 0) || (window > BENCH_WINDOW_MAX)) {
+        printf("error: window must be between 1 and %u\n", BENCH_WINDOW_MAX);
+        return 1;
+    }
+    if (stage == BENCH_STAGE_NUMOF) {
+        res = _layers(link, count, size);
+    }
+    else {
+        _result_t result;
+
+        if ((res = _run(link, stage, count, size, window, rate, &result)) == 0) {
+            _print_result(link, stage, size, window, &result);
+        }
+    }
+    if (res < 0) {
+        printf("error: %u bytes do not fit into a frame of %s\n",
+               (unsigned)size, link->name);
+        return 1;
+    }
+    return 0;
+}
+
+static const shell_command_t shell_commands[] = {
+    { "bench", "inject frames and measure the receive path", _bench_cmd },
+    { NULL, NULL, NULL }
+};
+
+static int _link_init(_link_t *link)
+{
+    netdev_test_setup(&link->dev, link);
+    netdev_test_set_isr_cb(&link->dev, _dev_isr);
+    netdev_test_set_recv_cb(&link->dev, _dev_recv);
+    if (link->build_hdr == _eth_hdr) {
+        gnrc_netdev_eth_init(&link->gnrc_netdev, (netdev_t *)&link->dev);
+    }
+    else {
+        gnrc_netdev_ieee802154_init(&link->gnrc_netdev,
+                                    (netdev_ieee802154_t *)&link->dev);
+    }
+    link->pid = gnrc_netdev_init(link->stack, sizeof(link->stack),
+                                 BENCH_MAC_PRIO, link->name, &link->gnrc_netdev);
+    if (link->pid <= KERNEL_PID_UNDEF) {
+        return -ENOMEM;
+    }
+    /* ff02::1 is added to every interface */
+    gnrc_ipv6_netif_add(link->pid);
+    return 0;
+}
+
+int main(void)
+{
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    puts("GNRC receive path benchmark");
+
+    for (unsigned i = 0; i < LINK_NUMOF; i++) {
+        if (_link_init(&_links[i]) < 0) {
+            printf("error: unable to start thread for %s\n", _links[i].name);
+            return 1;
+        }
+    }
+    for (unsigned i = 0; i < LINK_NUMOF; i++) {
+        for (unsigned j = 0; j < sizeof(_sizes) / sizeof(_sizes[0]); j++) {
+            _result_t res;
+
+            if (_layers(&_links[i], BENCH_COUNT, _sizes[j]) < 0) {
+                continue;
+            }
+            _run(&_links[i], BENCH_STAGE_UDP, BENCH_COUNT, _sizes[j],
+                 BENCH_WINDOW_MAX, 0, &res);
+            _print_result(&_links[i], BENCH_STAGE_UDP, _sizes[j],
+                          BENCH_WINDOW_MAX, &res);
+        }
+    }
+    puts("done");
+
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+    shell_run(shell_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+
+    /* should be never reached */
+    return 0;
+}
@@ -0,0 +1,305 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for deficit round robin in
+ *              gnrc_priority_pktqueue
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/priority_pktqueue.h"
+
+#ifndef TEST_NODES
+#define TEST_NODES          (8U)
+#endif
+#ifndef TEST_BULK_LIMIT
+#define TEST_BULK_LIMIT     (6U)
+#endif
+#ifndef TEST_DURATION
+#define TEST_DURATION       (10U * 1000U * 1000U)   /**< in us */
+#endif
+
+#define LINK_US_PER_BYTE    (32U)                   /**< 250 kbit/s */
+#define BULK_SIZE           (100U)
+#define BULK_INTERVAL       ((BULK_SIZE * LINK_US_PER_BYTE * 2U) / 3U)
+#define CTRL_SIZE           (40U)
+#define CTRL_INTERVAL       (50U * 1000U)
+#define BULK_CLASS          (1U)
+
+typedef struct {
+    uint32_t sent;
+    uint32_t dropped;
+    uint64_t latency_sum;
+    uint32_t latency_max;
+} stats_t;
+
+static gnrc_priority_pktqueue_node_t nodes[TEST_NODES];
+static gnrc_priority_pktqueue_t queue;
+
+static gnrc_priority_pktqueue_node_t *_alloc_node(void)
+{
+    /* same convention as gnrc_mac: unused nodes hold neither packet nor
+     * successor */
+    for (unsigned i = 0; i < TEST_NODES; i++) {
+        if ((nodes[i].pkt == NULL) && (nodes[i].next == NULL)) {
+            return &nodes[i];
+        }
+    }
+    return NULL;
+}
+
+static gnrc_pktsnip_t *_pkt(size_t size, uint32_t stamp)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, size, GNRC_NETTYPE_UNDEF);
+
+    if (pkt != NULL) {
+        memcpy(pkt->data, &stamp, sizeof(stamp));
+    }
+    return pkt;
+}
+
+static int _queue(size_t size, uint32_t priority, uint32_t stamp)
+{
+    gnrc_priority_pktqueue_node_t *node = _alloc_node();
+    gnrc_pktsnip_t *pkt;
+    int res;
+
+    if (node == NULL) {
+        return -ENOMEM;
+    }
+    if ((pkt = _pkt(size, stamp)) == NULL) {
+        return -ENOMEM;
+    }
+    gnrc_priority_pktqueue_node_init(node, priority, pkt);
+    if ((res = gnrc_priority_pktqueue_push(&queue, node)) < 0) {
+        gnrc_priority_pktqueue_node_init(node, 0, NULL);
+        gnrc_pktbuf_release(pkt);
+    }
+    return res;
+}
+
+static uint32_t _stamp(gnrc_pktsnip_t *pkt)
+{
+    uint32_t stamp;
+
+    memcpy(&stamp, pkt->data, sizeof(stamp));
+    return stamp;
+}
+
+static void _result(const char *name, bool ok)
+{
+    printf("%-32s %s\n", name, ok ? "OK" : "FAILED");
+}
+
+static void _reset(void)
+{
+    static const gnrc_priority_pktqueue_class_conf_t no_limit = { 0, 0, 0 };
+
+    for (unsigned i = 0; i < GNRC_PRIORITY_PKTQUEUE_CLASSES; i++) {
+        gnrc_priority_pktqueue_set_class(i, &no_limit);
+    }
+    gnrc_priority_pktqueue_flush(&queue);
+}
+
+static void test_fifo(void)
+{
+    bool ok = true;
+
+    _reset();
+    for (uint32_t i = 0; i < TEST_NODES; i++) {
+        _queue(BULK_SIZE, BULK_CLASS, i);
+    }
+    for (uint32_t i = 0; i < TEST_NODES; i++) {
+        gnrc_pktsnip_t *pkt = gnrc_priority_pktqueue_head(&queue);
+
+        ok = ok && (pkt == gnrc_priority_pktqueue_pop(&queue)) &&
+             (_stamp(pkt) == i);
+        gnrc_pktbuf_release(pkt);
+    }
+    ok = ok && (gnrc_priority_pktqueue_pop(&queue) == NULL);
+    _result("FIFO within a class", ok);
+}
+
+static void test_share(void)
+{
+    static const gnrc_priority_pktqueue_class_conf_t conf[] = {
+        { .quantum = 300, .max_pkts = TEST_NODES / 2 },
+        { .quantum = 100, .max_pkts = TEST_NODES / 2 },
+    };
+    unsigned count[2] = { 0, 0 };
+
+    _reset();
+    gnrc_priority_pktqueue_set_class(1, &conf[0]);
+    gnrc_priority_pktqueue_set_class(2, &conf[1]);
+    /* keep both classes backlogged, the quanta grant class 1 three packets
+     * per packet of class 2 */
+    for (unsigned i = 0; i < 400; i++) {
+        while (_queue(BULK_SIZE, 1, 0) == 0) {}
+        while (_queue(BULK_SIZE, 2, 1) == 0) {}
+        gnrc_pktsnip_t *pkt = gnrc_priority_pktqueue_pop(&queue);
+
+        count[_stamp(pkt)]++;
+        gnrc_pktbuf_release(pkt);
+    }
+    printf("shares (300/100 bytes quantum)   %u/%u packets\n", count[0], count[1]);
+    _result("deficit round robin shares", count[0] == 3 * count[1]);
+}
+
+static void test_control(void)
+{
+    bool ok;
+
+    _reset();
+    _queue(BULK_SIZE, 1, 1);
+    _queue(BULK_SIZE, 2, 2);
+    _queue(BULK_SIZE, 3, 3);
+    _queue(CTRL_SIZE, GNRC_PRIORITY_PKTQUEUE_CLASS_CONTROL, 0);
+    ok = (_stamp(gnrc_priority_pktqueue_head(&queue)) == 0);
+    for (uint32_t i = 0; ok && (i < 4); i++) {
+        gnrc_pktsnip_t *pkt = gnrc_priority_pktqueue_pop(&queue);
+
+        ok = (_stamp(pkt) == i);
+        gnrc_pktbuf_release(pkt);
+    }
+    _result("control class first", ok);
+    _reset();
+}
+
+static void test_limits(void)
+{
+    static const gnrc_priority_pktqueue_class_conf_t pkts = { .max_pkts = 2 };
+    static const gnrc_priority_pktqueue_class_conf_t bytes = { .max_bytes = 250 };
+    bool ok;
+
+    _reset();
+    gnrc_priority_pktqueue_set_class(1, &pkts);
+    gnrc_priority_pktqueue_set_class(2, &bytes);
+    ok = (_queue(10, 1, 0) == 0) && (_queue(10, 1, 0) == 0) &&
+         (_queue(10, 1, 0) == -ENOBUFS);
+    ok = ok && (_queue(BULK_SIZE, 2, 0) == 0) &&
+         (_queue(BULK_SIZE, 2, 0) == 0) &&
+         (_queue(BULK_SIZE, 2, 0) == -ENOBUFS) &&
+         (_queue(50, 2, 0) == 0);
+    /* other classes are not affected */
+    ok = ok && (_queue(BULK_SIZE, 0, 0) == 0) &&
+         (gnrc_priority_pktqueue_length(&queue) == 6);
+    _result("class limits", ok);
+    _reset();
+}
+
+static void _account(stats_t *stats, uint32_t now, uint32_t stamp)
+{
+    uint32_t latency = now - stamp;
+
+    stats->sent++;
+    stats->latency_sum += latency;
+    if (latency > stats->latency_max) {
+        stats->latency_max = latency;
+    }
+}
+
+static void _print(const char *name, const stats_t *stats)
+{
+    printf("  %-8s sent %6lu dropped %6lu latency avg %6lu us max %6lu us\n",
+           name, (unsigned long)stats->sent, (unsigned long)stats->dropped,
+           (unsigned long)(stats->sent ? stats->latency_sum / stats->sent : 0),
+           (unsigned long)stats->latency_max);
+}
+
+static void _simulate(const char *name, bool classified)
+{
+    stats_t bulk = { 0 }, ctrl = { 0 };
+    uint32_t next_bulk = 0, next_ctrl = CTRL_INTERVAL / 2;
+    uint32_t tx_done = 0;
+    gnrc_pktsnip_t *tx = NULL;
+
+    _reset();
+    if (classified) {
+        static const gnrc_priority_pktqueue_class_conf_t conf = {
+            .max_pkts = TEST_BULK_LIMIT
+        };
+        gnrc_priority_pktqueue_set_class(BULK_CLASS, &conf);
+    }
+    while (1) {
+        uint32_t now = next_bulk;
+
+        if (next_ctrl < now) {
+            now = next_ctrl;
+        }
+        if ((tx != NULL) && (tx_done <= now)) {
+            now = tx_done;
+        }
+        if (now >= TEST_DURATION) {
+            break;
+        }
+        /* the link finishes first, so the freed node can be reused by a
+         * packet arriving at the same time */
+        if ((tx != NULL) && (tx_done == now)) {
+            _account((gnrc_pkt_len(tx) == CTRL_SIZE) ? &ctrl : &bulk,
+                     now, _stamp(tx));
+            gnrc_pktbuf_release(tx);
+            tx = NULL;
+        }
+        if (next_ctrl == now) {
+            uint32_t prio = classified ? GNRC_PRIORITY_PKTQUEUE_CLASS_CONTROL
+                                       : BULK_CLASS;
+            if (_queue(CTRL_SIZE, prio, now) < 0) {
+                ctrl.dropped++;
+            }
+            next_ctrl += CTRL_INTERVAL;
+        }
+        if (next_bulk == now) {
+            if (_queue(BULK_SIZE, BULK_CLASS, now) < 0) {
+                bulk.dropped++;
+            }
+            next_bulk += BULK_INTERVAL;
+        }
+        if ((tx == NULL) &&
+            ((tx = gnrc_priority_pktqueue_pop(&queue)) != NULL)) {
+            tx_done = now + (gnrc_pkt_len(tx) * LINK_US_PER_BYTE);
+        }
+    }
+    if (tx != NULL) {
+        gnrc_pktbuf_release(tx);
+    }
+    printf("%s:\n", name);
+    _print("control", &ctrl);
+    _print("bulk", &bulk);
+}
+
+int main(void)
+{
+    puts("gnrc_priority_pktqueue deficit round robin test");
+
+    gnrc_priority_pktqueue_init(&queue);
+    test_fifo();
+    test_share();
+    test_control();
+    test_limits();
+
+    printf("\nsaturated %u kbit/s link, %u queue nodes, %u s:\n",
+           (unsigned)(8000U / LINK_US_PER_BYTE), (unsigned)TEST_NODES,
+           (unsigned)(TEST_DURATION / (1000U * 1000U)));
+    _simulate("single class", false);
+    _simulate("classified", true);
+
+    _reset();
+    return 0;
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Per frame cost of decoding IEEE 802.15.4 MAC headers
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "board.h"
+#include "periph_conf.h"
+#include "net/ieee802154.h"
+#include "xtimer.h"
+
+#ifndef TEST_FRAMES
+#define TEST_FRAMES         (100000U)
+#endif
+
+/* frames as seen by gnrc_netdev_ieee802154: short and long addresses, with
+ * and without PAN ID compression */
+static const uint8_t frames[][IEEE802154_MAX_HDR_LEN] = {
+    { 0x41, 0x88, 0x01, 0xcd, 0xab, 0xff, 0xff, 0x34, 0x12 },
+    { 0x41, 0xcc, 0x02, 0xcd, 0xab,
+      0x18, 0x17, 0x16, 0x15, 0x14, 0x13, 0x12, 0x11,
+      0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01 },
+    { 0x01, 0xc8, 0x03, 0xcd, 0xab, 0x34, 0x12, 0x21, 0x43,
+      0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01 },
+    { 0x41, 0xc8, 0x04, 0xcd, 0xab, 0xff, 0xff,
+      0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01 },
+};
+
+#define FRAMES_NUMOF        (sizeof(frames) / sizeof(frames[0]))
+
+static void _print(const char *name, uint32_t usec)
+{
+    uint64_t ns = ((uint64_t)usec * 1000) / TEST_FRAMES;
+
+#ifdef CLOCK_CORECLOCK
+    printf("%s %5lu ns/frame, %5lu cycles/frame\n", name, (unsigned long)ns,
+           (unsigned long)((ns * (CLOCK_CORECLOCK / 1000)) / 1000000));
+#else
+    printf("%s %5lu ns/frame\n", name, (unsigned long)ns);
+#endif
+}
+
+int main(void)
+{
+    /* volatile, so the compiler can't skip any decoding */
+    volatile unsigned sum = 0;
+
+    puts("IEEE 802.15.4 MAC header decoding benchmark");
+    printf("%u frames\n", TEST_FRAMES);
+
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_FRAMES; i++) {
+        const uint8_t *mhr = frames[i % FRAMES_NUMOF];
+        uint8_t src[IEEE802154_LONG_ADDRESS_LEN];
+        uint8_t dst[IEEE802154_LONG_ADDRESS_LEN];
+        le_uint16_t pan;
+
+        sum += ieee802154_get_frame_hdr_len(mhr);
+        sum += ieee802154_get_dst(mhr, dst, &pan);
+        sum += ieee802154_get_src(mhr, src, &pan);
+        sum += dst[0] + src[0];
+    }
+    uint32_t separate = xtimer_now_usec() - start;
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_FRAMES; i++) {
+        ieee802154_mhr_t mhr;
+
+        sum += ieee802154_parse_mhr(frames[i % FRAMES_NUMOF],
+                                    IEEE802154_MAX_HDR_LEN, &mhr);
+        sum += mhr.dst_len + mhr.src_len + mhr.dst[0] + mhr.src[0];
+    }
+    uint32_t single = xtimer_now_usec() - start;
+
+    _print("get_frame_hdr_len + get_dst + get_src:", separate);
+    _print("parse_mhr:                            ", single);
+    printf("checksum: %u\n", sum);
+    puts("done");
+
+    return 0;
+}
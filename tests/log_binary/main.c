@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the cost of logging calls
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "board.h"
+#include "periph_conf.h"
+#include "log.h"
+#include "xtimer.h"
+
+#ifndef CALLS
+#define CALLS           (1000UL)
+#endif
+
+int main(void)
+{
+    puts("log timings test");
+    LOG_INFO("logging starts\n");
+
+    uint32_t start = xtimer_now_usec();
+    for (unsigned long i = 0; i < CALLS; i++) {
+        LOG_INFO("log call %lu of %lu\n", i, CALLS);
+    }
+    uint32_t elapsed = xtimer_now_usec() - start;
+
+#ifdef MODULE_LOG_BINARY
+    printf("\n+ %-10s", "log_binary");
+#else
+    printf("\n+ %-10s", "printf");
+#endif
+    printf(" %6lu ns/call", (unsigned long)(((uint64_t)elapsed * 1000) / CALLS));
+#ifdef CLOCK_CORECLOCK
+    printf(" %6lu cycles/call",
+           (unsigned long)(((uint64_t)elapsed * (CLOCK_CORECLOCK / 1000000))
+                           / CALLS));
+#endif
+    puts("");
+
+#ifdef MODULE_LOG_BINARY
+    puts("\nrecorded messages:");
+    log_binary_dump();
+#endif
+
+    puts("\nDone.");
+    return 0;
+}
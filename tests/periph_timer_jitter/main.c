@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Peripheral timer jitter measurement
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "mutex.h"
+#include "periph/timer.h"
+
+#ifndef TEST_TIMER
+#define TEST_TIMER          TIMER_DEV(0)
+#endif
+#ifndef TEST_SPEED
+#define TEST_SPEED          (1000000ul)
+#endif
+#ifndef TEST_CHANNELS
+#define TEST_CHANNELS       (4U)
+#endif
+#ifndef TEST_SAMPLES
+#define TEST_SAMPLES        (1000U)
+#endif
+#ifndef TEST_INTERVAL
+#define TEST_INTERVAL       (1000U)     /* interval of channel 0 in ticks */
+#endif
+#ifndef TEST_INTERVAL_STEP
+#define TEST_INTERVAL_STEP  (250U)      /* added per channel */
+#endif
+#ifndef TEST_MAX_JITTER
+#define TEST_MAX_JITTER     (100U)
+#endif
+
+typedef struct {
+    uint32_t target;
+    uint32_t interval;
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+} chan_stats_t;
+
+static chan_stats_t stats[TEST_CHANNELS];
+static unsigned channels;
+static volatile unsigned running;
+static mutex_t done = MUTEX_INIT_LOCKED;
+
+static void cb(void *arg, int chan)
+{
+    (void)arg;
+    uint32_t now = timer_read(TEST_TIMER);
+    chan_stats_t *s = &stats[chan];
+    uint32_t late = now - s->target;
+
+    if (late < s->min) {
+        s->min = late;
+    }
+    if (late > s->max) {
+        s->max = late;
+    }
+    s->sum += late;
+
+    if (++s->count < TEST_SAMPLES) {
+        s->target += s->interval;
+        timer_set_absolute(TEST_TIMER, chan, s->target);
+    }
+    else if (--running == 0) {
+        mutex_unlock(&done);
+    }
+}
+
+int main(void)
+{
+    int res = 1;
+
+    puts("\nTest for peripheral timer jitter\n");
+
+    if (timer_init(TEST_TIMER, TEST_SPEED, cb, NULL) < 0) {
+        puts("TIMER_0: ERROR on initialization");
+        puts("\nTEST FAILED");
+        return 1;
+    }
+
+    /* find out how many channels are available */
+    for (channels = 0; channels < TEST_CHANNELS; channels++) {
+        if (timer_set(TEST_TIMER, channels, TEST_SPEED) < 0) {
+            break;
+        }
+        timer_clear(TEST_TIMER, channels);
+    }
+
+    if (channels == 0) {
+        puts("TIMER_0: ERROR setting any channel");
+        puts("\nTEST FAILED");
+        return 1;
+    }
+
+    printf("Testing %u channel(s) with %u samples each\n",
+           channels, (unsigned)TEST_SAMPLES);
+
+    uint32_t start = timer_read(TEST_TIMER);
+    running = channels;
+    for (unsigned i = 0; i < channels; i++) {
+        stats[i].interval = TEST_INTERVAL + (i * TEST_INTERVAL_STEP);
+        stats[i].target = start + stats[i].interval;
+        stats[i].min = UINT32_MAX;
+        timer_set_absolute(TEST_TIMER, i, stats[i].target);
+    }
+
+    mutex_lock(&done);
+
+    for (unsigned i = 0; i < channels; i++) {
+        printf("TIMER_0: channel %u: min %u avg %u max %u\n", i,
+               (unsigned)stats[i].min,
+               (unsigned)(stats[i].sum / stats[i].count),
+               (unsigned)stats[i].max);
+        if (stats[i].max > TEST_MAX_JITTER) {
+            res = 0;
+        }
+    }
+
+    if (!res) {
+        puts("\nTEST FAILED");
+        return 1;
+    }
+    puts("\nTEST SUCCEEDED");
+
+    return 0;
+}
@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2017 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.environ['RIOTBASE'], 'dist/tools/testrunner'))
+import testrunner
+
+
+def testfunc(child):
+    child.expect(r"Testing (\d+) channel\(s\) with (\d+) samples each")
+    channels = int(child.match.group(1))
+    for i in range(channels):
+        child.expect(r"TIMER_0: channel %i: min (\d+) avg (\d+) max (\d+)" % i)
+    child.expect_exact("TEST SUCCEEDED")
+
+
+if __name__ == "__main__":
+    sys.exit(testrunner.run(testfunc, timeout=60))
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Per packet cost of the packet filter compared to a linear scan
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "net/pktfilter.h"
+#include "random.h"
+#include "xtimer.h"
+
+#ifndef TEST_RULES
+#define TEST_RULES          (1000U)
+#endif
+#ifndef TEST_TABLE_SIZE
+#define TEST_TABLE_SIZE     (2048U)
+#endif
+#ifndef TEST_PREFIXES
+#define TEST_PREFIXES       (16U)   /* number of rules being /48 prefixes */
+#endif
+#ifndef TEST_PACKETS
+#define TEST_PACKETS        (100000U)
+#endif
+
+static pktfilter_rule_t rules[TEST_RULES];
+static uint16_t table[TEST_TABLE_SIZE];
+static pktfilter_t filter;
+
+/* what gnrc_ipv6_blacklist does, but with as many entries */
+static uint8_t list[TEST_RULES][16];
+
+static uint8_t pkts[64][16];
+
+static void _rand_addr(uint8_t *addr)
+{
+    /* all within 2001:db8::/32, so prefixes matter */
+    addr[0] = 0x20;
+    addr[1] = 0x01;
+    addr[2] = 0x0d;
+    addr[3] = 0xb8;
+    for (unsigned i = 4; i < 16; i += 4) {
+        uint32_t r = random_uint32();
+        memcpy(&addr[i], &r, sizeof(r));
+    }
+}
+
+static bool _linear_pass(const uint8_t *addr)
+{
+    for (unsigned i = 0; i < TEST_RULES; i++) {
+        if (memcmp(list[i], addr, 16) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(void)
+{
+    unsigned passed = 0;
+
+    puts("pktfilter benchmark");
+
+    random_init(1);
+    pktfilter_init(&filter, rules, TEST_RULES, table, TEST_TABLE_SIZE);
+    for (unsigned i = 0; i < TEST_RULES; i++) {
+        pktfilter_rule_t rule;
+
+        memset(&rule, 0, sizeof(rule));
+        _rand_addr(rule.addr);
+        rule.addr_len = 16;
+        rule.prefix_len = (i < TEST_PREFIXES) ? 48 : 128;
+        rule.field = PKTFILTER_IPV6_SRC;
+        rule.action = PKTFILTER_DROP;
+        rule.proto = PKTFILTER_PROTO_ANY;
+        rule.port = PKTFILTER_PORT_ANY;
+        if (pktfilter_add(&filter, &rule) < 0) {
+            puts("error: unable to add rule");
+            return 1;
+        }
+        memcpy(list[i], rule.addr, 16);
+    }
+
+    /* half of the packets come from filtered addresses */
+    for (unsigned i = 0; i < 64; i++) {
+        if (i & 1) {
+            memcpy(pkts[i], list[TEST_PREFIXES + random_uint32_range(0,
+                            TEST_RULES - TEST_PREFIXES)], 16);
+        }
+        else {
+            _rand_addr(pkts[i]);
+        }
+    }
+
+    printf("%u rules (%u /48 prefixes), %u packets\n", TEST_RULES,
+           TEST_PREFIXES, TEST_PACKETS);
+
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_PACKETS; i++) {
+        passed += _linear_pass(pkts[i & 63]);
+    }
+    uint32_t linear = xtimer_now_usec() - start;
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_PACKETS; i++) {
+        pktfilter_pkt_t pkt = { .ipv6_src = pkts[i & 63],
+                                .proto = 17, .port = 5683 };
+        passed += pktfilter_pass(&filter, &pkt);
+    }
+    uint32_t compiled = xtimer_now_usec() - start;
+
+    printf("linear scan: %lu ns/packet\n",
+           (unsigned long)(((uint64_t)linear * 1000) / TEST_PACKETS));
+    printf("pktfilter:   %lu ns/packet\n",
+           (unsigned long)(((uint64_t)compiled * 1000) / TEST_PACKETS));
+    printf("passed: %u\n", passed);
+    puts("done");
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the power mode selection of pm_set_lowest() with
+ *              pending xtimers
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "pm_layered.h"
+#include "xtimer.h"
+
+/* xtimer overhead and tick granularity */
+#define TEST_TOLERANCE  (500U)
+#define TEST_LONG       (100U * US_PER_MS)
+#define TEST_SHORT      (TEST_BREAK_EVEN / 2)
+#define TEST_IDLE       (PM_NUM_MODES)
+
+static volatile bool _fired;
+
+static void _cb(void *arg)
+{
+    (void)arg;
+    _fired = true;
+}
+
+static xtimer_t _long = { .callback = _cb };
+static xtimer_t _short = { .callback = _cb };
+
+/**
+ * @brief   Runs pm_set_lowest() once and returns the mode it entered
+ *
+ * @param[in] deadline  the next xtimer deadline in us since boot
+ */
+static unsigned _set_lowest(uint32_t deadline)
+{
+    pm_tickless_stats_t before[PM_NUM_MODES + 1];
+    const pm_tickless_stats_t *after = pm_layered_stats();
+    uint32_t expected_left = deadline - xtimer_now_usec();
+    uint32_t left = xtimer_usec_from_ticks(xtimer_left_until_next());
+
+    if ((left > (expected_left + TEST_TOLERANCE)) ||
+        ((left + TEST_TOLERANCE) < expected_left)) {
+        printf("xtimer_left_until_next(): %u us instead of %u us\n",
+               (unsigned)left, (unsigned)expected_left);
+        return UINT32_MAX;
+    }
+    memcpy(before, after, sizeof(before));
+    pm_set_lowest();
+    for (unsigned mode = 0; mode <= PM_NUM_MODES; mode++) {
+        if (after[mode].entries != before[mode].entries) {
+            return mode;
+        }
+    }
+    return UINT32_MAX;
+}
+
+static int _test(const char *name, unsigned mode, unsigned expected)
+{
+    printf("%s: entered mode %u, expected %u\n", name, mode, expected);
+    return (mode == expected) ? 0 : 1;
+}
+
+int main(void)
+{
+    uint32_t start;
+    unsigned lowest;
+    int failed = 0;
+
+    puts("pm_tickless test\n");
+
+    /* the deepest unblocked mode pays off, but the board may block some */
+    start = xtimer_now_usec();
+    xtimer_set(&_long, TEST_LONG);
+    lowest = _set_lowest(start + TEST_LONG);
+    if (lowest >= TEST_IDLE) {
+        printf("long deadline: entered mode %u, expected a power mode\n",
+               lowest);
+        failed++;
+    }
+    else {
+        printf("long deadline: entered mode %u\n", lowest);
+    }
+    xtimer_remove(&_long);
+
+    /* the next pending timer decides, not the one set last */
+    start = xtimer_now_usec();
+    xtimer_set(&_short, TEST_SHORT);
+    xtimer_set(&_long, TEST_LONG);
+    failed += _test("short deadline", _set_lowest(start + TEST_SHORT),
+                    TEST_IDLE);
+    while (!_fired) {}
+
+    /* once the short timer fired, the long one is next again */
+    failed += _test("long deadline pending", _set_lowest(start + TEST_LONG),
+                    lowest);
+    xtimer_remove(&_long);
+
+    if (failed) {
+        puts("[FAILED]");
+        return 1;
+    }
+    puts("[SUCCESS]");
+    return 0;
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Benchmark comparing priority_queue and priority_heap
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "priority_queue.h"
+#include "priority_heap.h"
+#include "random.h"
+#include "xtimer.h"
+
+#ifndef TEST_MAX_DEPTH
+#define TEST_MAX_DEPTH      (1024U)
+#endif
+#ifndef TEST_ROUNDS
+#define TEST_ROUNDS         (10000U)
+#endif
+#ifndef TEST_PRIORITIES
+#define TEST_PRIORITIES     (16U)
+#endif
+
+static priority_queue_node_t list_nodes[TEST_MAX_DEPTH];
+static priority_heap_node_t heap_nodes[TEST_MAX_DEPTH];
+
+static uint32_t _bench_list(unsigned depth)
+{
+    priority_queue_t queue = PRIORITY_QUEUE_INIT;
+
+    random_init(depth);
+    for (unsigned i = 0; i < depth; i++) {
+        priority_queue_node_init(&list_nodes[i]);
+        list_nodes[i].priority = random_uint32() % TEST_PRIORITIES;
+        priority_queue_add(&queue, &list_nodes[i]);
+    }
+
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_ROUNDS; i++) {
+        /* dequeue the head and queue it again, then remove and re-add an
+         * arbitrary node, the typical pattern of a MAC layer TX queue */
+        priority_queue_node_t *node = priority_queue_remove_head(&queue);
+        node->priority = random_uint32() % TEST_PRIORITIES;
+        priority_queue_add(&queue, node);
+
+        node = &list_nodes[i % depth];
+        priority_queue_remove(&queue, node);
+        priority_queue_add(&queue, node);
+    }
+    return xtimer_now_usec() - start;
+}
+
+static uint32_t _bench_heap(unsigned depth)
+{
+    priority_heap_t heap = PRIORITY_HEAP_INIT;
+
+    random_init(depth);
+    for (unsigned i = 0; i < depth; i++) {
+        priority_heap_node_init(&heap_nodes[i]);
+        heap_nodes[i].priority = random_uint32() % TEST_PRIORITIES;
+        priority_heap_add(&heap, &heap_nodes[i]);
+    }
+
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_ROUNDS; i++) {
+        priority_heap_node_t *node = priority_heap_remove_head(&heap);
+        node->priority = random_uint32() % TEST_PRIORITIES;
+        priority_heap_add(&heap, node);
+
+        node = &heap_nodes[i % depth];
+        priority_heap_remove(&heap, node);
+        priority_heap_add(&heap, node);
+    }
+    return xtimer_now_usec() - start;
+}
+
+int main(void)
+{
+    puts("priority queue benchmark");
+    printf("%u rounds of remove head + add + remove + add per depth\n",
+           TEST_ROUNDS);
+    puts("depth    list [ns/op]    heap [ns/op]");
+
+    for (unsigned depth = 4; depth <= TEST_MAX_DEPTH; depth *= 2) {
+        uint32_t list = _bench_list(depth);
+        uint32_t heap = _bench_heap(depth);
+
+        printf("%5u %15lu %15lu\n", depth,
+               (unsigned long)(((uint64_t)list * 1000) / (4 * TEST_ROUNDS)),
+               (unsigned long)(((uint64_t)heap * 1000) / (4 * TEST_ROUNDS)));
+    }
+
+    puts("done");
+    return 0;
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the cost of pthread thread-specific storage
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "board.h"
+#include "periph_conf.h"
+#include "pthread.h"
+#include "xtimer.h"
+
+#ifndef CALLS
+#define CALLS           (10000UL)
+#endif
+#ifndef KEYS
+#define KEYS            (6U)
+#endif
+
+static pthread_key_t keys[KEYS];
+static int values[KEYS];
+static pthread_key_t dtor_key;
+static unsigned dtor_calls;
+
+static void print_result(const char *name, uint32_t elapsed)
+{
+    printf("+ %-22s %6lu ns/call", name,
+           (unsigned long)(((uint64_t)elapsed * 1000) / CALLS));
+#ifdef CLOCK_CORECLOCK
+    printf(" %6lu cycles/call",
+           (unsigned long)(((uint64_t)elapsed * (CLOCK_CORECLOCK / 1000000))
+                           / CALLS));
+#endif
+    puts("");
+}
+
+static void *bench(void *arg)
+{
+    (void)arg;
+    void *volatile sink;
+
+    for (unsigned i = 0; i < KEYS; i++) {
+        pthread_setspecific(keys[i], &values[i]);
+    }
+
+    uint32_t start = xtimer_now_usec();
+    for (unsigned long i = 0; i < CALLS; i++) {
+        sink = pthread_getspecific(keys[0]);
+    }
+    print_result("pthread_getspecific()", xtimer_now_usec() - start);
+    (void)sink;
+
+    start = xtimer_now_usec();
+    for (unsigned long i = 0; i < CALLS; i++) {
+        pthread_setspecific(keys[0], &values[i % KEYS]);
+    }
+    print_result("pthread_setspecific()", xtimer_now_usec() - start);
+
+    return NULL;
+}
+
+static void dtor(void *value)
+{
+    dtor_calls++;
+    /* set a value again the first time, which must be destructed as well */
+    if (dtor_calls == 1) {
+        pthread_setspecific(dtor_key, value);
+    }
+}
+
+static void *dtor_thread(void *arg)
+{
+    pthread_setspecific(dtor_key, arg);
+    return NULL;
+}
+
+int main(void)
+{
+    pthread_t th;
+
+    puts("pthread tls timings test\n");
+
+    for (unsigned i = 0; i < KEYS; i++) {
+        if (pthread_key_create(&keys[i], NULL) != 0) {
+            puts("error: pthread_key_create() failed");
+            return 1;
+        }
+    }
+
+    pthread_create(&th, NULL, bench, NULL);
+    pthread_join(th, NULL);
+
+    pthread_key_create(&dtor_key, dtor);
+    pthread_create(&th, NULL, dtor_thread, &values[0]);
+    pthread_join(th, NULL);
+    printf("\ndestructor called %u times\n", dtor_calls);
+
+    puts((dtor_calls == 2) ? "SUCCESS" : "FAILURE");
+    return 0;
+}
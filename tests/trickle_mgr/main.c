@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief Trickle manager test application
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "trickle.h"
+#include "thread.h"
+#include "msg.h"
+#include "xtimer.h"
+
+#define Q_LEN           (8)
+#define TRICKLE_MSG     (0xfeef)
+#define TR_IMIN         (8)
+#define TR_IDOUBLINGS   (4)
+#define TR_REDCONST     (0)
+
+#ifndef TRICKLE_NUMOF
+#define TRICKLE_NUMOF   (100U)
+#endif
+#ifndef TEST_SLACK
+#define TEST_SLACK      (16U)       /* in ms */
+#endif
+#ifndef TEST_DURATION
+#define TEST_DURATION   (2U)        /* in s */
+#endif
+
+static msg_t _msg_q[Q_LEN];
+static trickle_mgr_t mgr;
+static trickle_t trickles[TRICKLE_NUMOF];
+static unsigned callbacks;
+
+static void callback(void *args)
+{
+    (void)args;
+    callbacks++;
+}
+
+static unsigned _run(uint32_t slack)
+{
+    uint32_t end = xtimer_now_usec() + (TEST_DURATION * US_PER_SEC);
+    msg_t msg;
+
+    callbacks = 0;
+    trickle_mgr_init(&mgr, sched_active_pid, TRICKLE_MSG, slack);
+    for (unsigned i = 0; i < TRICKLE_NUMOF; i++) {
+        trickles[i].callback.func = &callback;
+        trickles[i].callback.args = NULL;
+        trickle_mgr_start(&mgr, &trickles[i], TR_IMIN, TR_IDOUBLINGS,
+                          TR_REDCONST);
+    }
+
+    while ((int32_t)(end - xtimer_now_usec()) > 0) {
+        if (xtimer_msg_receive_timeout(&msg, end - xtimer_now_usec()) < 0) {
+            break;
+        }
+        if (msg.type == TRICKLE_MSG) {
+            trickle_mgr_handle((trickle_mgr_t *)msg.content.ptr);
+        }
+    }
+
+    for (unsigned i = 0; i < TRICKLE_NUMOF; i++) {
+        trickle_stop(&trickles[i]);
+    }
+    /* drop a wakeup that might have been queued meanwhile */
+    while (msg_try_receive(&msg) == 1) {}
+
+    printf("slack %u ms: %u timers, %u callbacks, %u wakeups\n",
+           (unsigned)slack, TRICKLE_NUMOF, callbacks, (unsigned)mgr.wakeups);
+
+    return mgr.wakeups;
+}
+
+int main(void)
+{
+    msg_init_queue(_msg_q, Q_LEN);
+
+    puts("Trickle manager test application\n");
+
+    unsigned exact = _run(0);
+    unsigned coalesced = _run(TEST_SLACK);
+
+    if (coalesced < exact) {
+        puts("\nTEST SUCCEEDED");
+    }
+    else {
+        puts("\nTEST FAILED");
+    }
+
+    return 0;
+}
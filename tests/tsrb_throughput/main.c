@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Throughput benchmark for tsrb and isrpipe
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "isrpipe.h"
+#include "thread.h"
+#include "tsrb.h"
+#include "xtimer.h"
+
+#ifndef TEST_BYTES
+#define TEST_BYTES          (64U * 1024U)
+#endif
+#ifndef TEST_CHUNK
+#define TEST_CHUNK          (48U)
+#endif
+#ifndef TEST_PIPE_BYTES
+#define TEST_PIPE_BYTES     (4U * 1024U)
+#endif
+#ifndef TEST_BURST
+#define TEST_BURST          (64U)
+#endif
+#ifndef TEST_WATERMARK
+#define TEST_WATERMARK      (32U)
+#endif
+#ifndef TEST_IDLE_TIMEOUT
+#define TEST_IDLE_TIMEOUT   (2000U)     /* in us */
+#endif
+
+static char _rb_buf[128];
+static char _pipe_buf[256];
+static char _in[TEST_CHUNK];
+static char _out[TEST_CHUNK];
+static tsrb_t _rb;
+static isrpipe_t _pipe;
+
+static char _writer_stack[THREAD_STACKSIZE_DEFAULT];
+
+static void _byte_wise(void)
+{
+    for (unsigned i = 0; i < TEST_CHUNK; i++) {
+        tsrb_add_one(&_rb, _in[i]);
+    }
+    for (unsigned i = 0; i < TEST_CHUNK; i++) {
+        _out[i] = tsrb_get_one(&_rb);
+    }
+}
+
+static void _bulk(void)
+{
+    tsrb_add(&_rb, _in, TEST_CHUNK);
+    tsrb_get(&_rb, _out, TEST_CHUNK);
+}
+
+static void _bench(const char *name, void (*func)(void))
+{
+    tsrb_init(&_rb, _rb_buf, sizeof(_rb_buf));
+
+    uint32_t start = xtimer_now_usec();
+    for (unsigned n = 0; n < TEST_BYTES; n += TEST_CHUNK) {
+        func();
+    }
+    uint32_t diff = xtimer_now_usec() - start;
+
+    printf("%-10s %6" PRIu32 " us, %6" PRIu32 " kB/s\n", name, diff,
+           (uint32_t)(((uint64_t)TEST_BYTES * US_PER_MS) / (diff ? diff : 1)));
+}
+
+static void *_writer(void *arg)
+{
+    (void)arg;
+
+    for (unsigned n = 0; n < TEST_PIPE_BYTES; n++) {
+        isrpipe_write_one(&_pipe, (char)n);
+        if ((n % TEST_BURST) == (TEST_BURST - 1)) {
+            xtimer_usleep(TEST_IDLE_TIMEOUT * 2);
+        }
+    }
+
+    return NULL;
+}
+
+static void _bench_pipe(size_t watermark)
+{
+    unsigned reads = 0;
+    unsigned total = 0;
+
+    isrpipe_init(&_pipe, _pipe_buf, sizeof(_pipe_buf));
+    isrpipe_set_watermark(&_pipe, watermark, TEST_IDLE_TIMEOUT);
+
+    /* the writer has a lower priority than the reader, just like an ISR
+     * feeding a thread would preempt it */
+    kernel_pid_t pid = thread_create(_writer_stack, sizeof(_writer_stack),
+                                     THREAD_PRIORITY_MAIN + 1,
+                                     THREAD_CREATE_STACKTEST,
+                                     _writer, NULL, "writer");
+
+    uint32_t start = xtimer_now_usec();
+    while (total < TEST_PIPE_BYTES) {
+        total += isrpipe_read(&_pipe, _out, sizeof(_out));
+        reads++;
+    }
+    uint32_t diff = xtimer_now_usec() - start;
+
+    /* let the writer terminate before its stack is reused */
+    while (thread_getstatus(pid) != STATUS_NOT_FOUND) {
+        xtimer_usleep(TEST_IDLE_TIMEOUT);
+    }
+
+    printf("isrpipe watermark %3u: %u bytes in %u reads, %" PRIu32 " us\n",
+           (unsigned)watermark, total, reads, diff);
+}
+
+int main(void)
+{
+    puts("tsrb and isrpipe throughput benchmark\n");
+
+    for (unsigned i = 0; i < TEST_CHUNK; i++) {
+        _in[i] = (char)i;
+    }
+
+    _bench("byte-wise", _byte_wise);
+    _bench("bulk", _bulk);
+
+    _bench_pipe(0);
+    _bench_pipe(TEST_WATERMARK);
+
+    puts("\nDONE");
+
+    return 0;
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures how long writing to stdio blocks the caller
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "periph/uart.h"
+#include "uart_stdio.h"
+#include "xtimer.h"
+
+#ifndef TEST_LINES
+#define TEST_LINES      (32U)
+#endif
+#ifndef TEST_LINE_LEN
+#define TEST_LINE_LEN   (64U)
+#endif
+/* long enough to transmit a line, so each line finds the transmit buffer
+ * empty and only the blocking of a single write is measured */
+#ifndef TEST_LINE_GAP
+#define TEST_LINE_GAP   (10U * US_PER_MS)
+#endif
+
+static char _line[TEST_LINE_LEN + 1];
+
+static void _write_uart(unsigned i)
+{
+    (void)i;
+    uart_write(UART_STDIO_DEV, (uint8_t *)_line, TEST_LINE_LEN);
+}
+
+static void _write_direct(unsigned i)
+{
+    (void)i;
+    uart_stdio_write(_line, TEST_LINE_LEN);
+}
+
+static void _write_printf(unsigned i)
+{
+    /* numbered, so lost or garbled lines are visible in the output */
+    printf("%03u%s", i, &_line[3]);
+}
+
+static uint32_t _measure(const char *name, void (*write_line)(unsigned))
+{
+    uint32_t min = UINT32_MAX, max = 0, sum = 0;
+
+    for (unsigned i = 0; i < TEST_LINES; i++) {
+        uint32_t start = xtimer_now_usec();
+        write_line(i);
+        uint32_t diff = xtimer_now_usec() - start;
+
+        if (diff < min) {
+            min = diff;
+        }
+        if (diff > max) {
+            max = diff;
+        }
+        sum += diff;
+        xtimer_usleep(TEST_LINE_GAP);
+    }
+
+    /* let all buffered data go out before printing the results */
+    xtimer_sleep(1);
+    uart_stdio_flush();
+
+#ifdef MODULE_UART_STDIO_TX_BUF
+    printf("TX_BUF=1 %s: ", name);
+#else
+    printf("TX_BUF=0 %s: ", name);
+#endif
+    printf("blocked min %" PRIu32 " avg %" PRIu32 " max %" PRIu32 " us per %u "
+           "byte line, %u bytes dropped\n", min, sum / TEST_LINES, max,
+           TEST_LINE_LEN, uart_stdio_tx_dropped());
+    return sum / TEST_LINES;
+}
+
+int main(void)
+{
+    uint32_t sync, buffered;
+
+    puts("uart_stdio transmit blocking test\n");
+
+#ifdef TEST_UART_STDIO_INIT
+    uart_stdio_init();
+#endif
+
+    memset(_line, '.', TEST_LINE_LEN);
+    _line[TEST_LINE_LEN - 1] = '\n';
+
+    /* the synchronous transmit path for reference */
+    sync = _measure("uart_write", _write_uart);
+    buffered = _measure("uart_stdio_write", _write_direct);
+    /* through the C library, as applications write (on native, stdio does
+     * not use uart_stdio, so this measures the host's stdout) */
+    _measure("printf", _write_printf);
+
+    if (uart_stdio_tx_dropped() != 0) {
+        puts("[FAILED] bytes dropped");
+        return 1;
+    }
+#if defined(MODULE_UART_STDIO_TX_BUF) && !defined(BOARD_NATIVE)
+    /* the emulated UART of native is not rate limited, so there is nothing
+     * to gain from the buffer there */
+    if (buffered >= sync) {
+        puts("[FAILED] buffered write blocks as long as a synchronous one");
+        return 1;
+    }
+#else
+    (void)sync;
+    (void)buffered;
+#endif
+    puts("[SUCCESS]");
+
+    return 0;
+}
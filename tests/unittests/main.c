@@ -11,12 +11,53 @@
 #include "embUnit.h"
 #include "xtimer.h"
 
+#ifdef BOARD_NATIVE
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "periph/pm.h"
+
+/* dist/tools/embunit_parallel runs each suite in its own native process. It
+ * lists the suites with UNITTESTS_LIST and selects the ones a worker runs
+ * with a comma separated UNITTESTS_SUITES. */
+static bool _selected(const char *name)
+{
+    const char *suites = getenv("UNITTESTS_SUITES");
+    size_t len = strlen(name);
+
+    if (getenv("UNITTESTS_LIST") != NULL) {
+        printf("suite %s\n", name);
+        return false;
+    }
+    if (suites == NULL) {
+        return true;
+    }
+    while (suites != NULL) {
+        if ((strncmp(suites, name, len) == 0) &&
+            ((suites[len] == ',') || (suites[len] == '\0'))) {
+            return true;
+        }
+        if ((suites = strchr(suites, ',')) != NULL) {
+            suites++;
+        }
+    }
+    return false;
+}
+#define SELECTED(TEST_SUITE)    _selected(#TEST_SUITE)
+#else
+#define SELECTED(TEST_SUITE)    (1)
+#endif
+
 #define UNCURRY(FUN, ARGS) FUN(ARGS)
 #define RUN_TEST_SUITES(...) MAP(RUN_TEST_SUITE, __VA_ARGS__)
 #define RUN_TEST_SUITE(TEST_SUITE) \
     do { \
         extern void tests_##TEST_SUITE(void); \
-        tests_##TEST_SUITE(); \
+        if (SELECTED(TEST_SUITE)) { \
+            tests_##TEST_SUITE(); \
+        } \
     } while (0);
 
 int main(void)
@@ -36,5 +77,13 @@ int main(void)
 #endif
     TESTS_END();
 
+#ifdef BOARD_NATIVE
+    if ((getenv("UNITTESTS_SUITES") != NULL) ||
+        (getenv("UNITTESTS_LIST") != NULL)) {
+        /* a worker is done, tell the runner by exiting */
+        pm_off();
+    }
+#endif
+
     return 0;
 }
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "priority_heap.h"
+
+#include "tests-core.h"
+
+#define H_LEN (16)
+
+static priority_heap_t h = PRIORITY_HEAP_INIT;
+static priority_heap_node_t he[H_LEN];
+
+static void set_up(void)
+{
+    priority_heap_init(&h);
+    for (unsigned i = 0; i < H_LEN; ++i) {
+        priority_heap_node_init(&(he[i]));
+    }
+}
+
+static void test_priority_heap_remove_head_empty(void)
+{
+    TEST_ASSERT_NULL(priority_heap_remove_head(&h));
+    TEST_ASSERT_NULL(priority_heap_peek(&h));
+    TEST_ASSERT_EQUAL_INT(0, priority_heap_size(&h));
+}
+
+static void test_priority_heap_add_one(void)
+{
+    he[1].priority = 713643658;
+
+    priority_heap_add(&h, &he[1]);
+
+    TEST_ASSERT(priority_heap_peek(&h) == &he[1]);
+    TEST_ASSERT_EQUAL_INT(1, priority_heap_size(&h));
+    TEST_ASSERT(priority_heap_remove_head(&h) == &he[1]);
+    TEST_ASSERT_NULL(priority_heap_remove_head(&h));
+}
+
+static void test_priority_heap_add_two_distinct(void)
+{
+    he[1].priority = 4567;
+    he[2].priority = 1234;
+
+    priority_heap_add(&h, &he[1]);
+    priority_heap_add(&h, &he[2]);
+
+    TEST_ASSERT(priority_heap_remove_head(&h) == &he[2]);
+    TEST_ASSERT(priority_heap_remove_head(&h) == &he[1]);
+    TEST_ASSERT_NULL(priority_heap_remove_head(&h));
+}
+
+static void test_priority_heap_equal_fifo(void)
+{
+    /* nodes with equal priority leave in insertion order */
+    for (unsigned i = 0; i < H_LEN; i++) {
+        he[i].priority = i % 3;
+        priority_heap_add(&h, &he[i]);
+    }
+    for (unsigned prio = 0; prio < 3; prio++) {
+        for (unsigned i = prio; i < H_LEN; i += 3) {
+            TEST_ASSERT(priority_heap_remove_head(&h) == &he[i]);
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(0, priority_heap_size(&h));
+}
+
+static void test_priority_heap_remove(void)
+{
+    for (unsigned i = 0; i < H_LEN; i++) {
+        he[i].priority = H_LEN - i;
+        priority_heap_add(&h, &he[i]);
+    }
+    /* remove every other node, including the head */
+    for (unsigned i = 1; i < H_LEN; i += 2) {
+        priority_heap_remove(&h, &he[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(H_LEN / 2, priority_heap_size(&h));
+    for (int i = H_LEN - 2; i >= 0; i -= 2) {
+        TEST_ASSERT(priority_heap_remove_head(&h) == &he[i]);
+    }
+    TEST_ASSERT_NULL(priority_heap_remove_head(&h));
+}
+
+Test *tests_core_priority_heap_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_priority_heap_remove_head_empty),
+        new_TestFixture(test_priority_heap_add_one),
+        new_TestFixture(test_priority_heap_add_two_distinct),
+        new_TestFixture(test_priority_heap_equal_fifo),
+        new_TestFixture(test_priority_heap_remove),
+    };
+
+    EMB_UNIT_TESTCALLER(core_priority_heap_tests, set_up, NULL,
+                        fixtures);
+
+    return (Test *)&core_priority_heap_tests;
+}
@@ -78,6 +78,13 @@ Test *tests_core_list_tests(void);
  */
 Test *tests_core_priority_queue_tests(void);
 
+/**
+ * @brief   Generates tests for priority_heap.h
+ *
+ * @return  embUnit tests if successful, NULL if not.
+ */
+Test *tests_core_priority_heap_tests(void);
+
 /**
  * @brief   Generates tests for byteorder.h
  *
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/ethertype.h"
+#include "net/icmp.h"
+#include "net/inet_csum.h"
+#include "net/ipv4/hdr.h"
+#include "net/gnrc/ipv4.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/protnum.h"
+
+#include "unittests-constants.h"
+#include "tests-gnrc_ipv4.h"
+
+#define TEST_PID1       (1)
+#define TEST_PID2       (2)
+#define TEST_ECHO_ID    (0x1234)
+#define TEST_ECHO_SEQ   (0x0001)
+
+static const ipv4_addr_t _addr1 = { { 10, 0, 0, 1 } };
+static const ipv4_addr_t _addr2 = { { 10, 1, 0, 1 } };
+static const ipv4_addr_t _bcast = { { 255, 255, 255, 255 } };
+
+static void set_up(void)
+{
+    gnrc_pktbuf_init();
+    gnrc_ipv4_netif_reset();
+}
+
+static void test_ipv4_netif_add_addr__EINVAL(void)
+{
+    TEST_ASSERT_EQUAL_INT(-EINVAL, gnrc_ipv4_netif_add_addr(TEST_PID1, &_addr1, 0));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, gnrc_ipv4_netif_add_addr(TEST_PID1, &_addr1, 33));
+    TEST_ASSERT_NULL(gnrc_ipv4_netif_get(TEST_PID1));
+}
+
+static void test_ipv4_netif_add_addr__ENOMEM(void)
+{
+    for (unsigned i = 0; i < GNRC_IPV4_NETIF_NUMOF; i++) {
+        TEST_ASSERT_EQUAL_INT(0, gnrc_ipv4_netif_add_addr(TEST_PID1 + i,
+                                                          &_addr1, 8));
+    }
+    TEST_ASSERT_EQUAL_INT(-ENOMEM,
+                          gnrc_ipv4_netif_add_addr(TEST_PID1 + GNRC_IPV4_NETIF_NUMOF,
+                                                   &_addr1, 8));
+}
+
+static void test_ipv4_netif_add_addr(void)
+{
+    ipv4_addr_t bcast = { { 10, 255, 255, 255 } };
+    ipv4_addr_t other = { { 10, 0, 0, 2 } };
+    gnrc_ipv4_netif_t *netif;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv4_netif_add_addr(TEST_PID1, &_addr1, 8));
+    TEST_ASSERT_NOT_NULL((netif = gnrc_ipv4_netif_get(TEST_PID1)));
+    TEST_ASSERT_EQUAL_INT(TEST_PID1, netif->pid);
+    TEST_ASSERT_EQUAL_INT(8, netif->prefix_len);
+    TEST_ASSERT_EQUAL_INT(_addr1.u32.u32, netif->addr.u32.u32);
+    TEST_ASSERT(gnrc_ipv4_netif_is_bcast(netif, &bcast));
+    TEST_ASSERT(gnrc_ipv4_netif_is_bcast(netif, &_bcast));
+    TEST_ASSERT(!gnrc_ipv4_netif_is_bcast(netif, &other));
+    TEST_ASSERT(netif == gnrc_ipv4_netif_find_by_addr(&_addr1));
+    TEST_ASSERT_NULL(gnrc_ipv4_netif_find_by_addr(&other));
+    /* replace address */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv4_netif_add_addr(TEST_PID1, &other, 24));
+    TEST_ASSERT(netif == gnrc_ipv4_netif_get(TEST_PID1));
+    TEST_ASSERT_NULL(gnrc_ipv4_netif_find_by_addr(&_addr1));
+    TEST_ASSERT(!gnrc_ipv4_netif_is_bcast(netif, &bcast));
+    gnrc_ipv4_netif_remove_addr(TEST_PID1);
+    TEST_ASSERT_NULL(gnrc_ipv4_netif_get(TEST_PID1));
+    TEST_ASSERT_NULL(gnrc_ipv4_netif_get_next(NULL));
+}
+
+static void test_ipv4_netif_find_by_prefix(void)
+{
+    ipv4_addr_t addr = { { 10, 1, 2, 3 } };
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv4_netif_add_addr(TEST_PID1, &_addr1, 8));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv4_netif_add_addr(TEST_PID2, &_addr2, 16));
+    TEST_ASSERT(gnrc_ipv4_netif_get(TEST_PID2) ==
+                gnrc_ipv4_netif_find_by_prefix(&addr));
+    addr.u8[1] = 2;
+    TEST_ASSERT(gnrc_ipv4_netif_get(TEST_PID1) ==
+                gnrc_ipv4_netif_find_by_prefix(&addr));
+    addr.u8[0] = 192;
+    TEST_ASSERT_NULL(gnrc_ipv4_netif_find_by_prefix(&addr));
+}
+
+static void test_ipv4_hdr_build(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_ipv4_hdr_build(NULL, &_addr1, &_addr2);
+    ipv4_hdr_t *hdr;
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_IPV4, pkt->type);
+    TEST_ASSERT_EQUAL_INT(sizeof(ipv4_hdr_t), pkt->size);
+    hdr = pkt->data;
+    TEST_ASSERT_EQUAL_INT(0x4, hdr->v_ih >> 4);
+    TEST_ASSERT_EQUAL_INT(sizeof(ipv4_hdr_t), ipv4_hdr_get_ihl(hdr));
+    TEST_ASSERT_EQUAL_INT(IPV4_HDR_FLAG_DF, ipv4_hdr_get_flags(hdr));
+    TEST_ASSERT_EQUAL_INT(0, ipv4_hdr_get_fo(hdr));
+    TEST_ASSERT_EQUAL_INT(PROTNUM_RESERVED, hdr->protocol);
+    TEST_ASSERT_EQUAL_INT(_addr1.u32.u32, hdr->src.u32.u32);
+    TEST_ASSERT_EQUAL_INT(_addr2.u32.u32, hdr->dst.u32.u32);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_ipv4_hdr_csum(void)
+{
+    /* header with valid checksum 0xb861 */
+    static const uint8_t data[] = {
+        0x45, 0x00, 0x00, 0x73, 0x00, 0x00, 0x40, 0x00,
+        0x40, 0x11, 0xb8, 0x61, 0xc0, 0xa8, 0x00, 0x01,
+        0xc0, 0xa8, 0x00, 0xc7,
+    };
+    ipv4_hdr_t hdr;
+
+    memcpy(&hdr, data, sizeof(hdr));
+    TEST_ASSERT_EQUAL_INT(0xffff, inet_csum(0, (uint8_t *)&hdr, sizeof(hdr)));
+    hdr.csum.u16 = 0;
+    TEST_ASSERT_EQUAL_INT(0xb861, (uint16_t)~inet_csum(0, (uint8_t *)&hdr,
+                                                       sizeof(hdr)));
+    /* pseudo header covers only the addresses, protocol and length */
+    TEST_ASSERT_EQUAL_INT(0xc0a8 + 0x0001 + 0xc0a8 + 0x00c7 + PROTNUM_UDP + 8 -
+                          0xffff,
+                          ipv4_hdr_inet_csum(0, &hdr, PROTNUM_UDP, 8));
+}
+
+static void test_ipv4_icmp_echo_csum(void)
+{
+    uint8_t data[] = { 0xde, 0xad, 0xbe, 0xef, 0x01 };
+    gnrc_pktsnip_t *pkt, *ipv4;
+
+    pkt = gnrc_ipv4_icmp_echo_build(ICMP_ECHO_REQ, TEST_ECHO_ID,
+                                    TEST_ECHO_SEQ, data, sizeof(data));
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_ICMP, pkt->type);
+    TEST_ASSERT_EQUAL_INT(sizeof(icmp_echo_t) + sizeof(data), pkt->size);
+    TEST_ASSERT_NOT_NULL((ipv4 = gnrc_ipv4_hdr_build(pkt, &_addr1, &_addr2)));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv4_icmp_calc_csum(pkt, ipv4));
+    TEST_ASSERT_EQUAL_INT(0xffff, inet_csum(0, pkt->data, pkt->size));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, gnrc_ipv4_icmp_calc_csum(ipv4, NULL));
+    gnrc_pktbuf_release(ipv4);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_ipv4_nettype(void)
+{
+    TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_IPV4,
+                          gnrc_nettype_from_ethertype(ETHERTYPE_IPV4));
+    TEST_ASSERT_EQUAL_INT(ETHERTYPE_IPV4,
+                          gnrc_nettype_to_ethertype(GNRC_NETTYPE_IPV4));
+    TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_ARP,
+                          gnrc_nettype_from_ethertype(ETHERTYPE_ARP));
+    TEST_ASSERT_EQUAL_INT(ETHERTYPE_ARP,
+                          gnrc_nettype_to_ethertype(GNRC_NETTYPE_ARP));
+    TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_ICMP,
+                          gnrc_nettype_from_protnum(PROTNUM_ICMP));
+    TEST_ASSERT_EQUAL_INT(PROTNUM_ICMP,
+                          gnrc_nettype_to_protnum(GNRC_NETTYPE_ICMP));
+}
+
+Test *tests_gnrc_ipv4_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_ipv4_netif_add_addr__EINVAL),
+        new_TestFixture(test_ipv4_netif_add_addr__ENOMEM),
+        new_TestFixture(test_ipv4_netif_add_addr),
+        new_TestFixture(test_ipv4_netif_find_by_prefix),
+        new_TestFixture(test_ipv4_hdr_build),
+        new_TestFixture(test_ipv4_hdr_csum),
+        new_TestFixture(test_ipv4_icmp_echo_csum),
+        new_TestFixture(test_ipv4_nettype),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_ipv4_tests, set_up, NULL, fixtures);
+
+    return (Test *)&gnrc_ipv4_tests;
+}
+
+void tests_gnrc_ipv4(void)
+{
+    TESTS_RUN(tests_gnrc_ipv4_tests());
+}
+/** @} */
@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/gnrc/ipv6/ext.h"
+#include "net/gnrc/pkt.h"
+#include "net/protnum.h"
+
+#include "tests-gnrc_ipv6_ext.h"
+
+#define TEST_OPT_TYPE   (0x3eU)     /* experimental, skip if unrecognized */
+
+static const uint8_t _hbh_dst_udp[] = {
+    /* Hop-by-Hop Options Header */
+    PROTNUM_IPV6_EXT_DST, 0x00,
+    0x63, 0x04, 0x80, 0x00, 0x80, 0x00,     /* RPL option */
+    /* Destination Options Header */
+    PROTNUM_UDP, 0x01,
+    0x00,                                   /* Pad1 */
+    TEST_OPT_TYPE, 0x02, 0xab, 0xcd,
+    0x01, 0x07, 0, 0, 0, 0, 0, 0, 0,        /* PadN */
+    /* UDP */
+    0x1f, 0x90, 0x1f, 0x90, 0x00, 0x08, 0xff, 0xff,
+};
+
+static unsigned _cb_calls;
+static int _cb_res;
+
+static int _opt_cb(gnrc_pktsnip_t *pkt, uint8_t ext, const ipv6_ext_opt_t *opt)
+{
+    const uint8_t *data = (const uint8_t *)(opt + 1);
+
+    (void)pkt;
+    TEST_ASSERT_EQUAL_INT(PROTNUM_IPV6_EXT_DST, ext);
+    TEST_ASSERT_EQUAL_INT(TEST_OPT_TYPE, opt->type);
+    TEST_ASSERT_EQUAL_INT(2, opt->len);
+    TEST_ASSERT_EQUAL_INT(0xab, data[0]);
+    TEST_ASSERT_EQUAL_INT(0xcd, data[1]);
+    _cb_calls++;
+    return _cb_res;
+}
+
+static gnrc_ipv6_ext_opt_handler_t _handler =
+    GNRC_IPV6_EXT_OPT_HANDLER_INIT(TEST_OPT_TYPE, _opt_cb);
+static gnrc_ipv6_ext_walk_t _walk;
+static uint8_t _buf[sizeof(_hbh_dst_udp)];
+static gnrc_pktsnip_t _pkt;
+
+static void set_up(void)
+{
+    memset(&_walk, 0, sizeof(_walk));
+    memcpy(_buf, _hbh_dst_udp, sizeof(_buf));
+    _pkt.data = _buf;
+    _pkt.size = sizeof(_buf);
+    _pkt.next = NULL;
+    _cb_calls = 0;
+    _cb_res = 0;
+}
+
+static void tear_down(void)
+{
+    gnrc_ipv6_ext_opt_unregister(&_handler);
+}
+
+static void test_ipv6_ext_walk(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_ext_walk(&_walk, &_pkt,
+                                                PROTNUM_IPV6_EXT_HOPOPT));
+    TEST_ASSERT_EQUAL_INT(2, _walk.numof);
+    TEST_ASSERT_EQUAL_INT(PROTNUM_IPV6_EXT_HOPOPT, _walk.type[0]);
+    TEST_ASSERT_EQUAL_INT(0, _walk.offset[0]);
+    TEST_ASSERT_EQUAL_INT(PROTNUM_IPV6_EXT_DST, _walk.type[1]);
+    TEST_ASSERT_EQUAL_INT(8, _walk.offset[1]);
+    TEST_ASSERT_EQUAL_INT(24, _walk.len);
+    TEST_ASSERT_EQUAL_INT(PROTNUM_UDP, _walk.nh);
+}
+
+static void test_ipv6_ext_walk_no_ext(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_ext_walk(&_walk, &_pkt, PROTNUM_UDP));
+    TEST_ASSERT_EQUAL_INT(0, _walk.numof);
+    TEST_ASSERT_EQUAL_INT(0, _walk.len);
+    TEST_ASSERT_EQUAL_INT(PROTNUM_UDP, _walk.nh);
+}
+
+static void test_ipv6_ext_walk_opt_handler(void)
+{
+    gnrc_ipv6_ext_opt_register(&_handler);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_ext_walk(&_walk, &_pkt,
+                                                PROTNUM_IPV6_EXT_HOPOPT));
+    TEST_ASSERT_EQUAL_INT(1, _cb_calls);
+    _cb_res = -EPERM;
+    TEST_ASSERT_EQUAL_INT(-EPERM, gnrc_ipv6_ext_walk(&_walk, &_pkt,
+                                                     PROTNUM_IPV6_EXT_HOPOPT));
+    TEST_ASSERT_EQUAL_INT(2, _cb_calls);
+    gnrc_ipv6_ext_opt_unregister(&_handler);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_ext_walk(&_walk, &_pkt,
+                                                PROTNUM_IPV6_EXT_HOPOPT));
+    TEST_ASSERT_EQUAL_INT(2, _cb_calls);
+}
+
+static void test_ipv6_ext_walk_truncated(void)
+{
+    /* destination options header exceeds the snip */
+    _pkt.size = 20;
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, gnrc_ipv6_ext_walk(&_walk, &_pkt,
+                                                       PROTNUM_IPV6_EXT_HOPOPT));
+    /* not even the first two bytes of the header */
+    _pkt.size = 9;
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, gnrc_ipv6_ext_walk(&_walk, &_pkt,
+                                                       PROTNUM_IPV6_EXT_DST));
+}
+
+static void test_ipv6_ext_walk_opt_exceeds_hdr(void)
+{
+    /* RPL option longer than the hop-by-hop options header */
+    _buf[3] = 0x05;
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, gnrc_ipv6_ext_walk(&_walk, &_pkt,
+                                                       PROTNUM_IPV6_EXT_HOPOPT));
+}
+
+static void test_ipv6_ext_walk_hopopt_not_first(void)
+{
+    /* destination options header followed by hop-by-hop options header */
+    _buf[0] = PROTNUM_IPV6_EXT_HOPOPT;
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, gnrc_ipv6_ext_walk(&_walk, &_pkt,
+                                                       PROTNUM_IPV6_EXT_DST));
+}
+
+static void test_ipv6_ext_walk_ah_esp(void)
+{
+    static const uint8_t ah_esp[] = {
+        /* Authentication Header: (4 + 2) * 4 = 24 bytes */
+        PROTNUM_IPV6_EXT_ESP, 0x04, 0x00, 0x00,
+        0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        /* ESP */
+        0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01,
+    };
+
+    memcpy(_buf, ah_esp, sizeof(ah_esp));
+    _pkt.size = sizeof(ah_esp);
+    TEST_ASSERT_EQUAL_INT(-ENOTSUP, gnrc_ipv6_ext_walk(&_walk, &_pkt,
+                                                       PROTNUM_IPV6_EXT_AH));
+    TEST_ASSERT_EQUAL_INT(1, _walk.numof);
+    _buf[0] = PROTNUM_TCP;
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_ext_walk(&_walk, &_pkt,
+                                                PROTNUM_IPV6_EXT_AH));
+    TEST_ASSERT_EQUAL_INT(24, _walk.len);
+    TEST_ASSERT_EQUAL_INT(PROTNUM_TCP, _walk.nh);
+}
+
+static void test_ipv6_ext_walk_atomic_frag(void)
+{
+    static const uint8_t frag_udp[] = {
+        /* Fragment Header: offset 0, M = 0 */
+        PROTNUM_UDP, 0x00, 0x00, 0x00, 0x12, 0x34, 0x56, 0x78,
+        /* UDP */
+        0x1f, 0x90, 0x1f, 0x90, 0x00, 0x08, 0xff, 0xff,
+    };
+
+    memcpy(_buf, frag_udp, sizeof(frag_udp));
+    _pkt.size = sizeof(frag_udp);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_ext_walk(&_walk, &_pkt,
+                                                PROTNUM_IPV6_EXT_FRAG));
+    TEST_ASSERT_EQUAL_INT(1, _walk.numof);
+    TEST_ASSERT_EQUAL_INT(8, _walk.len);
+    TEST_ASSERT_EQUAL_INT(PROTNUM_UDP, _walk.nh);
+}
+
+Test *tests_gnrc_ipv6_ext_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_ipv6_ext_walk),
+        new_TestFixture(test_ipv6_ext_walk_no_ext),
+        new_TestFixture(test_ipv6_ext_walk_opt_handler),
+        new_TestFixture(test_ipv6_ext_walk_truncated),
+        new_TestFixture(test_ipv6_ext_walk_opt_exceeds_hdr),
+        new_TestFixture(test_ipv6_ext_walk_hopopt_not_first),
+        new_TestFixture(test_ipv6_ext_walk_ah_esp),
+        new_TestFixture(test_ipv6_ext_walk_atomic_frag),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_ipv6_ext_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&gnrc_ipv6_ext_tests;
+}
+
+void tests_gnrc_ipv6_ext(void)
+{
+    TESTS_RUN(tests_gnrc_ipv6_ext_tests());
+}
+/** @} */
@@ -0,0 +1,324 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "msg.h"
+#include "net/ipv6/ext/frag.h"
+#include "net/ipv6/hdr.h"
+#include "net/gnrc/ipv6/ext/frag.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/protnum.h"
+
+#include "unittests-constants.h"
+#include "tests-gnrc_ipv6_ext_frag.h"
+
+#define TEST_MTU            (1280U)
+#define TEST_PAYLOAD_LEN    (3000U)
+#define TEST_FRAGS_NUMOF    (3U)
+#define TEST_FRAG_LEN       (TEST_MTU - sizeof(ipv6_hdr_t) - \
+                             sizeof(ipv6_ext_frag_t))
+/* smaller for reassembly, so old and grown reassembly buffer and a
+ * fragment fit into the packet buffer at the same time */
+#define TEST_RFRAG_LEN      (512U)
+#define TEST_RFRAGS_NUMOF   (3U)
+#define TEST_RPAYLOAD_LEN   (1400U)
+#define TEST_ID             (0x12345678)
+
+static const ipv6_addr_t _src = { {
+        0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01
+    } };
+static const ipv6_addr_t _dst = { {
+        0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02
+    } };
+
+static uint8_t _payload[TEST_PAYLOAD_LEN];
+static uint8_t _buf[TEST_MTU];
+
+static void set_up(void)
+{
+    gnrc_pktbuf_init();
+    gnrc_ipv6_ext_frag_rbuf_reset();
+    for (unsigned i = 0; i < sizeof(_payload); i++) {
+        _payload[i] = i * 7;
+    }
+}
+
+static void _init_ipv6_hdr(ipv6_hdr_t *hdr, uint8_t nh, size_t len)
+{
+    memset(hdr, 0, sizeof(ipv6_hdr_t));
+    ipv6_hdr_set_version(hdr);
+    hdr->nh = nh;
+    hdr->hl = 64;
+    hdr->len = byteorder_htons(len);
+    hdr->src = _src;
+    hdr->dst = _dst;
+}
+
+/* builds a received fragment: fragment header and data, IPv6 header,
+ * netif header */
+static gnrc_pktsnip_t *_rcvd_frag(uint32_t id, unsigned offset, size_t len,
+                                  bool more)
+{
+    gnrc_pktsnip_t *netif, *ipv6, *frag;
+    ipv6_ext_frag_t *fh = (ipv6_ext_frag_t *)_buf;
+
+    netif = gnrc_netif_hdr_build(NULL, 0, NULL, 0);
+    if (netif == NULL) {
+        return NULL;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = 1;
+    ipv6 = gnrc_pktbuf_add(netif, NULL, sizeof(ipv6_hdr_t), GNRC_NETTYPE_IPV6);
+    if (ipv6 == NULL) {
+        return NULL;
+    }
+    _init_ipv6_hdr(ipv6->data, PROTNUM_IPV6_EXT_FRAG,
+                   sizeof(ipv6_ext_frag_t) + len);
+    fh->nh = PROTNUM_UDP;
+    fh->resv = 0;
+    ipv6_ext_frag_set_offset(fh, offset);
+    if (more) {
+        ipv6_ext_frag_set_more(fh);
+    }
+    fh->id = byteorder_htonl(id);
+    memcpy(fh + 1, &_payload[offset], len);
+    frag = gnrc_pktbuf_add(ipv6, _buf, sizeof(ipv6_ext_frag_t) + len,
+                           GNRC_NETTYPE_UNDEF);
+    return frag;
+}
+
+static void _test_reassembled(gnrc_pktsnip_t *pkt, size_t len)
+{
+    ipv6_hdr_t *hdr;
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(len, pkt->size);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_payload, pkt->data, len));
+    TEST_ASSERT_NOT_NULL(pkt->next);
+    TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_IPV6, pkt->next->type);
+    hdr = pkt->next->data;
+    TEST_ASSERT_EQUAL_INT(PROTNUM_UDP, hdr->nh);
+    TEST_ASSERT_EQUAL_INT(len, byteorder_ntohs(hdr->len));
+    TEST_ASSERT(ipv6_addr_equal(&_src, &hdr->src));
+    TEST_ASSERT_NOT_NULL(pkt->next->next);
+    TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_NETIF, pkt->next->next->type);
+    TEST_ASSERT_EQUAL_INT(1, ((gnrc_netif_hdr_t *)pkt->next->next->data)->if_pid);
+    gnrc_pktbuf_release(pkt);
+}
+
+static void test_ipv6_ext_frag_send(void)
+{
+    gnrc_ipv6_ext_frag_send_t state;
+    gnrc_pktsnip_t *pkt, *frag;
+    unsigned offset = 0, numof = 0;
+
+    pkt = gnrc_pktbuf_add(NULL, _payload, sizeof(_payload), GNRC_NETTYPE_UNDEF);
+    pkt = gnrc_pktbuf_add(pkt, NULL, sizeof(ipv6_hdr_t), GNRC_NETTYPE_IPV6);
+    TEST_ASSERT_NOT_NULL(pkt);
+    _init_ipv6_hdr(pkt->data, PROTNUM_UDP, sizeof(_payload));
+    pkt = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_netif_hdr_t),
+                          GNRC_NETTYPE_NETIF);
+    TEST_ASSERT_NOT_NULL(pkt);
+    gnrc_netif_hdr_init(pkt->data, 0, 0);
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_ext_frag_init(&state, pkt, TEST_MTU));
+    while ((frag = gnrc_ipv6_ext_frag_next(&state)) != NULL) {
+        gnrc_pktsnip_t *ipv6 = frag->next, *ext = ipv6->next;
+        ipv6_hdr_t *hdr = ipv6->data;
+        ipv6_ext_frag_t *fh = ext->data;
+        bool last = (++numof == TEST_FRAGS_NUMOF);
+
+        TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_NETIF, frag->type);
+        TEST_ASSERT(gnrc_pkt_len(ipv6) <= TEST_MTU);
+        TEST_ASSERT_EQUAL_INT(PROTNUM_IPV6_EXT_FRAG, hdr->nh);
+        TEST_ASSERT_EQUAL_INT(gnrc_pkt_len(ext), byteorder_ntohs(hdr->len));
+        TEST_ASSERT_EQUAL_INT(sizeof(ipv6_ext_frag_t), ext->size);
+        TEST_ASSERT_EQUAL_INT(PROTNUM_UDP, fh->nh);
+        TEST_ASSERT_EQUAL_INT(offset, ipv6_ext_frag_get_offset(fh));
+        TEST_ASSERT_EQUAL_INT(!last, ipv6_ext_frag_more(fh));
+        TEST_ASSERT_EQUAL_INT(state.id, byteorder_ntohl(fh->id));
+        TEST_ASSERT_EQUAL_INT(last ? (TEST_PAYLOAD_LEN - offset) : TEST_FRAG_LEN,
+                              ext->next->size);
+        TEST_ASSERT_EQUAL_INT(0, memcmp(&_payload[offset], ext->next->data,
+                                        ext->next->size));
+        offset += ext->next->size;
+        gnrc_pktbuf_release(frag);
+    }
+    TEST_ASSERT_EQUAL_INT(TEST_FRAGS_NUMOF, numof);
+    TEST_ASSERT_EQUAL_INT(TEST_PAYLOAD_LEN, offset);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_ipv6_ext_frag_reass_in_order(void)
+{
+    unsigned offset = 0;
+
+    for (unsigned i = 0; i < (TEST_RFRAGS_NUMOF - 1); i++) {
+        TEST_ASSERT_NULL(gnrc_ipv6_ext_frag_reass(
+                             _rcvd_frag(TEST_ID, offset, TEST_RFRAG_LEN, true)));
+        offset += TEST_RFRAG_LEN;
+    }
+    _test_reassembled(gnrc_ipv6_ext_frag_reass(
+                          _rcvd_frag(TEST_ID, offset, TEST_RPAYLOAD_LEN - offset,
+                                     false)), TEST_RPAYLOAD_LEN);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_ipv6_ext_frag_reass_reversed_with_duplicate(void)
+{
+    unsigned offset = TEST_RFRAG_LEN * (TEST_RFRAGS_NUMOF - 1);
+
+    TEST_ASSERT_NULL(gnrc_ipv6_ext_frag_reass(
+                         _rcvd_frag(TEST_ID, offset, TEST_RPAYLOAD_LEN - offset,
+                                    false)));
+    TEST_ASSERT_NULL(gnrc_ipv6_ext_frag_reass(
+                         _rcvd_frag(TEST_ID, TEST_RFRAG_LEN, TEST_RFRAG_LEN, true)));
+    /* exact duplicate is ignored */
+    TEST_ASSERT_NULL(gnrc_ipv6_ext_frag_reass(
+                         _rcvd_frag(TEST_ID, TEST_RFRAG_LEN, TEST_RFRAG_LEN, true)));
+    _test_reassembled(gnrc_ipv6_ext_frag_reass(
+                          _rcvd_frag(TEST_ID, 0, TEST_RFRAG_LEN, true)),
+                      TEST_RPAYLOAD_LEN);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_ipv6_ext_frag_reass_interleaved(void)
+{
+    TEST_ASSERT_NULL(gnrc_ipv6_ext_frag_reass(
+                         _rcvd_frag(TEST_ID, 0, 64, true)));
+    TEST_ASSERT_NULL(gnrc_ipv6_ext_frag_reass(
+                         _rcvd_frag(TEST_ID + 1, 0, 128, true)));
+    _test_reassembled(gnrc_ipv6_ext_frag_reass(
+                          _rcvd_frag(TEST_ID, 64, 100, false)), 164);
+    _test_reassembled(gnrc_ipv6_ext_frag_reass(
+                          _rcvd_frag(TEST_ID + 1, 128, 10, false)), 138);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_ipv6_ext_frag_reass_overlap(void)
+{
+    TEST_ASSERT_NULL(gnrc_ipv6_ext_frag_reass(
+                         _rcvd_frag(TEST_ID, 0, 64, true)));
+    /* overlaps the first fragment: the whole datagram is dropped */
+    TEST_ASSERT_NULL(gnrc_ipv6_ext_frag_reass(
+                         _rcvd_frag(TEST_ID, 56, 64, true)));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+    /* so the datagram can't be completed anymore */
+    TEST_ASSERT_NULL(gnrc_ipv6_ext_frag_reass(
+                         _rcvd_frag(TEST_ID, 64, 100, false)));
+    gnrc_ipv6_ext_frag_rbuf_reset();
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_ipv6_ext_frag_reass_invalid(void)
+{
+    /* not the last fragment, but length is not a multiple of 8 */
+    TEST_ASSERT_NULL(gnrc_ipv6_ext_frag_reass(
+                         _rcvd_frag(TEST_ID, 0, 63, true)));
+    /* exceeds maximum datagram size */
+    TEST_ASSERT_NULL(gnrc_ipv6_ext_frag_reass(
+                         _rcvd_frag(TEST_ID, GNRC_IPV6_EXT_FRAG_MAX_SIZE, 8,
+                                    false)));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+    /* data beyond the last fragment */
+    TEST_ASSERT_NULL(gnrc_ipv6_ext_frag_reass(
+                         _rcvd_frag(TEST_ID, 64, 64, true)));
+    TEST_ASSERT_NULL(gnrc_ipv6_ext_frag_reass(
+                         _rcvd_frag(TEST_ID, 0, 64, false)));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_ipv6_ext_frag_reass_rbuf_full(void)
+{
+    /* fill the reassembly buffer, the oldest datagram is dropped for a new
+     * one */
+    for (unsigned i = 0; i <= GNRC_IPV6_EXT_FRAG_RBUF_SIZE; i++) {
+        TEST_ASSERT_NULL(gnrc_ipv6_ext_frag_reass(
+                             _rcvd_frag(TEST_ID + i, 0, 64, true)));
+    }
+    _test_reassembled(gnrc_ipv6_ext_frag_reass(
+                          _rcvd_frag(TEST_ID + GNRC_IPV6_EXT_FRAG_RBUF_SIZE,
+                                     64, 8, false)), 72);
+    /* first fragment of the oldest datagram is gone */
+    TEST_ASSERT_NULL(gnrc_ipv6_ext_frag_reass(
+                         _rcvd_frag(TEST_ID, 64, 8, false)));
+    gnrc_ipv6_ext_frag_rbuf_reset();
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_ipv6_ext_frag_reass_limits_pool_full(void)
+{
+    /* one fragment more than can be kept track of drops the datagram */
+    for (unsigned i = 0; i <= GNRC_IPV6_EXT_FRAG_LIMITS_POOL_SIZE; i++) {
+        TEST_ASSERT_NULL(gnrc_ipv6_ext_frag_reass(
+                             _rcvd_frag(TEST_ID, i * 8, 8, true)));
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+    /* all fragment limits are free again */
+    for (unsigned i = 0; i < GNRC_IPV6_EXT_FRAG_LIMITS_POOL_SIZE; i++) {
+        TEST_ASSERT_NULL(gnrc_ipv6_ext_frag_reass(
+                             _rcvd_frag(TEST_ID + 1, i * 8, 8, true)));
+    }
+    gnrc_ipv6_ext_frag_rbuf_reset();
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+    /* and datagrams are still reassembled */
+    TEST_ASSERT_NULL(gnrc_ipv6_ext_frag_reass(
+                         _rcvd_frag(TEST_ID + 2, 0, 64, true)));
+    _test_reassembled(gnrc_ipv6_ext_frag_reass(
+                          _rcvd_frag(TEST_ID + 2, 64, 100, false)), 164);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_ipv6_ext_frag_reass_timeout(void)
+{
+    msg_t msg;
+
+    TEST_ASSERT_NULL(gnrc_ipv6_ext_frag_reass(
+                         _rcvd_frag(TEST_ID, 0, 64, true)));
+    TEST_ASSERT(!gnrc_pktbuf_is_empty());
+    /* the timer tells the receiving thread when the datagram timed out */
+    msg_receive(&msg);
+    TEST_ASSERT_EQUAL_INT(GNRC_IPV6_EXT_FRAG_RBUF_GC, msg.type);
+    gnrc_ipv6_ext_frag_rbuf_gc();
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+Test *tests_gnrc_ipv6_ext_frag_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_ipv6_ext_frag_send),
+        new_TestFixture(test_ipv6_ext_frag_reass_in_order),
+        new_TestFixture(test_ipv6_ext_frag_reass_reversed_with_duplicate),
+        new_TestFixture(test_ipv6_ext_frag_reass_interleaved),
+        new_TestFixture(test_ipv6_ext_frag_reass_overlap),
+        new_TestFixture(test_ipv6_ext_frag_reass_invalid),
+        new_TestFixture(test_ipv6_ext_frag_reass_rbuf_full),
+        new_TestFixture(test_ipv6_ext_frag_reass_limits_pool_full),
+        new_TestFixture(test_ipv6_ext_frag_reass_timeout),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_ipv6_ext_frag_tests, set_up, NULL, fixtures);
+
+    return (Test *)&gnrc_ipv6_ext_frag_tests;
+}
+
+void tests_gnrc_ipv6_ext_frag(void)
+{
+    TESTS_RUN(tests_gnrc_ipv6_ext_frag_tests());
+}
+/** @} */
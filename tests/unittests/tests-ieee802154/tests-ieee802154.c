@@ -1011,6 +1011,144 @@ static void test_ieee802154_get_iid_addr_len_8(void)
     TEST_ASSERT_EQUAL_INT(0, memcmp((const char *)exp, (char *) &iid, sizeof(iid)));
 }
 
+static void test_ieee802154_parse_mhr_too_short(void)
+{
+    const uint8_t mhr[] = { IEEE802154_FCF_TYPE_DATA,
+                            IEEE802154_FCF_DST_ADDR_SHORT |
+                            IEEE802154_FCF_VERS_V1, TEST_UINT8, 0x34 };
+    ieee802154_mhr_t res;
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL, ieee802154_parse_mhr(mhr, 1, &res));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, ieee802154_parse_mhr(mhr, sizeof(mhr), &res));
+}
+
+static void test_ieee802154_parse_mhr_dstr(void)
+{
+    const uint8_t mhr[] = { IEEE802154_FCF_TYPE_DATA, 0x04, TEST_UINT8 };
+    ieee802154_mhr_t res;
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL, ieee802154_parse_mhr(mhr, sizeof(mhr), &res));
+}
+
+static void test_ieee802154_parse_mhr_dst0_src2_pancomp(void)
+{
+    const uint8_t mhr[] = { IEEE802154_FCF_TYPE_DATA | IEEE802154_FCF_PAN_COMP,
+                            IEEE802154_FCF_SRC_ADDR_SHORT |
+                            IEEE802154_FCF_VERS_V1, TEST_UINT8,
+                            0x12, 0x34 };
+    ieee802154_mhr_t res;
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL, ieee802154_parse_mhr(mhr, sizeof(mhr), &res));
+}
+
+static void test_ieee802154_parse_mhr_dst2_src8_pancomp(void)
+{
+    const uint8_t mhr[] = { IEEE802154_FCF_TYPE_DATA | IEEE802154_FCF_PAN_COMP,
+                            IEEE802154_FCF_DST_ADDR_SHORT |
+                            IEEE802154_FCF_SRC_ADDR_LONG |
+                            IEEE802154_FCF_VERS_V1, TEST_UINT8,
+                            0xcd, 0xab,         /* dst PAN */
+                            0xff, 0xff,         /* dst */
+                            0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01,
+                            0x42 };             /* payload */
+    const uint8_t exp_src[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08 };
+    ieee802154_mhr_t res;
+
+    TEST_ASSERT_EQUAL_INT(sizeof(mhr) - 1,
+                          ieee802154_parse_mhr(mhr, sizeof(mhr), &res));
+    TEST_ASSERT_EQUAL_INT(sizeof(mhr) - 1, res.hdr_len);
+    TEST_ASSERT_EQUAL_INT(IEEE802154_MHR_SEQ, res.flags);
+    TEST_ASSERT_EQUAL_INT(TEST_UINT8, res.seq);
+    TEST_ASSERT_EQUAL_INT(byteorder_htols(0xabcd).u16, res.dst_pan.u16);
+    TEST_ASSERT_EQUAL_INT(byteorder_htols(0xabcd).u16, res.src_pan.u16);
+    TEST_ASSERT_EQUAL_INT(2, res.dst_len);
+    TEST_ASSERT_EQUAL_INT(0xff, res.dst[0]);
+    TEST_ASSERT_EQUAL_INT(0xff, res.dst[1]);
+    TEST_ASSERT_EQUAL_INT(8, res.src_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(exp_src, res.src, sizeof(exp_src)));
+    /* must agree with the single field accessors */
+    TEST_ASSERT_EQUAL_INT(res.hdr_len, ieee802154_get_frame_hdr_len(mhr));
+}
+
+static void test_ieee802154_parse_mhr_dst2_src2(void)
+{
+    const uint8_t mhr[] = { IEEE802154_FCF_TYPE_DATA,
+                            IEEE802154_FCF_DST_ADDR_SHORT |
+                            IEEE802154_FCF_SRC_ADDR_SHORT |
+                            IEEE802154_FCF_VERS_V1, TEST_UINT8,
+                            0xcd, 0xab, 0x34, 0x12,     /* dst PAN, dst */
+                            0x21, 0x43, 0x78, 0x56 };   /* src PAN, src */
+    ieee802154_mhr_t res;
+
+    TEST_ASSERT_EQUAL_INT(sizeof(mhr), ieee802154_parse_mhr(mhr, sizeof(mhr),
+                                                            &res));
+    TEST_ASSERT_EQUAL_INT(byteorder_htols(0xabcd).u16, res.dst_pan.u16);
+    TEST_ASSERT_EQUAL_INT(byteorder_htols(0x4321).u16, res.src_pan.u16);
+    TEST_ASSERT_EQUAL_INT(0x12, res.dst[0]);
+    TEST_ASSERT_EQUAL_INT(0x34, res.dst[1]);
+    TEST_ASSERT_EQUAL_INT(0x56, res.src[0]);
+    TEST_ASSERT_EQUAL_INT(0x78, res.src[1]);
+}
+
+static void test_ieee802154_parse_mhr_v2_dst8_src8_pancomp(void)
+{
+    /* both addresses extended with PAN ID compression: no PAN ID at all */
+    const uint8_t mhr[] = { IEEE802154_FCF_TYPE_DATA | IEEE802154_FCF_PAN_COMP,
+                            IEEE802154_FCF_DST_ADDR_LONG |
+                            IEEE802154_FCF_SRC_ADDR_LONG |
+                            IEEE802154_FCF_VERS_V2, TEST_UINT8,
+                            0x18, 0x17, 0x16, 0x15, 0x14, 0x13, 0x12, 0x11,
+                            0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01 };
+    ieee802154_mhr_t res;
+
+    TEST_ASSERT_EQUAL_INT(sizeof(mhr), ieee802154_parse_mhr(mhr, sizeof(mhr),
+                                                            &res));
+    TEST_ASSERT_EQUAL_INT(0x11, res.dst[0]);
+    TEST_ASSERT_EQUAL_INT(0x01, res.src[0]);
+}
+
+static void test_ieee802154_parse_mhr_v2_seq_suppr_sec_ie(void)
+{
+    const uint8_t mhr[] = { IEEE802154_FCF_TYPE_DATA |
+                            IEEE802154_FCF_SECURITY_EN,
+                            IEEE802154_FCF_SEQ_SUPPR |
+                            IEEE802154_FCF_IE_PRESENT |
+                            IEEE802154_FCF_DST_ADDR_SHORT |
+                            IEEE802154_FCF_VERS_V2,
+                            0xcd, 0xab, 0x34, 0x12,     /* dst PAN, dst */
+                            0x0d,                       /* level 5, key mode 1 */
+                            0x04, 0x03, 0x02, 0x01,     /* frame counter */
+                            0x07,                       /* key index */
+                            0x02, 0x0d, 0xaa, 0xbb,     /* header IE id 0x1a */
+                            0x00, 0x3f,                 /* HT1 */
+                            0x42 };                     /* payload IE */
+    ieee802154_mhr_t res;
+
+    TEST_ASSERT_EQUAL_INT(sizeof(mhr) - 1,
+                          ieee802154_parse_mhr(mhr, sizeof(mhr), &res));
+    TEST_ASSERT_EQUAL_INT(IEEE802154_MHR_SECURITY | IEEE802154_MHR_HDR_IE |
+                          IEEE802154_MHR_PAYLOAD_IE, res.flags);
+    TEST_ASSERT_EQUAL_INT(2, res.dst_len);
+    TEST_ASSERT_EQUAL_INT(0, res.src_len);
+    TEST_ASSERT_EQUAL_INT(6, res.sec_offset);
+    TEST_ASSERT_EQUAL_INT(0x0d, res.sec_ctrl);
+    TEST_ASSERT_EQUAL_INT(0x01020304, res.frame_cnt);
+    TEST_ASSERT_EQUAL_INT(12, res.ie_offset);
+    TEST_ASSERT_EQUAL_INT(4, res.ie_len);
+}
+
+static void test_ieee802154_parse_mhr_v2_ie_truncated(void)
+{
+    const uint8_t mhr[] = { IEEE802154_FCF_TYPE_DATA,
+                            IEEE802154_FCF_SEQ_SUPPR |
+                            IEEE802154_FCF_IE_PRESENT |
+                            IEEE802154_FCF_VERS_V2,
+                            0x04, 0x0d, 0xaa, 0xbb };
+    ieee802154_mhr_t res;
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL, ieee802154_parse_mhr(mhr, sizeof(mhr), &res));
+}
+
 Test *tests_ieee802154_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -1069,6 +1207,14 @@ Test *tests_ieee802154_tests(void)
         new_TestFixture(test_ieee802154_get_dst_dst8),
         new_TestFixture(test_ieee802154_get_dst_dst8_pancomp),
         new_TestFixture(test_ieee802154_get_seq),
+        new_TestFixture(test_ieee802154_parse_mhr_too_short),
+        new_TestFixture(test_ieee802154_parse_mhr_dstr),
+        new_TestFixture(test_ieee802154_parse_mhr_dst0_src2_pancomp),
+        new_TestFixture(test_ieee802154_parse_mhr_dst2_src8_pancomp),
+        new_TestFixture(test_ieee802154_parse_mhr_dst2_src2),
+        new_TestFixture(test_ieee802154_parse_mhr_v2_dst8_src8_pancomp),
+        new_TestFixture(test_ieee802154_parse_mhr_v2_seq_suppr_sec_ie),
+        new_TestFixture(test_ieee802154_parse_mhr_v2_ie_truncated),
         new_TestFixture(test_ieee802154_get_iid_addr_len_0),
         new_TestFixture(test_ieee802154_get_iid_addr_len_SIZE_MAX),
         new_TestFixture(test_ieee802154_get_iid_addr_len_2),
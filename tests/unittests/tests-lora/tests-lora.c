@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include "embUnit.h"
+
+#include "net/lora.h"
+
+#include "tests-lora.h"
+
+#define FREQ_G_LOW      (864100000UL)
+#define FREQ_G          (865100000UL)
+#define FREQ_G1         (868100000UL)
+#define FREQ_G2         (868800000UL)
+#define FREQ_G3         (869525000UL)
+#define FREQ_NONE       (433175000UL)
+#define NOW             (1000000ULL)
+
+static lora_duty_t duty;
+
+static void set_up(void)
+{
+    lora_duty_init(&duty, lora_duty_bands_eu868, LORA_DUTY_BANDS_EU868_NUMOF);
+}
+
+static void test_lora_symbol_time(void)
+{
+    lora_modulation_t mod = { .bandwidth = 125, .sf = 7 };
+
+    TEST_ASSERT_EQUAL_INT(1024, lora_symbol_time(&mod));
+    mod.sf = 12;
+    TEST_ASSERT_EQUAL_INT(32768, lora_symbol_time(&mod));
+    mod.bandwidth = 250;
+    TEST_ASSERT_EQUAL_INT(16384, lora_symbol_time(&mod));
+    mod.bandwidth = 500;
+    mod.sf = 6;
+    TEST_ASSERT_EQUAL_INT(128, lora_symbol_time(&mod));
+}
+
+static void test_lora_time_on_air__sf7(void)
+{
+    /* values of the time on air formula of the SX1276 data sheet */
+    lora_modulation_t mod = {
+        .bandwidth = 125, .preamble_len = 8, .sf = 7, .cr = 1,
+        .flags = LORA_FLAG_CRC,
+    };
+
+    TEST_ASSERT_EQUAL_INT(41216, lora_time_on_air(&mod, 10));
+    mod.bandwidth = 500;
+    mod.cr = 4;
+    TEST_ASSERT_EQUAL_INT(156736, lora_time_on_air(&mod, 255));
+}
+
+static void test_lora_time_on_air__sf12_ldro(void)
+{
+    lora_modulation_t mod = {
+        .bandwidth = 125, .preamble_len = 8, .sf = 12, .cr = 1,
+        .flags = LORA_FLAG_CRC | LORA_FLAG_LOW_DATARATE_OPT,
+    };
+
+    TEST_ASSERT_EQUAL_INT(2465792, lora_time_on_air(&mod, 51));
+}
+
+static void test_lora_time_on_air__other(void)
+{
+    lora_modulation_t mod = {
+        .bandwidth = 250, .preamble_len = 8, .sf = 9, .cr = 1,
+        .flags = LORA_FLAG_CRC,
+    };
+
+    TEST_ASSERT_EQUAL_INT(92672, lora_time_on_air(&mod, 20));
+    mod.bandwidth = 125;
+    mod.preamble_len = 12;
+    mod.sf = 8;
+    mod.cr = 2;
+    TEST_ASSERT_EQUAL_INT(184832, lora_time_on_air(&mod, 40));
+}
+
+static void test_lora_time_on_air__implicit_header(void)
+{
+    lora_modulation_t mod = {
+        .bandwidth = 125, .preamble_len = 8, .sf = 6, .cr = 1,
+        .flags = LORA_FLAG_IMPLICIT_HEADER,
+    };
+
+    TEST_ASSERT_EQUAL_INT(20608, lora_time_on_air(&mod, 12));
+    /* an empty payload fits into the 8 header symbols */
+    mod.sf = 10;
+    TEST_ASSERT_EQUAL_INT(165888, lora_time_on_air(&mod, 0));
+}
+
+static void test_lora_duty__init(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, lora_duty_wait(&duty, FREQ_G_LOW, 0));
+    TEST_ASSERT_EQUAL_INT(0, lora_duty_wait(&duty, FREQ_G, 0));
+    TEST_ASSERT_EQUAL_INT(0, lora_duty_wait(&duty, FREQ_G1, NOW));
+    TEST_ASSERT_EQUAL_INT(0, lora_duty_wait(&duty, FREQ_G2, NOW));
+    TEST_ASSERT_EQUAL_INT(0, lora_duty_wait(&duty, FREQ_G3, NOW));
+}
+
+static void test_lora_duty__account(void)
+{
+    /* 1 % */
+    lora_duty_account(&duty, FREQ_G1, NOW, 41216);
+    TEST_ASSERT_EQUAL_INT(4121600, lora_duty_wait(&duty, FREQ_G1, NOW));
+    TEST_ASSERT_EQUAL_INT(121600, lora_duty_wait(&duty, FREQ_G1,
+                                                 NOW + 4000000));
+    TEST_ASSERT_EQUAL_INT(0, lora_duty_wait(&duty, FREQ_G1, NOW + 4121600));
+    /* 0.1 % */
+    lora_duty_account(&duty, FREQ_G2, NOW, 41216);
+    TEST_ASSERT_EQUAL_INT(41216000, lora_duty_wait(&duty, FREQ_G2, NOW));
+    /* 10 % */
+    lora_duty_account(&duty, FREQ_G3, NOW, 41216);
+    TEST_ASSERT_EQUAL_INT(412160, lora_duty_wait(&duty, FREQ_G3, NOW));
+}
+
+static void test_lora_duty__below_865mhz(void)
+{
+    /* 863.0 - 865.0 MHz only allows 0.1 % */
+    lora_duty_account(&duty, FREQ_G_LOW, NOW, 41216);
+    TEST_ASSERT_EQUAL_INT(41216000, lora_duty_wait(&duty, FREQ_G_LOW, NOW));
+    TEST_ASSERT_EQUAL_INT(41216000, lora_duty_wait(&duty, 863100000, NOW));
+    TEST_ASSERT_EQUAL_INT(0, lora_duty_wait(&duty, FREQ_G, NOW));
+    /* 865.0 - 868.0 MHz allows 1 % */
+    lora_duty_account(&duty, FREQ_G, NOW, 41216);
+    TEST_ASSERT_EQUAL_INT(4121600, lora_duty_wait(&duty, FREQ_G, NOW));
+}
+
+static void test_lora_duty__bands_independent(void)
+{
+    lora_duty_account(&duty, FREQ_G1, NOW, 41216);
+    TEST_ASSERT_EQUAL_INT(0, lora_duty_wait(&duty, FREQ_G, NOW));
+    TEST_ASSERT_EQUAL_INT(0, lora_duty_wait(&duty, FREQ_G2, NOW));
+    /* all channels of a sub-band share its budget */
+    TEST_ASSERT_EQUAL_INT(4121600, lora_duty_wait(&duty, 868000000, NOW));
+    TEST_ASSERT_EQUAL_INT(4121600, lora_duty_wait(&duty, 868600000, NOW));
+    /* a later transmission restarts the off time */
+    lora_duty_account(&duty, FREQ_G1, NOW + 5000000, 1000);
+    TEST_ASSERT_EQUAL_INT(100000, lora_duty_wait(&duty, FREQ_G1,
+                                                 NOW + 5000000));
+}
+
+static void test_lora_duty__outside_bands(void)
+{
+    lora_duty_account(&duty, FREQ_NONE, NOW, 41216);
+    TEST_ASSERT_EQUAL_INT(0, lora_duty_wait(&duty, FREQ_NONE, NOW));
+    /* between two sub-bands */
+    lora_duty_account(&duty, 868650000, NOW, 41216);
+    TEST_ASSERT_EQUAL_INT(0, lora_duty_wait(&duty, 868650000, NOW));
+    TEST_ASSERT_EQUAL_INT(0, lora_duty_wait(&duty, FREQ_G1, NOW));
+}
+
+static void test_lora_duty__custom_band(void)
+{
+    static const lora_duty_band_t band = {
+        .min_freq = 915000000, .max_freq = 916000000, .duty = 3,
+    };
+
+    lora_duty_init(&duty, &band, 1);
+    /* off time is rounded up */
+    lora_duty_account(&duty, 915500000, NOW, 1000);
+    TEST_ASSERT_EQUAL_INT(333334, lora_duty_wait(&duty, 915500000, NOW));
+    TEST_ASSERT_EQUAL_INT(0, lora_duty_wait(&duty, FREQ_G1, NOW));
+}
+
+Test *tests_lora_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_lora_symbol_time),
+        new_TestFixture(test_lora_time_on_air__sf7),
+        new_TestFixture(test_lora_time_on_air__sf12_ldro),
+        new_TestFixture(test_lora_time_on_air__other),
+        new_TestFixture(test_lora_time_on_air__implicit_header),
+        new_TestFixture(test_lora_duty__init),
+        new_TestFixture(test_lora_duty__account),
+        new_TestFixture(test_lora_duty__below_865mhz),
+        new_TestFixture(test_lora_duty__bands_independent),
+        new_TestFixture(test_lora_duty__outside_bands),
+        new_TestFixture(test_lora_duty__custom_band),
+    };
+
+    EMB_UNIT_TESTCALLER(lora_tests, set_up, NULL, fixtures);
+
+    return (Test *)&lora_tests;
+}
+
+void tests_lora(void)
+{
+    TESTS_RUN(tests_lora_tests());
+}
+/** @} */
@@ -812,6 +812,35 @@ static void test_pktbuf_get_iovec__null(void)
     TEST_ASSERT_EQUAL_INT(0, len);
 }
 
+#ifdef DEVELHELP
+static void test_pktbuf_get_used(void)
+{
+    gnrc_pktsnip_t *pkt1, *pkt2;
+    size_t used, max_used;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_get_used(&max_used));
+    TEST_ASSERT_EQUAL_INT(0, max_used);
+    pkt1 = gnrc_pktbuf_add(NULL, TEST_STRING16, sizeof(TEST_STRING16),
+                           GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt1);
+    TEST_ASSERT((used = gnrc_pktbuf_get_used(NULL)) >=
+                (sizeof(gnrc_pktsnip_t) + sizeof(TEST_STRING16)));
+    pkt2 = gnrc_pktbuf_add(NULL, TEST_STRING8, sizeof(TEST_STRING8),
+                           GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt2);
+    TEST_ASSERT(gnrc_pktbuf_get_used(NULL) > used);
+    gnrc_pktbuf_release(pkt2);
+    TEST_ASSERT_EQUAL_INT(used, gnrc_pktbuf_get_used(&max_used));
+    TEST_ASSERT(max_used > used);
+    gnrc_pktbuf_reset_max_used();
+    gnrc_pktbuf_get_used(&max_used);
+    TEST_ASSERT_EQUAL_INT(used, max_used);
+    gnrc_pktbuf_release(pkt1);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_get_used(NULL));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+#endif
+
 Test *tests_pktbuf_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -858,6 +887,9 @@ Test *tests_pktbuf_tests(void)
         new_TestFixture(test_pktbuf_get_iovec__1_elem),
         new_TestFixture(test_pktbuf_get_iovec__3_elem),
         new_TestFixture(test_pktbuf_get_iovec__null),
+#ifdef DEVELHELP
+        new_TestFixture(test_pktbuf_get_used),
+#endif
     };
 
     EMB_UNIT_TESTCALLER(gnrc_pktbuf_tests, set_up, NULL, fixtures);
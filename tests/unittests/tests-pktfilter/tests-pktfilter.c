@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/pktfilter.h"
+
+#include "tests-pktfilter.h"
+
+#define RULES_NUMOF     (8U)
+#define TABLE_SIZE      (16U)
+
+static pktfilter_rule_t rules[RULES_NUMOF];
+static uint16_t table[TABLE_SIZE];
+static pktfilter_t filter;
+
+static const uint8_t addr_a[] = { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 1,
+                                  0, 0, 0, 0, 0, 0, 0, 0x0a };
+static const uint8_t addr_b[] = { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 2,
+                                  0, 0, 0, 0, 0, 0, 0, 0x0b };
+static const uint8_t l2_a[] = { 0x12, 0x34 };
+
+static void set_up(void)
+{
+    pktfilter_init(&filter, rules, RULES_NUMOF, table, TABLE_SIZE);
+}
+
+static int _add(uint8_t field, const uint8_t *addr, uint8_t addr_len,
+                uint8_t prefix_len, uint8_t action)
+{
+    pktfilter_rule_t rule;
+
+    memset(&rule, 0, sizeof(rule));
+    memcpy(rule.addr, addr, addr_len);
+    rule.addr_len = addr_len;
+    rule.prefix_len = prefix_len;
+    rule.field = field;
+    rule.action = action;
+    rule.proto = PKTFILTER_PROTO_ANY;
+    rule.port = PKTFILTER_PORT_ANY;
+    return pktfilter_add(&filter, &rule);
+}
+
+static bool _pass_ipv6(const uint8_t *src, uint8_t proto, uint16_t port)
+{
+    pktfilter_pkt_t pkt = { .ipv6_src = src, .ipv6_dst = addr_b,
+                            .proto = proto, .port = port };
+
+    return pktfilter_pass(&filter, &pkt);
+}
+
+static void test_pktfilter_empty(void)
+{
+    TEST_ASSERT(_pass_ipv6(addr_a, 17, 5683));
+    filter.default_action = PKTFILTER_DROP;
+    TEST_ASSERT(!_pass_ipv6(addr_a, 17, 5683));
+}
+
+static void test_pktfilter_exact(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, _add(PKTFILTER_IPV6_SRC, addr_a, 16, 128,
+                                  PKTFILTER_DROP));
+    TEST_ASSERT(!_pass_ipv6(addr_a, 17, 5683));
+    TEST_ASSERT(_pass_ipv6(addr_b, 17, 5683));
+    TEST_ASSERT_EQUAL_INT(1, rules[0].hits);
+}
+
+static void test_pktfilter_l2(void)
+{
+    pktfilter_pkt_t pkt = { .l2_src = l2_a, .l2_src_len = sizeof(l2_a),
+                            .proto = PKTFILTER_PROTO_ANY };
+
+    TEST_ASSERT_EQUAL_INT(0, _add(PKTFILTER_L2_SRC, l2_a, sizeof(l2_a), 16,
+                                  PKTFILTER_DROP));
+    TEST_ASSERT(!pktfilter_pass(&filter, &pkt));
+    /* same address bytes as IPv6 prefix must not match */
+    TEST_ASSERT(_pass_ipv6(addr_a, 17, 5683));
+}
+
+static void test_pktfilter_longest_prefix(void)
+{
+    /* drop 2001:db8::/32, but accept 2001:db8:0:1::/64 */
+    TEST_ASSERT_EQUAL_INT(0, _add(PKTFILTER_IPV6_SRC, addr_a, 16, 32,
+                                  PKTFILTER_DROP));
+    TEST_ASSERT_EQUAL_INT(1, _add(PKTFILTER_IPV6_SRC, addr_a, 16, 64,
+                                  PKTFILTER_ACCEPT));
+    TEST_ASSERT(_pass_ipv6(addr_a, 17, 5683));
+    TEST_ASSERT(!_pass_ipv6(addr_b, 17, 5683));
+    TEST_ASSERT_EQUAL_INT(1, rules[0].hits);
+    TEST_ASSERT_EQUAL_INT(1, rules[1].hits);
+}
+
+static void test_pktfilter_proto_port(void)
+{
+    /* drop UDP port 5683 from the /64 of addr_a, same key, chained */
+    TEST_ASSERT_EQUAL_INT(0, _add(PKTFILTER_IPV6_SRC, addr_a, 16, 64,
+                                  PKTFILTER_COUNT));
+    rules[0].proto = 17;
+    rules[0].port = 5683;
+    rules[0].action = PKTFILTER_DROP;
+    TEST_ASSERT_EQUAL_INT(1, _add(PKTFILTER_IPV6_SRC, addr_a, 16, 64,
+                                  PKTFILTER_COUNT));
+    TEST_ASSERT(!_pass_ipv6(addr_a, 17, 5683));
+    TEST_ASSERT(_pass_ipv6(addr_a, 17, 5684));
+    TEST_ASSERT(_pass_ipv6(addr_a, 6, 5683));
+    TEST_ASSERT_EQUAL_INT(1, rules[0].hits);
+    TEST_ASSERT_EQUAL_INT(2, rules[1].hits);
+}
+
+static void test_pktfilter_del(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, _add(PKTFILTER_IPV6_SRC, addr_a, 16, 128,
+                                  PKTFILTER_DROP));
+    TEST_ASSERT_EQUAL_INT(1, _add(PKTFILTER_IPV6_SRC, addr_b, 16, 128,
+                                  PKTFILTER_DROP));
+    TEST_ASSERT_EQUAL_INT(0, pktfilter_del(&filter, 0));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, pktfilter_del(&filter, 1));
+    TEST_ASSERT(_pass_ipv6(addr_a, 17, 5683));
+    TEST_ASSERT(!_pass_ipv6(addr_b, 17, 5683));
+}
+
+static void test_pktfilter_full(void)
+{
+    uint8_t addr[16];
+
+    memcpy(addr, addr_a, sizeof(addr));
+    for (unsigned i = 0; i < RULES_NUMOF; i++) {
+        addr[15] = i;
+        TEST_ASSERT_EQUAL_INT(i, _add(PKTFILTER_IPV6_SRC, addr, 16, 128,
+                                      PKTFILTER_DROP));
+    }
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, _add(PKTFILTER_IPV6_SRC, addr_b, 16, 128,
+                                        PKTFILTER_DROP));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, _add(PKTFILTER_FIELD_NUMOF, addr_b, 16,
+                                        128, PKTFILTER_DROP));
+}
+
+static void test_pktfilter_ratelimit(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, _add(PKTFILTER_IPV6_SRC, addr_a, 16, 128,
+                                  PKTFILTER_RATELIMIT));
+    /* no refill, just the bucket */
+    rules[0].burst = rules[0].tokens = 2;
+    TEST_ASSERT(_pass_ipv6(addr_a, 17, 5683));
+    TEST_ASSERT(_pass_ipv6(addr_a, 17, 5683));
+    TEST_ASSERT(!_pass_ipv6(addr_a, 17, 5683));
+    TEST_ASSERT_EQUAL_INT(3, rules[0].hits);
+}
+
+Test *tests_pktfilter_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_pktfilter_empty),
+        new_TestFixture(test_pktfilter_exact),
+        new_TestFixture(test_pktfilter_l2),
+        new_TestFixture(test_pktfilter_longest_prefix),
+        new_TestFixture(test_pktfilter_proto_port),
+        new_TestFixture(test_pktfilter_del),
+        new_TestFixture(test_pktfilter_full),
+        new_TestFixture(test_pktfilter_ratelimit),
+    };
+
+    EMB_UNIT_TESTCALLER(pktfilter_tests, set_up, NULL, fixtures);
+
+    return (Test *)&pktfilter_tests;
+}
+
+void tests_pktfilter(void)
+{
+    TESTS_RUN(tests_pktfilter_tests());
+}
+/** @} */
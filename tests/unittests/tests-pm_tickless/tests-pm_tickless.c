@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+
+#include "pm_tickless.h"
+#include "tests-pm_tickless.h"
+
+#define MOCK_NUM_MODES  (3U)
+#define MOCK_IDLE       (MOCK_NUM_MODES)
+
+/* mode 0 is the deepest mode */
+static const pm_tickless_mode_t _modes[MOCK_NUM_MODES] = {
+    { .exit_latency = 2000, .break_even = 10000 },
+    { .exit_latency = 500, .break_even = 1500 },
+    { .exit_latency = 20, .break_even = 100 },
+};
+
+static pm_tickless_stats_t _stats[MOCK_NUM_MODES + 1];
+static unsigned _mock_mode;
+static uint32_t _mock_deadline;
+
+static void set_up(void)
+{
+    memset(_stats, 0, sizeof(_stats));
+    _mock_mode = UINT32_MAX;
+    _mock_deadline = 0;
+}
+
+/* mock backend: pretends to sleep until the pending deadline */
+static uint32_t _mock_pm_set(unsigned mode)
+{
+    _mock_mode = mode;
+    return _mock_deadline;
+}
+
+/* runs one iteration of the idle loop, like pm_set_lowest() does */
+static unsigned _idle(unsigned lowest, uint32_t deadline)
+{
+    _mock_deadline = deadline;
+    unsigned mode = pm_tickless_select(_modes, MOCK_NUM_MODES, lowest, deadline);
+    pm_tickless_record(&_stats[mode], _mock_pm_set(mode));
+    return mode;
+}
+
+static void test_pm_tickless_select_deepest(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, pm_tickless_select(_modes, MOCK_NUM_MODES, 0,
+                                                UINT32_MAX));
+    TEST_ASSERT_EQUAL_INT(0, pm_tickless_select(_modes, MOCK_NUM_MODES, 0,
+                                                10000));
+}
+
+static void test_pm_tickless_select_break_even(void)
+{
+    /* exit latency of mode 0 fits, but it does not pay off */
+    TEST_ASSERT_EQUAL_INT(1, pm_tickless_select(_modes, MOCK_NUM_MODES, 0,
+                                                9999));
+    TEST_ASSERT_EQUAL_INT(1, pm_tickless_select(_modes, MOCK_NUM_MODES, 0,
+                                                1500));
+    TEST_ASSERT_EQUAL_INT(2, pm_tickless_select(_modes, MOCK_NUM_MODES, 0,
+                                                1499));
+}
+
+static void test_pm_tickless_select_exit_latency(void)
+{
+    static const pm_tickless_mode_t modes[] = {
+        { .exit_latency = 300, .break_even = 100 },
+    };
+
+    TEST_ASSERT_EQUAL_INT(0, pm_tickless_select(modes, 1, 0, 300));
+    TEST_ASSERT_EQUAL_INT(1, pm_tickless_select(modes, 1, 0, 299));
+}
+
+static void test_pm_tickless_select_idle(void)
+{
+    TEST_ASSERT_EQUAL_INT(MOCK_IDLE, pm_tickless_select(_modes, MOCK_NUM_MODES,
+                                                        0, 99));
+    TEST_ASSERT_EQUAL_INT(MOCK_IDLE, pm_tickless_select(_modes, MOCK_NUM_MODES,
+                                                        0, 0));
+}
+
+static void test_pm_tickless_select_blocked(void)
+{
+    /* modes below the lowest unblocked one must never be selected */
+    TEST_ASSERT_EQUAL_INT(2, pm_tickless_select(_modes, MOCK_NUM_MODES, 2,
+                                                UINT32_MAX));
+    TEST_ASSERT_EQUAL_INT(MOCK_IDLE, pm_tickless_select(_modes, MOCK_NUM_MODES,
+                                                        MOCK_IDLE, UINT32_MAX));
+}
+
+static void test_pm_tickless_idle_loop(void)
+{
+    static const uint32_t deadlines[] = { 50000, 5000, 200, 50, 20000, 3000 };
+    static const unsigned expected[] = { 0, 1, 2, MOCK_IDLE, 0, 1 };
+
+    for (unsigned i = 0; i < sizeof(deadlines) / sizeof(deadlines[0]); i++) {
+        TEST_ASSERT_EQUAL_INT(expected[i], _idle(0, deadlines[i]));
+        TEST_ASSERT_EQUAL_INT(expected[i], _mock_mode);
+    }
+
+    TEST_ASSERT_EQUAL_INT(2, _stats[0].entries);
+    TEST_ASSERT(_stats[0].residency == 70000);
+    TEST_ASSERT_EQUAL_INT(2, _stats[1].entries);
+    TEST_ASSERT(_stats[1].residency == 8000);
+    TEST_ASSERT_EQUAL_INT(1, _stats[2].entries);
+    TEST_ASSERT(_stats[2].residency == 200);
+    TEST_ASSERT_EQUAL_INT(1, _stats[MOCK_IDLE].entries);
+    TEST_ASSERT(_stats[MOCK_IDLE].residency == 50);
+}
+
+static void test_pm_tickless_idle_loop_blocked(void)
+{
+    TEST_ASSERT_EQUAL_INT(1, _idle(1, 50000));
+    TEST_ASSERT_EQUAL_INT(0, _stats[0].entries);
+    TEST_ASSERT_EQUAL_INT(1, _stats[1].entries);
+}
+
+Test *tests_pm_tickless_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_pm_tickless_select_deepest),
+        new_TestFixture(test_pm_tickless_select_break_even),
+        new_TestFixture(test_pm_tickless_select_exit_latency),
+        new_TestFixture(test_pm_tickless_select_idle),
+        new_TestFixture(test_pm_tickless_select_blocked),
+        new_TestFixture(test_pm_tickless_idle_loop),
+        new_TestFixture(test_pm_tickless_idle_loop_blocked),
+    };
+
+    EMB_UNIT_TESTCALLER(pm_tickless_tests, set_up, NULL, fixtures);
+
+    return (Test *)&pm_tickless_tests;
+}
+
+void tests_pm_tickless(void)
+{
+    TESTS_RUN(tests_pm_tickless_tests());
+}
+/** @} */
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+
+#include "tsrb.h"
+#include "tests-tsrb.h"
+
+#define BUF_SIZE    (16U)
+
+static char _buf[BUF_SIZE];
+static tsrb_t _rb;
+
+static void set_up(void)
+{
+    memset(_buf, 0, sizeof(_buf));
+    tsrb_init(&_rb, _buf, sizeof(_buf));
+}
+
+static void _fill(char *data, size_t n, char start)
+{
+    for (size_t i = 0; i < n; i++) {
+        data[i] = start + i;
+    }
+}
+
+static void test_tsrb_add_get(void)
+{
+    char in[BUF_SIZE];
+    char out[BUF_SIZE];
+
+    _fill(in, sizeof(in), 'a');
+    TEST_ASSERT_EQUAL_INT(10, tsrb_add(&_rb, in, 10));
+    TEST_ASSERT_EQUAL_INT(10, tsrb_avail(&_rb));
+    TEST_ASSERT_EQUAL_INT(4, tsrb_get(&_rb, out, 4));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(in, out, 4));
+    TEST_ASSERT_EQUAL_INT(6, tsrb_get(&_rb, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(in + 4, out, 6));
+    TEST_ASSERT(tsrb_empty(&_rb));
+}
+
+static void test_tsrb_add_full(void)
+{
+    char in[BUF_SIZE + 4];
+    char out[BUF_SIZE];
+
+    _fill(in, sizeof(in), 'a');
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE, tsrb_add(&_rb, in, sizeof(in)));
+    TEST_ASSERT(tsrb_full(&_rb));
+    TEST_ASSERT_EQUAL_INT(0, tsrb_add(&_rb, in, 1));
+    TEST_ASSERT_EQUAL_INT(-1, tsrb_add_one(&_rb, 'x'));
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE, tsrb_get(&_rb, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(in, out, BUF_SIZE));
+    TEST_ASSERT_EQUAL_INT(-1, tsrb_get_one(&_rb));
+}
+
+static void test_tsrb_wrap_around(void)
+{
+    char in[BUF_SIZE];
+    char out[BUF_SIZE];
+
+    /* move the read and write positions close to the end of the buffer */
+    _fill(in, sizeof(in), 'A');
+    tsrb_add(&_rb, in, BUF_SIZE - 3);
+    tsrb_get(&_rb, out, BUF_SIZE - 3);
+
+    _fill(in, sizeof(in), 'a');
+    TEST_ASSERT_EQUAL_INT(10, tsrb_add(&_rb, in, 10));
+    TEST_ASSERT_EQUAL_INT(10, tsrb_get(&_rb, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(in, out, 10));
+    /* the data did wrap around the end of the buffer */
+    TEST_ASSERT_EQUAL_INT('a', _buf[BUF_SIZE - 3]);
+    TEST_ASSERT_EQUAL_INT('d', _buf[0]);
+}
+
+static void test_tsrb_one(void)
+{
+    for (unsigned i = 0; i < (2 * BUF_SIZE); i++) {
+        TEST_ASSERT_EQUAL_INT(0, tsrb_add_one(&_rb, 'a' + (i % 16)));
+        TEST_ASSERT_EQUAL_INT('a' + (i % 16), tsrb_get_one(&_rb));
+    }
+}
+
+static void test_tsrb_read_contiguous(void)
+{
+    char in[BUF_SIZE];
+    char *ptr;
+
+    TEST_ASSERT_EQUAL_INT(0, tsrb_read_contiguous(&_rb, &ptr));
+
+    _fill(in, sizeof(in), 'a');
+    tsrb_add(&_rb, in, BUF_SIZE - 2);
+    tsrb_get(&_rb, in, BUF_SIZE - 2);
+    _fill(in, sizeof(in), 'a');
+    tsrb_add(&_rb, in, 5);
+
+    /* first segment up to the end of the buffer */
+    TEST_ASSERT_EQUAL_INT(2, tsrb_read_contiguous(&_rb, &ptr));
+    TEST_ASSERT(ptr == &_buf[BUF_SIZE - 2]);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(in, ptr, 2));
+    /* not committed yet */
+    TEST_ASSERT_EQUAL_INT(5, tsrb_avail(&_rb));
+    tsrb_read_commit(&_rb, 2);
+
+    /* second segment at the start of the buffer */
+    TEST_ASSERT_EQUAL_INT(3, tsrb_read_contiguous(&_rb, &ptr));
+    TEST_ASSERT(ptr == &_buf[0]);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(in + 2, ptr, 3));
+    tsrb_read_commit(&_rb, 1);
+    TEST_ASSERT_EQUAL_INT('d', tsrb_get_one(&_rb));
+    TEST_ASSERT_EQUAL_INT(1, tsrb_avail(&_rb));
+}
+
+static void test_tsrb_write_contiguous(void)
+{
+    char out[BUF_SIZE];
+    char *ptr;
+
+    memset(out, 0, sizeof(out));
+    tsrb_add(&_rb, out, 6);
+    tsrb_get(&_rb, out, 4);
+
+    /* first segment up to the end of the buffer */
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE - 6, tsrb_write_contiguous(&_rb, &ptr));
+    TEST_ASSERT(ptr == &_buf[6]);
+    _fill(ptr, BUF_SIZE - 6, 'a');
+    tsrb_write_commit(&_rb, BUF_SIZE - 6);
+
+    /* second segment limited by the unread data */
+    TEST_ASSERT_EQUAL_INT(4, tsrb_write_contiguous(&_rb, &ptr));
+    TEST_ASSERT(ptr == &_buf[0]);
+    tsrb_write_commit(&_rb, 4);
+    TEST_ASSERT(tsrb_full(&_rb));
+    TEST_ASSERT_EQUAL_INT(0, tsrb_write_contiguous(&_rb, &ptr));
+
+    TEST_ASSERT_EQUAL_INT(2, tsrb_get(&_rb, out, 2));
+    TEST_ASSERT_EQUAL_INT(BUF_SIZE - 6, tsrb_get(&_rb, out, BUF_SIZE - 6));
+    TEST_ASSERT_EQUAL_INT('a', out[0]);
+    TEST_ASSERT_EQUAL_INT('a' + BUF_SIZE - 7, out[BUF_SIZE - 7]);
+}
+
+Test *tests_tsrb_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_tsrb_add_get),
+        new_TestFixture(test_tsrb_add_full),
+        new_TestFixture(test_tsrb_wrap_around),
+        new_TestFixture(test_tsrb_one),
+        new_TestFixture(test_tsrb_read_contiguous),
+        new_TestFixture(test_tsrb_write_contiguous),
+    };
+
+    EMB_UNIT_TESTCALLER(tsrb_tests, set_up, NULL, fixtures);
+
+    return (Test *)&tsrb_tests;
+}
+
+void tests_tsrb(void)
+{
+    TESTS_RUN(tests_tsrb_tests());
+}
+/** @} */
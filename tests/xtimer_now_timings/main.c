@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2017 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the cost of reading the time via xtimer
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "board.h"
+#include "periph_conf.h"
+#include "xtimer.h"
+
+#ifndef CALLS
+#define CALLS           (100000UL)
+#endif
+#ifndef LOAD_INTERVAL
+#define LOAD_INTERVAL   (100U)
+#endif
+
+static xtimer_t load_timer;
+static volatile int load_active;
+static volatile uint32_t load_count;
+
+static void load_cb(void *arg)
+{
+    (void)arg;
+    load_count++;
+    if (load_active) {
+        xtimer_set(&load_timer, LOAD_INTERVAL);
+    }
+}
+
+static uint32_t read_now(void)
+{
+    return xtimer_now().ticks32;
+}
+
+static uint32_t read_now64(void)
+{
+    return (uint32_t)xtimer_now64().ticks64;
+}
+
+static uint32_t read_now_coarse(void)
+{
+    return xtimer_now_coarse().ticks32;
+}
+
+static void run(const char *name, uint32_t (*read)(void))
+{
+    volatile uint32_t sink;
+
+    uint32_t start = xtimer_now_usec();
+    for (unsigned long i = 0; i < CALLS; i++) {
+        sink = read();
+    }
+    uint32_t elapsed = xtimer_now_usec() - start;
+    (void)sink;
+
+    printf("+ %-18s %6lu ns/call", name,
+           (unsigned long)(((uint64_t)elapsed * 1000) / CALLS));
+#ifdef CLOCK_CORECLOCK
+    printf(" %6lu cycles/call",
+           (unsigned long)(((uint64_t)elapsed * (CLOCK_CORECLOCK / 1000000))
+                           / CALLS));
+#endif
+    puts("");
+}
+
+static void run_all(void)
+{
+    run("xtimer_now()", read_now);
+    run("xtimer_now64()", read_now64);
+    run("xtimer_now_coarse()", read_now_coarse);
+}
+
+int main(void)
+{
+    puts("xtimer_now timings test");
+
+    puts("\nidle:");
+    run_all();
+
+    printf("\ninterrupt load (every %u us):\n", LOAD_INTERVAL);
+    load_timer.callback = load_cb;
+    load_active = 1;
+    xtimer_set(&load_timer, LOAD_INTERVAL);
+    run_all();
+    load_active = 0;
+    xtimer_remove(&load_timer);
+    printf("%lu timer interrupts\n", (unsigned long)load_count);
+
+    puts("\nDone.");
+    return 0;
+}